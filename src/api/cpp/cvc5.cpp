@@ -52,6 +52,7 @@
 #include "expr/node_algorithm.h"
 #include "expr/node_builder.h"
 #include "expr/node_manager.h"
+#include "expr/node_serializer.h"
 #include "expr/sequence.h"
 #include "expr/type_node.h"
 #include "expr/uninterpreted_constant.h"
@@ -59,6 +60,7 @@
 #include "options/main_options.h"
 #include "options/option_exception.h"
 #include "options/options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/unsat_core.h"
 #include "smt/model.h"
@@ -74,6 +76,7 @@
 #include "util/iand.h"
 #include "util/random.h"
 #include "util/regexp.h"
+#include "util/resource_manager.h"
 #include "util/result.h"
 #include "util/roundingmode.h"
 #include "util/statistics_registry.h"
@@ -4743,8 +4746,13 @@ std::ostream& operator<<(std::ostream& out, const Statistics& stats)
 /* -------------------------------------------------------------------------- */
 
 Solver::Solver(Options* opts)
+    : Solver(std::shared_ptr<NodeManager>(new NodeManager()), opts)
+{
+}
+
+Solver::Solver(std::shared_ptr<NodeManager> nm, Options* opts)
+    : d_nodeMgr(nm)
 {
-  d_nodeMgr.reset(new NodeManager());
   d_originalOptions.reset(new Options());
   if (opts != nullptr)
   {
@@ -4758,6 +4766,48 @@ Solver::Solver(Options* opts)
 
 Solver::~Solver() {}
 
+std::unique_ptr<Solver> Solver::clone() const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  std::unique_ptr<Solver> res(
+      new Solver(d_nodeMgr, &d_smtEngine->getOptions()));
+  res->d_smtEngine->setLogic(d_smtEngine->getLogicInfo());
+  res->d_smtEngine->copyPreprocessedState(*d_smtEngine);
+  return res;
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+Term Solver::importTerm(const Term& t) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_ARG_CHECK_NOT_NULL(t);
+  CVC5_API_ARG_CHECK_EXPECTED(t.d_solver->getNodeManager() == getNodeManager(),
+                              t)
+      << "a term of a solver that shares the node manager of this solver";
+  //////// all checks before this line
+  return Term(this, *t.d_node);
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+Sort Solver::importSort(const Sort& s) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_ARG_CHECK_NOT_NULL(s);
+  CVC5_API_ARG_CHECK_EXPECTED(s.d_solver->getNodeManager() == getNodeManager(),
+                              s)
+      << "a sort of a solver that shares the node manager of this solver";
+  //////// all checks before this line
+  return Sort(this, *s.d_type);
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 /* Helpers and private functions                                              */
 /* -------------------------------------------------------------------------- */
 
@@ -6523,6 +6573,106 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
   CVC5_API_TRY_CATCH_END;
 }
 
+std::vector<Result> Solver::checkSatAssumingBatch(
+    const std::vector<std::vector<Term>>& assumptions) const
+{
+  std::vector<std::vector<Term>> values;
+  std::vector<std::vector<Term>> unsatAssumptions;
+  return checkSatAssumingBatch(assumptions, {}, values, unsatAssumptions);
+}
+
+std::vector<Result> Solver::checkSatAssumingBatch(
+    const std::vector<std::vector<Term>>& assumptions,
+    const std::vector<Term>& terms,
+    std::vector<std::vector<Term>>& values,
+    std::vector<std::vector<Term>>& unsatAssumptions) const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_CHECK(d_smtEngine->getOptions().base.incrementalSolving)
+      << "Cannot make a batch of queries unless incremental solving is "
+         "enabled (try --incremental)";
+  CVC5_API_RECOVERABLE_CHECK(terms.empty()
+                             || d_smtEngine->getOptions().smt.produceModels)
+      << "Cannot get values unless model generation is enabled "
+         "(try --produce-models)";
+  for (const std::vector<Term>& as : assumptions)
+  {
+    CVC5_API_SOLVER_CHECK_TERMS_WITH_SORT(as, getBooleanSort());
+  }
+  CVC5_API_SOLVER_CHECK_TERMS(terms);
+  //////// all checks before this line
+  std::vector<std::vector<Node>> eassumptions;
+  for (const std::vector<Term>& as : assumptions)
+  {
+    eassumptions.push_back(Term::termVectorToNodes(as));
+  }
+  std::vector<std::vector<Node>> evalues;
+  std::vector<std::vector<Node>> eunsat;
+  std::vector<cvc5::Result> rs =
+      d_smtEngine->checkSatAssumingBatch(eassumptions,
+                                         Term::termVectorToNodes(terms),
+                                         evalues,
+                                         eunsat);
+  std::vector<Result> res;
+  values.clear();
+  unsatAssumptions.clear();
+  for (size_t i = 0, size = rs.size(); i < size; i++)
+  {
+    res.push_back(Result(rs[i]));
+    values.emplace_back();
+    for (const Node& n : evalues[i])
+    {
+      values.back().push_back(Term(this, n));
+    }
+    unsatAssumptions.emplace_back();
+    for (const Node& n : eunsat[i])
+    {
+      unsatAssumptions.back().push_back(Term(this, n));
+    }
+  }
+  return res;
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+std::vector<std::vector<Term>> Solver::getCubes(uint32_t depth) const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  //////// all checks before this line
+  std::vector<std::vector<Term>> res;
+  for (const std::vector<Node>& cube : d_smtEngine->getCubes(depth))
+  {
+    res.emplace_back();
+    for (const Node& n : cube)
+    {
+      res.back().push_back(Term(this, n));
+    }
+  }
+  return res;
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+std::vector<Term> Solver::getLearnedClauses() const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_CHECK(d_smtEngine->getOptions().prop.satExportSize > 0)
+      << "Cannot get learned clauses unless they are recorded "
+         "(try --sat-export-size)";
+  //////// all checks before this line
+  std::vector<Term> res;
+  for (const Node& n : d_smtEngine->getLearnedClauses())
+  {
+    res.push_back(Term(this, n));
+  }
+  return res;
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 Sort Solver::declareDatatype(
     const std::string& symbol,
     const std::vector<DatatypeConstructorDecl>& ctors) const
@@ -6818,6 +6968,83 @@ std::vector<Term> Solver::getAssertions(void) const
   CVC5_API_TRY_CATCH_END;
 }
 
+void Solver::saveBinary(std::ostream& out,
+                        const std::vector<Term>& assertions,
+                        const std::vector<Term>& declTerms,
+                        const std::vector<Sort>& declSorts,
+                        const std::vector<Term>& definedFuns,
+                        const std::vector<Term>& definitions) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_SOLVER_CHECK_TERMS(assertions);
+  CVC5_API_SOLVER_CHECK_TERMS(declTerms);
+  CVC5_API_SOLVER_CHECK_SORTS(declSorts);
+  CVC5_API_SOLVER_CHECK_TERMS(definedFuns);
+  CVC5_API_SOLVER_CHECK_TERMS(definitions);
+  CVC5_API_ARG_SIZE_CHECK_EXPECTED(definedFuns.size() == definitions.size(),
+                                   definitions)
+      << "'" << definedFuns.size() << "'";
+  //////// all checks before this line
+  std::vector<Node> defs = Term::termVectorToNodes(definedFuns);
+  // the assertions added by define-fun, which equate the function with its
+  // definition
+  std::unordered_set<Node> defEqs;
+  for (size_t i = 0, n = defs.size(); i < n; ++i)
+  {
+    defEqs.insert(defs[i].eqNode(*definitions[i].d_node));
+  }
+  std::vector<Node> asserts;
+  for (const Term& a : assertions)
+  {
+    if (defEqs.find(*a.d_node) != defEqs.end())
+    {
+      continue;
+    }
+    asserts.emplace_back(*a.d_node);
+  }
+  expr::NodeSerializer ns(out);
+  ns.writeTypes(Sort::sortVectorToTypeNodes(declSorts));
+  ns.writeNodes(Term::termVectorToNodes(declTerms));
+  ns.writeNodes(defs);
+  ns.writeNodes(Term::termVectorToNodes(definitions));
+  ns.writeNodes(asserts);
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+void Solver::loadBinary(std::istream& in,
+                        std::vector<Term>& assertions,
+                        std::vector<Term>& declTerms,
+                        std::vector<Sort>& declSorts,
+                        std::vector<Term>& definedFuns,
+                        std::vector<Term>& definitions) const
+{
+  NodeManagerScope scope(getNodeManager());
+  CVC5_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  expr::NodeDeserializer nd(getNodeManager(), in);
+  declSorts = Sort::typeNodeVectorToSorts(this, nd.readTypes());
+  for (const Node& n : nd.readNodes())
+  {
+    declTerms.push_back(Term(this, n));
+  }
+  for (const Node& n : nd.readNodes())
+  {
+    definedFuns.push_back(Term(this, n));
+  }
+  for (const Node& n : nd.readNodes())
+  {
+    definitions.push_back(Term(this, n));
+  }
+  for (const Node& n : nd.readNodes())
+  {
+    assertions.push_back(Term(this, n));
+  }
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 std::string Solver::getInfo(const std::string& flag) const
 {
   CVC5_API_TRY_CATCH_BEGIN;
@@ -7175,6 +7402,17 @@ void Solver::resetAssertions(void) const
   CVC5_API_TRY_CATCH_END;
 }
 
+void Solver::interrupt() const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  // Only touch the (thread-safe) interrupt flag of the resource manager here,
+  // the solver thread notices it the next time it spends a resource.
+  d_smtEngine->getResourceManager()->interrupt();
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 void Solver::setInfo(const std::string& keyword, const std::string& value) const
 {
   CVC5_API_TRY_CATCH_BEGIN;
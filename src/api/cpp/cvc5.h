@@ -2751,6 +2751,44 @@ class CVC5_EXPORT Solver
   Solver(const Solver&) = delete;
   Solver& operator=(const Solver&) = delete;
 
+  /**
+   * Create a copy of this solver that shares its node manager. The copy has
+   * the same options, logic and assertions as this solver, and can be used
+   * to explore different extensions of the current set of assertions, e.g.,
+   * at a branching point of a symbolic execution.
+   *
+   * The copy is made from the state of this solver after preprocessing: the
+   * preprocessed assertions and the substitutions derived by preprocessing
+   * are copied as they are, so preprocessing is not run again on assertions
+   * that were already processed by a check-sat call. Learned clauses are not
+   * copied. The assertions of all user context levels of this solver are
+   * added at the base level of the copy.
+   *
+   * Terms and sorts of this solver can be used with the copy after importing
+   * them via importTerm() and importSort(), which does not copy them. Solvers
+   * that share a node manager must not be used concurrently. This is not
+   * supported if proofs or unsat cores are enabled.
+   *
+   * @return the copy
+   */
+  std::unique_ptr<Solver> clone() const;
+
+  /**
+   * Import a term of a solver that shares the node manager of this solver,
+   * see clone().
+   * @param t the term
+   * @return the term, associated with this solver
+   */
+  Term importTerm(const Term& t) const;
+
+  /**
+   * Import a sort of a solver that shares the node manager of this solver,
+   * see clone().
+   * @param s the sort
+   * @return the sort, associated with this solver
+   */
+  Sort importSort(const Sort& s) const;
+
   /* .................................................................... */
   /* Sorts Handling                                                       */
   /* .................................................................... */
@@ -3500,6 +3538,64 @@ class CVC5_EXPORT Solver
    */
   Result checkSatAssuming(const std::vector<Term>& assumptions) const;
 
+  /**
+   * Check satisfiability assuming each of the given sets of formulas, over the
+   * same current assertions. This is equivalent to one call to
+   * checkSatAssuming() per set, but the assertions are preprocessed only once
+   * and the learned clauses and lemmas are shared between the checks, which
+   * makes this considerably faster for many small sets of assumptions.
+   * Requires to enable incremental mode.
+   * @param assumptions the sets of formulas to assume
+   * @return the result of the satisfiability check of each set
+   */
+  std::vector<Result> checkSatAssumingBatch(
+      const std::vector<std::vector<Term>>& assumptions) const;
+
+  /**
+   * Check satisfiability assuming each of the given sets of formulas, as
+   * above, and collect the values of the given terms for every satisfiable
+   * set and the unsat assumptions of every unsatisfiable set.
+   * Requires to enable incremental mode, and option 'produce-models' if terms
+   * is not empty.
+   * @param assumptions the sets of formulas to assume
+   * @param terms the terms to get the values of in each model
+   * @param values set to the values of terms for each satisfiable set, and to
+   *               an empty vector for the other sets
+   * @param unsatAssumptions set to a subset of each unsatisfiable set that is
+   *                         unsatisfiable together with the assertions, and
+   *                         to an empty vector for the other sets
+   * @return the result of the satisfiability check of each set
+   */
+  std::vector<Result> checkSatAssumingBatch(
+      const std::vector<std::vector<Term>>& assumptions,
+      const std::vector<Term>& terms,
+      std::vector<std::vector<Term>>& values,
+      std::vector<std::vector<Term>>& unsatAssumptions) const;
+
+  /**
+   * Split the search space of the current assertions into cubes, e.g., to
+   * solve them in parallel by checkSatAssuming() (cube-and-conquer). A cube
+   * is a set of literals. The cubes are obtained by lookahead in the SAT
+   * solver, with at most the given number of splits per cube, and together
+   * they cover all models of the assertions. If no cube is returned, the
+   * assertions are unsatisfiable. The literals are over atoms of the
+   * preprocessed assertions.
+   * @param depth the maximal number of splits per cube
+   * @return the cubes
+   */
+  std::vector<std::vector<Term>> getCubes(uint32_t depth) const;
+
+  /**
+   * Get the clauses learned by the SAT solver since the last call that have
+   * at most as many literals as given by option 'sat-export-size' and do not
+   * depend on assumptions or assertions of user levels above zero. They are
+   * implied by the assertions of user level zero and can thus be asserted in
+   * other solvers working on the same problem.
+   * Requires option 'sat-export-size' to be greater than zero.
+   * @return the learned clauses
+   */
+  std::vector<Term> getLearnedClauses() const;
+
   /**
    * Check entailment of the given formula w.r.t. the current set of assertions.
    * @param term the formula to check entailment for
@@ -3672,6 +3768,55 @@ class CVC5_EXPORT Solver
    */
   std::vector<Term> getAssertions() const;
 
+  /**
+   * Write the given assertions, declarations and definitions to the given
+   * stream in cvc5's binary format. The result can be read back by
+   * loadBinary() much faster than by parsing the corresponding SMT-LIB
+   * input.
+   *
+   * Free constants and uninterpreted sorts are stored by name. Terms involving
+   * datatypes, floating-point values or other constants that have no binary
+   * representation cannot be saved.
+   *
+   * Function definitions are stored as definitions: definitions[i] is the
+   * lambda (or, for a constant, the term) defining definedFuns[i]. The
+   * assertion definedFuns[i] = definitions[i], which getAssertions() returns
+   * for each definition, is not stored.
+   *
+   * @param out the output stream
+   * @param assertions the assertions to save
+   * @param declTerms the declared terms (free constants and functions)
+   * @param declSorts the declared sorts
+   * @param definedFuns the functions defined by define-fun
+   * @param definitions the definitions of the functions in definedFuns
+   */
+  void saveBinary(std::ostream& out,
+                  const std::vector<Term>& assertions,
+                  const std::vector<Term>& declTerms,
+                  const std::vector<Sort>& declSorts,
+                  const std::vector<Term>& definedFuns,
+                  const std::vector<Term>& definitions) const;
+
+  /**
+   * Read assertions, declarations and definitions written by saveBinary()
+   * from the given stream. Declared and defined terms and declared sorts are
+   * created anew and are not bound to any symbol, the assertions are not
+   * asserted and the functions are not defined; this is left to the caller.
+   *
+   * @param in the input stream
+   * @param assertions the assertions read
+   * @param declTerms the declared terms read
+   * @param declSorts the declared sorts read
+   * @param definedFuns the defined functions read
+   * @param definitions the definitions of the functions in definedFuns
+   */
+  void loadBinary(std::istream& in,
+                  std::vector<Term>& assertions,
+                  std::vector<Term>& declTerms,
+                  std::vector<Sort>& declSorts,
+                  std::vector<Term>& definedFuns,
+                  std::vector<Term>& definitions) const;
+
   /**
    * Get info from the solver.
    * SMT-LIB: \verbatim( get-info <info_flag> )\verbatim
@@ -3934,6 +4079,16 @@ class CVC5_EXPORT Solver
    */
   void resetAssertions() const;
 
+  /**
+   * Interrupt the current (or, if none is running, the next) call to
+   * checkSat(), checkSatAssuming() or checkEntailed(), which then returns
+   * an unknown result with explanation INTERRUPTED. In contrast to all other
+   * methods of this class, this method may be called from a different thread
+   * than the one using this solver, e.g., to cancel the remaining solvers of
+   * a portfolio once one of them has found a result.
+   */
+  void interrupt() const;
+
   /**
    * Set info.
    * SMT-LIB:
@@ -4128,6 +4283,8 @@ class CVC5_EXPORT Solver
   Statistics getStatistics() const;
 
  private:
+  /** Constructor for a solver that uses the given node manager. */
+  Solver(std::shared_ptr<NodeManager> nm, Options* opts);
   /** @return the node manager of this solver */
   NodeManager* getNodeManager(void) const;
   /** Reset the API statistics */
@@ -4225,8 +4382,8 @@ class CVC5_EXPORT Solver
 
   /** Keep a copy of the original option settings (for resets). */
   std::unique_ptr<Options> d_originalOptions;
-  /** The node manager of this solver. */
-  std::unique_ptr<NodeManager> d_nodeMgr;
+  /** The node manager of this solver, shared with its clones. */
+  std::shared_ptr<NodeManager> d_nodeMgr;
   /** The statistics collected on the Api level. */
   std::unique_ptr<APIStatistics> d_stats;
   /** The SMT engine of this solver. */
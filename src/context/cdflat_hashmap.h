@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Context-dependent hash map with open addressing and insertion-ordered
+ * storage.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__CDFLAT_HASHMAP_H
+#define CVC5__CONTEXT__CDFLAT_HASHMAP_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * The common part of CDFlatHashMap and CDFlatHashSet: a context-dependent
+ * table of entries, which are stored in insertion order in a contiguous
+ * array, plus an open-addressing index (with linear probing) that maps
+ * hashes of keys to positions in this array.
+ *
+ * Entries cannot be removed other than by backtracking. The first insertion
+ * in a scope records the current number of entries on the undo trail of the
+ * context (see TrailObj); popping the scope truncates the array to this
+ * size and replaces the index slots of the removed entries by tombstones
+ * (or marks them empty if possible). Tombstones are dropped whenever the
+ * index is rebuilt.
+ *
+ * KeyOf extracts the key from an entry.
+ */
+template <class Key, class Entry, class KeyOf, class HashFcn>
+class CDFlatTable : public TrailObj
+{
+  friend class UndoTrail;
+
+ public:
+  using const_iterator = typename std::vector<Entry>::const_iterator;
+
+  CDFlatTable(Context* context)
+      : TrailObj(context), d_bits(0), d_tombstones(0), d_level(0)
+  {
+  }
+
+  /** The number of entries. */
+  size_t size() const { return d_entries.size(); }
+  /** Whether there are no entries. */
+  bool empty() const { return d_entries.empty(); }
+  /** Whether there is an entry for k. */
+  bool contains(const Key& k) const { return lookup(k) != NPOS; }
+  /** Returns 1 if there is an entry for k, 0 otherwise. */
+  size_t count(const Key& k) const { return contains(k) ? 1 : 0; }
+  /** Returns the entry for k, or end(). */
+  const_iterator find(const Key& k) const
+  {
+    size_t pos = lookup(k);
+    return pos == NPOS ? d_entries.end() : d_entries.begin() + pos;
+  }
+
+  /** Iterates over the entries in insertion order. */
+  const_iterator begin() const { return d_entries.begin(); }
+  const_iterator end() const { return d_entries.end(); }
+
+ protected:
+  /** Returned by lookup() if there is no entry. */
+  static constexpr size_t NPOS = static_cast<size_t>(-1);
+  /** Marks an index slot that was used by a removed entry. */
+  static constexpr uint32_t TOMBSTONE = static_cast<uint32_t>(-1);
+
+  /** Returns the position of the entry for k, or NPOS. */
+  size_t lookup(const Key& k) const
+  {
+    if (d_entries.empty())
+    {
+      return NPOS;
+    }
+    size_t mask = d_index.size() - 1;
+    for (size_t i = home(k);; i = (i + 1) & mask)
+    {
+      uint32_t slot = d_index[i];
+      if (slot == 0)
+      {
+        return NPOS;
+      }
+      if (slot != TOMBSTONE && KeyOf()(d_entries[slot - 1]) == k)
+      {
+        return slot - 1;
+      }
+    }
+  }
+
+  /** Appends e, whose key must not have an entry yet. */
+  void append(Entry&& e)
+  {
+    Assert(!contains(KeyOf()(e)));
+    int level = getContextLevel();
+    if (d_level < level)
+    {
+      recordUndo(this, Truncate{d_entries.size(), d_level});
+      d_level = level;
+    }
+    if ((d_entries.size() + d_tombstones + 1) * 8 > d_index.size() * 7)
+    {
+      rebuild(d_entries.size() + 1);
+    }
+    size_t mask = d_index.size() - 1;
+    size_t i = home(KeyOf()(e));
+    while (d_index[i] != 0 && d_index[i] != TOMBSTONE)
+    {
+      i = (i + 1) & mask;
+    }
+    if (d_index[i] == TOMBSTONE)
+    {
+      --d_tombstones;
+    }
+    d_entries.push_back(std::move(e));
+    d_index[i] = static_cast<uint32_t>(d_entries.size());
+  }
+
+  /** The entries, in insertion order. */
+  std::vector<Entry> d_entries;
+
+ private:
+  /** The undo record: the number of entries before the scope. */
+  struct Truncate
+  {
+    size_t d_size;
+    int d_level;
+  };
+
+  /** The home slot of k in the index. */
+  size_t home(const Key& k) const
+  {
+    uint64_t h = static_cast<uint64_t>(HashFcn()(k)) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<size_t>(h >> (64 - d_bits));
+  }
+
+  /** Rebuilds the index for (at least) the given number of entries. */
+  void rebuild(size_t size)
+  {
+    d_bits = 4;
+    while ((static_cast<size_t>(1) << d_bits) < 2 * size)
+    {
+      ++d_bits;
+    }
+    d_index.assign(static_cast<size_t>(1) << d_bits, 0);
+    d_tombstones = 0;
+    size_t mask = d_index.size() - 1;
+    for (size_t pos = 0, n = d_entries.size(); pos < n; ++pos)
+    {
+      size_t i = home(KeyOf()(d_entries[pos]));
+      while (d_index[i] != 0)
+      {
+        i = (i + 1) & mask;
+      }
+      d_index[i] = static_cast<uint32_t>(pos + 1);
+    }
+  }
+
+  /** Removes the entries beyond the size of the record. */
+  void undo(Truncate&& t)
+  {
+    Assert(t.d_size <= d_entries.size());
+    size_t mask = d_index.size() - 1;
+    while (d_entries.size() > t.d_size)
+    {
+      uint32_t slot = static_cast<uint32_t>(d_entries.size());
+      size_t i = home(KeyOf()(d_entries.back()));
+      while (d_index[i] != slot)
+      {
+        i = (i + 1) & mask;
+      }
+      // no probe sequence continues beyond an empty slot
+      if (d_index[(i + 1) & mask] == 0)
+      {
+        d_index[i] = 0;
+      }
+      else
+      {
+        d_index[i] = TOMBSTONE;
+        ++d_tombstones;
+      }
+      d_entries.pop_back();
+    }
+    d_level = t.d_level;
+  }
+
+  /** The index, zero for empty slots, otherwise a position plus one. */
+  std::vector<uint32_t> d_index;
+  /** The binary logarithm of the size of d_index. */
+  uint32_t d_bits;
+  /** The number of tombstones in d_index. */
+  size_t d_tombstones;
+  /** The level of the last insertion, or a lower one. */
+  int d_level;
+};
+
+/** Extracts the key of a map entry. */
+template <class Key, class Data>
+struct CDFlatHashMapKeyOf
+{
+  const Key& operator()(const std::pair<Key, Data>& e) const
+  {
+    return e.first;
+  }
+};
+
+/**
+ * A context-dependent hash map that is a drop-in replacement for CDHashMap
+ * and CDInsertHashMap for the common operations (insert, lookup and
+ * iteration in insertion order), but stores all entries in one contiguous
+ * array with an open-addressing index, see CDFlatTable. Changing the value
+ * of a key records the previous value on the undo trail.
+ *
+ * Keys cannot be inserted at context level zero while at a higher level
+ * (insertAtContextLevelZero() is not supported) and values can only be
+ * changed via insert().
+ */
+template <class Key, class Data, class HashFcn = std::hash<Key>>
+class CDFlatHashMap
+    : public CDFlatTable<Key,
+                         std::pair<Key, Data>,
+                         CDFlatHashMapKeyOf<Key, Data>,
+                         HashFcn>
+{
+  friend class UndoTrail;
+  using Super = CDFlatTable<Key,
+                            std::pair<Key, Data>,
+                            CDFlatHashMapKeyOf<Key, Data>,
+                            HashFcn>;
+
+ public:
+  using value_type = std::pair<Key, Data>;
+  using iterator = typename Super::const_iterator;
+  using const_iterator = typename Super::const_iterator;
+
+  CDFlatHashMap(Context* context) : Super(context) {}
+
+  /**
+   * Maps k to d in the current scope. Returns true if k was not mapped
+   * before.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    size_t pos = this->lookup(k);
+    if (pos == Super::NPOS)
+    {
+      this->append(value_type(k, d));
+      return true;
+    }
+    if (this->getContextLevel() > 0)
+    {
+      this->recordUndo(this, Overwrite{pos, this->d_entries[pos].second});
+    }
+    this->d_entries[pos].second = d;
+    return false;
+  }
+
+  /** Inserts k with d if k is not mapped yet, returns true if inserted. */
+  bool insert_safe(const Key& k, const Data& d)
+  {
+    if (this->contains(k))
+    {
+      return false;
+    }
+    this->append(value_type(k, d));
+    return true;
+  }
+
+  /** Returns the data mapped by k, which must be in the map. */
+  const Data& operator[](const Key& k) const
+  {
+    size_t pos = this->lookup(k);
+    Assert(pos != Super::NPOS) << "key not in CDFlatHashMap";
+    return this->d_entries[pos].second;
+  }
+
+ private:
+  /** The undo record: the previous value of an entry. */
+  struct Overwrite
+  {
+    size_t d_pos;
+    Data d_data;
+  };
+  /** Restores the value of the entry of a record. */
+  void undo(Overwrite&& o)
+  {
+    Assert(o.d_pos < this->d_entries.size());
+    this->d_entries[o.d_pos].second = std::move(o.d_data);
+  }
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__CDFLAT_HASHMAP_H */
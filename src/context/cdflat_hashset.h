@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Context-dependent hash set with open addressing and insertion-ordered
+ * storage.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__CDFLAT_HASHSET_H
+#define CVC5__CONTEXT__CDFLAT_HASHSET_H
+
+#include <functional>
+
+#include "context/cdflat_hashmap.h"
+
+namespace cvc5 {
+namespace context {
+
+/** Extracts the key of a set entry, i.e., the entry itself. */
+template <class V>
+struct CDFlatHashSetKeyOf
+{
+  const V& operator()(const V& v) const { return v; }
+};
+
+/**
+ * A context-dependent hash set that is a drop-in replacement for CDHashSet
+ * for insertion, lookup and iteration in insertion order, but stores all
+ * elements in one contiguous array with an open-addressing index, see
+ * CDFlatTable.
+ */
+template <class V, class HashFcn = std::hash<V>>
+class CDFlatHashSet
+    : public CDFlatTable<V, V, CDFlatHashSetKeyOf<V>, HashFcn>
+{
+  using Super = CDFlatTable<V, V, CDFlatHashSetKeyOf<V>, HashFcn>;
+
+ public:
+  using value_type = V;
+  using const_iterator = typename Super::const_iterator;
+
+  CDFlatHashSet(Context* context) : Super(context) {}
+
+  /** Inserts v in the current scope, returns true if it is new. */
+  bool insert(const V& v)
+  {
+    if (this->contains(v))
+    {
+      return false;
+    }
+    this->append(V(v));
+    return true;
+  }
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__CDFLAT_HASHSET_H */
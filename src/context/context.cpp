@@ -64,6 +64,9 @@ void Context::push() {
   // Create a new memory region
   d_pCMM->push();
 
+  // Start a new level of the undo trail
+  d_trail.push();
+
   // Create a new top Scope
   d_scopeList.push_back(new(d_pCMM) Scope(this, d_pCMM, getLevel()+1));
 }
@@ -81,6 +84,9 @@ void Context::pop() {
     pCNO = next;
   }
 
+  // Replay the undo records of the top level
+  d_trail.pop();
+
   // Grab the top Scope
   Scope* pScope = d_scopeList.back();
 
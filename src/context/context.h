@@ -27,6 +27,7 @@
 #include "base/check.h"
 #include "base/output.h"
 #include "context/context_mm.h"
+#include "context/undo_trail.h"
 
 namespace cvc5 {
 namespace context {
@@ -87,6 +88,12 @@ class Context {
    */
   ContextNotifyObj* d_pCNOpost;
 
+  /**
+   * Undo records of the trail-based context-dependent data structures, see
+   * TrailObj.
+   */
+  UndoTrail d_trail;
+
   friend std::ostream& operator<<(std::ostream&, const Context&);
 
   // disable copy, assignment
@@ -168,6 +175,11 @@ public:
    */
   ContextMemoryManager* getCMM() { return d_pCMM; }
 
+  /**
+   * Return the UndoTrail associated with the context.
+   */
+  UndoTrail& getTrail() { return d_trail; }
+
   /**
    * Save the current state, create a new Scope
    */
@@ -727,6 +739,15 @@ inline void ContextObj::makeCurrent()
 
 inline void ContextObj::makeSaveRestorePoint() { update(); }
 
+inline int TrailObj::getContextLevel() const { return d_context->getLevel(); }
+
+template <class Obj, class T>
+inline void TrailObj::recordUndo(Obj* obj, T&& data)
+{
+  Assert(static_cast<TrailObj*>(obj) == this);
+  d_context->getTrail().record(obj, std::forward<T>(data));
+}
+
 inline void Scope::addToChain(ContextObj* pContextObj)
 {
   if(d_pContextObjList != NULL) {
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A context-dependent hash map that is backtracked via the undo trail.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__TRAIL_CDHASHMAP_H
+#define CVC5__CONTEXT__TRAIL_CDHASHMAP_H
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * A context-dependent hash map, like CDHashMap, that is backtracked via the
+ * undo trail of its context: every insertion (above level 0) records the key
+ * and the previous value, if any. Popping a scope erases the key or restores
+ * the previous value, respectively.
+ *
+ * Unlike CDHashMap, the elements are not iterated in insertion order.
+ */
+template <class Key, class Data, class HashFcn = std::hash<Key>>
+class TrailCDHashMap : public TrailObj
+{
+  friend class UndoTrail;
+  using Table = std::unordered_map<Key, Data, HashFcn>;
+
+ public:
+  using const_iterator = typename Table::const_iterator;
+  using iterator = const_iterator;
+
+  TrailCDHashMap(Context* context) : TrailObj(context) {}
+
+  /**
+   * Maps k to d in the current scope. Returns true if k was not in the map
+   * before.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    auto it = d_map.find(k);
+    if (it == d_map.end())
+    {
+      if (getContextLevel() > 0)
+      {
+        recordUndo(this, Saved{k, std::nullopt});
+      }
+      d_map.emplace(k, d);
+      return true;
+    }
+    if (getContextLevel() > 0)
+    {
+      recordUndo(this, Saved{k, it->second});
+    }
+    it->second = d;
+    return false;
+  }
+
+  /** Get the value of k, which must be in the map. */
+  const Data& operator[](const Key& k) const
+  {
+    const_iterator it = d_map.find(k);
+    Assert(it != d_map.end()) << "key not in TrailCDHashMap";
+    return it->second;
+  }
+
+  /** The number of keys. */
+  size_t size() const { return d_map.size(); }
+  /** Whether the map is empty. */
+  bool empty() const { return d_map.empty(); }
+  /** Returns 1 if k is in the map, 0 otherwise. */
+  size_t count(const Key& k) const { return d_map.count(k); }
+  /** Whether k is in the map. */
+  bool contains(const Key& k) const { return d_map.find(k) != d_map.end(); }
+  const_iterator find(const Key& k) const { return d_map.find(k); }
+
+  const_iterator begin() const { return d_map.begin(); }
+  const_iterator end() const { return d_map.end(); }
+
+ private:
+  /** The undo record: a key and its previous value, if any. */
+  struct Saved
+  {
+    Key d_key;
+    std::optional<Data> d_data;
+  };
+  /** Restores the previous state of the key of a record. */
+  void undo(Saved&& saved)
+  {
+    if (saved.d_data)
+    {
+      d_map.insert_or_assign(std::move(saved.d_key), std::move(*saved.d_data));
+    }
+    else
+    {
+      d_map.erase(saved.d_key);
+    }
+  }
+
+  /** The current map. */
+  Table d_map;
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__TRAIL_CDHASHMAP_H */
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A context-dependent hash set that is backtracked via the undo trail.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__TRAIL_CDHASHSET_H
+#define CVC5__CONTEXT__TRAIL_CDHASHSET_H
+
+#include <functional>
+#include <unordered_set>
+
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * A context-dependent hash set, like CDHashSet, that is backtracked via the
+ * undo trail of its context: every insertion (above level 0) of a new
+ * element records it, popping the scope erases it again.
+ *
+ * Unlike CDHashSet, the elements are not iterated in insertion order.
+ */
+template <class V, class HashFcn = std::hash<V>>
+class TrailCDHashSet : public TrailObj
+{
+  friend class UndoTrail;
+  using Table = std::unordered_set<V, HashFcn>;
+
+ public:
+  using const_iterator = typename Table::const_iterator;
+
+  TrailCDHashSet(Context* context) : TrailObj(context) {}
+
+  /** Inserts v in the current scope, returns true if it is new. */
+  bool insert(const V& v)
+  {
+    if (!d_set.insert(v).second)
+    {
+      return false;
+    }
+    if (getContextLevel() > 0)
+    {
+      recordUndo(this, Saved{v});
+    }
+    return true;
+  }
+
+  /** The number of elements. */
+  size_t size() const { return d_set.size(); }
+  /** Whether the set is empty. */
+  bool empty() const { return d_set.empty(); }
+  /** Whether v is in the set. */
+  bool contains(const V& v) const { return d_set.find(v) != d_set.end(); }
+  const_iterator find(const V& v) const { return d_set.find(v); }
+
+  const_iterator begin() const { return d_set.begin(); }
+  const_iterator end() const { return d_set.end(); }
+
+ private:
+  /** The undo record: an inserted element. */
+  struct Saved
+  {
+    V d_value;
+  };
+  /** Erases the element of a record. */
+  void undo(Saved&& saved) { d_set.erase(saved.d_value); }
+
+  /** The current set. */
+  Table d_set;
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__TRAIL_CDHASHSET_H */
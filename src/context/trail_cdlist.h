@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A context-dependent list that is backtracked via the undo trail.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__TRAIL_CDLIST_H
+#define CVC5__CONTEXT__TRAIL_CDLIST_H
+
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * A context-dependent list, like CDList, that is backtracked via the undo
+ * trail of its context: the first modification in a scope records the size
+ * of the list, popping the scope removes all elements beyond this size.
+ */
+template <class T>
+class TrailCDList : public TrailObj
+{
+  friend class UndoTrail;
+
+ public:
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  TrailCDList(Context* context) : TrailObj(context), d_level(0) {}
+
+  /** Add an element to the end of the list. */
+  void push_back(const T& data)
+  {
+    save();
+    d_list.push_back(data);
+  }
+  /** Construct an element at the end of the list. */
+  template <class... Args>
+  void emplace_back(Args&&... args)
+  {
+    save();
+    d_list.emplace_back(std::forward<Args>(args)...);
+  }
+
+  /** The number of elements. */
+  size_t size() const { return d_list.size(); }
+  /** Whether the list is empty. */
+  bool empty() const { return d_list.empty(); }
+  /** Access the i-th element. */
+  const T& operator[](size_t i) const
+  {
+    Assert(i < d_list.size()) << "index out of bounds in TrailCDList::[]";
+    return d_list[i];
+  }
+  /** Access the last element. */
+  const T& back() const
+  {
+    Assert(!d_list.empty()) << "TrailCDList::back() called on empty list";
+    return d_list.back();
+  }
+
+  const_iterator begin() const { return d_list.begin(); }
+  const_iterator end() const { return d_list.end(); }
+
+ private:
+  /** The undo record: the previous size and its level. */
+  struct Saved
+  {
+    size_t d_size;
+    int d_level;
+  };
+  /** Records the size if the list was not modified in this scope. */
+  void save()
+  {
+    int level = getContextLevel();
+    if (d_level < level)
+    {
+      recordUndo(this, Saved{d_list.size(), d_level});
+      d_level = level;
+    }
+  }
+  /** Truncates the list to the size of a record. */
+  void undo(Saved&& saved)
+  {
+    Assert(saved.d_size <= d_list.size());
+    d_list.erase(d_list.begin() + saved.d_size, d_list.end());
+    d_level = saved.d_level;
+  }
+
+  /** The elements. */
+  std::vector<T> d_list;
+  /** The level of the last modification, or a lower one. */
+  int d_level;
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__TRAIL_CDLIST_H */
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A context-dependent object that is backtracked via the undo trail.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__TRAIL_CDO_H
+#define CVC5__CONTEXT__TRAIL_CDO_H
+
+#include <utility>
+
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+/**
+ * A context-dependent object, like CDO, that is backtracked via the undo
+ * trail of its context: the first modification in a scope records the
+ * previous value on the trail.
+ */
+template <class T>
+class TrailCDO : public TrailObj
+{
+  friend class UndoTrail;
+
+ public:
+  TrailCDO(Context* context) : TrailObj(context), d_data(), d_level(0) {}
+  TrailCDO(Context* context, const T& data)
+      : TrailObj(context), d_data(data), d_level(0)
+  {
+  }
+
+  /** Set the value of the object in the current scope. */
+  void set(const T& data)
+  {
+    save();
+    d_data = data;
+  }
+  TrailCDO& operator=(const T& data)
+  {
+    set(data);
+    return *this;
+  }
+
+  /** Get the current value. */
+  const T& get() const { return d_data; }
+  operator T() const { return get(); }
+
+ private:
+  /** The undo record: the previous value and its level. */
+  struct Saved
+  {
+    T d_data;
+    int d_level;
+  };
+  /** Records the current value if it was not modified in this scope. */
+  void save()
+  {
+    int level = getContextLevel();
+    if (d_level < level)
+    {
+      recordUndo(this, Saved{d_data, d_level});
+      d_level = level;
+    }
+  }
+  /** Restores the value of a record. */
+  void undo(Saved&& saved)
+  {
+    d_data = std::move(saved.d_data);
+    d_level = saved.d_level;
+  }
+
+  /** The current value. */
+  T d_data;
+  /** The level in which d_data was set, or a lower one. */
+  int d_level;
+};
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__TRAIL_CDO_H */
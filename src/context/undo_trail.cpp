@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A trail of undo records, the backend of trail-based context-dependent
+ * data structures.
+ */
+
+#include "context/undo_trail.h"
+
+#include <algorithm>
+
+#include "context/context.h"
+
+namespace cvc5 {
+namespace context {
+
+TrailObj::TrailObj(Context* context)
+    : d_context(context), d_id(context->getTrail().add(this))
+{
+}
+
+TrailObj::~TrailObj() { d_context->getTrail().remove(d_id); }
+
+UndoTrail::UndoTrail() : d_chunk(0), d_numRecords(0) {}
+
+UndoTrail::~UndoTrail()
+{
+  while (!d_marks.empty())
+  {
+    pop();
+  }
+}
+
+void UndoTrail::push()
+{
+  size_t used = d_chunks.empty() ? 0 : d_chunks[d_chunk].d_used;
+  d_marks.push_back(Mark{d_chunk, used, d_numRecords});
+}
+
+void UndoTrail::pop()
+{
+  Assert(!d_marks.empty()) << "Cannot pop below level 0";
+  Mark mark = d_marks.back();
+  d_marks.pop_back();
+  while (d_numRecords > mark.d_numRecords)
+  {
+    Chunk& c = d_chunks[d_chunk];
+    if (c.d_used == 0)
+    {
+      Assert(d_chunk > 0);
+      --d_chunk;
+      continue;
+    }
+    const Header* h =
+        reinterpret_cast<const Header*>(c.d_data.get() + c.d_used - HEADER_SIZE);
+    size_t size = h->d_size;
+    const Slot& slot = d_objects[h->d_id];
+    TrailObj* obj =
+        slot.d_generation == h->d_generation ? slot.d_obj : nullptr;
+    h->d_undo(obj, c.d_data.get() + c.d_used - HEADER_SIZE - size);
+    c.d_used -= size + HEADER_SIZE;
+    --d_numRecords;
+  }
+  // the chunks after the one of the mark are empty now
+  d_chunk = mark.d_chunk;
+  Assert(d_chunks.empty() || d_chunks[d_chunk].d_used == mark.d_used);
+}
+
+uint32_t UndoTrail::add(TrailObj* obj)
+{
+  if (d_freeIds.empty())
+  {
+    d_objects.push_back(Slot{obj, 0});
+    return static_cast<uint32_t>(d_objects.size() - 1);
+  }
+  uint32_t id = d_freeIds.back();
+  d_freeIds.pop_back();
+  d_objects[id].d_obj = obj;
+  return id;
+}
+
+void UndoTrail::remove(uint32_t id)
+{
+  Assert(id < d_objects.size());
+  // records for the old object are recognized by their generation
+  d_objects[id].d_obj = nullptr;
+  ++d_objects[id].d_generation;
+  d_freeIds.push_back(id);
+}
+
+void UndoTrail::nextChunk(size_t size)
+{
+  if (!d_chunks.empty())
+  {
+    ++d_chunk;
+  }
+  if (d_chunk == d_chunks.size())
+  {
+    d_chunks.emplace_back();
+  }
+  Chunk& c = d_chunks[d_chunk];
+  if (c.d_data == nullptr || c.d_capacity < size)
+  {
+    c.d_capacity = std::max(CHUNK_SIZE, size);
+    c.d_data.reset(new char[c.d_capacity]);
+  }
+  c.d_used = 0;
+}
+
+}  // namespace context
+}  // namespace cvc5
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A trail of undo records, the backend of trail-based context-dependent
+ * data structures.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__UNDO_TRAIL_H
+#define CVC5__CONTEXT__UNDO_TRAIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace context {
+
+class Context;
+class UndoTrail;
+
+/**
+ * Base class of the trail-based context-dependent data structures
+ * (TrailCDO, TrailCDList, TrailCDHashMap and TrailCDHashSet).
+ *
+ * Instead of saving a copy of the whole object upon the first modification
+ * in a scope (as a ContextObj does), these objects record what is needed to
+ * undo a modification in the UndoTrail of their context. When the context is
+ * popped, the records of the popped scope are replayed in reverse order.
+ *
+ * A TrailObj may be destroyed while records for it are still on the trail;
+ * these records are then skipped. As for ContextObj, the context must
+ * outlive the object.
+ */
+class TrailObj
+{
+  friend class UndoTrail;
+
+ public:
+  TrailObj(Context* context);
+  ~TrailObj();
+  TrailObj(const TrailObj&) = delete;
+  TrailObj& operator=(const TrailObj&) = delete;
+
+  /** Get the context of this object. */
+  Context* getContext() const { return d_context; }
+
+ protected:
+  /** Returns the current level of the context. Defined in context.h. */
+  inline int getContextLevel() const;
+  /**
+   * Records data to undo a modification of obj (which is this object), see
+   * UndoTrail::record(). Defined in context.h.
+   */
+  template <class Obj, class T>
+  inline void recordUndo(Obj* obj, T&& data);
+
+ private:
+  /** The context of this object. */
+  Context* d_context;
+  /** The index of this object in the object table of the trail. */
+  uint32_t d_id;
+};
+
+/**
+ * The trail of undo records of a context.
+ *
+ * Records are stored back to back in large chunks of memory: the data of a
+ * record, followed by a header with its size, the object it belongs to and
+ * the function that undoes it. Popping a level walks the records of this
+ * level backwards and calls these functions, which also destroy the data.
+ * Chunks are kept for later levels, hence a steady state of pushes and pops
+ * does not allocate.
+ *
+ * Objects are referenced by their index in an object table. Every table
+ * entry has a generation that is incremented once its object is destroyed,
+ * such that stale records are recognized and merely destroyed.
+ */
+class UndoTrail
+{
+ public:
+  UndoTrail();
+  ~UndoTrail();
+  UndoTrail(const UndoTrail&) = delete;
+  UndoTrail& operator=(const UndoTrail&) = delete;
+
+  /** Starts a new level. */
+  void push();
+  /** Undoes all records of the current level, the most recent first. */
+  void pop();
+
+  /**
+   * Records data to undo a modification of obj. Upon pop, obj->undo() is
+   * called with an rvalue reference to data, unless obj was destroyed.
+   * Obj must derive from TrailObj and befriend UndoTrail.
+   */
+  template <class Obj, class T>
+  void record(Obj* obj, T&& data);
+
+  /** The number of records currently on the trail. */
+  size_t size() const { return d_numRecords; }
+
+  /** Adds obj to the object table, returns its index. */
+  uint32_t add(TrailObj* obj);
+  /** Removes the object with the given index from the object table. */
+  void remove(uint32_t id);
+
+ private:
+  /** The alignment of all records. */
+  static constexpr size_t ALIGNMENT = 16;
+  /** The minimal size of a chunk in bytes. */
+  static constexpr size_t CHUNK_SIZE = static_cast<size_t>(1) << 16;
+
+  /** Undoes a record and destroys its data, obj is null if it is gone. */
+  using UndoFunction = void (*)(TrailObj* obj, void* data);
+  /** Stored after the data of every record. */
+  struct Header
+  {
+    /** Undoes the record. */
+    UndoFunction d_undo;
+    /** The index of the object. */
+    uint32_t d_id;
+    /** The generation of the object. */
+    uint32_t d_generation;
+    /** The size of the (padded) data. */
+    uint32_t d_size;
+  };
+  /** The size of the header, padded to the alignment. */
+  static constexpr size_t HEADER_SIZE =
+      (sizeof(Header) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  /** A chunk of memory that holds records. */
+  struct Chunk
+  {
+    /** The memory. */
+    std::unique_ptr<char[]> d_data;
+    /** The size of d_data. */
+    size_t d_capacity;
+    /** The number of bytes used by records. */
+    size_t d_used;
+  };
+  /** The position in the trail where a level starts. */
+  struct Mark
+  {
+    size_t d_chunk;
+    size_t d_used;
+    size_t d_numRecords;
+  };
+  /** An entry of the object table. */
+  struct Slot
+  {
+    TrailObj* d_obj;
+    uint32_t d_generation;
+  };
+
+  /** The undo function for records of type T of objects of type Obj. */
+  template <class Obj, class T>
+  static void undoRecord(TrailObj* obj, void* data)
+  {
+    T* t = static_cast<T*>(data);
+    if (obj != nullptr)
+    {
+      static_cast<Obj*>(obj)->undo(std::move(*t));
+    }
+    t->~T();
+  }
+  /** Returns memory for a record of the given size. */
+  char* allocate(size_t size)
+  {
+    if (d_chunks.empty()
+        || d_chunks[d_chunk].d_used + size > d_chunks[d_chunk].d_capacity)
+    {
+      nextChunk(size);
+    }
+    Chunk& c = d_chunks[d_chunk];
+    char* res = c.d_data.get() + c.d_used;
+    c.d_used += size;
+    return res;
+  }
+  /** Makes the next chunk, with at least size bytes, the current one. */
+  void nextChunk(size_t size);
+
+  /** The chunks, only those up to d_chunk are in use. */
+  std::vector<Chunk> d_chunks;
+  /** The current chunk. */
+  size_t d_chunk;
+  /** The number of records on the trail. */
+  size_t d_numRecords;
+  /** The start of every level. */
+  std::vector<Mark> d_marks;
+  /** The object table. */
+  std::vector<Slot> d_objects;
+  /** Indices of unused entries of the object table. */
+  std::vector<uint32_t> d_freeIds;
+};
+
+template <class Obj, class T>
+void UndoTrail::record(Obj* obj, T&& data)
+{
+  using Data = std::decay_t<T>;
+  static_assert(alignof(Data) <= ALIGNMENT, "record data is overaligned");
+  static_assert(std::is_base_of<TrailObj, Obj>::value,
+                "records belong to trail objects");
+  Assert(!d_marks.empty()) << "Nothing to undo at level 0";
+  size_t size = (sizeof(Data) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  char* mem = allocate(size + HEADER_SIZE);
+  new (mem) Data(std::forward<T>(data));
+  uint32_t id = static_cast<TrailObj*>(obj)->d_id;
+  new (mem + size) Header{&undoRecord<Obj, Data>,
+                          id,
+                          d_objects[id].d_generation,
+                          static_cast<uint32_t>(size)};
+  ++d_numRecords;
+}
+
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__UNDO_TRAIL_H */
@@ -49,6 +49,11 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseBools.erase(nv);
+  d_denseInts.erase(nv);
+  d_denseTNodes.erase(nv);
+  d_denseNodes.erase(nv);
+  d_denseTypes.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -58,6 +63,11 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_denseBools.clear();
+  d_denseInts.clear();
+  d_denseTNodes.clear();
+  d_denseNodes.clear();
+  d_denseTypes.clear();
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -96,6 +106,22 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
       deleteAttributesFromTable(d_strings, ids);
       break;
 
+    case AttrTableDenseBool:
+      Unimplemented() << "delete attributes is unimplemented for bools";
+      break;
+    case AttrTableDenseUInt64:
+      deleteDenseAttributes(d_denseInts, ids);
+      break;
+    case AttrTableDenseTNode:
+      deleteDenseAttributes(d_denseTNodes, ids);
+      break;
+    case AttrTableDenseNode:
+      deleteDenseAttributes(d_denseNodes, ids);
+      break;
+    case AttrTableDenseTypeNode:
+      deleteDenseAttributes(d_denseTypes, ids);
+      break;
+
     case AttrTableCDBool:
     case AttrTableCDUInt64:
     case AttrTableCDTNode:
@@ -71,6 +71,15 @@ namespace attr {
  * These should be unique for each Attribute. Then via some template messiness
  * when InstLevelAttribute() is passed as the argument to getAttribute(...) the
  * load time id is instantiated.
+ *
+ * Attributes that are set on a large fraction of all nodes and queried in hot
+ * loops (e.g., the type of a node) can instead be stored densely by passing
+ * true as third template argument:
+ * ```
+ * typedef expr::Attribute<TypeAttrTag, TypeNode, true> TypeAttr;
+ * ```
+ * Dense attributes live in DenseAttrTable<>s that are indexed by node id
+ * rather than hashed, see DenseColumn for details.
  */
 // ATTRIBUTE MANAGER ===========================================================
 
@@ -92,12 +101,18 @@ class AttributeManager {
   template <class T>
   void reconstructTable(AttrHash<T>& table);
 
+  template <class T>
+  void deleteDenseAttributes(DenseAttrTable<T>& table,
+                             const std::vector<uint64_t>& ids);
+
   /**
    * getTable<> is a helper template that gets the right table from an
    * AttributeManager given its type.
    */
   template <class T, class Enable>
   friend struct getTable;
+  template <class T, class Enable>
+  friend struct getDenseTable;
 
   bool d_inGarbageCollection;
 
@@ -124,6 +139,17 @@ public:
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
 
+  /** Underlying dense table for boolean-valued attributes */
+  DenseAttrTable<bool> d_denseBools;
+  /** Underlying dense table for integral-valued attributes */
+  DenseAttrTable<uint64_t> d_denseInts;
+  /** Underlying dense table for node-valued attributes */
+  DenseAttrTable<TNode> d_denseTNodes;
+  /** Underlying dense table for node-valued attributes */
+  DenseAttrTable<Node> d_denseNodes;
+  /** Underlying dense table for types attributes */
+  DenseAttrTable<TypeNode> d_denseTypes;
+
   /**
    * Get a particular attribute on a particular node.
    *
@@ -320,12 +346,135 @@ struct getTable<std::string>
   }
 };
 
+/**
+ * The getDenseTable<> template provides (static) access to the
+ * AttributeManager field holding the dense table, like getTable<> does for
+ * the hash tables. There is no dense table for string-valued attributes.
+ */
+template <class T, class Enable = void>
+struct getDenseTable;
+
+/** Access the "d_denseBools" member of AttributeManager. */
+template <>
+struct getDenseTable<bool>
+{
+  static const AttrTableId id = AttrTableDenseBool;
+  typedef DenseAttrTable<bool> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseBools;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseBools;
+  }
+};
+
+/** Access the "d_denseInts" member of AttributeManager. */
+template <class T>
+struct getDenseTable<
+    T,
+    // Use this specialization only for unsigned integers
+    typename std::enable_if<std::is_unsigned<T>::value>::type>
+{
+  static const AttrTableId id = AttrTableDenseUInt64;
+  typedef DenseAttrTable<uint64_t> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseInts;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseInts;
+  }
+};
+
+/** Access the "d_denseTNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<TNode>
+{
+  static const AttrTableId id = AttrTableDenseTNode;
+  typedef DenseAttrTable<TNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTNodes;
+  }
+};
+
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<Node>
+{
+  static const AttrTableId id = AttrTableDenseNode;
+  typedef DenseAttrTable<Node> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+};
+
+/** Access the "d_denseTypes" member of AttributeManager. */
+template <>
+struct getDenseTable<TypeNode>
+{
+  static const AttrTableId id = AttrTableDenseTypeNode;
+  typedef DenseAttrTable<TypeNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+};
+
 }  // namespace attr
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
 
 namespace attr {
 
+/**
+ * Looks up the dense attribute AttrKind of nv. Returns false if it is not
+ * set, and the value in ret otherwise. Boolean-valued attributes are always
+ * set (to their default value).
+ */
+template <class AttrKind>
+inline bool getDenseAttribute(const AttributeManager& am,
+                              NodeValue* nv,
+                              typename AttrKind::value_type& ret)
+{
+  typedef typename AttrKind::value_type value_type;
+  typedef KindValueToTableValueMapping<value_type> mapping;
+  const typename getDenseTable<value_type>::table_type& table =
+      getDenseTable<value_type>::get(am);
+  if constexpr (std::is_same<value_type, bool>::value)
+  {
+    ret = table.get(AttrKind::getId(), nv);
+    return true;
+  }
+  else
+  {
+    const typename mapping::table_value_type* value =
+        table.find(AttrKind::getId(), nv);
+    if (value == nullptr)
+    {
+      return false;
+    }
+    ret = mapping::convertBack(*value);
+    return true;
+  }
+}
+
 // implementation for AttributeManager::getAttribute()
 template <class AttrKind>
 typename AttrKind::value_type
@@ -334,6 +483,13 @@ AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
   typedef KindValueToTableValueMapping<value_type> mapping;
   typedef typename getTable<value_type>::table_type table_type;
 
+  if constexpr (AttrKind::is_dense)
+  {
+    value_type ret = value_type();
+    getDenseAttribute<AttrKind>(*this, nv, ret);
+    return ret;
+  }
+
   const table_type& ah = getTable<value_type>::get(*this);
   typename table_type::const_iterator i =
     ah.find(std::make_pair(AttrKind::getId(), nv));
@@ -374,6 +530,15 @@ struct HasAttribute<true, AttrKind> {
     typedef KindValueToTableValueMapping<value_type> mapping;
     typedef typename getTable<value_type>::table_type table_type;
 
+    if constexpr (AttrKind::is_dense)
+    {
+      if (!getDenseAttribute<AttrKind>(*am, nv, ret))
+      {
+        ret = AttrKind::default_value;
+      }
+      return true;
+    }
+
     const table_type& ah = getTable<value_type>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
@@ -400,6 +565,12 @@ struct HasAttribute<false, AttrKind> {
     //typedef KindValueToTableValueMapping<value_type> mapping;
     typedef typename getTable<value_type>::table_type table_type;
 
+    if constexpr (AttrKind::is_dense)
+    {
+      return getDenseTable<value_type>::get(*am).find(AttrKind::getId(), nv)
+             != nullptr;
+    }
+
     const table_type& ah = getTable<value_type>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
@@ -418,6 +589,11 @@ struct HasAttribute<false, AttrKind> {
     typedef KindValueToTableValueMapping<value_type> mapping;
     typedef typename getTable<value_type>::table_type table_type;
 
+    if constexpr (AttrKind::is_dense)
+    {
+      return getDenseAttribute<AttrKind>(*am, nv, ret);
+    }
+
     const table_type& ah = getTable<value_type>::get(*am);
     typename table_type::const_iterator i =
       ah.find(std::make_pair(AttrKind::getId(), nv));
@@ -456,6 +632,13 @@ AttributeManager::setAttribute(NodeValue* nv,
   typedef KindValueToTableValueMapping<value_type> mapping;
   typedef typename getTable<value_type>::table_type table_type;
 
+  if constexpr (AttrKind::is_dense)
+  {
+    getDenseTable<value_type>::get(*this).set(
+        AttrKind::getId(), nv, mapping::convert(value));
+    return;
+  }
+
   table_type& ah = getTable<value_type>::get(*this);
   ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
 }
@@ -485,7 +668,8 @@ inline void AttributeManager::deleteAllFromTable(AttrHash<T>& table) {
 template <class AttrKind>
 AttributeUniqueId AttributeManager::getAttributeId(const AttrKind& attr){
   typedef typename AttrKind::value_type value_type;
-  AttrTableId tableId = getTable<value_type>::id;
+  AttrTableId tableId = AttrKind::is_dense ? getDenseTable<value_type>::id
+                                           : getTable<value_type>::id;
   return AttributeUniqueId(tableId, attr.getId());
 }
 
@@ -530,6 +714,18 @@ void AttributeManager::reconstructTable(AttrHash<T>& table){
   d_inGarbageCollection = false;
 }
 
+template <class T>
+void AttributeManager::deleteDenseAttributes(DenseAttrTable<T>& table,
+                                             const std::vector<uint64_t>& ids)
+{
+  d_inGarbageCollection = true;
+  for (uint64_t id : ids)
+  {
+    table.eraseAttribute(id);
+  }
+  d_inGarbageCollection = false;
+}
+
 }  // namespace attr
 }  // namespace expr
 
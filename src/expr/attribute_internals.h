@@ -22,7 +22,12 @@
 #ifndef CVC5__EXPR__ATTRIBUTE_INTERNALS_H
 #define CVC5__EXPR__ATTRIBUTE_INTERNALS_H
 
+#include <array>
+#include <bitset>
+#include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace cvc5 {
 namespace expr {
@@ -364,15 +369,231 @@ public:
 
 }  // namespace attr
 
+// DENSE ATTRIBUTE TABLES ======================================================
+
+namespace attr {
+
+/**
+ * A map from node ids to values of type V. The values are stored in pages of
+ * PAGE_SIZE consecutive ids, a lookup is thus an index computation and (at
+ * most) two loads. Node ids are handed out in increasing order and are never
+ * reused, hence a page is released once all its entries are erased, i.e.,
+ * once the nodes of its range of ids that had an entry are gone.
+ */
+template <class V>
+class DenseColumn
+{
+ public:
+  /** The binary logarithm of PAGE_SIZE. */
+  static constexpr uint64_t PAGE_BITS = 10;
+  /** The number of entries of a page. */
+  static constexpr uint64_t PAGE_SIZE = static_cast<uint64_t>(1) << PAGE_BITS;
+
+  /** Returns the value for id, or nullptr if there is none. */
+  const V* find(uint64_t id) const
+  {
+    const Page* page = getPage(id);
+    uint64_t i = id & (PAGE_SIZE - 1);
+    return page != nullptr && page->d_set[i] ? &page->d_values[i] : nullptr;
+  }
+  /** Returns the value for id, or nullptr if there is none. */
+  V* find(uint64_t id)
+  {
+    Page* page = getPage(id);
+    uint64_t i = id & (PAGE_SIZE - 1);
+    return page != nullptr && page->d_set[i] ? &page->d_values[i] : nullptr;
+  }
+
+  /**
+   * Returns the value for id, which is default-constructed if there was none
+   * before.
+   */
+  V& operator[](uint64_t id)
+  {
+    uint64_t p = id >> PAGE_BITS;
+    if (p >= d_pages.size())
+    {
+      d_pages.resize(p + 1);
+    }
+    if (d_pages[p] == nullptr)
+    {
+      d_pages[p].reset(new Page());
+    }
+    Page& page = *d_pages[p];
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (!page.d_set[i])
+    {
+      page.d_set[i] = true;
+      ++page.d_count;
+    }
+    return page.d_values[i];
+  }
+
+  /** Removes the value for id, if there is one. */
+  void erase(uint64_t id)
+  {
+    uint64_t p = id >> PAGE_BITS;
+    Page* page = getPage(id);
+    uint64_t i = id & (PAGE_SIZE - 1);
+    if (page == nullptr || !page->d_set[i])
+    {
+      return;
+    }
+    // Releasing the value may release nodes, hence this column has to be in
+    // a consistent state before the value is destroyed.
+    V old = V();
+    std::swap(old, page->d_values[i]);
+    page->d_set[i] = false;
+    if (--page->d_count == 0)
+    {
+      d_pages[p].reset();
+    }
+  }
+
+  /** Removes all values. */
+  void clear()
+  {
+    std::vector<std::unique_ptr<Page>> pages;
+    pages.swap(d_pages);
+  }
+
+ private:
+  /** A page of entries. */
+  struct Page
+  {
+    /** The values, only meaningful if the respective bit in d_set is set */
+    std::array<V, PAGE_SIZE> d_values;
+    /** Which entries are present */
+    std::bitset<PAGE_SIZE> d_set;
+    /** The number of present entries */
+    uint64_t d_count = 0;
+  };
+
+  /** Returns the page holding id, or nullptr if there is none. */
+  Page* getPage(uint64_t id) const
+  {
+    uint64_t p = id >> PAGE_BITS;
+    return p < d_pages.size() ? d_pages[p].get() : nullptr;
+  }
+
+  /** The pages, nullptr if no id in its range has an entry. */
+  std::vector<std::unique_ptr<Page>> d_pages;
+};/* class DenseColumn<> */
+
+/**
+ * The table underlying dense attributes of a given value type: one
+ * DenseColumn per attribute, indexed by its id.
+ */
+template <class value_type>
+class DenseAttrTable
+{
+ public:
+  /** Returns the value of attribute attrId for nv, or nullptr if unset. */
+  const value_type* find(uint64_t attrId, const NodeValue* nv) const
+  {
+    return attrId < d_columns.size() ? d_columns[attrId].find(nv->getId())
+                                     : nullptr;
+  }
+
+  /** Sets the value of attribute attrId for nv. */
+  void set(uint64_t attrId, const NodeValue* nv, const value_type& value)
+  {
+    if (attrId >= d_columns.size())
+    {
+      d_columns.resize(attrId + 1);
+    }
+    d_columns[attrId][nv->getId()] = value;
+  }
+
+  /** Removes all attributes of nv. */
+  void erase(const NodeValue* nv)
+  {
+    for (DenseColumn<value_type>& column : d_columns)
+    {
+      column.erase(nv->getId());
+    }
+  }
+
+  /** Removes attribute attrId from all nodes. */
+  void eraseAttribute(uint64_t attrId)
+  {
+    if (attrId < d_columns.size())
+    {
+      d_columns[attrId].clear();
+    }
+  }
+
+  /** Removes all attributes from all nodes. */
+  void clear()
+  {
+    for (DenseColumn<value_type>& column : d_columns)
+    {
+      column.clear();
+    }
+  }
+
+ private:
+  /** The columns, indexed by attribute id */
+  std::vector<DenseColumn<value_type>> d_columns;
+};/* class DenseAttrTable<> */
+
+/**
+ * Dense boolean-valued attributes pack the flags of a node into a single
+ * word, like AttrHash<bool>. Nodes without any flag set have no entry.
+ */
+template <>
+class DenseAttrTable<bool>
+{
+ public:
+  /** Returns the flag with the given bit for nv. */
+  bool get(uint64_t bit, const NodeValue* nv) const
+  {
+    const uint64_t* word = d_words.find(nv->getId());
+    return word != nullptr && (*word & GetBitSet(bit)) != 0;
+  }
+
+  /** Sets the flag with the given bit for nv. */
+  void set(uint64_t bit, const NodeValue* nv, bool value)
+  {
+    if (value)
+    {
+      d_words[nv->getId()] |= GetBitSet(bit);
+      return;
+    }
+    uint64_t* word = d_words.find(nv->getId());
+    if (word != nullptr)
+    {
+      *word &= ~GetBitSet(bit);
+      if (*word == 0)
+      {
+        d_words.erase(nv->getId());
+      }
+    }
+  }
+
+  /** Removes all flags of nv. */
+  void erase(const NodeValue* nv) { d_words.erase(nv->getId()); }
+
+  /** Removes all flags from all nodes. */
+  void clear() { d_words.clear(); }
+
+ private:
+  /** The flags of every node */
+  DenseColumn<uint64_t> d_words;
+};/* class DenseAttrTable<bool> */
+
+}  // namespace attr
+
 // ATTRIBUTE IDENTIFIER ASSIGNMENT TEMPLATE ====================================
 
 namespace attr {
 
 /**
  * This is the last-attribute-assigner.  IDs are not globally
- * unique; rather, they are unique for each table_value_type.
+ * unique; rather, they are unique for each table_value_type, separately
+ * for hashed and for dense attributes.
  */
-template <class T>
+template <class T, bool dense = false>
 struct LastAttributeId
 {
  public:
@@ -403,8 +624,14 @@ struct LastAttributeId
  * @param T the tag for the attribute kind.
  *
  * @param value_t the underlying value_type for the attribute kind
+ *
+ * @param dense whether the attribute is stored in a DenseAttrTable, indexed
+ * by node id, instead of a hash table. Lookups are faster, but every page of
+ * the table takes memory for PAGE_SIZE consecutive node ids. This pays off
+ * for attributes that are queried frequently and set for most nodes, like
+ * the type of a node.
  */
-template <class T, class value_t>
+template <class T, class value_t, bool dense = false>
 class Attribute
 {
   /**
@@ -418,6 +645,9 @@ public:
   /** The value type for this attribute. */
   typedef value_t value_type;
 
+  /** Whether this attribute is stored in a dense table. */
+  static const bool is_dense = dense;
+
   /** Get the unique ID associated to this attribute. */
   static inline uint64_t getId() { return s_id; }
 
@@ -437,15 +667,15 @@ public:
   static inline uint64_t registerAttribute() {
     typedef typename attr::KindValueToTableValueMapping<value_t>::
                      table_value_type table_value_type;
-    return attr::LastAttributeId<table_value_type>::getNextId();
+    return attr::LastAttributeId<table_value_type, dense>::getNextId();
   }
 };/* class Attribute<> */
 
 /**
  * An "attribute type" structure for boolean flags (special).
  */
-template <class T>
-class Attribute<T, bool>
+template <class T, bool dense>
+class Attribute<T, bool, dense>
 {
   /** IDs for bool-valued attributes are actually bit assignments. */
   static const uint64_t s_id;
@@ -455,6 +685,9 @@ public:
   /** The value type for this attribute; here, bool. */
   typedef bool value_type;
 
+  /** Whether this attribute is stored in a dense table. */
+  static const bool is_dense = dense;
+
   /** Get the unique ID associated to this attribute. */
   static inline uint64_t getId() { return s_id; }
 
@@ -478,7 +711,7 @@ public:
    * return the id.
    */
   static inline uint64_t registerAttribute() {
-    const uint64_t id = attr::LastAttributeId<bool>::getNextId();
+    const uint64_t id = attr::LastAttributeId<bool, dense>::getNextId();
     AlwaysAssert(id <= 63) << "Too many boolean node attributes registered "
                               "during initialization !";
     return id;
@@ -488,14 +721,14 @@ public:
 // ATTRIBUTE IDENTIFIER ASSIGNMENT =============================================
 
 /** Assign unique IDs to attributes at load time. */
-template <class T, class value_t>
-const uint64_t Attribute<T, value_t>::s_id =
-    Attribute<T, value_t>::registerAttribute();
+template <class T, class value_t, bool dense>
+const uint64_t Attribute<T, value_t, dense>::s_id =
+    Attribute<T, value_t, dense>::registerAttribute();
 
 /** Assign unique IDs to attributes at load time. */
-template <class T>
-const uint64_t Attribute<T, bool>::s_id =
-    Attribute<T, bool>::registerAttribute();
+template <class T, bool dense>
+const uint64_t Attribute<T, bool, dense>::s_id =
+    Attribute<T, bool, dense>::registerAttribute();
 
 }  // namespace expr
 }  // namespace cvc5
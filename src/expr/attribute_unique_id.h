@@ -40,6 +40,11 @@ enum AttrTableId {
   AttrTableCDNode,
   AttrTableCDString,
   AttrTableCDPointer,
+  AttrTableDenseBool,
+  AttrTableDenseUInt64,
+  AttrTableDenseTNode,
+  AttrTableDenseNode,
+  AttrTableDenseTypeNode,
   LastAttrTable
 };
 
@@ -74,8 +74,8 @@ UnknownTypeException::UnknownTypeException(TNode n)
 /** Is this node constant? (and has that been computed yet?) */
 struct IsConstTag { };
 struct IsConstComputedTag { };
-typedef expr::Attribute<IsConstTag, bool> IsConstAttr;
-typedef expr::Attribute<IsConstComputedTag, bool> IsConstComputedAttr;
+typedef expr::Attribute<IsConstTag, bool, true> IsConstAttr;
+typedef expr::Attribute<IsConstComputedTag, bool, true> IsConstComputedAttr;
 
 template <bool ref_count>
 bool NodeTemplate<ref_count>::isConst() const {
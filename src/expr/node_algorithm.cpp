@@ -245,8 +245,9 @@ struct HasBoundVarComputedTag
 {
 };
 /** Attribute true for expressions with bound variables in them */
-typedef expr::Attribute<HasBoundVarTag, bool> HasBoundVarAttr;
-typedef expr::Attribute<HasBoundVarComputedTag, bool> HasBoundVarComputedAttr;
+typedef expr::Attribute<HasBoundVarTag, bool, true> HasBoundVarAttr;
+typedef expr::Attribute<HasBoundVarComputedTag, bool, true>
+    HasBoundVarComputedAttr;
 
 bool hasBoundVar(TNode n)
 {
@@ -405,12 +405,7 @@ expr::NodeValue* NodeBuilder::constructNV()
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv =
-        (expr::NodeValue*)std::malloc(sizeof(expr::NodeValue));
-    if (nv == nullptr)
-    {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
@@ -488,13 +483,8 @@ expr::NodeValue* NodeBuilder::constructNV()
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)std::malloc(
-          sizeof(expr::NodeValue)
-          + (sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren));
-      if (nv == nullptr)
-      {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator.allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->next_id++;  // FIXME multithreading
@@ -548,16 +538,23 @@ expr::NodeValue* NodeBuilder::constructNV()
       /* Subcase (b) The Node under construction is NOT already in the
        * NodeManager's pool. */
 
-      /* 2(b). The heap-allocated d_nv is "cropped" to the correct
-       * size (based on the number of children it _actually_ has).
-       * d_nv is repointed to d_inlineNv so that destruction of the
-       * NodeBuilder doesn't cause any problems, and the (old) value
-       * it had is placed into the NodeManager's pool and returned in
-       * a Node wrapper. */
-
-      crop();
-      expr::NodeValue* nv = d_nv;
+      /* 2(b). The contents of the heap-allocated d_nv are moved into a
+       * new NodeValue obtained from the NodeManager's allocator, which
+       * takes over the reference counts of the children, and d_nv is
+       * freed.  d_nv is repointed to d_inlineNv so that destruction of
+       * the NodeBuilder doesn't cause any problems, and the new value is
+       * placed into the NodeManager's pool and returned in a Node
+       * wrapper. */
+
+      expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(d_nv->d_nchildren);
+      nv->d_nchildren = d_nv->d_nchildren;
+      nv->d_kind = d_nv->d_kind;
       nv->d_id = d_nm->next_id++;  // FIXME multithreading
+      nv->d_rc = 0;
+      std::copy(d_nv->d_children,
+                d_nv->d_children + d_nv->d_nchildren,
+                nv->d_children);
+      free(d_nv);
       d_nv = &d_inlineNv;
       d_nvMaxChildren = default_nchild_thresh;
       setUsed();
@@ -664,28 +661,6 @@ void NodeBuilder::allocateNvIfNecessaryForAppend()
   }
 }
 
-void NodeBuilder::crop()
-{
-  if (CVC5_PREDICT_FALSE(nvIsAllocated())
-      && CVC5_PREDICT_TRUE(d_nvMaxChildren > d_nv->d_nchildren))
-  {
-    // Ensure d_nv is not modified on allocation failure
-    expr::NodeValue* newBlock = (expr::NodeValue*)std::realloc(
-        d_nv,
-        sizeof(expr::NodeValue)
-            + (sizeof(expr::NodeValue*) * d_nv->d_nchildren));
-    if (newBlock == nullptr)
-    {
-      // In this case, d_nv was NOT freed.  If we throw, the
-      // deallocation should occur on destruction of the
-      // NodeBuilder.
-      throw std::bad_alloc();
-    }
-    d_nv = newBlock;
-    d_nvMaxChildren = d_nv->d_nchildren;
-  }
-}
-
 NodeBuilder& NodeBuilder::collapseTo(Kind k)
 {
   AssertArgument(
@@ -93,12 +93,16 @@
  *         cause any problems.  The existing NodeManager pool entry
  *         is returned.
  *
- *   2(b). The heap-allocated d_nv is "cropped" to the correct size
- *         (based on the number of children it _actually_ has).  d_nv
- *         is repointed to d_inlineNv so that destruction of the
- *         NodeBuilder doesn't cause any problems, and the (old)
- *         value it had is placed into the NodeManager's pool and
- *         returned in a Node wrapper.
+ *   2(b). The contents of the heap-allocated d_nv are moved into a
+ *         new NodeValue of the correct size (based on the number of
+ *         children it _actually_ has), which takes over the child
+ *         reference counts, and d_nv is freed.  d_nv is repointed to
+ *         d_inlineNv so that destruction of the NodeBuilder doesn't
+ *         cause any problems, and the new value is placed into the
+ *         NodeManager's pool and returned in a Node wrapper.
+ *
+ * New NodeValues in 0, 1(b) and 2(b) are obtained from the
+ * NodeManager's NodeValueAllocator.
  *
  * NOTE IN 1(b) AND 2(b) THAT we can NOT create Node wrapper
  * temporary for the NodeValue in the NodeBuilder::operator Node()
@@ -348,17 +352,6 @@ class NodeBuilder {
    */
   void decrRefCounts();
 
-  /**
-   * Trim d_nv down to the size it needs to be for the number of
-   * children it has.  Used when a Node is extracted from a
-   * NodeBuilder and we want the returned memory not to suffer from
-   * internal fragmentation.  If d_nv was not heap-allocated by this
-   * class, or is already the right size, this function does nothing.
-   *
-   * @throws bad_alloc if the reallocation fails
-   */
-  void crop();
-
   /** Construct the node value out of the node builder */
   expr::NodeValue* constructNV();
 
@@ -15,6 +15,7 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <stack>
 #include <utility>
@@ -101,6 +102,8 @@ NodeManager::NodeManager()
       d_attrManager(new expr::attr::AttributeManager()),
       d_nodeUnderDeletion(nullptr),
       d_inReclaimZombies(false),
+      d_zombieThreshold(5000),
+      d_zombiePauseBudget(0),
       d_abstractValueCount(0),
       d_skolemCounter(0)
 {
@@ -257,14 +260,12 @@ NodeManager::~NodeManager() {
 
   if(Debug.isOn("gc:leaks")) {
     Debug("gc:leaks") << "still in pool:" << endl;
-    for(NodeValuePool::const_iterator i = d_nodeValuePool.begin(),
-          iend = d_nodeValuePool.end();
-        i != iend;
-        ++i) {
-      Debug("gc:leaks") << "  " << *i
-                        << " id=" << (*i)->d_id
-                        << " rc=" << (*i)->d_rc
-                        << " " << **i << endl;
+    for (NodeValue* nv : d_nodeValuePool)
+    {
+      Debug("gc:leaks") << "  " << nv
+                        << " id=" << nv->d_id
+                        << " rc=" << nv->d_rc
+                        << " " << *nv << endl;
     }
     Debug("gc:leaks") << ":end:" << endl;
   }
@@ -282,11 +283,13 @@ const DType& NodeManager::getDTypeForIndex(size_t index) const
   return *d_dtypes[index];
 }
 
-void NodeManager::reclaimZombies() {
+void NodeManager::reclaimZombies(bool incremental)
+{
   // FIXME multithreading
   Assert(!d_attrManager->inGarbageCollection());
 
-  Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
+  Debug("gc") << "reclaiming " << (incremental ? "old " : "") << "zombies, "
+              << d_zombies.size() << " zombie(s) present\n";
 
   // during reclamation, reclaimZombies() is never supposed to be called
   Assert(!d_inReclaimZombies)
@@ -296,42 +299,35 @@ void NodeManager::reclaimZombies() {
   // and ensures that d_inReclaimZombies is set back to false.
   ScopedBool r(d_inReclaimZombies);
 
-  // We copy the set away and clear the NodeManager's set of zombies.
-  // This is because reclaimZombie() decrements the RC of the
-  // NodeValue's children, which may (recursively) reclaim them.
+  // Reclaiming a zombie decrements the RC of its children, which may turn
+  // them into zombies as well (NodeManager::markForDeletion() is called).
+  // They are appended to d_zombieQueue, hence we never hold an iterator into
+  // the queue but always take its front.
   //
-  // Let's say we're reclaiming zombie NodeValue "A" and its child "B"
-  // then becomes a zombie (NodeManager::markForDeletion(B) is called).
-  //
-  // One way to handle B's zombification would be simply to put it
-  // into d_zombies.  This is what we do.  However, if we were to
-  // concurrently process d_zombies in the loop below, such addition
-  // may be invisible to us (B is leaked) or even invalidate our
-  // iterator, causing a crash.  So we need to copy the set away.
-
-  vector<NodeValue*> zombies;
-  zombies.reserve(d_zombies.size());
-  remove_copy_if(d_zombies.begin(),
-                 d_zombies.end(),
-                 back_inserter(zombies),
-                 NodeValueReferenceCountNonZero());
-  d_zombies.clear();
-
-#ifdef _LIBCPP_VERSION
-  NodeValue* last = NULL;
-#endif
-  for(vector<NodeValue*>::iterator i = zombies.begin();
-      i != zombies.end();
-      ++i) {
-    NodeValue* nv = *i;
-#ifdef _LIBCPP_VERSION
-    // Work around an apparent bug in libc++'s hash_set<> which can
-    // (very occasionally) have an element repeated.
-    if(nv == last) {
-      continue;
+  // Young zombies are the most likely ones to be resurrected by a lookup in
+  // the pool, reclaiming them would only mean to build them again. Hence an
+  // incremental collection keeps the youngest zombies for later.
+  size_t keep = incremental ? d_zombieThreshold / 2 : 0;
+  bool bounded = incremental && d_zombiePauseBudget > 0;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point deadline =
+      start + std::chrono::microseconds(d_zombiePauseBudget);
+  size_t reclaimed = 0;
+  size_t visited = 0;
+  while (d_zombieQueue.size() > keep)
+  {
+    // only check the clock every now and then
+    if (bounded && ++visited % 64 == 0
+        && std::chrono::steady_clock::now() >= deadline)
+    {
+      Debug("gc") << "pause budget exhausted, " << d_zombieQueue.size()
+                  << " zombie(s) left\n";
+      break;
     }
-    last = nv;
-#endif
+    NodeValue* nv = d_zombieQueue.front();
+    d_zombieQueue.pop_front();
+    d_zombies.erase(nv);
 
     // collect ONLY IF still zero
     if(nv->d_rc == 0) {
@@ -381,10 +377,28 @@ void NodeManager::reclaimZombies() {
         // constant, but then, you should probably use a smart-pointer
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
+        // constants are allocated by mkConstInternal() with a payload
+        // whose size is not known here
+        free(nv);
       }
-      free(nv);
+      else
+      {
+        d_nvAllocator.deallocate(nv, nv->d_nchildren);
+      }
+      ++reclaimed;
     }
   }
+  d_nvAllocator.releaseEmptySlabs();
+
+  uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+  Debug("gc") << "reclaimed " << reclaimed << " zombie(s) in " << micros
+              << "us\n";
+  for (NodeManagerListener* listener : d_listeners)
+  {
+    listener->nmNotifyReclaimZombies(reclaimed, micros);
+  }
 }/* NodeManager::reclaimZombies() */
 
 std::vector<NodeValue*> NodeManager::TopologicalSort(
@@ -836,6 +850,13 @@ void NodeManager::reclaimAllZombies(){
   reclaimZombiesUntil(0u);
 }
 
+void NodeManager::setZombieCollectionPolicy(size_t threshold,
+                                            uint64_t pauseBudget)
+{
+  d_zombieThreshold = threshold;
+  d_zombiePauseBudget = pauseBudget;
+}
+
 /** Reclaim zombies while there are more than k nodes in the pool (if possible).*/
 void NodeManager::reclaimZombiesUntil(uint32_t k){
   if(safeToReclaimZombies()){
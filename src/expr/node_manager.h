@@ -23,6 +23,7 @@
 #ifndef CVC5__NODE_MANAGER_H
 #define CVC5__NODE_MANAGER_H
 
+#include <deque>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -31,6 +32,8 @@
 #include "expr/kind.h"
 #include "expr/metakind.h"
 #include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "expr/node_value_table.h"
 #include "util/floatingpoint_size.h"
 
 namespace cvc5 {
@@ -53,6 +56,7 @@ namespace expr {
     class AttributeManager;
     }  // namespace attr
 
+  class NodeDeserializer;
   class TypeChecker;
   }  // namespace expr
 
@@ -80,11 +84,18 @@ class NodeManagerListener {
    * to the Node somewhere, very bad things will happen.
    */
   virtual void nmNotifyDeleteNode(TNode n) {}
+  /**
+   * Notify a listener that a round of zombie reclamation finished, which
+   * deleted the given number of nodes and took the given number of
+   * microseconds.
+   */
+  virtual void nmNotifyReclaimZombies(size_t reclaimed, uint64_t micros) {}
 }; /* class NodeManagerListener */
 
 class NodeManager
 {
   friend class api::Solver;
+  friend class expr::NodeDeserializer;
   friend class expr::NodeValue;
   friend class expr::TypeChecker;
   friend class SkolemManager;
@@ -101,20 +112,24 @@ class NodeManager
   static bool isNAryKind(Kind k);
 
  private:
-  /** Predicate for use with STL algorithms */
-  struct NodeValueReferenceCountNonZero {
-    bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
-  };
-
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq> NodeValuePool;
+  typedef expr::NodeValueTable<expr::NodeValuePoolHashFunction,
+                               expr::NodeValuePoolEq>
+      NodeValuePool;
+  typedef expr::NodeValueTable<expr::NodeValueIDHashFunction,
+                               expr::NodeValueIDEquality>
+      NodeValueZombieSet;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality> NodeValueIDSet;
 
   static thread_local NodeManager* s_current;
 
+  /**
+   * The allocator for all non-constant node values. It is the first member
+   * so that it outlives all other members that may refer to nodes.
+   */
+  expr::NodeValueAllocator d_nvAllocator;
+
   /** The skolem manager */
   std::unique_ptr<SkolemManager> d_skManager;
   /** The bound variable manager */
@@ -145,11 +160,31 @@ class NodeManager
   bool d_inReclaimZombies;
 
   /**
-   * The set of zombie nodes.  We may want to revisit this design, as
-   * we might like to delete nodes in least-recently-used order.  But
-   * we also need to avoid processing a zombie twice.
+   * The set of zombie nodes.  It contains the same node values as
+   * d_zombieQueue and avoids that a zombie is queued (and thus processed)
+   * twice.
+   */
+  NodeValueZombieSet d_zombies;
+
+  /**
+   * The zombie nodes in the order in which they became zombies, the oldest
+   * one first.  A zombie that was resurrected (its reference count became
+   * nonzero again) stays in the queue and is dropped once it reaches the
+   * front; if it dies again before that, it keeps its old position.
    */
-  NodeValueIDSet d_zombies;
+  std::deque<expr::NodeValue*> d_zombieQueue;
+
+  /**
+   * The number of zombies that triggers an incremental collection in
+   * markForDeletion().
+   */
+  size_t d_zombieThreshold;
+
+  /**
+   * The time budget (in microseconds) of an incremental collection, zero for
+   * no limit.
+   */
+  uint64_t d_zombiePauseBudget;
 
   /**
    * NodeValues with maxed out reference counts. These live as long as the
@@ -282,13 +317,17 @@ class NodeManager
     // already contains a node value with the same id as `nv`, but the pointers
     // are different, then the wrong `NodeManager` was in scope for one of the
     // two nodes when it reached refcount zero.
-    Assert(d_zombies.find(nv) == d_zombies.end() || *d_zombies.find(nv) == nv);
+    Assert(d_zombies.find(nv) == nullptr || d_zombies.find(nv) == nv);
 
-    d_zombies.insert(nv);
+    if (d_zombies.insert(nv))
+    {
+      d_zombieQueue.push_back(nv);
+    }
 
     if(safeToReclaimZombies()) {
-      if(d_zombies.size() > 5000) {
-        reclaimZombies();
+      if (d_zombies.size() > d_zombieThreshold)
+      {
+        reclaimZombies(true);
       }
     }
   }
@@ -307,9 +346,13 @@ class NodeManager
   }
 
   /**
-   * Reclaim all zombies.
+   * Reclaim zombies, oldest first.  A full collection reclaims all zombies,
+   * including the ones that die while it runs.  An incremental collection
+   * keeps the youngest half of d_zombieThreshold zombies, which are the most
+   * likely to be resurrected, and stops once d_zombiePauseBudget is spent.
+   * The remaining zombies are left for the next call.
    */
-  void reclaimZombies();
+  void reclaimZombies(bool incremental = false);
 
   /**
    * It is safe to collect zombies.
@@ -1039,6 +1082,20 @@ class NodeManager
   /** Size of the node pool. */
   size_t poolSize() const;
 
+  /**
+   * Sets the policy for reclaiming zombies: an incremental collection starts
+   * once there are more than threshold zombies and should not take longer
+   * than pauseBudget microseconds (zero for no limit).
+   */
+  void setZombieCollectionPolicy(size_t threshold, uint64_t pauseBudget);
+
+  /** Counters of the allocator for node values. */
+  const expr::NodeValueAllocator::Statistics& getNodeValueAllocatorStatistics()
+      const
+  {
+    return d_nvAllocator.getStatistics();
+  }
+
   /** Deletes a list of attributes from the NM's AttributeManager.*/
   void deleteAttributes(const std::vector< const expr::attr::AttributeUniqueId* >& ids);
 
@@ -1108,22 +1165,17 @@ inline TypeNode NodeManager::mkSetType(TypeNode elementType) {
 }
 
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
-  NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
-  if(find == d_nodeValuePool.end()) {
-    return NULL;
-  } else {
-    return *find;
-  }
+  return d_nodeValuePool.find(nv);
 }
 
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
+  Assert(d_nodeValuePool.find(nv) == nullptr)
       << "NodeValue already in the pool!";
   d_nodeValuePool.insert(nv);// FIXME multithreading
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
+  Assert(d_nodeValuePool.find(nv) != nullptr)
       << "NodeValue is not in the pool!";
 
   d_nodeValuePool.erase(nv);// FIXME multithreading
@@ -34,8 +34,8 @@ namespace attr {
 
 typedef Attribute<attr::VarNameTag, std::string> VarNameAttr;
 typedef Attribute<attr::SortArityTag, uint64_t> SortArityAttr;
-typedef expr::Attribute<expr::attr::TypeTag, TypeNode> TypeAttr;
-typedef expr::Attribute<expr::attr::TypeCheckedTag, bool> TypeCheckedAttr;
+typedef expr::Attribute<expr::attr::TypeTag, TypeNode, true> TypeAttr;
+typedef expr::Attribute<expr::attr::TypeCheckedTag, bool, true> TypeCheckedAttr;
 
 }  // namespace expr
 }  // namespace cvc5
@@ -0,0 +1,597 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A compact binary format for node and type DAGs.
+ */
+
+#include "expr/node_serializer.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+#include "base/exception.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+#include "expr/node_manager_attributes.h"
+#include "util/bitvector.h"
+#include "util/floatingpoint_size.h"
+#include "util/rational.h"
+#include "util/roundingmode.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace expr {
+
+namespace {
+
+/** The magic bytes at the start of every stream. */
+const char s_magic[4] = {'c', 'v', '5', 'b'};
+/**
+ * The version of the format. Kinds are stored by their numeric value, so
+ * this must be increased whenever the kinds change. It must also be increased
+ * whenever api::Solver::saveBinary() changes the groups it writes.
+ */
+const uint64_t s_version = 2;
+
+std::string unsupported(const std::string& what, Kind k)
+{
+  std::stringstream ss;
+  ss << "binary serialization does not support " << what << " of kind " << k;
+  return ss.str();
+}
+
+}  // namespace
+
+NodeSerializer::NodeSerializer(std::ostream& out) : d_out(out)
+{
+  d_out.write(s_magic, sizeof(s_magic));
+  writeUnsigned(s_version);
+}
+
+void NodeSerializer::writeNodes(const std::vector<Node>& nodes)
+{
+  writeGroup(std::vector<Item>(nodes.begin(), nodes.end()));
+}
+
+void NodeSerializer::writeTypes(const std::vector<TypeNode>& types)
+{
+  writeGroup(std::vector<Item>(types.begin(), types.end()));
+}
+
+void NodeSerializer::writeString(const std::string& s)
+{
+  writeUnsigned(s.size());
+  d_out.write(s.data(), s.size());
+}
+
+void NodeSerializer::writeUnsigned(uint64_t n)
+{
+  while (n >= 0x80)
+  {
+    d_out.put(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  d_out.put(static_cast<char>(n));
+}
+
+void NodeSerializer::getChildren(const Item& item,
+                                 std::vector<Item>& children) const
+{
+  if (item.d_isType)
+  {
+    const TypeNode& tn = item.d_type;
+    switch (tn.getMetaKind())
+    {
+      case kind::metakind::CONSTANT: break;
+      case kind::metakind::PARAMETERIZED:
+        // only uninterpreted sorts, which are stored by name
+        if (!tn.isSort() || tn.getNumChildren() > 0)
+        {
+          throw Exception(unsupported("type", tn.getKind()));
+        }
+        break;
+      case kind::metakind::OPERATOR:
+        for (const TypeNode& tc : tn)
+        {
+          children.emplace_back(tc);
+        }
+        break;
+      default: throw Exception(unsupported("type", tn.getKind()));
+    }
+    return;
+  }
+  const Node& n = item.d_node;
+  switch (n.getMetaKind())
+  {
+    case kind::metakind::CONSTANT: break;
+    case kind::metakind::VARIABLE:
+      if (n.getKind() != kind::VARIABLE && n.getKind() != kind::BOUND_VARIABLE)
+      {
+        throw Exception(unsupported("variable", n.getKind()));
+      }
+      children.emplace_back(n.getType());
+      break;
+    case kind::metakind::NULLARY_OPERATOR:
+      children.emplace_back(n.getType());
+      break;
+    case kind::metakind::PARAMETERIZED:
+      children.emplace_back(n.getOperator());
+      CVC5_FALLTHROUGH;
+    case kind::metakind::OPERATOR:
+      for (const Node& nc : n)
+      {
+        children.emplace_back(nc);
+      }
+      break;
+    default: throw Exception(unsupported("term", n.getKind()));
+  }
+}
+
+void NodeSerializer::collect(const std::vector<Item>& roots)
+{
+  // iterative post-order traversal, children are written before parents
+  std::vector<std::pair<Item, bool>> visit;
+  for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+  {
+    visit.emplace_back(*it, false);
+  }
+  std::vector<Item> children;
+  while (!visit.empty())
+  {
+    Item cur = visit.back().first;
+    bool expanded = visit.back().second;
+    visit.pop_back();
+    uint64_t id = cur.getId();
+    if (d_index.find(id) != d_index.end())
+    {
+      continue;
+    }
+    if (expanded)
+    {
+      uint64_t index = d_index.size();
+      d_index[id] = index;
+      d_pending.push_back(cur);
+      continue;
+    }
+    visit.emplace_back(cur, true);
+    children.clear();
+    getChildren(cur, children);
+    for (auto it = children.rbegin(); it != children.rend(); ++it)
+    {
+      if (d_index.find(it->getId()) == d_index.end())
+      {
+        visit.emplace_back(*it, false);
+      }
+    }
+  }
+}
+
+void NodeSerializer::writeGroup(const std::vector<Item>& roots)
+{
+  collect(roots);
+  writeUnsigned(d_pending.size());
+  for (const Item& item : d_pending)
+  {
+    writeEntry(item);
+  }
+  d_pending.clear();
+  writeUnsigned(roots.size());
+  for (const Item& item : roots)
+  {
+    writeUnsigned(d_index[item.getId()]);
+  }
+}
+
+void NodeSerializer::writeEntry(const Item& item)
+{
+  std::vector<Item> children;
+  if (item.d_isType)
+  {
+    const TypeNode& tn = item.d_type;
+    Kind k = tn.getKind();
+    writeUnsigned((static_cast<uint64_t>(k) << 1) | 1);
+    switch (tn.getMetaKind())
+    {
+      case kind::metakind::CONSTANT:
+        switch (k)
+        {
+          case kind::TYPE_CONSTANT:
+            writeUnsigned(tn.getConst<TypeConstant>());
+            break;
+          case kind::BITVECTOR_TYPE:
+            writeUnsigned(tn.getConst<BitVectorSize>());
+            break;
+          case kind::FLOATINGPOINT_TYPE:
+          {
+            const FloatingPointSize& fs = tn.getConst<FloatingPointSize>();
+            writeUnsigned(fs.exponentWidth());
+            writeUnsigned(fs.significandWidth());
+            break;
+          }
+          default: throw Exception(unsupported("type", k));
+        }
+        return;
+      case kind::metakind::PARAMETERIZED: writeString(tn.getName()); return;
+      default: break;
+    }
+  }
+  else
+  {
+    const Node& n = item.d_node;
+    Kind k = n.getKind();
+    writeUnsigned(static_cast<uint64_t>(k) << 1);
+    switch (n.getMetaKind())
+    {
+      case kind::metakind::CONSTANT:
+        switch (k)
+        {
+          case kind::CONST_BOOLEAN: writeUnsigned(n.getConst<bool>()); break;
+          case kind::CONST_RATIONAL:
+            writeString(n.getConst<Rational>().toString());
+            break;
+          case kind::CONST_BITVECTOR:
+          {
+            const BitVector& bv = n.getConst<BitVector>();
+            writeUnsigned(bv.getSize());
+            writeString(bv.getValue().toString(16));
+            break;
+          }
+          case kind::CONST_STRING:
+          {
+            const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+            writeUnsigned(vec.size());
+            for (unsigned c : vec)
+            {
+              writeUnsigned(c);
+            }
+            break;
+          }
+          case kind::CONST_ROUNDINGMODE:
+            writeUnsigned(static_cast<uint64_t>(n.getConst<RoundingMode>()));
+            break;
+          case kind::BITVECTOR_EXTRACT_OP:
+          {
+            const BitVectorExtract& ext = n.getConst<BitVectorExtract>();
+            writeUnsigned(ext.d_high);
+            writeUnsigned(ext.d_low);
+            break;
+          }
+          case kind::BITVECTOR_REPEAT_OP:
+            writeUnsigned(n.getConst<BitVectorRepeat>());
+            break;
+          case kind::BITVECTOR_ZERO_EXTEND_OP:
+            writeUnsigned(n.getConst<BitVectorZeroExtend>());
+            break;
+          case kind::BITVECTOR_SIGN_EXTEND_OP:
+            writeUnsigned(n.getConst<BitVectorSignExtend>());
+            break;
+          case kind::BITVECTOR_ROTATE_LEFT_OP:
+            writeUnsigned(n.getConst<BitVectorRotateLeft>());
+            break;
+          case kind::BITVECTOR_ROTATE_RIGHT_OP:
+            writeUnsigned(n.getConst<BitVectorRotateRight>());
+            break;
+          case kind::INT_TO_BITVECTOR_OP:
+            writeUnsigned(n.getConst<IntToBitVector>());
+            break;
+          default: throw Exception(unsupported("constant", k));
+        }
+        return;
+      case kind::metakind::VARIABLE:
+      {
+        std::string name;
+        if (n.getAttribute(VarNameAttr(), name))
+        {
+          writeUnsigned(1);
+          writeString(name);
+        }
+        else
+        {
+          writeUnsigned(0);
+        }
+        writeUnsigned(d_index[n.getType().getId()]);
+        return;
+      }
+      case kind::metakind::NULLARY_OPERATOR:
+        writeUnsigned(d_index[n.getType().getId()]);
+        return;
+      default: break;
+    }
+  }
+  // operator applications are determined by their children
+  getChildren(item, children);
+  writeUnsigned(children.size());
+  for (const Item& c : children)
+  {
+    writeUnsigned(d_index[c.getId()]);
+  }
+}
+
+NodeDeserializer::NodeDeserializer(NodeManager* nm, std::istream& in)
+    : d_nm(nm), d_in(in)
+{
+  char magic[sizeof(s_magic)];
+  if (!d_in.read(magic, sizeof(magic))
+      || !std::equal(magic, magic + sizeof(magic), s_magic))
+  {
+    throw Exception("input is not in cvc5 binary format");
+  }
+  uint64_t version = readUnsigned();
+  if (version != s_version)
+  {
+    std::stringstream ss;
+    ss << "unsupported version " << version << " of cvc5 binary format";
+    throw Exception(ss.str());
+  }
+}
+
+std::vector<Node> NodeDeserializer::readNodes()
+{
+  std::vector<Node> res;
+  for (uint64_t index : readGroup(false))
+  {
+    res.push_back(d_nodes[index]);
+  }
+  return res;
+}
+
+std::vector<TypeNode> NodeDeserializer::readTypes()
+{
+  std::vector<TypeNode> res;
+  for (uint64_t index : readGroup(true))
+  {
+    res.push_back(d_types[index]);
+  }
+  return res;
+}
+
+std::string NodeDeserializer::readString()
+{
+  uint64_t size = readUnsigned();
+  // The size is not trusted: the string grows in bounded chunks, so that a
+  // corrupt size hits the end of the input before allocating its memory.
+  static constexpr uint64_t chunkSize = 1 << 16;
+  std::string res;
+  while (res.size() < size)
+  {
+    size_t offset = res.size();
+    size_t chunk = std::min(size - offset, chunkSize);
+    res.resize(offset + chunk);
+    if (!d_in.read(&res[offset], chunk))
+    {
+      throw Exception("unexpected end of binary input");
+    }
+  }
+  return res;
+}
+
+uint64_t NodeDeserializer::readUnsigned()
+{
+  uint64_t res = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    int c = d_in.get();
+    if (c == std::char_traits<char>::eof())
+    {
+      throw Exception("unexpected end of binary input");
+    }
+    res |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if ((c & 0x80) == 0)
+    {
+      return res;
+    }
+  }
+  throw Exception("invalid integer in binary input");
+}
+
+Node NodeDeserializer::readNodeIndex()
+{
+  uint64_t index = readUnsigned();
+  if (index >= d_nodes.size() || d_nodes[index].isNull())
+  {
+    throw Exception("invalid term reference in binary input");
+  }
+  return d_nodes[index];
+}
+
+TypeNode NodeDeserializer::readTypeIndex()
+{
+  uint64_t index = readUnsigned();
+  if (index >= d_types.size() || d_types[index].isNull())
+  {
+    throw Exception("invalid type reference in binary input");
+  }
+  return d_types[index];
+}
+
+std::vector<uint64_t> NodeDeserializer::readGroup(bool isType)
+{
+  uint64_t nentries = readUnsigned();
+  for (uint64_t i = 0; i < nentries; ++i)
+  {
+    readEntry();
+  }
+  uint64_t nroots = readUnsigned();
+  std::vector<uint64_t> roots;
+  for (uint64_t i = 0; i < nroots; ++i)
+  {
+    uint64_t index = readUnsigned();
+    if (index >= d_nodes.size()
+        || (isType ? d_types[index].isNull() : d_nodes[index].isNull()))
+    {
+      throw Exception("invalid root reference in binary input");
+    }
+    roots.push_back(index);
+  }
+  return roots;
+}
+
+void NodeDeserializer::readEntry()
+{
+  uint64_t header = readUnsigned();
+  uint64_t kval = header >> 1;
+  if (kval >= static_cast<uint64_t>(kind::LAST_KIND))
+  {
+    throw Exception("invalid kind in binary input");
+  }
+  Kind k = static_cast<Kind>(kval);
+  kind::MetaKind mk = kind::metaKindOf(k);
+  if (header & 1)
+  {
+    TypeNode tn;
+    switch (mk)
+    {
+      case kind::metakind::CONSTANT:
+        switch (k)
+        {
+          case kind::TYPE_CONSTANT:
+            tn = d_nm->mkTypeConst(static_cast<TypeConstant>(readUnsigned()));
+            break;
+          case kind::BITVECTOR_TYPE:
+            tn = d_nm->mkBitVectorType(readUnsigned());
+            break;
+          case kind::FLOATINGPOINT_TYPE:
+          {
+            unsigned exp = readUnsigned();
+            unsigned sig = readUnsigned();
+            tn = d_nm->mkFloatingPointType(exp, sig);
+            break;
+          }
+          default: throw Exception(unsupported("type", k));
+        }
+        break;
+      case kind::metakind::PARAMETERIZED:
+        if (k != kind::SORT_TYPE)
+        {
+          throw Exception(unsupported("type", k));
+        }
+        tn = d_nm->mkSort(readString());
+        break;
+      case kind::metakind::OPERATOR:
+      {
+        std::vector<TypeNode> children;
+        uint64_t nchildren = readUnsigned();
+        for (uint64_t i = 0; i < nchildren; ++i)
+        {
+          children.push_back(readTypeIndex());
+        }
+        tn = d_nm->mkTypeNode(k, children);
+        break;
+      }
+      default: throw Exception(unsupported("type", k));
+    }
+    d_nodes.emplace_back();
+    d_types.push_back(tn);
+    return;
+  }
+  Node n;
+  switch (mk)
+  {
+    case kind::metakind::CONSTANT:
+      switch (k)
+      {
+        case kind::CONST_BOOLEAN: n = d_nm->mkConst(readUnsigned() != 0); break;
+        case kind::CONST_RATIONAL:
+          n = d_nm->mkConst(Rational(readString()));
+          break;
+        case kind::CONST_BITVECTOR:
+        {
+          unsigned size = readUnsigned();
+          n = d_nm->mkConst(BitVector(size, Integer(readString(), 16)));
+          break;
+        }
+        case kind::CONST_STRING:
+        {
+          // the length is not trusted, see readString()
+          std::vector<unsigned> vec;
+          for (uint64_t i = 0, len = readUnsigned(); i < len; ++i)
+          {
+            vec.push_back(readUnsigned());
+          }
+          n = d_nm->mkConst(String(vec));
+          break;
+        }
+        case kind::CONST_ROUNDINGMODE:
+          n = d_nm->mkConst(static_cast<RoundingMode>(readUnsigned()));
+          break;
+        case kind::BITVECTOR_EXTRACT_OP:
+        {
+          unsigned high = readUnsigned();
+          unsigned low = readUnsigned();
+          n = d_nm->mkConst(BitVectorExtract(high, low));
+          break;
+        }
+        case kind::BITVECTOR_REPEAT_OP:
+          n = d_nm->mkConst(BitVectorRepeat(readUnsigned()));
+          break;
+        case kind::BITVECTOR_ZERO_EXTEND_OP:
+          n = d_nm->mkConst(BitVectorZeroExtend(readUnsigned()));
+          break;
+        case kind::BITVECTOR_SIGN_EXTEND_OP:
+          n = d_nm->mkConst(BitVectorSignExtend(readUnsigned()));
+          break;
+        case kind::BITVECTOR_ROTATE_LEFT_OP:
+          n = d_nm->mkConst(BitVectorRotateLeft(readUnsigned()));
+          break;
+        case kind::BITVECTOR_ROTATE_RIGHT_OP:
+          n = d_nm->mkConst(BitVectorRotateRight(readUnsigned()));
+          break;
+        case kind::INT_TO_BITVECTOR_OP:
+          n = d_nm->mkConst(IntToBitVector(readUnsigned()));
+          break;
+        default: throw Exception(unsupported("constant", k));
+      }
+      break;
+    case kind::metakind::VARIABLE:
+    {
+      if (k != kind::VARIABLE && k != kind::BOUND_VARIABLE)
+      {
+        throw Exception(unsupported("variable", k));
+      }
+      bool hasName = readUnsigned() != 0;
+      std::string name = hasName ? readString() : "";
+      TypeNode tn = readTypeIndex();
+      if (k == kind::VARIABLE)
+      {
+        n = hasName ? d_nm->mkVar(name, tn) : d_nm->mkVar(tn);
+      }
+      else
+      {
+        n = hasName ? d_nm->mkBoundVar(name, tn) : d_nm->mkBoundVar(tn);
+      }
+      break;
+    }
+    case kind::metakind::NULLARY_OPERATOR:
+      n = d_nm->mkNullaryOperator(readTypeIndex(), k);
+      break;
+    case kind::metakind::PARAMETERIZED:
+    case kind::metakind::OPERATOR:
+    {
+      NodeBuilder nb(d_nm, k);
+      uint64_t nchildren = readUnsigned();
+      for (uint64_t i = 0; i < nchildren; ++i)
+      {
+        nb << readNodeIndex();
+      }
+      n = nb.constructNode();
+      break;
+    }
+    default: throw Exception(unsupported("term", k));
+  }
+  d_nodes.push_back(n);
+  d_types.emplace_back();
+}
+
+}  // namespace expr
+}  // namespace cvc5
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A compact binary format for node and type DAGs.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_SERIALIZER_H
+#define CVC5__EXPR__NODE_SERIALIZER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5 {
+
+class NodeManager;
+
+namespace expr {
+
+/**
+ * Writes nodes and types to a stream in a compact binary format that can be
+ * read back by NodeDeserializer.
+ *
+ * The stream consists of a header followed by any number of groups of nodes
+ * or types (and strings, for meta information). Each group first lists the
+ * DAG nodes that were not written by a previous group, in topological order
+ * and without duplicates, and then the indices of its roots. Every DAG node is
+ * stored as its kind, the indices of its children (including the operator of
+ * parameterized nodes) and a payload for constants, variables and
+ * uninterpreted sorts. Variables are stored with their name and type, so
+ * free symbols are restored with the same names.
+ *
+ * Constants of kinds that are not supported (e.g. datatypes, floating-point
+ * values, sequences), skolems and sort constructors cause an exception.
+ */
+class NodeSerializer
+{
+ public:
+  /** Write the header to out. */
+  NodeSerializer(std::ostream& out);
+  /** Write a group of nodes. */
+  void writeNodes(const std::vector<Node>& nodes);
+  /** Write a group of types. */
+  void writeTypes(const std::vector<TypeNode>& types);
+  /** Write a string. */
+  void writeString(const std::string& s);
+
+ private:
+  /** A node or a type, i.e., an entry of the DAG. */
+  struct Item
+  {
+    Item(TNode n) : d_node(n), d_isType(false) {}
+    Item(TypeNode tn) : d_type(tn), d_isType(true) {}
+    uint64_t getId() const
+    {
+      return d_isType ? d_type.getId() : d_node.getId();
+    }
+    Node d_node;
+    TypeNode d_type;
+    bool d_isType;
+  };
+  /** Get the children of an item. */
+  void getChildren(const Item& item, std::vector<Item>& children) const;
+  /** Add all items reachable from the roots to d_pending. */
+  void collect(const std::vector<Item>& roots);
+  /** Write the pending items and the indices of the roots. */
+  void writeGroup(const std::vector<Item>& roots);
+  /** Write the kind-specific payload of an item. */
+  void writeEntry(const Item& item);
+  /** Write an unsigned integer in LEB128 encoding. */
+  void writeUnsigned(uint64_t n);
+
+  /** The output stream. */
+  std::ostream& d_out;
+  /** Maps node ids to their index in the stream. */
+  std::unordered_map<uint64_t, uint64_t> d_index;
+  /** The items not yet written, in topological order. */
+  std::vector<Item> d_pending;
+};
+
+/** Reads nodes and types written by a NodeSerializer. */
+class NodeDeserializer
+{
+ public:
+  /**
+   * Read the header from in.
+   *
+   * @throws Exception if the stream does not start with a valid header
+   */
+  NodeDeserializer(NodeManager* nm, std::istream& in);
+  /** Read a group of nodes. */
+  std::vector<Node> readNodes();
+  /** Read a group of types. */
+  std::vector<TypeNode> readTypes();
+  /** Read a string. */
+  std::string readString();
+
+ private:
+  /** Read a group and return the indices of its roots. */
+  std::vector<uint64_t> readGroup(bool isType);
+  /** Read one DAG entry. */
+  void readEntry();
+  /** Read an unsigned integer in LEB128 encoding. */
+  uint64_t readUnsigned();
+  /** Read an index and return the corresponding node. */
+  Node readNodeIndex();
+  /** Read an index and return the corresponding type. */
+  TypeNode readTypeIndex();
+
+  /** The node manager used to build nodes. */
+  NodeManager* d_nm;
+  /** The input stream. */
+  std::istream& d_in;
+  /** The nodes read so far, by index. Null for types. */
+  std::vector<Node> d_nodes;
+  /** The types read so far, by index. Null for nodes. */
+  std::vector<TypeNode> d_types;
+};
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_SERIALIZER_H */
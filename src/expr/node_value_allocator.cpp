@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A slab allocator for node values.
+ */
+
+#include "expr/node_value_allocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/node_value.h"
+
+namespace cvc5 {
+namespace expr {
+
+namespace {
+/**
+ * The number of slabs that need to become empty before releaseEmptySlabs()
+ * scans the free lists.
+ */
+constexpr size_t s_releaseThreshold = 16;
+}  // namespace
+
+NodeValueAllocator::NodeValueAllocator() : d_emptied(0)
+{
+  d_freeLists.fill(nullptr);
+  d_bump.fill(nullptr);
+  d_bumpEnd.fill(nullptr);
+}
+
+NodeValueAllocator::~NodeValueAllocator()
+{
+  for (SlabHeader* slab : d_slabs)
+  {
+    std::free(slab);
+  }
+}
+
+size_t NodeValueAllocator::blockSize(uint32_t nchildren)
+{
+  return sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+}
+
+NodeValueAllocator::SlabHeader* NodeValueAllocator::slabOf(const void* ptr)
+{
+  return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(ptr)
+                                       & ~(SLAB_SIZE - 1));
+}
+
+void NodeValueAllocator::newSlab(uint32_t nchildren)
+{
+  void* mem = std::aligned_alloc(SLAB_SIZE, SLAB_SIZE);
+  if (mem == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  SlabHeader* slab = static_cast<SlabHeader*>(mem);
+  slab->d_live = 0;
+  slab->d_release = false;
+  d_slabs.push_back(slab);
+  ++d_stats.d_slabsAcquired;
+  char* begin = static_cast<char*>(mem) + HEADER_SIZE;
+  size_t size = blockSize(nchildren);
+  d_bump[nchildren] = begin;
+  d_bumpEnd[nchildren] =
+      begin + ((SLAB_SIZE - HEADER_SIZE) / size) * size;
+}
+
+NodeValue* NodeValueAllocator::allocate(uint32_t nchildren)
+{
+  if (nchildren > MAX_SLAB_CHILDREN)
+  {
+    void* mem = std::malloc(blockSize(nchildren));
+    if (mem == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    ++d_stats.d_largeAllocations;
+    return static_cast<NodeValue*>(mem);
+  }
+  ++d_stats.d_slabAllocations;
+  void* mem;
+  FreeBlock*& head = d_freeLists[nchildren];
+  if (head != nullptr)
+  {
+    mem = head;
+    head = head->d_next;
+    ++d_stats.d_recycled;
+  }
+  else
+  {
+    if (d_bump[nchildren] == d_bumpEnd[nchildren])
+    {
+      newSlab(nchildren);
+    }
+    mem = d_bump[nchildren];
+    d_bump[nchildren] += blockSize(nchildren);
+  }
+  ++slabOf(mem)->d_live;
+  return static_cast<NodeValue*>(mem);
+}
+
+void NodeValueAllocator::deallocate(NodeValue* nv, uint32_t nchildren)
+{
+  if (nchildren > MAX_SLAB_CHILDREN)
+  {
+    std::free(nv);
+    return;
+  }
+  SlabHeader* slab = slabOf(nv);
+  Assert(slab->d_live > 0);
+  if (--slab->d_live == 0)
+  {
+    ++d_emptied;
+  }
+  FreeBlock* block = reinterpret_cast<FreeBlock*>(nv);
+  block->d_next = d_freeLists[nchildren];
+  d_freeLists[nchildren] = block;
+}
+
+void NodeValueAllocator::releaseEmptySlabs()
+{
+  if (d_emptied < s_releaseThreshold)
+  {
+    return;
+  }
+  d_emptied = 0;
+
+  // Mark the empty slabs, except for those we are currently bumping into.
+  size_t nrelease = 0;
+  for (SlabHeader* slab : d_slabs)
+  {
+    slab->d_release = (slab->d_live == 0);
+  }
+  for (uint32_t i = 0; i <= MAX_SLAB_CHILDREN; ++i)
+  {
+    if (d_bump[i] != d_bumpEnd[i])
+    {
+      slabOf(d_bump[i])->d_release = false;
+    }
+  }
+  for (SlabHeader* slab : d_slabs)
+  {
+    nrelease += slab->d_release ? 1 : 0;
+  }
+  if (nrelease == 0)
+  {
+    return;
+  }
+
+  // Unlink the blocks of marked slabs from the free lists.
+  for (uint32_t i = 0; i <= MAX_SLAB_CHILDREN; ++i)
+  {
+    FreeBlock** link = &d_freeLists[i];
+    while (*link != nullptr)
+    {
+      if (slabOf(*link)->d_release)
+      {
+        *link = (*link)->d_next;
+      }
+      else
+      {
+        link = &(*link)->d_next;
+      }
+    }
+  }
+
+  auto it = std::remove_if(
+      d_slabs.begin(), d_slabs.end(), [](SlabHeader* slab) {
+        if (slab->d_release)
+        {
+          std::free(slab);
+          return true;
+        }
+        return false;
+      });
+  d_slabs.erase(it, d_slabs.end());
+  d_stats.d_slabsReleased += nrelease;
+  Debug("gc") << "released " << nrelease << " empty node value slab(s), "
+              << d_slabs.size() << " remaining" << std::endl;
+}
+
+}  // namespace expr
+}  // namespace cvc5
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A slab allocator for node values.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_ALLOCATOR_H
+#define CVC5__EXPR__NODE_VALUE_ALLOCATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cvc5 {
+namespace expr {
+
+class NodeValue;
+
+/**
+ * Allocates the memory for non-constant node values, i.e., the node value
+ * header plus its trailing array of children.
+ *
+ * Node values with at most MAX_SLAB_CHILDREN children are served from
+ * slabs, large chunks of memory that are split into blocks of the same size
+ * class (the number of children). Every size class has an intrusive free
+ * list of deallocated blocks, which is the first source for allocation, and
+ * the slab most recently obtained for this class, from which blocks are
+ * taken in order. Node values with more children are rare and are allocated
+ * with malloc() directly.
+ *
+ * Slabs are aligned to their size, which allows to find the slab (and its
+ * number of live blocks) for any block. releaseEmptySlabs() returns slabs
+ * without live blocks to the system; the NodeManager calls it after a round
+ * of zombie reclamation.
+ *
+ * The allocator only deals with raw memory: it neither constructs nor
+ * destructs node values. All slabs are released upon destruction.
+ */
+class NodeValueAllocator
+{
+ public:
+  /** Node values with more children are not allocated from slabs. */
+  static constexpr uint32_t MAX_SLAB_CHILDREN = 15;
+  /** The size (and alignment) of a slab in bytes. */
+  static constexpr size_t SLAB_SIZE = static_cast<size_t>(1) << 16;
+
+  /** Counters on the behavior of the allocator. */
+  struct Statistics
+  {
+    /** Number of node values allocated from slabs. */
+    uint64_t d_slabAllocations = 0;
+    /** Number of slab allocations served from a free list. */
+    uint64_t d_recycled = 0;
+    /** Number of node values allocated with malloc(). */
+    uint64_t d_largeAllocations = 0;
+    /** Number of slabs obtained from the system. */
+    uint64_t d_slabsAcquired = 0;
+    /** Number of slabs given back to the system. */
+    uint64_t d_slabsReleased = 0;
+  };
+
+  NodeValueAllocator();
+  ~NodeValueAllocator();
+  NodeValueAllocator(const NodeValueAllocator&) = delete;
+  NodeValueAllocator& operator=(const NodeValueAllocator&) = delete;
+
+  /**
+   * Returns uninitialized memory for a node value with nchildren children.
+   * Throws std::bad_alloc if no memory is available.
+   */
+  NodeValue* allocate(uint32_t nchildren);
+  /**
+   * Gives back the memory of nv, which was obtained from allocate() with the
+   * same number of children.
+   */
+  void deallocate(NodeValue* nv, uint32_t nchildren);
+
+  /**
+   * Returns all slabs that contain no live node values to the system. This is
+   * linear in the number of free blocks and only does work if enough slabs
+   * may have become empty since the last call.
+   */
+  void releaseEmptySlabs();
+
+  /** Returns the counters of this allocator. */
+  const Statistics& getStatistics() const { return d_stats; }
+
+ private:
+  /** The header at the beginning of every slab. */
+  struct SlabHeader
+  {
+    /** The number of blocks of this slab that are currently allocated. */
+    uint32_t d_live;
+    /** Whether this slab is about to be released by releaseEmptySlabs(). */
+    bool d_release;
+  };
+  /** A deallocated block, linked into the free list of its size class. */
+  struct FreeBlock
+  {
+    FreeBlock* d_next;
+  };
+  /** Offset of the first block in a slab, keeps blocks 16-byte aligned. */
+  static constexpr size_t HEADER_SIZE = 16;
+
+  /** The size of a block for nchildren children. */
+  static size_t blockSize(uint32_t nchildren);
+  /** The slab that ptr lies in. */
+  static SlabHeader* slabOf(const void* ptr);
+  /** Obtains a new slab and makes it the bump slab of the size class. */
+  void newSlab(uint32_t nchildren);
+
+  /** The free lists, indexed by number of children. */
+  std::array<FreeBlock*, MAX_SLAB_CHILDREN + 1> d_freeLists;
+  /** The next unused block of the current slab of each size class. */
+  std::array<char*, MAX_SLAB_CHILDREN + 1> d_bump;
+  /** The end of the current slab of each size class. */
+  std::array<char*, MAX_SLAB_CHILDREN + 1> d_bumpEnd;
+  /** All slabs currently owned by this allocator. */
+  std::vector<SlabHeader*> d_slabs;
+  /** Number of times a slab lost its last live block since the last trim. */
+  size_t d_emptied;
+  /** The counters. */
+  Statistics d_stats;
+};
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_VALUE_ALLOCATOR_H */
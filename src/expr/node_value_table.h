@@ -0,0 +1,286 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A flat hash set of node values.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_TABLE_H
+#define CVC5__EXPR__NODE_VALUE_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace expr {
+
+class NodeValue;
+
+/**
+ * A hash set of node value pointers with open addressing and Robin Hood
+ * hashing, used by the NodeManager for the pool of hash-consed node values
+ * and for the set of zombies.
+ *
+ * All entries live in a single array of slots. Every slot stores the node
+ * value, (the upper half of) its hash and its distance from the slot the
+ * hash maps to. Lookups thus only compare node values whose cached hash
+ * matches and stop as soon as they reach a slot with a smaller distance
+ * than the current one. Erasing shifts the subsequent entries back, hence
+ * there are no tombstones.
+ *
+ * Hash is applied to node values, Eq compares a stored node value to a
+ * queried one. Note that the queried node value may be a temporary that is
+ * not (yet) fully constructed, e.g. the one of a NodeBuilder.
+ */
+template <class Hash, class Eq>
+class NodeValueTable
+{
+  /** A slot of the table. */
+  struct Slot
+  {
+    /** The stored node value. */
+    NodeValue* d_nv;
+    /** The upper 32 bits of the mixed hash of d_nv. */
+    uint32_t d_hash;
+    /** The distance to the home slot plus one, zero for empty slots. */
+    uint32_t d_dist;
+  };
+
+ public:
+  /** Iterates over the stored node values in no particular order. */
+  class const_iterator
+  {
+   public:
+    const_iterator(const Slot* slot, const Slot* end) : d_slot(slot), d_end(end)
+    {
+      skipEmpty();
+    }
+    NodeValue* operator*() const { return d_slot->d_nv; }
+    const_iterator& operator++()
+    {
+      ++d_slot;
+      skipEmpty();
+      return *this;
+    }
+    bool operator==(const const_iterator& it) const
+    {
+      return d_slot == it.d_slot;
+    }
+    bool operator!=(const const_iterator& it) const
+    {
+      return d_slot != it.d_slot;
+    }
+
+   private:
+    void skipEmpty()
+    {
+      while (d_slot != d_end && d_slot->d_dist == 0)
+      {
+        ++d_slot;
+      }
+    }
+    const Slot* d_slot;
+    const Slot* d_end;
+  };
+
+  NodeValueTable() : d_capacity(0), d_bits(0), d_size(0) {}
+  NodeValueTable(const NodeValueTable&) = delete;
+  NodeValueTable& operator=(const NodeValueTable&) = delete;
+
+  /** The number of stored node values. */
+  size_t size() const { return d_size; }
+  /** Whether the table is empty. */
+  bool empty() const { return d_size == 0; }
+
+  const_iterator begin() const
+  {
+    return const_iterator(d_slots.get(), d_slots.get() + d_capacity);
+  }
+  const_iterator end() const
+  {
+    return const_iterator(d_slots.get() + d_capacity,
+                          d_slots.get() + d_capacity);
+  }
+
+  /**
+   * Returns the stored node value that is equal to nv, or nullptr if there
+   * is none.
+   */
+  NodeValue* find(const NodeValue* nv) const
+  {
+    if (d_size == 0)
+    {
+      return nullptr;
+    }
+    uint32_t hash = hashOf(nv);
+    size_t mask = d_capacity - 1;
+    size_t i = home(hash);
+    for (uint32_t dist = 1;; ++dist, i = (i + 1) & mask)
+    {
+      const Slot& s = d_slots[i];
+      if (s.d_dist < dist)
+      {
+        return nullptr;
+      }
+      if (s.d_hash == hash && Eq()(s.d_nv, nv))
+      {
+        return s.d_nv;
+      }
+    }
+  }
+
+  /**
+   * Inserts nv if no equal node value is stored yet. Returns true if nv was
+   * inserted.
+   */
+  bool insert(NodeValue* nv)
+  {
+    if (find(nv) != nullptr)
+    {
+      return false;
+    }
+    if ((d_size + 1) * 8 > d_capacity * 7)
+    {
+      grow();
+    }
+    place(Slot{nv, hashOf(nv), 1});
+    ++d_size;
+    return true;
+  }
+
+  /** Removes the node value that is equal to nv, returns true if found. */
+  bool erase(const NodeValue* nv)
+  {
+    if (d_size == 0)
+    {
+      return false;
+    }
+    uint32_t hash = hashOf(nv);
+    size_t mask = d_capacity - 1;
+    size_t i = home(hash);
+    for (uint32_t dist = 1;; ++dist, i = (i + 1) & mask)
+    {
+      const Slot& s = d_slots[i];
+      if (s.d_dist < dist)
+      {
+        return false;
+      }
+      if (s.d_hash == hash && Eq()(s.d_nv, nv))
+      {
+        break;
+      }
+    }
+    // shift the following entries of the cluster back by one slot
+    size_t next = (i + 1) & mask;
+    while (d_slots[next].d_dist > 1)
+    {
+      d_slots[i] = d_slots[next];
+      --d_slots[i].d_dist;
+      i = next;
+      next = (i + 1) & mask;
+    }
+    d_slots[i] = Slot{nullptr, 0, 0};
+    --d_size;
+    return true;
+  }
+
+  /** Removes all node values, keeping the allocated slots. */
+  void clear()
+  {
+    for (size_t i = 0; i < d_capacity; ++i)
+    {
+      d_slots[i] = Slot{nullptr, 0, 0};
+    }
+    d_size = 0;
+  }
+
+ private:
+  /** The minimal number of slots once anything is stored. */
+  static constexpr size_t s_minCapacity = 64;
+
+  /**
+   * Spreads the hash of nv over all bits (Fibonacci hashing) and keeps the
+   * upper half, which is the part used to find the home slot.
+   */
+  static uint32_t hashOf(const NodeValue* nv)
+  {
+    uint64_t h = static_cast<uint64_t>(Hash()(nv)) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<uint32_t>(h >> 32);
+  }
+  /** The home slot for the given (mixed) hash. */
+  size_t home(uint32_t hash) const { return hash >> (32 - d_bits); }
+
+  /** Places s into the table, which must have a free slot. */
+  void place(Slot s)
+  {
+    size_t mask = d_capacity - 1;
+    size_t i = home(s.d_hash);
+    for (;; ++s.d_dist, i = (i + 1) & mask)
+    {
+      Slot& cur = d_slots[i];
+      if (cur.d_dist == 0)
+      {
+        cur = s;
+        return;
+      }
+      if (cur.d_dist < s.d_dist)
+      {
+        // Robin Hood: the entry closer to its home slot moves on
+        std::swap(cur, s);
+      }
+    }
+  }
+
+  /** Doubles the number of slots and reinserts all entries. */
+  void grow()
+  {
+    size_t oldCapacity = d_capacity;
+    std::unique_ptr<Slot[]> old = std::move(d_slots);
+    d_capacity = oldCapacity == 0 ? s_minCapacity : 2 * oldCapacity;
+    d_bits = 0;
+    while ((static_cast<size_t>(1) << d_bits) < d_capacity)
+    {
+      ++d_bits;
+    }
+    Assert(d_bits <= 32);
+    d_slots.reset(new Slot[d_capacity]);
+    for (size_t i = 0; i < d_capacity; ++i)
+    {
+      d_slots[i] = Slot{nullptr, 0, 0};
+    }
+    for (size_t i = 0; i < oldCapacity; ++i)
+    {
+      if (old[i].d_dist != 0)
+      {
+        place(Slot{old[i].d_nv, old[i].d_hash, 1});
+      }
+    }
+  }
+
+  /** The slots, d_capacity many. */
+  std::unique_ptr<Slot[]> d_slots;
+  /** The number of slots, zero or a power of two. */
+  size_t d_capacity;
+  /** The binary logarithm of d_capacity. */
+  uint32_t d_bits;
+  /** The number of stored node values. */
+  size_t d_size;
+};
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_VALUE_TABLE_H */
@@ -28,15 +28,19 @@
 #include "base/configuration.h"
 #include "base/cvc5config.h"
 #include "base/output.h"
+#include "expr/symbol_manager.h"
+#include "expr/symbol_table.h"
 #include "main/command_executor.h"
 #include "main/interactive_shell.h"
 #include "main/main.h"
+#include "main/portfolio.h"
 #include "main/signal_handlers.h"
 #include "main/time_limit.h"
 #include "options/base_options.h"
 #include "options/options.h"
 #include "options/parser_options.h"
 #include "options/main_options.h"
+#include "options/option_exception.h"
 #include "options/set_language.h"
 #include "parser/parser.h"
 #include "parser/parser_builder.h"
@@ -95,6 +99,181 @@ void printUsage(Options& opts, bool full) {
   }
 }
 
+namespace {
+
+/** Get the name of a declared term or sort, without SMT-LIB quotes. */
+std::string getDeclarationName(const std::string& str)
+{
+  if (str.size() >= 2 && str.front() == '|' && str.back() == '|')
+  {
+    return str.substr(1, str.size() - 2);
+  }
+  return str;
+}
+
+/** The functions defined by the input, as stored by --dump-binary. */
+struct BinaryDefinitions
+{
+  /**
+   * Records the definition made by cmd, if any. A function with parameters
+   * is recorded with the lambda defining it.
+   */
+  void record(Command* cmd, api::Solver* solver)
+  {
+    if (DefineFunctionCommand* dfc = dynamic_cast<DefineFunctionCommand*>(cmd))
+    {
+      if (dfc->getFunction().isNull())
+      {
+        return;
+      }
+      d_funs.push_back(dfc->getFunction());
+      const std::vector<api::Term>& formals = dfc->getFormals();
+      if (formals.empty())
+      {
+        d_defs.push_back(dfc->getFormula());
+      }
+      else
+      {
+        d_defs.push_back(
+            solver->mkTerm(api::LAMBDA,
+                           solver->mkTerm(api::BOUND_VAR_LIST, formals),
+                           dfc->getFormula()));
+      }
+    }
+    else if (dynamic_cast<DefineFunctionRecCommand*>(cmd) != nullptr)
+    {
+      d_recursive = true;
+    }
+  }
+
+  /** The defined functions. */
+  std::vector<api::Term> d_funs;
+  /** The definitions of the functions in d_funs. */
+  std::vector<api::Term> d_defs;
+  /** Whether there are recursive definitions, which cannot be stored. */
+  bool d_recursive = false;
+};
+
+/**
+ * Write the current assertions, declarations and definitions of the solver
+ * to the given file in binary format.
+ */
+void saveBinary(const std::string& filename,
+                api::Solver* solver,
+                SymbolManager* symman,
+                const BinaryDefinitions& defs)
+{
+  if (defs.d_recursive)
+  {
+    throw Exception(
+        "cannot write recursive function definitions in binary format");
+  }
+  std::ofstream out(filename, std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    throw Exception("cannot open " + filename + " for writing");
+  }
+  try
+  {
+    solver->saveBinary(out,
+                       solver->getAssertions(),
+                       symman->getModelDeclareTerms(),
+                       symman->getModelDeclareSorts(),
+                       defs.d_funs,
+                       defs.d_defs);
+  }
+  catch (const api::CVC5ApiException& e)
+  {
+    throw Exception(e.getMessage());
+  }
+}
+
+/**
+ * Load assertions, declarations and definitions in binary format from the
+ * given file. The declared and defined symbols are bound in the symbol table
+ * of symman. The commands that define the functions and assert the assertions
+ * are returned, they are muted.
+ */
+std::vector<std::unique_ptr<Command>> loadBinary(const std::string& filename,
+                                                 api::Solver* solver,
+                                                 SymbolManager* symman)
+{
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    throw Exception("cannot open " + filename + " for reading");
+  }
+  std::vector<api::Term> assertions;
+  std::vector<api::Term> declTerms;
+  std::vector<api::Sort> declSorts;
+  std::vector<api::Term> definedFuns;
+  std::vector<api::Term> definitions;
+  try
+  {
+    solver->loadBinary(
+        in, assertions, declTerms, declSorts, definedFuns, definitions);
+  }
+  catch (const api::CVC5ApiException& e)
+  {
+    throw Exception(e.getMessage());
+  }
+  SymbolTable* st = symman->getSymbolTable();
+  for (const api::Sort& s : declSorts)
+  {
+    st->bindType(getDeclarationName(s.getUninterpretedSortName()), s, true);
+    symman->addModelDeclarationSort(s);
+  }
+  for (const api::Term& t : declTerms)
+  {
+    st->bind(getDeclarationName(t.toString()), t, true);
+    symman->addModelDeclarationTerm(t);
+  }
+  std::vector<std::unique_ptr<Command>> cmds;
+  for (size_t i = 0, n = definedFuns.size(); i < n; ++i)
+  {
+    const api::Term& f = definedFuns[i];
+    std::string name = getDeclarationName(f.toString());
+    st->bind(name, f, true);
+    const api::Term& def = definitions[i];
+    if (def.getKind() == api::LAMBDA)
+    {
+      std::vector<api::Term> formals(def[0].begin(), def[0].end());
+      cmds.emplace_back(
+          new DefineFunctionCommand(name, f, formals, def[1], false));
+    }
+    else
+    {
+      cmds.emplace_back(new DefineFunctionCommand(name, f, def, false));
+    }
+  }
+  for (const api::Term& a : assertions)
+  {
+    cmds.emplace_back(new AssertCommand(a));
+  }
+  for (std::unique_ptr<Command>& cmd : cmds)
+  {
+    cmd->setMuted(true);
+  }
+  return cmds;
+}
+
+/**
+ * Whether cmd may appear before the loaded assertions are asserted, i.e.,
+ * whether it only sets up the solver.
+ */
+bool isSetupCommand(Command* cmd)
+{
+  return dynamic_cast<SetOptionCommand*>(cmd) != nullptr
+         || dynamic_cast<SetInfoCommand*>(cmd) != nullptr
+         || dynamic_cast<SetBenchmarkLogicCommand*>(cmd) != nullptr
+         || dynamic_cast<GetOptionCommand*>(cmd) != nullptr
+         || dynamic_cast<GetInfoCommand*>(cmd) != nullptr
+         || dynamic_cast<EchoCommand*>(cmd) != nullptr
+         || dynamic_cast<EmptyCommand*>(cmd) != nullptr;
+}
+
+}  // namespace
+
 int runCvc5(int argc, char* argv[], Options& opts)
 {
   main::totalTime = std::make_unique<TotalTimer>();
@@ -140,6 +319,15 @@ int runCvc5(int argc, char* argv[], Options& opts)
     throw Exception("Too many input files specified.");
   }
 
+  // The workers of the portfolio do not read or write binary files
+  if (opts.driver.portfolioJobs > 1
+      && (!opts.driver.dumpBinary.empty() || !opts.driver.loadBinary.empty()))
+  {
+    throw OptionException(
+        "--dump-binary and --load-binary cannot be used with "
+        "--portfolio-jobs");
+  }
+
   // If no file supplied we will read from standard input
   const bool inputFromStdin = filenames.empty() || filenames[0] == "-";
 
@@ -200,6 +388,25 @@ int runCvc5(int argc, char* argv[], Options& opts)
   (*opts.base.out)
       << language::SetLanguage(opts.base.outputLanguage);
 
+  if (usePortfolio(opts))
+  {
+    // the portfolio sets up its own solvers, one per worker thread
+    int returnValue = runPortfolio(opts, filenameStr, inputFromStdin);
+    totalTime.reset();
+    signal_handlers::cleanup();
+    return returnValue;
+  }
+  if (opts.driver.portfolioJobs > 1)
+  {
+    Warning() << "--portfolio-jobs is ignored for interactive or incremental "
+                 "solving"
+              << std::endl;
+  }
+  if (opts.driver.cubeDepth > 0)
+  {
+    Warning() << "--cube-depth is ignored without a portfolio" << std::endl;
+  }
+
   // Create the command executor to execute the parsed commands
   pExecutor = std::make_unique<CommandExecutor>(opts);
 
@@ -259,22 +466,42 @@ int runCvc5(int argc, char* argv[], Options& opts)
         cmd->setMuted(true);
         pExecutor->doCommand(cmd);
       }
+      if (!opts.driver.dumpBinary.empty())
+      {
+        cmd.reset(new SetOptionCommand("produce-assertions", "true"));
+        cmd->setMuted(true);
+        pExecutor->doCommand(cmd);
+      }
+      // definitions and assertions loaded from a binary file, executed
+      // before the first command that does not only set up the solver
+      std::vector<std::unique_ptr<Command>> loaded;
+      if (!opts.driver.loadBinary.empty())
+      {
+        loaded = loadBinary(opts.driver.loadBinary,
+                            pExecutor->getSolver(),
+                            pExecutor->getSymbolManager());
+      }
 
       ParserBuilder parserBuilder(pExecutor->getSolver(),
                                   pExecutor->getSymbolManager(),
                                   opts);
       std::unique_ptr<Parser> parser(parserBuilder.build());
       if( inputFromStdin ) {
-        parser->setInput(Input::newStreamInput(
-            opts.base.inputLanguage, cin, filename));
+        parser->setInput(Input::newStreamInput(opts.base.inputLanguage,
+                                               cin,
+                                               filename,
+                                               opts.parser.fastParser));
       }
       else
       {
         parser->setInput(Input::newFileInput(opts.base.inputLanguage,
                                              filename,
-                                             opts.parser.memoryMap));
+                                             opts.parser.memoryMap,
+                                             opts.parser.fastParser));
       }
 
+      // the definitions of the input, for --dump-binary
+      BinaryDefinitions definitions;
       bool interrupted = false;
       while (status)
       {
@@ -291,7 +518,17 @@ int runCvc5(int argc, char* argv[], Options& opts)
           continue;
         }
 
-        status = pExecutor->doCommand(cmd);
+        if (!loaded.empty() && !isSetupCommand(cmd.get()))
+        {
+          for (std::unique_ptr<Command>& lcmd : loaded)
+          {
+            status = pExecutor->doCommand(lcmd) && status;
+            definitions.record(lcmd.get(), pExecutor->getSolver());
+          }
+          loaded.clear();
+        }
+        status = pExecutor->doCommand(cmd) && status;
+        definitions.record(cmd.get(), pExecutor->getSolver());
         if (cmd->interrupted() && status == 0) {
           interrupted = true;
           break;
@@ -301,6 +538,13 @@ int runCvc5(int argc, char* argv[], Options& opts)
           break;
         }
       }
+      if (status && !opts.driver.dumpBinary.empty())
+      {
+        saveBinary(opts.driver.dumpBinary,
+                   pExecutor->getSolver(),
+                   pExecutor->getSymbolManager(),
+                   definitions);
+      }
     }
 
     api::Result result;
@@ -0,0 +1,930 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Parallel portfolio solving in the driver.
+ */
+
+#include "main/portfolio.h"
+
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "api/cpp/cvc5.h"
+#include "base/configuration.h"
+#include "base/exception.h"
+#include "base/output.h"
+#include "main/command_executor.h"
+#include "options/base_options.h"
+#include "options/bv_options.h"
+#include "options/decision_options.h"
+#include "options/language.h"
+#include "options/main_options.h"
+#include "options/parser_options.h"
+#include "options/prop_options.h"
+#include "options/set_language.h"
+#include "options/smt_options.h"
+#include "parser/input.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "parser/parser_exception.h"
+#include "smt/command.h"
+#include "smt/smt_engine.h"
+#include "theory/logic_info.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/**
+ * The state shared by the workers of a cube-and-conquer run. The first worker
+ * splits the search space into cubes, all workers then take the cubes one by
+ * one and share short learned clauses between each other. Since every worker
+ * has its own NodeManager, cubes and clauses are exchanged as SMT-LIB terms
+ * and parsed again by each worker.
+ */
+class ConquerState
+{
+ public:
+  /** The status of a cube, or of the whole input. */
+  enum class Status
+  {
+    SAT,
+    UNSAT,
+    UNKNOWN,
+    /** Not yet determined by this cube. */
+    OPEN
+  };
+
+  ConquerState()
+      : d_ready(false), d_failed(false), d_next(0), d_open(0), d_unknown(false)
+  {
+  }
+
+  /** Publishes the cubes computed by the first worker. */
+  void setCubes(std::vector<std::vector<std::string>>&& cubes)
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    d_cubes = std::move(cubes);
+    d_open = d_cubes.size();
+    d_ready = true;
+    d_cv.notify_all();
+  }
+
+  /** Releases the waiting workers if the first worker could not split. */
+  void abort()
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    if (!d_ready)
+    {
+      d_failed = true;
+      d_ready = true;
+    }
+    d_cv.notify_all();
+  }
+
+  /**
+   * Waits until the cubes are available or stopped is set. Returns false if
+   * there are no cubes to work on.
+   */
+  bool waitForCubes(const std::atomic<bool>& stopped)
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_cv.wait(lock, [this, &stopped]() { return d_ready || stopped.load(); });
+    return d_ready && !d_failed;
+  }
+
+  /** Wakes up all waiting workers, e.g. after they were stopped. */
+  void wakeUp()
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    d_cv.notify_all();
+  }
+
+  /** Takes the next cube, returns false if all cubes were taken. */
+  bool nextCube(std::vector<std::string>& cube)
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    if (d_next == d_cubes.size())
+    {
+      return false;
+    }
+    cube = d_cubes[d_next++];
+    return true;
+  }
+
+  /**
+   * Records the status of a solved cube. Returns the status of the input if
+   * it is determined by this cube, i.e., SAT if the cube is satisfiable, and
+   * UNSAT or UNKNOWN if this was the last open cube. Returns OPEN otherwise.
+   */
+  Status finishCube(Status status)
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    if (status == Status::SAT)
+    {
+      return Status::SAT;
+    }
+    d_unknown = d_unknown || status == Status::UNKNOWN;
+    if (--d_open > 0)
+    {
+      return Status::OPEN;
+    }
+    return d_unknown ? Status::UNKNOWN : Status::UNSAT;
+  }
+
+  /** Adds the clauses learned by worker id to the pool. */
+  void shareClauses(size_t id, const std::vector<std::string>& clauses)
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    for (const std::string& c : clauses)
+    {
+      d_clauses.emplace_back(id, c);
+    }
+  }
+
+  /**
+   * Gets the clauses of the pool starting at index that were not learned by
+   * worker id, and sets index to the end of the pool.
+   */
+  void getClauses(size_t id, size_t& index, std::vector<std::string>& clauses)
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    for (size_t n = d_clauses.size(); index < n; ++index)
+    {
+      if (d_clauses[index].first != id)
+      {
+        clauses.push_back(d_clauses[index].second);
+      }
+    }
+  }
+
+ private:
+  /** Protects all members. */
+  std::mutex d_mutex;
+  /** Signals that the cubes are ready. */
+  std::condition_variable d_cv;
+  /** Whether the first worker finished splitting. */
+  bool d_ready;
+  /** Whether splitting failed. */
+  bool d_failed;
+  /** The cubes, as lists of literals. */
+  std::vector<std::vector<std::string>> d_cubes;
+  /** The index of the next cube to be taken. */
+  size_t d_next;
+  /** The number of cubes that were not solved yet. */
+  size_t d_open;
+  /** Whether some cube could not be solved. */
+  bool d_unknown;
+  /** The shared clauses, with the worker that learned them. */
+  std::vector<std::pair<size_t, std::string>> d_clauses;
+};
+
+/**
+ * A single member of the portfolio. It owns a CommandExecutor (and thus an
+ * api::Solver) whose output is buffered until the portfolio has decided
+ * which worker to report.
+ */
+class PortfolioWorker
+{
+ public:
+  PortfolioWorker(size_t id, std::atomic<int>& winner, ConquerState* conquer)
+      : d_id(id),
+        d_winner(winner),
+        d_conquer(conquer),
+        d_stopped(false),
+        d_status(false)
+  {
+  }
+
+  /**
+   * Parses and executes the input with a configuration derived from opts.
+   * Calls stopOthers() if this worker is the first to find a definitive
+   * result. In cube-and-conquer mode, the first check-sat command is solved
+   * together with the other workers by conquer().
+   */
+  template <typename StopOthers>
+  void run(const Options& opts,
+           const std::string& filename,
+           const std::string* input,
+           StopOthers stopOthers);
+
+  /** Interrupts this worker; may be called from any thread. */
+  void stop()
+  {
+    std::lock_guard<std::mutex> guard(d_mutex);
+    d_stopped.store(true);
+    if (d_executor != nullptr)
+    {
+      d_executor->getSolver()->interrupt();
+    }
+  }
+
+  /** Writes the buffered output of this worker to the given streams. */
+  void flush(std::ostream& out, std::ostream& err) const
+  {
+    out << d_out.str() << std::flush;
+    err << d_err.str() << std::flush;
+  }
+
+  /** Whether all commands of this worker were successful. */
+  bool getStatus() const { return d_status; }
+
+ private:
+  /** Applies the portfolio configuration of this worker to the solver. */
+  void configure(const Options& opts, api::Solver* solver) const;
+  /**
+   * Solves the current assertions by cube-and-conquer. Parses cubes and
+   * shared clauses with parser, whose input is replaced. Returns whether this
+   * worker determined the result (which it then printed) and thus won.
+   */
+  bool conquer(const Options& opts, parser::Parser* parser);
+  /**
+   * Parses a term printed by another worker. Returns the null term if it
+   * cannot be parsed, e.g. since it contains symbols introduced by
+   * preprocessing.
+   */
+  api::Term parseTerm(const Options& opts,
+                      parser::Parser* parser,
+                      const std::string& s) const;
+  /** Prints t in the SMT-LIB format, such that parseTerm() can read it. */
+  std::string printTerm(const api::Term& t) const;
+  /** Tries to become the winner, returns false if another worker won. */
+  bool claimWin()
+  {
+    int expected = -1;
+    return d_winner.compare_exchange_strong(expected, static_cast<int>(d_id));
+  }
+  /** Sets an option of the solver, ignoring incompatible configurations. */
+  void trySetOption(api::Solver* solver,
+                    const std::string& name,
+                    const std::string& value) const;
+  /** Whether res allows to stop the portfolio. */
+  static bool isDefinitive(const api::Result& res)
+  {
+    return res.isSat() || res.isUnsat() || res.isEntailed()
+           || res.isNotEntailed();
+  }
+
+  /** The index of this worker in the portfolio. */
+  size_t d_id;
+  /** The index of the winning worker, or -1 if there is none (yet). */
+  std::atomic<int>& d_winner;
+  /** The shared cube-and-conquer state, null for a regular portfolio. */
+  ConquerState* d_conquer;
+  /** The options used to print terms for the other workers. */
+  Options d_printOptions;
+  /** Whether this worker was asked to stop. */
+  std::atomic<bool> d_stopped;
+  /** Protects d_executor against concurrent calls to stop(). */
+  std::mutex d_mutex;
+  /** The command executor of this worker, only set while running. */
+  std::unique_ptr<CommandExecutor> d_executor;
+  /** The buffered regular output. */
+  std::stringstream d_out;
+  /** The buffered error output. */
+  std::stringstream d_err;
+  /** Whether all commands were successful. */
+  bool d_status;
+};
+
+void PortfolioWorker::trySetOption(api::Solver* solver,
+                                   const std::string& name,
+                                   const std::string& value) const
+{
+  try
+  {
+    solver->setOption(name, value);
+  }
+  catch (const api::CVC5ApiException& e)
+  {
+    Trace("portfolio") << "worker " << d_id << " ignores " << name << "="
+                       << value << ": " << e.getMessage() << std::endl;
+  }
+}
+
+void PortfolioWorker::configure(const Options& opts, api::Solver* solver) const
+{
+  if (d_conquer != nullptr)
+  {
+    // Cubes are solved as assumptions, and all workers share the configuration
+    // of the user.
+    solver->setOption("incremental", "true");
+    solver->setOption("sat-export-size",
+                      std::to_string(opts.driver.cubeShareSize));
+    trySetOption(
+        solver, "random-seed", std::to_string(opts.prop.satRandomSeed + d_id));
+    return;
+  }
+  if (!opts.base.incrementalSolvingWasSetByUser)
+  {
+    solver->setOption("incremental", "false");
+  }
+  // The first worker runs the configuration of the user.
+  if (d_id == 0)
+  {
+    return;
+  }
+  trySetOption(
+      solver, "random-seed", std::to_string(opts.prop.satRandomSeed + d_id));
+  if (!opts.decision.decisionModeWasSetByUser)
+  {
+    trySetOption(
+        solver, "decision", (d_id & 1) ? "justification" : "internal");
+  }
+  if (!opts.smt.simplificationModeWasSetByUser)
+  {
+    trySetOption(solver, "simplification", (d_id & 2) ? "none" : "batch");
+  }
+  if (!opts.bv.bvSatSolverWasSetByUser)
+  {
+    trySetOption(solver, "bv-sat-solver", (d_id & 4) ? "cadical" : "minisat");
+  }
+}
+
+template <typename StopOthers>
+void PortfolioWorker::run(const Options& opts,
+                          const std::string& filename,
+                          const std::string* input,
+                          StopOthers stopOthers)
+{
+  Options wopts;
+  wopts.copyValues(opts);
+  wopts.base.out = &d_out;
+  wopts.base.err = &d_err;
+  d_out << language::SetLanguage(wopts.base.outputLanguage);
+  try
+  {
+    {
+      std::lock_guard<std::mutex> guard(d_mutex);
+      d_executor = std::make_unique<CommandExecutor>(wopts);
+    }
+    configure(opts, d_executor->getSolver());
+    d_executor->getSmtEngine()->notifyStartParsing(filename);
+
+    parser::ParserBuilder parserBuilder(
+        d_executor->getSolver(), d_executor->getSymbolManager(), wopts);
+    std::unique_ptr<parser::Parser> parser(parserBuilder.build());
+    if (input != nullptr)
+    {
+      parser->setInput(parser::Input::newStringInput(wopts.base.inputLanguage,
+                                                     *input,
+                                                     filename,
+                                                     wopts.parser.fastParser));
+    }
+    else
+    {
+      parser->setInput(parser::Input::newFileInput(wopts.base.inputLanguage,
+                                                   filename,
+                                                   wopts.parser.memoryMap,
+                                                   wopts.parser.fastParser));
+    }
+
+    bool status = true;
+    bool isWinner = false;
+    bool conquered = false;
+    // the commands after the first check-sat in cube-and-conquer mode
+    std::vector<std::unique_ptr<Command>> pending;
+    size_t nextPending = 0;
+    std::unique_ptr<Command> cmd;
+    while (status && (isWinner || !d_stopped.load()))
+    {
+      if (!conquered)
+      {
+        cmd.reset(parser->nextCommand());
+      }
+      else if (nextPending < pending.size())
+      {
+        cmd = std::move(pending[nextPending++]);
+      }
+      else
+      {
+        cmd.reset();
+      }
+      if (cmd == nullptr)
+      {
+        break;
+      }
+      if (d_conquer != nullptr && !conquered
+          && dynamic_cast<CheckSatCommand*>(cmd.get()) != nullptr)
+      {
+        conquered = true;
+        // Parse the remaining commands first, the parser is then used for the
+        // cubes and the shared clauses.
+        Command* next;
+        while ((next = parser->nextCommand()) != nullptr)
+        {
+          pending.emplace_back(next);
+        }
+        if (!conquer(wopts, parser.get()))
+        {
+          break;
+        }
+        // the winner executes the remaining commands, e.g. (get-model)
+        isWinner = true;
+        stopOthers(d_id);
+        continue;
+      }
+      status = d_executor->doCommand(cmd);
+      if (dynamic_cast<QuitCommand*>(cmd.get()) != nullptr)
+      {
+        break;
+      }
+      if (!isWinner && !conquered && isDefinitive(d_executor->getResult()))
+      {
+        if (!claimWin())
+        {
+          // some other worker was faster
+          break;
+        }
+        // the winner executes the remaining commands, e.g. (get-model)
+        isWinner = true;
+        stopOthers(d_id);
+      }
+    }
+    d_status = status;
+    d_executor->flushOutputStreams();
+  }
+  catch (const Exception& e)
+  {
+    d_err << "(error \"" << e << "\")" << std::endl;
+    d_status = false;
+  }
+  catch (const api::CVC5ApiException& e)
+  {
+    d_err << "(error \"" << e.getMessage() << "\")" << std::endl;
+    d_status = false;
+  }
+  if (d_conquer != nullptr && d_id == 0)
+  {
+    // do not leave the other workers waiting for cubes
+    d_conquer->abort();
+  }
+  std::lock_guard<std::mutex> guard(d_mutex);
+  d_executor.reset();
+}
+
+api::Term PortfolioWorker::parseTerm(const Options& opts,
+                                     parser::Parser* parser,
+                                     const std::string& s) const
+{
+  try
+  {
+    parser->setInput(parser::Input::newStringInput(
+        opts.base.inputLanguage, s, "<shared>", opts.parser.fastParser));
+    return parser->nextExpression();
+  }
+  catch (const parser::ParserException& e)
+  {
+    Trace("portfolio") << "worker " << d_id << " cannot parse " << s << ": "
+                       << e.getMessage() << std::endl;
+  }
+  catch (const api::CVC5ApiException& e)
+  {
+    Trace("portfolio") << "worker " << d_id << " cannot parse " << s << ": "
+                       << e.getMessage() << std::endl;
+  }
+  return api::Term();
+}
+
+std::string PortfolioWorker::printTerm(const api::Term& t) const
+{
+  // printing uses the output language of the current options
+  Options::OptionsScope scope(const_cast<Options*>(&d_printOptions));
+  return t.toString();
+}
+
+bool PortfolioWorker::conquer(const Options& opts, parser::Parser* parser)
+{
+  api::Solver* solver = d_executor->getSolver();
+  d_printOptions.copyValues(opts);
+  d_printOptions.base.outputLanguage = language::output::LANG_SMTLIB_V2_6;
+  if (d_id == 0)
+  {
+    std::vector<std::vector<std::string>> cubes;
+    for (const std::vector<api::Term>& cube :
+         solver->getCubes(opts.driver.cubeDepth))
+    {
+      cubes.emplace_back();
+      for (const api::Term& lit : cube)
+      {
+        cubes.back().push_back(printTerm(lit));
+      }
+    }
+    Trace("portfolio") << "cube-and-conquer with " << cubes.size() << " cubes"
+                       << std::endl;
+    if (cubes.empty())
+    {
+      // the cuber refuted the input
+      d_conquer->setCubes({});
+      if (!claimWin())
+      {
+        return false;
+      }
+      d_out << "unsat" << std::endl;
+      return true;
+    }
+    d_conquer->setCubes(std::move(cubes));
+  }
+  else if (!d_conquer->waitForCubes(d_stopped))
+  {
+    return false;
+  }
+
+  size_t clauseIndex = 0;
+  std::vector<std::string> cube;
+  while (!d_stopped.load() && d_conquer->nextCube(cube))
+  {
+    // Every cube that was taken must be finished, otherwise the other workers
+    // never learn that all cubes are done. Hence all failures below leave the
+    // cube unsolved, which makes the overall result unknown.
+    api::Result res;
+    try
+    {
+      // assert the clauses learned by the other workers
+      std::vector<std::string> clauses;
+      d_conquer->getClauses(d_id, clauseIndex, clauses);
+      for (const std::string& c : clauses)
+      {
+        api::Term t = parseTerm(opts, parser, c);
+        if (!t.isNull())
+        {
+          solver->assertFormula(t);
+        }
+      }
+      // literals that cannot be parsed are dropped, which weakens the cube
+      std::vector<api::Term> assumptions;
+      for (const std::string& lit : cube)
+      {
+        api::Term t = parseTerm(opts, parser, lit);
+        if (!t.isNull())
+        {
+          assumptions.push_back(t);
+        }
+      }
+      res = assumptions.empty() ? solver->checkSat()
+                                : solver->checkSatAssuming(assumptions);
+    }
+    catch (const Exception& e)
+    {
+      Trace("portfolio") << "worker " << d_id << " fails on a cube: " << e
+                         << std::endl;
+    }
+    catch (const api::CVC5ApiException& e)
+    {
+      Trace("portfolio") << "worker " << d_id
+                         << " fails on a cube: " << e.getMessage() << std::endl;
+    }
+    catch (const std::bad_alloc& e)
+    {
+      Trace("portfolio") << "worker " << d_id
+                         << " fails on a cube: out of memory" << std::endl;
+    }
+    Trace("portfolio") << "worker " << d_id << " solved a cube: " << res
+                       << std::endl;
+    if (d_stopped.load())
+    {
+      // some other worker won, but the cube is closed nevertheless
+      d_conquer->finishCube(ConquerState::Status::UNKNOWN);
+      return false;
+    }
+    ConquerState::Status status = ConquerState::Status::UNKNOWN;
+    if (res.isSat())
+    {
+      status = ConquerState::Status::SAT;
+    }
+    else if (res.isUnsat())
+    {
+      status = ConquerState::Status::UNSAT;
+    }
+    ConquerState::Status overall = d_conquer->finishCube(status);
+    if (overall != ConquerState::Status::OPEN)
+    {
+      if (!claimWin())
+      {
+        return false;
+      }
+      if (overall == ConquerState::Status::UNKNOWN)
+      {
+        d_out << "unknown" << std::endl;
+      }
+      else
+      {
+        d_out << res << std::endl;
+      }
+      return true;
+    }
+    if (opts.driver.cubeShareSize > 0)
+    {
+      std::vector<std::string> learned;
+      for (const api::Term& c : solver->getLearnedClauses())
+      {
+        learned.push_back(printTerm(c));
+      }
+      d_conquer->shareClauses(d_id, learned);
+    }
+  }
+  return false;
+}
+
+/** What a scan of an SMT-LIB input found out about its commands. */
+struct InputSummary
+{
+  /** The number of check-sat, check-sat-assuming and check-synth commands */
+  size_t d_queries = 0;
+  /** Whether there is a push, pop, reset or reset-assertions command */
+  bool d_incremental = false;
+  /** The argument of set-logic, if any */
+  std::string d_logic;
+};
+
+/**
+ * Scans the SMT-LIB or SyGuS input in [it, end) for the names of its top-level
+ * commands, without parsing the input. Comments, string literals and quoted
+ * symbols are skipped. Stops as soon as the input is known not to be solvable
+ * in parallel, or at an exit command.
+ */
+template <class Iterator>
+void scanSmt2Input(Iterator it, Iterator end, InputSummary& summary)
+{
+  auto isDelimiter = [](char c) {
+    return std::isspace(static_cast<unsigned char>(c)) || c == '('
+           || c == ')' || c == '"' || c == '|' || c == ';';
+  };
+  size_t depth = 0;
+  // whether the next symbol is the name of a top-level command
+  bool command = false;
+  // whether the next symbol is the argument of set-logic
+  bool logic = false;
+  while (it != end && !summary.d_incremental && summary.d_queries <= 1)
+  {
+    char c = *it;
+    ++it;
+    if (std::isspace(static_cast<unsigned char>(c)))
+    {
+      continue;
+    }
+    std::string symbol;
+    switch (c)
+    {
+      case ';':
+        while (it != end && *it != '\n')
+        {
+          ++it;
+        }
+        continue;
+      case '(':
+        command = depth == 0;
+        logic = false;
+        ++depth;
+        continue;
+      case ')':
+        depth = depth > 0 ? depth - 1 : 0;
+        command = logic = false;
+        continue;
+      case '"':
+        // "" is an escaped quote within a string literal
+        while (it != end)
+        {
+          char d = *it;
+          ++it;
+          if (d == '"')
+          {
+            if (it == end || *it != '"')
+            {
+              break;
+            }
+            ++it;
+          }
+        }
+        command = logic = false;
+        continue;
+      case '|':
+        for (; it != end && *it != '|'; ++it)
+        {
+          symbol.push_back(*it);
+        }
+        if (it != end)
+        {
+          ++it;
+        }
+        break;
+      default:
+        symbol.push_back(c);
+        for (; it != end && !isDelimiter(*it); ++it)
+        {
+          symbol.push_back(*it);
+        }
+        break;
+    }
+    if (logic)
+    {
+      summary.d_logic = symbol;
+    }
+    logic = command && symbol == "set-logic";
+    if (command)
+    {
+      if (symbol == "check-sat" || symbol == "check-sat-assuming"
+          || symbol == "check-synth")
+      {
+        ++summary.d_queries;
+      }
+      else if (symbol == "push" || symbol == "pop" || symbol == "reset"
+               || symbol == "reset-assertions")
+      {
+        summary.d_incremental = true;
+      }
+      else if (symbol == "exit")
+      {
+        return;
+      }
+    }
+    command = false;
+  }
+}
+
+/**
+ * Checks whether the workers can solve the input in parallel. This is not
+ * the case if the input makes more than one query or uses push and pop,
+ * since the workers solve it non-incrementally. It is neither the case if its
+ * logic includes nonlinear arithmetic and cvc5 is built with libpoly, whose
+ * global state must not be shared between threads. The input is only scanned
+ * for the names of its commands, which requires SMT-LIB or SyGuS input.
+ * Otherwise, reason is set to why the input is not solved in parallel.
+ */
+bool isParallelInput(const Options& opts,
+                     const std::string& filename,
+                     const std::string* input,
+                     std::string& reason)
+{
+  if (!language::isInputLang_smt2(opts.base.inputLanguage)
+      && !language::isInputLangSygus(opts.base.inputLanguage))
+  {
+    reason = "the input is not in SMT-LIB or SyGuS format";
+    return false;
+  }
+  InputSummary summary;
+  if (input != nullptr)
+  {
+    scanSmt2Input(input->begin(), input->end(), summary);
+  }
+  else
+  {
+    std::ifstream in(filename);
+    if (!in)
+    {
+      // left to the worker, which reports the error
+      reason = "the input cannot be read";
+      return false;
+    }
+    scanSmt2Input(std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>(),
+                  summary);
+  }
+  if (summary.d_incremental || summary.d_queries > 1)
+  {
+    reason = "the input is incremental";
+    return false;
+  }
+  if (Configuration::isBuiltWithPoly())
+  {
+    std::string logic = opts.parser.forceLogicString.empty()
+                            ? summary.d_logic
+                            : opts.parser.forceLogicString;
+    try
+    {
+      // without a logic, all theories are enabled
+      LogicInfo info(logic.empty() ? "ALL" : logic);
+      if (info.isTheoryEnabled(theory::THEORY_ARITH) && !info.isLinear())
+      {
+        reason = "nonlinear arithmetic is not thread-safe with libpoly";
+        return false;
+      }
+    }
+    catch (const Exception& e)
+    {
+      // left to the worker, which reports the error
+      reason = "the logic is invalid";
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool usePortfolio(const Options& opts)
+{
+  return opts.driver.portfolioJobs > 1 && !opts.driver.interactive
+         && !(opts.base.incrementalSolvingWasSetByUser
+              && opts.base.incrementalSolving);
+}
+
+int runPortfolio(const Options& opts,
+                 const std::string& filename,
+                 bool inputFromStdin)
+{
+  // Standard input can only be read once, hence all workers parse a copy.
+  std::unique_ptr<std::string> input;
+  if (inputFromStdin)
+  {
+    input = std::make_unique<std::string>(
+        std::istreambuf_iterator<char>(std::cin),
+        std::istreambuf_iterator<char>());
+  }
+
+  // Otherwise, the input is solved sequentially by a single worker with the
+  // configuration of the user.
+  size_t jobs = 1;
+  std::string reason;
+  if (isParallelInput(opts, filename, input.get(), reason))
+  {
+    jobs = opts.driver.portfolioJobs;
+  }
+  else
+  {
+    Warning() << "--portfolio-jobs"
+              << (opts.driver.cubeDepth > 0 ? " and --cube-depth are" : " is")
+              << " ignored since " << reason << std::endl;
+  }
+  Trace("portfolio") << "portfolio with " << jobs << " workers" << std::endl;
+
+  // Cubes and clauses are exchanged as SMT-LIB terms.
+  std::unique_ptr<ConquerState> conquer;
+  if (jobs > 1 && opts.driver.cubeDepth > 0)
+  {
+    if (language::isInputLang_smt2(opts.base.inputLanguage))
+    {
+      conquer = std::make_unique<ConquerState>();
+    }
+    else
+    {
+      Warning() << "--cube-depth is ignored since the input is not in SMT-LIB "
+                   "format"
+                << std::endl;
+    }
+  }
+
+  std::atomic<int> winner(-1);
+  std::vector<std::unique_ptr<PortfolioWorker>> workers;
+  for (size_t i = 0; i < jobs; ++i)
+  {
+    workers.emplace_back(
+        std::make_unique<PortfolioWorker>(i, winner, conquer.get()));
+  }
+  auto stopOthers = [&workers, &conquer](size_t id) {
+    for (size_t i = 0, n = workers.size(); i < n; ++i)
+    {
+      if (i != id)
+      {
+        workers[i]->stop();
+      }
+    }
+    if (conquer != nullptr)
+    {
+      conquer->wakeUp();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::unique_ptr<PortfolioWorker>& w : workers)
+  {
+    PortfolioWorker* worker = w.get();
+    threads.emplace_back([worker, &opts, &filename, &input, &stopOthers]() {
+      worker->run(opts, filename, input.get(), stopOthers);
+    });
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+
+  int w = winner.load();
+  const PortfolioWorker& reported = *workers[w < 0 ? 0 : w];
+  Trace("portfolio") << "portfolio winner: " << w << std::endl;
+  reported.flush(*opts.base.out, *opts.base.err);
+  return reported.getStatus() ? 0 : 1;
+}
+
+}  // namespace main
+}  // namespace cvc5
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Parallel portfolio solving in the driver.
+ */
+
+#ifndef CVC5__MAIN__PORTFOLIO_H
+#define CVC5__MAIN__PORTFOLIO_H
+
+#include <string>
+
+#include "options/options.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * Checks whether the input should be solved by runPortfolio(), i.e., whether
+ * more than one portfolio job was requested and the input is neither
+ * interactive nor incremental.
+ */
+bool usePortfolio(const Options& opts);
+
+/**
+ * Solves a non-incremental input with a portfolio of differently configured
+ * solvers. Each of the opts.driver.portfolioJobs workers runs in its own
+ * thread with its own api::Solver (and thus its own NodeManager), parses the
+ * input independently and executes all commands on it. Worker i > 0 varies
+ * the random seed, the decision mode, the simplification mode and the SAT
+ * solver used for bit-blasting, unless they were set by the user.
+ *
+ * The first worker that obtains a definitive result (sat or unsat) wins: all
+ * other workers are interrupted via api::Solver::interrupt() and the
+ * (buffered) output of the winner is written to the output streams of opts.
+ * If no worker obtains a definitive result, the output of the first worker
+ * is used.
+ *
+ * Before the workers are started, the input is scanned for the names of its
+ * commands (without parsing it). If it makes more than one query, uses push
+ * or pop, is neither in SMT-LIB nor SyGuS format, or has a logic with
+ * nonlinear arithmetic while cvc5 is built with libpoly (which is not
+ * thread-safe), it is solved by a single worker with the configuration of the
+ * user instead, and a warning is issued.
+ *
+ * If opts.driver.cubeDepth is positive and the input is in SMT-LIB format,
+ * the workers instead cooperate on the first check-sat command
+ * (cube-and-conquer): the first worker splits the search space into cubes by
+ * lookahead (see api::Solver::getCubes()), and all workers solve these cubes
+ * as assumptions in incremental mode. Learned clauses of at most
+ * opts.driver.cubeShareSize literals are shared between the workers. The
+ * input is sat if some cube is sat, and unsat if all cubes are unsat.
+ *
+ * @param opts the options given on the command line
+ * @param filename the name of the input file, or "<stdin>"
+ * @param inputFromStdin whether the input is read from standard input
+ * @return the exit code of the driver
+ */
+int runPortfolio(const Options& opts,
+                 const std::string& filename,
+                 bool inputFromStdin);
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC5__MAIN__PORTFOLIO_H */
@@ -21,6 +21,7 @@
 #include "base/output.h"
 #include "parser/parser.h"
 #include "parser/parser_exception.h"
+#include "parser/smt2/smt2_fast_input.h"
 
 
 using namespace std;
@@ -53,8 +54,13 @@ InputStream *Input::getInputStream() {
 
 Input* Input::newFileInput(InputLanguage lang,
                            const std::string& filename,
-                           bool useMmap)
+                           bool useMmap,
+                           bool fastParser)
 {
+  if (fastParser && lang == language::input::LANG_SMTLIB_V2_6)
+  {
+    return Smt2FastInput::newFileInput(filename, useMmap);
+  }
   AntlrInputStream *inputStream = 
     AntlrInputStream::newFileInputStream(filename, useMmap);
   return AntlrInput::newInput(lang, *inputStream);
@@ -62,8 +68,13 @@ Input* Input::newFileInput(InputLanguage lang,
 
 Input* Input::newStreamInput(InputLanguage lang,
                              std::istream& input,
-                             const std::string& name)
+                             const std::string& name,
+                             bool fastParser)
 {
+  if (fastParser && lang == language::input::LANG_SMTLIB_V2_6)
+  {
+    return Smt2FastInput::newStreamInput(input, name);
+  }
   AntlrInputStream* inputStream =
       AntlrInputStream::newStreamInputStream(input, name);
   return AntlrInput::newInput(lang, *inputStream);
@@ -71,8 +82,13 @@ Input* Input::newStreamInput(InputLanguage lang,
 
 Input* Input::newStringInput(InputLanguage lang,
                              const std::string& str,
-                             const std::string& name)
+                             const std::string& name,
+                             bool fastParser)
 {
+  if (fastParser && lang == language::input::LANG_SMTLIB_V2_6)
+  {
+    return Smt2FastInput::newStringInput(str, name);
+  }
   AntlrInputStream *inputStream = AntlrInputStream::newStringInputStream(str, name);
   return AntlrInput::newInput(lang, *inputStream);
 }
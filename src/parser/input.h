@@ -99,10 +99,13 @@ class CVC5_EXPORT Input
     * @param lang the input language
     * @param filename the input filename
     * @param useMmap true if the parser should use memory-mapped I/O (default: false)
+    * @param fastParser true if SMT-LIB 2.6 input should be parsed by the
+    * hand-written streaming parser instead of the ANTLR-based one
     */
   static Input* newFileInput(InputLanguage lang,
                              const std::string& filename,
-                             bool useMmap = false);
+                             bool useMmap = false,
+                             bool fastParser = false);
 
   /** Create an input for the given stream.
    *
@@ -112,20 +115,26 @@ class CVC5_EXPORT Input
    * @param lineBuffered whether this Input should be line-buffered
    * (false, the default, means that the entire Input might be read
    * before being lexed and parsed)
+   * @param fastParser true if SMT-LIB 2.6 input should be parsed by the
+   * hand-written streaming parser instead of the ANTLR-based one
    */
   static Input* newStreamInput(InputLanguage lang,
                                std::istream& input,
-                               const std::string& name);
+                               const std::string& name,
+                               bool fastParser = false);
 
   /** Create an input for the given string
    *
    * @param lang the input language
    * @param input the input string
    * @param name the name of the stream, for use in error messages
+   * @param fastParser true if SMT-LIB 2.6 input should be parsed by the
+   * hand-written streaming parser instead of the ANTLR-based one
    */
   static Input* newStringInput(InputLanguage lang,
                                const std::string& input,
-                               const std::string& name);
+                               const std::string& name,
+                               bool fastParser = false);
 
   /** Destructor. Frees the input stream and closes the input. */
   virtual ~Input();
@@ -0,0 +1,1498 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A streaming SMT-LIB version 2 input that does not use ANTLR.
+ */
+
+#include "parser/smt2/smt2_fast_input.h"
+
+#include <cctype>
+#include <sstream>
+#include <unordered_set>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/symbol_manager.h"
+#include "parser/parser_exception.h"
+#include "parser/smt2/smt2.h"
+#include "smt/command.h"
+#include "util/floatingpoint_size.h"
+
+namespace cvc5 {
+namespace parser {
+
+Smt2FastInput::Smt2FastInput(Smt2FastInputStream& inputStream)
+    : Input(inputStream), d_state(nullptr)
+{
+}
+
+Smt2FastInput::~Smt2FastInput() {}
+
+Smt2FastInput* Smt2FastInput::newFileInput(const std::string& filename,
+                                           bool useMmap)
+{
+  Smt2FastInput* input =
+      new Smt2FastInput(*new Smt2FastInputStream(filename));
+  if (!input->d_lex.initFile(filename, useMmap))
+  {
+    delete input;
+    throw InputStreamException("Couldn't open file: " + filename);
+  }
+  return input;
+}
+
+Smt2FastInput* Smt2FastInput::newStreamInput(std::istream& input,
+                                             const std::string& name)
+{
+  Smt2FastInput* in = new Smt2FastInput(*new Smt2FastInputStream(name));
+  in->d_lex.initStream(input);
+  return in;
+}
+
+Smt2FastInput* Smt2FastInput::newStringInput(const std::string& input,
+                                             const std::string& name)
+{
+  Smt2FastInput* in = new Smt2FastInput(*new Smt2FastInputStream(name));
+  in->d_lex.initString(input);
+  return in;
+}
+
+void Smt2FastInput::setParser(Parser& parser)
+{
+  d_state = dynamic_cast<Smt2*>(&parser);
+  if (d_state == nullptr)
+  {
+    throw ParserException(
+        "The fast SMT-LIB parser requires an SMT-LIB parser state.");
+  }
+}
+
+void Smt2FastInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ':' << d_lex.getLine() << '.'
+            << d_lex.getColumn() << ": " << msg << std::endl;
+}
+
+void Smt2FastInput::parseError(const std::string& msg, bool eofException)
+{
+  std::stringstream ss;
+  ss << msg << std::endl
+     << std::endl
+     << "  " << d_lex.getLineText() << std::endl
+     << "  " << std::string(d_lex.getColumn(), ' ') << '^' << std::endl;
+  Debug("parser") << "Throwing exception: " << getInputStream()->getName()
+                  << ":" << d_lex.getLine() << "." << d_lex.getColumn()
+                  << ": " << ss.str() << std::endl;
+  if (eofException)
+  {
+    throw ParserEndOfFileException(
+        msg, getInputStream()->getName(), d_lex.getLine(), d_lex.getColumn());
+  }
+  throw ParserException(
+      ss.str(), getInputStream()->getName(), d_lex.getLine(), d_lex.getColumn());
+}
+
+void Smt2FastInput::unsupported(const std::string& what)
+{
+  parseError(what
+             + " is not supported by the fast SMT-LIB parser, use the default "
+               "parser instead (--no-fast-parser)");
+}
+
+/* -------------------------------------------------------------------------- */
+/* Tokens                                                                     */
+/* -------------------------------------------------------------------------- */
+
+Smt2Token Smt2FastInput::peek()
+{
+  d_lex.setEscapeDupDblQuote(d_state->escapeDupDblQuote());
+  Smt2Token t = d_lex.peekToken();
+  if (t == Smt2Token::UNTERMINATED)
+  {
+    d_state->unexpectedEOF("unterminated string literal or |quoted| symbol");
+  }
+  else if (t == Smt2Token::INVALID)
+  {
+    parseError("unexpected character `" + std::string(d_lex.tokenText())
+               + "'");
+  }
+  return t;
+}
+
+void Smt2FastInput::expect(Smt2Token t)
+{
+  Smt2Token got = peek();
+  if (got != t)
+  {
+    std::stringstream ss;
+    ss << "expected " << t << ", got " << got;
+    if (got != Smt2Token::EOF_TOK)
+    {
+      ss << " `" << d_lex.tokenText() << "'";
+    }
+    if (got == Smt2Token::EOF_TOK)
+    {
+      d_state->unexpectedEOF(ss.str());
+    }
+    parseError(ss.str());
+  }
+  d_lex.consumeToken();
+}
+
+bool Smt2FastInput::peekWord(const char* word)
+{
+  return peek() == Smt2Token::SYMBOL && d_lex.tokenText() == word;
+}
+
+bool Smt2FastInput::tryWord(const char* word)
+{
+  if (peekWord(word))
+  {
+    d_lex.consumeToken();
+    return true;
+  }
+  return false;
+}
+
+std::string Smt2FastInput::parseSymbol(DeclarationCheck check,
+                                       SymbolType type)
+{
+  Smt2Token t = peek();
+  if (t != Smt2Token::SYMBOL && t != Smt2Token::QUOTED_SYMBOL)
+  {
+    expect(Smt2Token::SYMBOL);
+  }
+  std::string id(d_lex.tokenText());
+  if (t == Smt2Token::SYMBOL && (id == "_" || id == "!"))
+  {
+    parseError("unexpected reserved word `" + id + "'");
+  }
+  d_lex.consumeToken();
+  if (!d_state->isAbstractValue(id))
+  {
+    // if an abstract value, SmtEngine handles declaration
+    d_state->checkDeclaration(id, check, type);
+  }
+  return id;
+}
+
+uint64_t Smt2FastInput::parseNumeral()
+{
+  if (peek() != Smt2Token::NUMERAL)
+  {
+    expect(Smt2Token::NUMERAL);
+  }
+  std::string_view text = d_lex.tokenText();
+  if (d_state->strictModeEnabled() && text.size() > 1 && text[0] == '0')
+  {
+    parseError("numerals with leading zeroes are not permitted in strict "
+               "compliance mode");
+  }
+  uint64_t n = 0;
+  for (char c : text)
+  {
+    uint64_t next = n * 10 + (c - '0');
+    if (next / 10 != n)
+    {
+      parseError("numeral `" + std::string(text) + "' is too large");
+    }
+    n = next;
+  }
+  d_lex.consumeToken();
+  return n;
+}
+
+std::vector<uint64_t> Smt2FastInput::parseNumeralList()
+{
+  std::vector<uint64_t> numerals;
+  do
+  {
+    numerals.push_back(parseNumeral());
+  } while (peek() != Smt2Token::RPAREN_TOK);
+  return numerals;
+}
+
+std::string Smt2FastInput::parseKeyword()
+{
+  if (peek() != Smt2Token::KEYWORD)
+  {
+    expect(Smt2Token::KEYWORD);
+  }
+  std::string kw(d_lex.tokenText());
+  d_lex.consumeToken();
+  return kw;
+}
+
+std::string Smt2FastInput::parseString(bool fsmtlib)
+{
+  if (peek() != Smt2Token::STRING)
+  {
+    expect(Smt2Token::STRING);
+  }
+  std::string_view text = d_lex.tokenText();
+  std::string s;
+  s.reserve(text.size());
+  bool dupDblQuote = d_state->escapeDupDblQuote();
+  for (size_t i = 0, size = text.size(); i < size; ++i)
+  {
+    char c = text[i];
+    if ((unsigned char)c > 127 && !isprint(c))
+    {
+      parseError(
+          "Extended/unprintable characters are not part of SMT-LIB, and they "
+          "must be encoded as escape sequences");
+    }
+    if (fsmtlib || dupDblQuote)
+    {
+      if (dupDblQuote && c == '"')
+      {
+        // Handle SMT-LIB >=2.5 standard escape '""'.
+        Assert(i + 1 < size && text[i + 1] == '"');
+        ++i;
+      }
+      else if (!dupDblQuote && c == '\\' && i + 1 < size)
+      {
+        // Handle SMT-LIB 2.0 standard escapes '\\' and '\"'.
+        ++i;
+        if (text[i] != '\\' && text[i] != '"')
+        {
+          s.push_back('\\');
+        }
+        c = text[i];
+      }
+    }
+    s.push_back(c);
+  }
+  d_lex.consumeToken();
+  return s;
+}
+
+std::string Smt2FastInput::parseSimpleSymbolicExpr()
+{
+  switch (peek())
+  {
+    case Smt2Token::NUMERAL:
+    case Smt2Token::DECIMAL:
+    case Smt2Token::HEX:
+    case Smt2Token::BINARY:
+    case Smt2Token::SYMBOL:
+    {
+      std::string s(d_lex.tokenText());
+      d_lex.consumeToken();
+      return s;
+    }
+    case Smt2Token::QUOTED_SYMBOL: return parseSymbol(CHECK_NONE, SYM_SORT);
+    case Smt2Token::STRING: return parseString(false);
+    default: expect(Smt2Token::SYMBOL);
+  }
+  return "";
+}
+
+api::Term Smt2FastInput::parseSymbolicExpr()
+{
+  api::Solver* solver = d_state->getSolver();
+  if (peek() == Smt2Token::LPAREN_TOK)
+  {
+    d_lex.consumeToken();
+    std::vector<api::Term> children;
+    while (peek() != Smt2Token::RPAREN_TOK)
+    {
+      children.push_back(parseSymbolicExpr());
+    }
+    d_lex.consumeToken();
+    return solver->mkTerm(api::SEXPR, children);
+  }
+  std::string s = peek() == Smt2Token::KEYWORD ? parseKeyword()
+                                                : parseSimpleSymbolicExpr();
+  return solver->mkString(d_state->processAdHocStringEsc(s));
+}
+
+/* -------------------------------------------------------------------------- */
+/* Sorts                                                                      */
+/* -------------------------------------------------------------------------- */
+
+api::Sort Smt2FastInput::parseSort(DeclarationCheck check)
+{
+  api::Solver* solver = d_state->getSolver();
+  if (peek() != Smt2Token::LPAREN_TOK)
+  {
+    std::string name = parseSymbol(CHECK_NONE, SYM_SORT);
+    if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+    {
+      return d_state->getSort(name);
+    }
+    return d_state->mkUnresolvedType(name);
+  }
+  d_lex.consumeToken();
+  api::Sort t;
+  if (d_state->isHoEnabled() && tryWord("->"))
+  {
+    std::vector<api::Sort> args = parseSortList();
+    if (args.size() < 2)
+    {
+      parseError("Arrow types must have at least 2 arguments");
+    }
+    // flatten the type
+    api::Sort rangeType = args.back();
+    args.pop_back();
+    t = d_state->mkFlatFunctionType(args, rangeType);
+  }
+  else if (tryWord("_"))
+  {
+    std::string name = parseSymbol(CHECK_NONE, SYM_SORT);
+    if (peek() != Smt2Token::NUMERAL)
+    {
+      std::stringstream ss;
+      ss << "Unexpected use of indexing operator `_' before `" << name
+         << "', try leaving it out";
+      parseError(ss.str());
+    }
+    std::vector<uint64_t> numerals = parseNumeralList();
+    if (name == "BitVec")
+    {
+      if (numerals.size() != 1)
+      {
+        parseError("Illegal bitvector type.");
+      }
+      if (numerals.front() == 0)
+      {
+        parseError("Illegal bitvector size: 0");
+      }
+      t = solver->mkBitVectorSort(numerals.front());
+    }
+    else if (name == "FloatingPoint")
+    {
+      if (numerals.size() != 2)
+      {
+        parseError("Illegal floating-point type.");
+      }
+      if (!validExponentSize(numerals[0]))
+      {
+        parseError("Illegal floating-point exponent size");
+      }
+      if (!validSignificandSize(numerals[1]))
+      {
+        parseError("Illegal floating-point significand size");
+      }
+      t = solver->mkFloatingPointSort(numerals[0], numerals[1]);
+    }
+    else
+    {
+      std::stringstream ss;
+      ss << "unknown indexed sort symbol `" << name << "'";
+      parseError(ss.str());
+    }
+  }
+  else
+  {
+    std::string name = parseSymbol(CHECK_NONE, SYM_SORT);
+    if (peek() == Smt2Token::NUMERAL)
+    {
+      std::stringstream ss;
+      ss << "SMT-LIB requires use of an indexed sort here, e.g. (_ " << name
+         << " ...)";
+      parseError(ss.str());
+    }
+    std::vector<api::Sort> args = parseSortList();
+    if (args.empty())
+    {
+      parseError(
+          "Extra parentheses around sort name not permitted in SMT-LIB");
+    }
+    else if (name == "Array"
+             && d_state->isTheoryEnabled(theory::THEORY_ARRAYS))
+    {
+      if (args.size() != 2)
+      {
+        parseError("Illegal array type.");
+      }
+      t = solver->mkArraySort(args[0], args[1]);
+    }
+    else if (name == "Set" && d_state->isTheoryEnabled(theory::THEORY_SETS))
+    {
+      if (args.size() != 1)
+      {
+        parseError("Illegal set type.");
+      }
+      t = solver->mkSetSort(args[0]);
+    }
+    else if (name == "Bag" && d_state->isTheoryEnabled(theory::THEORY_BAGS))
+    {
+      if (args.size() != 1)
+      {
+        parseError("Illegal bag type.");
+      }
+      t = solver->mkBagSort(args[0]);
+    }
+    else if (name == "Seq" && !d_state->strictModeEnabled()
+             && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+    {
+      if (args.size() != 1)
+      {
+        parseError("Illegal sequence type.");
+      }
+      t = solver->mkSequenceSort(args[0]);
+    }
+    else if (name == "Tuple" && !d_state->strictModeEnabled())
+    {
+      t = solver->mkTupleSort(args);
+    }
+    else if (check == CHECK_DECLARED || d_state->isDeclared(name, SYM_SORT))
+    {
+      t = d_state->getSort(name, args);
+    }
+    else
+    {
+      // make unresolved type
+      t = d_state->mkUnresolvedTypeConstructor(name, args);
+      t = t.instantiate(args);
+    }
+  }
+  expect(Smt2Token::RPAREN_TOK);
+  return t;
+}
+
+std::vector<api::Sort> Smt2FastInput::parseSortList()
+{
+  std::vector<api::Sort> sorts;
+  while (peek() != Smt2Token::RPAREN_TOK)
+  {
+    sorts.push_back(parseSort());
+  }
+  return sorts;
+}
+
+std::vector<std::pair<std::string, api::Sort>>
+Smt2FastInput::parseSortedVarList()
+{
+  std::vector<std::pair<std::string, api::Sort>> sortedVars;
+  expect(Smt2Token::LPAREN_TOK);
+  while (peek() != Smt2Token::RPAREN_TOK)
+  {
+    expect(Smt2Token::LPAREN_TOK);
+    std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    api::Sort t = parseSort();
+    expect(Smt2Token::RPAREN_TOK);
+    sortedVars.emplace_back(name, t);
+  }
+  d_lex.consumeToken();
+  return sortedVars;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Terms                                                                      */
+/* -------------------------------------------------------------------------- */
+
+api::Term Smt2FastInput::parseTerm()
+{
+  api::Term expr2;
+  return parseTerm(expr2);
+}
+
+std::vector<api::Term> Smt2FastInput::parseTermList()
+{
+  std::vector<api::Term> terms;
+  do
+  {
+    terms.push_back(parseTerm());
+  } while (peek() != Smt2Token::RPAREN_TOK);
+  return terms;
+}
+
+std::vector<api::Term> Smt2FastInput::parseParenTermList(const char* cmd)
+{
+  if (peek() != Smt2Token::LPAREN_TOK)
+  {
+    std::stringstream ss;
+    ss << "The " << cmd
+       << " command expects a list of terms.  Perhaps you forgot a pair of "
+          "parentheses?";
+    parseError(ss.str());
+  }
+  d_lex.consumeToken();
+  std::vector<api::Term> terms = parseTermList();
+  expect(Smt2Token::RPAREN_TOK);
+  return terms;
+}
+
+api::Term Smt2FastInput::parseTerm(api::Term& expr2)
+{
+  api::Solver* solver = d_state->getSolver();
+  switch (peek())
+  {
+    case Smt2Token::NUMERAL:
+    {
+      std::string str(d_lex.tokenText());
+      if (d_state->strictModeEnabled() && str.size() > 1 && str[0] == '0')
+      {
+        parseError("numerals with leading zeroes are not permitted in strict "
+                   "compliance mode");
+      }
+      d_lex.consumeToken();
+      return solver->mkInteger(str);
+    }
+    case Smt2Token::DECIMAL:
+    {
+      std::string str(d_lex.tokenText());
+      d_lex.consumeToken();
+      return solver->ensureTermSort(solver->mkReal(str),
+                                    solver->getRealSort());
+    }
+    case Smt2Token::HEX:
+    {
+      std::string str(d_lex.tokenText().substr(2));
+      d_lex.consumeToken();
+      return solver->mkBitVector(str, 16);
+    }
+    case Smt2Token::BINARY:
+    {
+      std::string str(d_lex.tokenText().substr(2));
+      d_lex.consumeToken();
+      return solver->mkBitVector(str, 2);
+    }
+    case Smt2Token::STRING:
+      return d_state->mkStringConstant(parseString(false));
+    case Smt2Token::SYMBOL:
+    case Smt2Token::QUOTED_SYMBOL:
+    {
+      if (peekWord("mkTuple")
+          && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+      {
+        d_lex.consumeToken();
+        return solver->mkTuple(std::vector<api::Sort>(),
+                               std::vector<api::Term>());
+      }
+      ParseOp p;
+      p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+      return d_state->parseOpToExpr(p);
+    }
+    case Smt2Token::LPAREN_TOK: break;
+    default: expect(Smt2Token::LPAREN_TOK);
+  }
+  d_lex.consumeToken();
+  api::Term expr;
+  ParseOp p;
+  if (peek() == Smt2Token::LPAREN_TOK)
+  {
+    // an application with a parenthesized head, e.g. ((_ extract 1 0) x)
+    d_lex.consumeToken();
+    parseParenQualIdentifier(p);
+  }
+  else if (peek() != Smt2Token::SYMBOL)
+  {
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+  }
+  else if (tryWord("let"))
+  {
+    return parseLet();
+  }
+  else if (tryWord("forall"))
+  {
+    return parseQuantifier(api::FORALL);
+  }
+  else if (tryWord("exists"))
+  {
+    return parseQuantifier(api::EXISTS);
+  }
+  else if (tryWord("!"))
+  {
+    api::Term f2;
+    expr = parseTerm(f2);
+    std::vector<api::Term> patexprs;
+    do
+    {
+      api::Term attexpr = parseAttribute(expr);
+      if (!attexpr.isNull())
+      {
+        patexprs.push_back(attexpr);
+      }
+    } while (peek() != Smt2Token::RPAREN_TOK);
+    d_lex.consumeToken();
+    if (!patexprs.empty())
+    {
+      if (!f2.isNull() && f2.getKind() == api::INST_PATTERN_LIST)
+      {
+        for (size_t i = 0; i < f2.getNumChildren(); i++)
+        {
+          patexprs.push_back(f2[i]);
+        }
+      }
+      expr2 = solver->mkTerm(api::INST_PATTERN_LIST, patexprs);
+    }
+    else
+    {
+      expr2 = f2;
+    }
+    return expr;
+  }
+  else if (tryWord("_"))
+  {
+    // an indexed constant, e.g. (_ bv5 3) or (_ +oo 8 24)
+    if (peekWord("char") && d_state->isTheoryEnabled(theory::THEORY_STRINGS))
+    {
+      d_lex.consumeToken();
+      if (peek() != Smt2Token::HEX)
+      {
+        expect(Smt2Token::HEX);
+      }
+      std::string hexStr(d_lex.tokenText().substr(2));
+      d_lex.consumeToken();
+      expr = d_state->mkCharConstant(hexStr);
+    }
+    else
+    {
+      std::string name(d_lex.tokenText());
+      expect(Smt2Token::SYMBOL);
+      expr = d_state->mkIndexedConstant(name, parseNumeralList());
+    }
+    expect(Smt2Token::RPAREN_TOK);
+    return expr;
+  }
+  else if (peekWord("as"))
+  {
+    // an ascripted identifier that is not applied, e.g. (as emptyset T)
+    parseParenQualIdentifier(p);
+    return d_state->parseOpToExpr(p);
+  }
+  else if (peekWord("match") || peekWord("lambda")
+           || peekWord("comprehension") || peekWord("tuple_project"))
+  {
+    unsupported("`" + std::string(d_lex.tokenText()) + "'");
+  }
+  else if (peekWord("mkTuple")
+           && d_state->isTheoryEnabled(theory::THEORY_DATATYPES))
+  {
+    d_lex.consumeToken();
+    std::vector<api::Term> args = parseTermList();
+    d_lex.consumeToken();
+    std::vector<api::Sort> sorts;
+    for (const api::Term& arg : args)
+    {
+      sorts.emplace_back(arg.getSort());
+    }
+    return solver->mkTuple(sorts, args);
+  }
+  else
+  {
+    p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+  }
+  std::vector<api::Term> args = parseTermList();
+  d_lex.consumeToken();
+  return d_state->applyParseOp(p, args);
+}
+
+void Smt2FastInput::parseParenQualIdentifier(ParseOp& p)
+{
+  if (tryWord("_"))
+  {
+    parseIndexedIdentifier(p);
+    return;
+  }
+  if (!tryWord("as"))
+  {
+    expect(Smt2Token::SYMBOL);
+    parseError("expected an indexed or ascripted identifier");
+  }
+  if (!d_state->strictModeEnabled() && tryWord("const"))
+  {
+    api::Sort type = parseSort();
+    p.d_kind = api::CONST_ARRAY;
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  else
+  {
+    if (peek() == Smt2Token::LPAREN_TOK)
+    {
+      d_lex.consumeToken();
+      if (!tryWord("_"))
+      {
+        expect(Smt2Token::SYMBOL);
+        parseError("expected an indexed identifier");
+      }
+      parseIndexedIdentifier(p);
+    }
+    else
+    {
+      p.d_name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    }
+    api::Sort type = parseSort();
+    d_state->parseOpApplyTypeAscription(p, type);
+  }
+  expect(Smt2Token::RPAREN_TOK);
+}
+
+void Smt2FastInput::parseIndexedIdentifier(ParseOp& p)
+{
+  bool datatypes = d_state->isTheoryEnabled(theory::THEORY_DATATYPES);
+  if (datatypes && tryWord("is"))
+  {
+    api::Term f = parseTerm();
+    if (f.getKind() == api::APPLY_CONSTRUCTOR && f.getNumChildren() == 1)
+    {
+      // for nullary constructors, must get the operator
+      f = f[0];
+    }
+    if (!f.getSort().isConstructor())
+    {
+      parseError("Bad syntax for test (_ is X), X must be a constructor.");
+    }
+    // get the datatype that f belongs to
+    api::Sort sf = f.getSort().getConstructorCodomainSort();
+    api::Datatype d = sf.getDatatype();
+    // lookup by name
+    api::DatatypeConstructor dc = d.getConstructor(f.toString());
+    p.d_expr = dc.getTesterTerm();
+  }
+  else if (datatypes && tryWord("update"))
+  {
+    api::Term f = parseTerm();
+    if (!f.getSort().isSelector())
+    {
+      parseError("Bad syntax for test (_ update X), X must be a selector.");
+    }
+    // get the datatype that f belongs to
+    api::Sort sf = f.getSort().getSelectorDomainSort();
+    api::Datatype d = sf.getDatatype();
+    // find the selector and get its updater term
+    api::DatatypeSelector ds = d.getSelector(f.toString());
+    p.d_expr = ds.getUpdaterTerm();
+  }
+  else if (datatypes && tryWord("tupSel"))
+  {
+    // we adopt a special syntax (_ tupSel n)
+    p.d_kind = api::APPLY_SELECTOR;
+    // put n in expr so that the caller can deal with this case
+    p.d_expr = d_state->getSolver()->mkInteger(parseNumeral());
+  }
+  else
+  {
+    std::string name(d_lex.tokenText());
+    expect(Smt2Token::SYMBOL);
+    p.d_op = d_state->mkIndexedOp(name, parseNumeralList());
+  }
+  expect(Smt2Token::RPAREN_TOK);
+}
+
+api::Term Smt2FastInput::parseQuantifier(api::Kind k)
+{
+  if (!d_state->isTheoryEnabled(theory::THEORY_QUANTIFIERS))
+  {
+    parseError("Quantifier used in non-quantified logic.");
+  }
+  api::Solver* solver = d_state->getSolver();
+  d_state->pushScope();
+  std::vector<std::pair<std::string, api::Sort>> sortedVarNames =
+      parseSortedVarList();
+  std::vector<api::Term> vars = d_state->bindBoundVars(sortedVarNames);
+  std::vector<api::Term> args;
+  args.push_back(solver->mkTerm(api::BOUND_VAR_LIST, vars));
+  api::Term f2;
+  args.push_back(parseTerm(f2));
+  expect(Smt2Token::RPAREN_TOK);
+  d_state->popScope();
+  if (!f2.isNull())
+  {
+    args.push_back(f2);
+  }
+  return solver->mkTerm(k, args);
+}
+
+api::Term Smt2FastInput::parseLet()
+{
+  expect(Smt2Token::LPAREN_TOK);
+  d_state->pushScope();
+  // this is a parallel let, so we have to save up all the contributions of
+  // the let and define them only later on
+  std::unordered_set<std::string> names;
+  std::vector<std::pair<std::string, api::Term>> binders;
+  do
+  {
+    expect(Smt2Token::LPAREN_TOK);
+    std::string name = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    api::Term expr = parseTerm();
+    expect(Smt2Token::RPAREN_TOK);
+    if (!names.insert(name).second)
+    {
+      std::stringstream ss;
+      ss << "warning: symbol `" << name << "' bound multiple times by let;"
+         << " the last binding will be used, shadowing earlier ones";
+      d_state->warning(ss.str());
+    }
+    binders.emplace_back(name, expr);
+  } while (peek() != Smt2Token::RPAREN_TOK);
+  d_lex.consumeToken();
+  for (const std::pair<std::string, api::Term>& binder : binders)
+  {
+    d_state->defineVar(binder.first, binder.second);
+  }
+  api::Term expr = parseTerm();
+  expect(Smt2Token::RPAREN_TOK);
+  d_state->popScope();
+  return expr;
+}
+
+api::Term Smt2FastInput::parseAttribute(api::Term& expr)
+{
+  api::Solver* solver = d_state->getSolver();
+  std::string key = parseKeyword();
+  if (key == ":pattern" || key == ":pool" || key == ":inst-add-to-pool"
+      || key == ":skolem-add-to-pool")
+  {
+    api::Kind k = key == ":pattern"
+                      ? api::INST_PATTERN
+                      : (key == ":pool" ? api::INST_POOL
+                                        : (key == ":inst-add-to-pool"
+                                               ? api::INST_ADD_TO_POOL
+                                               : api::SKOLEM_ADD_TO_POOL));
+    expect(Smt2Token::LPAREN_TOK);
+    std::vector<api::Term> patexprs = parseTermList();
+    d_lex.consumeToken();
+    return solver->mkTerm(k, patexprs);
+  }
+  if (key == ":no-pattern")
+  {
+    return solver->mkTerm(api::INST_NO_PATTERN, parseTerm());
+  }
+  if (key == ":quant-inst-max-level")
+  {
+    api::Term n = solver->mkInteger(parseNumeral());
+    std::vector<api::Term> values;
+    values.push_back(n);
+    std::string attrName = key.substr(1);
+    api::Term avar = d_state->bindVar(attrName, solver->getBooleanSort());
+    Command* c = new SetUserAttributeCommand(attrName, avar, values);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+    return solver->mkTerm(api::INST_ATTRIBUTE, avar);
+  }
+  if (key == ":qid")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    api::Term avar =
+        solver->mkConst(solver->getBooleanSort(), sexprToString(sexpr));
+    Command* c = new SetUserAttributeCommand("qid", avar);
+    c->setMuted(true);
+    d_state->preemptCommand(c);
+    return solver->mkTerm(api::INST_ATTRIBUTE, avar);
+  }
+  if (key == ":named")
+  {
+    api::Term sexpr = parseSymbolicExpr();
+    // notify that expression was given a name
+    d_state->notifyNamedExpression(expr, sexprToString(sexpr));
+    return api::Term();
+  }
+  Smt2Token t = peek();
+  if (t != Smt2Token::KEYWORD && t != Smt2Token::LPAREN_TOK
+      && t != Smt2Token::RPAREN_TOK)
+  {
+    parseSimpleSymbolicExpr();
+  }
+  d_state->attributeNotSupported(key);
+  return api::Term();
+}
+
+/* -------------------------------------------------------------------------- */
+/* Commands                                                                   */
+/* -------------------------------------------------------------------------- */
+
+Command* Smt2FastInput::parseCommand()
+{
+  if (peek() == Smt2Token::EOF_TOK)
+  {
+    return nullptr;
+  }
+  expect(Smt2Token::LPAREN_TOK);
+  std::unique_ptr<Command> cmd = parseCommandBody();
+  // do not look beyond the closing parenthesis, the next command may not be
+  // available yet in interactive mode
+  expect(Smt2Token::RPAREN_TOK);
+  return cmd.release();
+}
+
+api::Term Smt2FastInput::parseExpr()
+{
+  if (peek() == Smt2Token::EOF_TOK)
+  {
+    return api::Term();
+  }
+  return parseTerm();
+}
+
+std::unique_ptr<Command> Smt2FastInput::parseCommandBody()
+{
+  SymbolManager* symman = d_state->getSymbolManager();
+  if (peek() != Smt2Token::SYMBOL)
+  {
+    expect(Smt2Token::SYMBOL);
+  }
+  std::string name(d_lex.tokenText());
+  d_lex.consumeToken();
+  std::unique_ptr<Command> cmd;
+  bool extended = false;
+  if (name == "set-logic")
+  {
+    cmd.reset(d_state->setLogic(parseSymbol(CHECK_NONE, SYM_SORT)));
+  }
+  else if (name == "set-info")
+  {
+    std::string key = parseKeyword();
+    api::Term sexpr = parseSymbolicExpr();
+    cmd.reset(new SetInfoCommand(key.substr(1), sexprToString(sexpr)));
+  }
+  else if (name == "get-info")
+  {
+    cmd.reset(new GetInfoCommand(parseKeyword().substr(1)));
+  }
+  else if (name == "set-option")
+  {
+    std::string key = parseKeyword();
+    api::Term sexpr = parseSymbolicExpr();
+    cmd.reset(new SetOptionCommand(key.substr(1), sexprToString(sexpr)));
+    // global-declarations affects parsing, so we can't hold off on this
+    // until the command is executed.
+    if (key == ":global-declarations")
+    {
+      symman->setGlobalDeclarations(sexprToString(sexpr) == "true");
+    }
+  }
+  else if (name == "get-option")
+  {
+    cmd.reset(new GetOptionCommand(parseKeyword().substr(1)));
+  }
+  else if (name == "declare-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->checkLogicAllowsFreeSorts();
+    std::string sname = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(sname);
+    uint64_t arity = parseNumeral();
+    if (arity == 0)
+    {
+      api::Sort type = d_state->mkSort(sname);
+      cmd.reset(new DeclareSortCommand(sname, 0, type));
+    }
+    else
+    {
+      api::Sort type = d_state->mkSortConstructor(sname, arity);
+      cmd.reset(new DeclareSortCommand(sname, arity, type));
+    }
+  }
+  else if (name == "define-sort")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string sname = parseSymbol(CHECK_UNDECLARED, SYM_SORT);
+    d_state->checkUserSymbol(sname);
+    expect(Smt2Token::LPAREN_TOK);
+    std::vector<std::string> names;
+    while (peek() != Smt2Token::RPAREN_TOK)
+    {
+      names.push_back(parseSymbol(CHECK_NONE, SYM_SORT));
+    }
+    d_lex.consumeToken();
+    d_state->pushScope();
+    std::vector<api::Sort> sorts;
+    for (const std::string& pname : names)
+    {
+      sorts.push_back(d_state->mkSort(pname));
+    }
+    api::Sort t = parseSort();
+    d_state->popScope();
+    // This name is not its own distinct sort, it's an alias.
+    d_state->defineParameterizedType(sname, sorts, t);
+    cmd.reset(new DefineSortCommand(sname, sorts, t));
+  }
+  else if (name == "declare-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string fname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(fname);
+    expect(Smt2Token::LPAREN_TOK);
+    std::vector<api::Sort> sorts = parseSortList();
+    d_lex.consumeToken();
+    api::Sort t = parseSort();
+    if (!sorts.empty())
+    {
+      t = d_state->mkFlatFunctionType(sorts, t);
+    }
+    if (t.isFunction())
+    {
+      d_state->checkLogicAllowsFunctions();
+    }
+    // we allow overloading for function declarations
+    api::Term func = d_state->bindVar(fname, t, false, true);
+    cmd.reset(new DeclareFunctionCommand(fname, func, t));
+  }
+  else if (name == "declare-const")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string cname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(cname);
+    api::Sort t = parseSort();
+    // allow overloading here
+    api::Term c = d_state->bindVar(cname, t, false, true);
+    cmd.reset(new DeclareFunctionCommand(cname, c, t));
+  }
+  else if (name == "define-fun")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string fname = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    d_state->checkUserSymbol(fname);
+    std::vector<std::pair<std::string, api::Sort>> sortedVarNames =
+        parseSortedVarList();
+    api::Sort t = parseSort();
+    std::vector<api::Sort> sorts;
+    for (const std::pair<std::string, api::Sort>& svn : sortedVarNames)
+    {
+      sorts.push_back(svn.second);
+    }
+    std::vector<api::Term> flattenVars;
+    t = d_state->mkFlatFunctionType(sorts, t, flattenVars);
+    if (!sortedVarNames.empty())
+    {
+      d_state->pushScope();
+    }
+    std::vector<api::Term> terms = d_state->bindBoundVars(sortedVarNames);
+    api::Term expr = parseTerm();
+    if (!flattenVars.empty())
+    {
+      // apply the body of the definition to the flatten vars
+      expr = d_state->mkHoApply(expr, flattenVars);
+      terms.insert(terms.end(), flattenVars.begin(), flattenVars.end());
+    }
+    if (!sortedVarNames.empty())
+    {
+      d_state->popScope();
+    }
+    // declare the name down here, no recursion permitted
+    api::Term func = d_state->bindVar(fname, t, false, true);
+    cmd.reset(new DefineFunctionCommand(
+        fname, func, terms, expr, symman->getGlobalDeclarations()));
+  }
+  else if (name == "define-const")
+  {
+    extended = true;
+    d_state->checkThatLogicIsSet();
+    std::string cname = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+    d_state->checkUserSymbol(cname);
+    api::Sort t = parseSort();
+    api::Term e = parseTerm();
+    api::Term func = d_state->bindVar(cname, t);
+    cmd.reset(new DefineFunctionCommand(cname,
+                                        func,
+                                        std::vector<api::Term>(),
+                                        e,
+                                        symman->getGlobalDeclarations()));
+  }
+  else if (name == "define-fun-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    std::string fname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+    d_state->checkUserSymbol(fname);
+    std::vector<std::pair<std::string, api::Sort>> sortedVarNames =
+        parseSortedVarList();
+    api::Sort t = parseSort();
+    std::vector<api::Term> flattenVars;
+    std::vector<api::Term> bvs;
+    api::Term func =
+        d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars);
+    d_state->pushDefineFunRecScope(sortedVarNames, func, flattenVars, bvs);
+    api::Term expr = parseTerm();
+    d_state->popScope();
+    if (!flattenVars.empty())
+    {
+      expr = d_state->mkHoApply(expr, flattenVars);
+    }
+    cmd.reset(new DefineFunctionRecCommand(
+        func, bvs, expr, symman->getGlobalDeclarations()));
+  }
+  else if (name == "define-funs-rec")
+  {
+    d_state->checkThatLogicIsSet();
+    std::vector<std::vector<std::pair<std::string, api::Sort>>>
+        sortedVarNamesList;
+    std::vector<std::vector<api::Term>> flattenVarsList;
+    std::vector<api::Term> funcs;
+    expect(Smt2Token::LPAREN_TOK);
+    do
+    {
+      expect(Smt2Token::LPAREN_TOK);
+      std::string fname = parseSymbol(CHECK_UNDECLARED, SYM_VARIABLE);
+      d_state->checkUserSymbol(fname);
+      std::vector<std::pair<std::string, api::Sort>> sortedVarNames =
+          parseSortedVarList();
+      api::Sort t = parseSort();
+      std::vector<api::Term> flattenVars;
+      funcs.push_back(
+          d_state->bindDefineFunRec(fname, sortedVarNames, t, flattenVars));
+      sortedVarNamesList.push_back(sortedVarNames);
+      flattenVarsList.push_back(flattenVars);
+      expect(Smt2Token::RPAREN_TOK);
+    } while (peek() != Smt2Token::RPAREN_TOK);
+    d_lex.consumeToken();
+    expect(Smt2Token::LPAREN_TOK);
+    std::vector<std::vector<api::Term>> formals;
+    std::vector<api::Term> funcDefs;
+    while (peek() != Smt2Token::RPAREN_TOK)
+    {
+      size_t j = funcDefs.size();
+      if (j >= funcs.size())
+      {
+        break;
+      }
+      std::vector<api::Term> bvs;
+      d_state->pushDefineFunRecScope(
+          sortedVarNamesList[j], funcs[j], flattenVarsList[j], bvs);
+      api::Term expr = parseTerm();
+      if (!flattenVarsList[j].empty())
+      {
+        expr = d_state->mkHoApply(expr, flattenVarsList[j]);
+      }
+      d_state->popScope();
+      funcDefs.push_back(expr);
+      formals.push_back(bvs);
+    }
+    expect(Smt2Token::RPAREN_TOK);
+    if (funcs.size() != funcDefs.size())
+    {
+      parseError(
+          "Number of functions defined does not match number listed in "
+          "define-funs-rec");
+    }
+    cmd.reset(new DefineFunctionRecCommand(
+        funcs, formals, funcDefs, symman->getGlobalDeclarations()));
+  }
+  else if ((name == "declare-datatype" || name == "declare-codatatype")
+           && d_state->v2_6())
+  {
+    extended = name == "declare-codatatype";
+    d_state->checkThatLogicIsSet();
+    std::vector<std::string> dnames;
+    dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+    cmd = parseDatatypes(extended, dnames, std::vector<int>(1, -1));
+  }
+  else if ((name == "declare-datatypes" || name == "declare-codatatypes")
+           && d_state->v2_6())
+  {
+    extended = name == "declare-codatatypes";
+    d_state->checkThatLogicIsSet();
+    std::vector<std::string> dnames;
+    std::vector<int> arities;
+    expect(Smt2Token::LPAREN_TOK);
+    while (peek() != Smt2Token::RPAREN_TOK)
+    {
+      expect(Smt2Token::LPAREN_TOK);
+      dnames.push_back(parseSymbol(CHECK_UNDECLARED, SYM_SORT));
+      arities.push_back(static_cast<int>(parseNumeral()));
+      expect(Smt2Token::RPAREN_TOK);
+    }
+    d_lex.consumeToken();
+    expect(Smt2Token::LPAREN_TOK);
+    cmd = parseDatatypes(extended, dnames, arities);
+    expect(Smt2Token::RPAREN_TOK);
+  }
+  else if (name == "get-value")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetValueCommand(parseParenTermList("get-value")));
+  }
+  else if (name == "get-assignment")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetAssignmentCommand());
+  }
+  else if (name == "assert")
+  {
+    d_state->checkThatLogicIsSet();
+    d_state->clearLastNamedTerm();
+    api::Term expr = parseTerm();
+    bool inUnsatCore = d_state->lastNamedTerm().first == expr;
+    cmd.reset(new AssertCommand(expr, inUnsatCore));
+    if (inUnsatCore)
+    {
+      // set the expression name, if there was a named term
+      std::pair<api::Term, std::string> namedTerm = d_state->lastNamedTerm();
+      symman->setExpressionName(namedTerm.first, namedTerm.second, true);
+    }
+  }
+  else if (name == "check-sat")
+  {
+    d_state->checkThatLogicIsSet();
+    api::Term expr;
+    if (peek() != Smt2Token::RPAREN_TOK)
+    {
+      if (d_state->strictModeEnabled())
+      {
+        parseError(
+            "Extended commands (such as check-sat with an argument) are not "
+            "permitted while operating in strict compliance mode.");
+      }
+      expr = parseTerm();
+    }
+    cmd.reset(new CheckSatCommand(expr));
+  }
+  else if (name == "check-sat-assuming")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(
+        new CheckSatAssumingCommand(parseParenTermList("check-sat-assuming")));
+  }
+  else if (name == "get-assertions")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetAssertionsCommand());
+  }
+  else if (name == "get-proof")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetProofCommand());
+  }
+  else if (name == "get-unsat-assumptions")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetUnsatAssumptionsCommand);
+  }
+  else if (name == "get-unsat-core")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetUnsatCoreCommand);
+  }
+  else if (name == "get-model")
+  {
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new GetModelCommand());
+  }
+  else if (name == "push" || name == "pop")
+  {
+    d_state->checkThatLogicIsSet();
+    bool isPush = name == "push";
+    uint64_t num = 1;
+    if (peek() == Smt2Token::NUMERAL)
+    {
+      num = parseNumeral();
+    }
+    else if (d_state->strictModeEnabled())
+    {
+      parseError("Strict compliance mode demands an integer to be provided "
+                 "to "
+                 + name + ".  Maybe you want (" + name + " 1)?");
+    }
+    if (!isPush && num > d_state->scopeLevel())
+    {
+      parseError("Attempted to pop above the top stack frame.");
+    }
+    std::vector<Command*> cmds;
+    for (uint64_t i = 0; i < num; ++i)
+    {
+      if (isPush)
+      {
+        d_state->pushScope(true);
+        cmds.push_back(new PushCommand());
+      }
+      else
+      {
+        d_state->popScope();
+        cmds.push_back(new PopCommand());
+      }
+    }
+    if (num == 0)
+    {
+      cmd.reset(new EmptyCommand());
+    }
+    else if (num == 1)
+    {
+      cmd.reset(cmds[0]);
+    }
+    else
+    {
+      std::unique_ptr<CommandSequence> seq(new CommandSequence());
+      for (Command* c : cmds)
+      {
+        c->setMuted(true);
+        seq->addCommand(c);
+      }
+      cmd = std::move(seq);
+    }
+  }
+  else if (name == "echo")
+  {
+    if (peek() == Smt2Token::RPAREN_TOK)
+    {
+      cmd.reset(new EchoCommand());
+    }
+    else
+    {
+      cmd.reset(new EchoCommand(parseSimpleSymbolicExpr()));
+    }
+  }
+  else if (name == "reset")
+  {
+    cmd.reset(new ResetCommand());
+    // reset the state of the parser, which is independent of the symbol
+    // manager
+    d_state->reset();
+  }
+  else if (name == "reset-assertions")
+  {
+    cmd.reset(new ResetAssertionsCommand());
+  }
+  else if (name == "exit")
+  {
+    cmd.reset(new QuitCommand());
+  }
+  else if (name == "simplify")
+  {
+    extended = true;
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new SimplifyCommand(parseTerm()));
+  }
+  else if (name == "get-qe" || name == "get-qe-disjunct")
+  {
+    extended = true;
+    d_state->checkThatLogicIsSet();
+    cmd.reset(
+        new GetQuantifierEliminationCommand(parseTerm(), name == "get-qe"));
+  }
+  else if (name == "block-model")
+  {
+    extended = true;
+    d_state->checkThatLogicIsSet();
+    cmd.reset(new BlockModelCommand());
+  }
+  else if (name == "block-model-values")
+  {
+    extended = true;
+    d_state->checkThatLogicIsSet();
+    cmd.reset(
+        new BlockModelValuesCommand(parseParenTermList("block-model-values")));
+  }
+  else if (name == "benchmark")
+  {
+    parseError(
+        "In SMT-LIBv2 mode, but got something that looks like SMT-LIBv1, "
+        "which is not supported anymore.");
+  }
+  else if (name == "include" || name == "declare-sorts"
+           || name == "declare-funs" || name == "declare-preds"
+           || name == "define" || name == "declare-datatypes"
+           || name == "declare-codatatypes" || name == "get-abduct"
+           || name == "get-interpol" || name == "declare-heap"
+           || name == "declare-pool")
+  {
+    unsupported("The command `" + name + "'");
+  }
+  else
+  {
+    parseError("expected SMT-LIBv2 command, got `" + name + "'.");
+  }
+  if (extended && d_state->strictModeEnabled())
+  {
+    parseError(
+        "Extended commands are not permitted while operating in strict "
+        "compliance mode.");
+  }
+  return cmd;
+}
+
+std::unique_ptr<Command> Smt2FastInput::parseDatatypes(
+    bool isCo,
+    const std::vector<std::string>& dnames,
+    const std::vector<int>& arities)
+{
+  api::Solver* solver = d_state->getSolver();
+  d_state->pushScope();
+  // Declare the datatypes that are currently being defined as unresolved
+  // types. If we do not know the arity of the datatype yet, we wait to define
+  // it until parsing the preamble of its body, which may optionally involve
+  // `par`.
+  for (size_t i = 0, dsize = dnames.size(); i < dsize; i++)
+  {
+    if (arities[i] >= 0)
+    {
+      d_state->mkUnresolvedType(dnames[i], static_cast<size_t>(arities[i]));
+    }
+  }
+  std::vector<api::DatatypeDecl> dts;
+  do
+  {
+    if (dts.size() >= dnames.size())
+    {
+      parseError("Too many datatypes defined in this block.");
+    }
+    expect(Smt2Token::LPAREN_TOK);
+    size_t i = dts.size();
+    std::vector<api::Sort> params;
+    bool parametric = false;
+    if (tryWord("par"))
+    {
+      parametric = true;
+      d_state->pushScope();
+      expect(Smt2Token::LPAREN_TOK);
+      while (peek() != Smt2Token::RPAREN_TOK)
+      {
+        params.push_back(
+            d_state->mkSort(parseSymbol(CHECK_UNDECLARED, SYM_SORT)));
+      }
+      d_lex.consumeToken();
+      // if the arity was fixed by the prelude, it must match
+      if (arities[i] >= 0 && static_cast<int>(params.size()) != arities[i])
+      {
+        parseError("Wrong number of parameters for datatype.");
+      }
+      expect(Smt2Token::LPAREN_TOK);
+    }
+    else if (arities[i] > 0)
+    {
+      parseError("No parameters given for datatype.");
+    }
+    if (arities[i] < 0)
+    {
+      // now declare it as an unresolved type
+      d_state->mkUnresolvedType(dnames[i], params.size());
+    }
+    dts.push_back(solver->mkDatatypeDecl(dnames[i], params, isCo));
+    // the constructors
+    do
+    {
+      expect(Smt2Token::LPAREN_TOK);
+      std::string cname = parseSymbol(CHECK_NONE, SYM_VARIABLE);
+      api::DatatypeConstructorDecl ctor =
+          solver->mkDatatypeConstructorDecl(cname);
+      while (peek() != Smt2Token::RPAREN_TOK)
+      {
+        expect(Smt2Token::LPAREN_TOK);
+        std::string sname = parseSymbol(CHECK_NONE, SYM_SORT);
+        api::Sort t = parseSort(CHECK_NONE);
+        ctor.addSelector(sname, t);
+        expect(Smt2Token::RPAREN_TOK);
+      }
+      d_lex.consumeToken();
+      dts.back().addConstructor(ctor);
+    } while (peek() != Smt2Token::RPAREN_TOK);
+    d_lex.consumeToken();
+    if (parametric)
+    {
+      expect(Smt2Token::RPAREN_TOK);
+      d_state->popScope();
+    }
+  } while (peek() != Smt2Token::RPAREN_TOK);
+  if (dts.size() != dnames.size())
+  {
+    parseError("Wrong number of datatypes provided.");
+  }
+  d_state->popScope();
+  return std::unique_ptr<Command>(new DatatypeDeclarationCommand(
+      d_state->bindMutualDatatypeTypes(dts, true)));
+}
+
+}  // namespace parser
+}  // namespace cvc5
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A streaming SMT-LIB version 2 input that does not use ANTLR.
+ */
+
+#include "cvc5parser_private.h"
+
+#ifndef CVC5__PARSER__SMT2__SMT2_FAST_INPUT_H
+#define CVC5__PARSER__SMT2__SMT2_FAST_INPUT_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/cpp/cvc5.h"
+#include "parser/input.h"
+#include "parser/parse_op.h"
+#include "parser/parser.h"
+#include "parser/smt2/smt2_fast_lexer.h"
+
+namespace cvc5 {
+
+class Command;
+
+namespace parser {
+
+class Smt2;
+
+/** The input stream of an Smt2FastInput, the lexer does the actual work. */
+class Smt2FastInputStream : public InputStream
+{
+ public:
+  Smt2FastInputStream(const std::string& name) : InputStream(name) {}
+};
+
+/**
+ * An input for SMT-LIB version 2.6 that is parsed by a hand-written
+ * recursive descent parser on top of the Smt2FastLexer.
+ *
+ * In contrast to Smt2Input, this does not build ANTLR token objects or a
+ * token buffer: every token is inspected in place and turned into terms
+ * right away, using the same Smt2 parser state (and thus the same symbol
+ * tables, operator maps and error checks) as the ANTLR-based parser. Input
+ * is consumed lazily, so this is suitable for interactive use as well.
+ *
+ * It covers the SMT-LIB 2.6 commands and term language, including datatype
+ * declarations, as well as the most common cvc5 extensions. Less common
+ * extensions (SyGuS, include, match, lambda, set comprehension, tuple
+ * projections, abduction and interpolation, separation logic declarations)
+ * are rejected with a parse error suggesting to use the default parser.
+ */
+class Smt2FastInput : public Input
+{
+ public:
+  /** Create an input that reads the given file. */
+  static Smt2FastInput* newFileInput(const std::string& filename,
+                                     bool useMmap);
+  /** Create an input that reads from the given stream. */
+  static Smt2FastInput* newStreamInput(std::istream& input,
+                                       const std::string& name);
+  /** Create an input that reads from the given string. */
+  static Smt2FastInput* newStringInput(const std::string& input,
+                                       const std::string& name);
+
+  ~Smt2FastInput();
+
+ protected:
+  Command* parseCommand() override;
+  api::Term parseExpr() override;
+  void warning(const std::string& msg) override;
+  void parseError(const std::string& msg, bool eofException = false) override;
+  void setParser(Parser& parser) override;
+
+ private:
+  Smt2FastInput(Smt2FastInputStream& inputStream);
+
+  /** Peek at the next token. */
+  Smt2Token peek();
+  /** Consume the next token, which must be of the given type. */
+  void expect(Smt2Token t);
+  /** Whether the next token is the given reserved word. */
+  bool peekWord(const char* word);
+  /** Consume the next token if it is the given reserved word. */
+  bool tryWord(const char* word);
+
+  /** Parse the body of a command, after the opening parenthesis. */
+  std::unique_ptr<Command> parseCommandBody();
+  /** Parse the body of a declare-datatype(s) command. */
+  std::unique_ptr<Command> parseDatatypes(bool isCo,
+                                          const std::vector<std::string>& names,
+                                          const std::vector<int>& arities);
+
+  /** Parse a (simple or quoted) symbol. */
+  std::string parseSymbol(DeclarationCheck check, SymbolType type);
+  /** Parse a numeral. */
+  uint64_t parseNumeral();
+  /** Parse a non-empty list of numerals, up to the closing parenthesis. */
+  std::vector<uint64_t> parseNumeralList();
+  /** Parse a keyword, including the leading colon. */
+  std::string parseKeyword();
+  /** Parse a string literal, processing escapes. */
+  std::string parseString(bool fsmtlib);
+  /** Parse a symbolic expression. */
+  api::Term parseSymbolicExpr();
+  /** Parse a simple symbolic expression, which is not a keyword. */
+  std::string parseSimpleSymbolicExpr();
+
+  /** Parse a sort. */
+  api::Sort parseSort(DeclarationCheck check = CHECK_DECLARED);
+  /** Parse a list of sorts, up to the closing parenthesis. */
+  std::vector<api::Sort> parseSortList();
+  /** Parse a parenthesized list of sorted variables. */
+  std::vector<std::pair<std::string, api::Sort>> parseSortedVarList();
+
+  /**
+   * Parse a term. Annotations of the term (such as instantiation patterns)
+   * are stored in expr2.
+   */
+  api::Term parseTerm(api::Term& expr2);
+  /** Parse a term, ignoring annotations. */
+  api::Term parseTerm();
+  /** Parse a list of terms, up to the closing parenthesis. */
+  std::vector<api::Term> parseTermList();
+  /** Parse a parenthesized, non-empty list of terms. */
+  std::vector<api::Term> parseParenTermList(const char* cmd);
+  /**
+   * Parse the remainder of an identifier or qualified identifier that starts
+   * with an opening parenthesis, e.g. (_ extract 1 0) or (as const T), after
+   * the parenthesis.
+   */
+  void parseParenQualIdentifier(ParseOp& p);
+  /** Parse the remainder of (_ ...) as identifier, after the underscore. */
+  void parseIndexedIdentifier(ParseOp& p);
+  /** Parse the remainder of a quantified formula, after the quantifier. */
+  api::Term parseQuantifier(api::Kind k);
+  /** Parse the remainder of a let term, after the let. */
+  api::Term parseLet();
+  /** Parse an attribute of expr. Returns an annotation, if any. */
+  api::Term parseAttribute(api::Term& expr);
+
+  /** Raise a parse error for a construct this parser does not support. */
+  void unsupported(const std::string& what);
+
+  /** The lexer. */
+  Smt2FastLexer d_lex;
+  /** The parser state. */
+  Smt2* d_state;
+}; /* class Smt2FastInput */
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC5__PARSER__SMT2__SMT2_FAST_INPUT_H */
@@ -0,0 +1,426 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A hand-written, zero-copy lexer for SMT-LIB version 2.
+ */
+
+#include "parser/smt2/smt2_fast_lexer.h"
+
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace parser {
+
+namespace {
+
+/** Characters (other than letters and digits) allowed in simple symbols. */
+bool isSymbolChar(int c)
+{
+  switch (c)
+  {
+    case '+': case '-': case '/': case '*': case '=': case '%': case '?':
+    case '.': case '$': case '~': case '&': case '^': case '<': case '>':
+    case '@': case '_': case '!':
+      return true;
+    default: return false;
+  }
+}
+
+bool isAlpha(int c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+bool isHexDigit(int c)
+{
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool isWhitespace(int c)
+{
+  return c == ' ' || c == '\t' || c == '\f' || c == '\r' || c == '\n';
+}
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, Smt2Token t)
+{
+  switch (t)
+  {
+    case Smt2Token::EOF_TOK: return os << "end of file";
+    case Smt2Token::LPAREN_TOK: return os << "'('";
+    case Smt2Token::RPAREN_TOK: return os << "')'";
+    case Smt2Token::SYMBOL: return os << "symbol";
+    case Smt2Token::QUOTED_SYMBOL: return os << "quoted symbol";
+    case Smt2Token::KEYWORD: return os << "keyword";
+    case Smt2Token::NUMERAL: return os << "numeral";
+    case Smt2Token::DECIMAL: return os << "decimal";
+    case Smt2Token::HEX: return os << "hexadecimal literal";
+    case Smt2Token::BINARY: return os << "binary literal";
+    case Smt2Token::STRING: return os << "string literal";
+    case Smt2Token::UNTERMINATED: return os << "unterminated literal";
+    case Smt2Token::INVALID: return os << "invalid character";
+  }
+  return os;
+}
+
+Smt2FastLexer::Smt2FastLexer()
+    : d_begin(nullptr),
+      d_pos(0),
+      d_end(0),
+      d_tokStart(0),
+      d_tokEnd(0),
+      d_line(1),
+      d_column(0),
+      d_tokLine(1),
+      d_tokColumn(0),
+      d_token(Smt2Token::EOF_TOK),
+      d_peeked(false),
+      d_escapeDupDblQuote(true),
+      d_stream(nullptr),
+      d_mmapData(nullptr),
+      d_mmapSize(0)
+{
+}
+
+Smt2FastLexer::~Smt2FastLexer()
+{
+#ifndef _WIN32
+  if (d_mmapData != nullptr)
+  {
+    munmap(d_mmapData, d_mmapSize);
+  }
+#endif /* _WIN32 */
+}
+
+bool Smt2FastLexer::initFile(const std::string& filename, bool useMmap)
+{
+#ifndef _WIN32
+  if (useMmap)
+  {
+    struct stat st;
+    if (stat(filename.c_str(), &st) == -1)
+    {
+      return false;
+    }
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      return false;
+    }
+    d_mmapSize = st.st_size;
+    if (d_mmapSize > 0)
+    {
+      d_mmapData = mmap(0, d_mmapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (d_mmapData == MAP_FAILED)
+    {
+      d_mmapData = nullptr;
+      return false;
+    }
+    d_begin = static_cast<const char*>(d_mmapData);
+    d_end = d_mmapSize;
+    return true;
+  }
+#endif /* _WIN32 */
+  std::unique_ptr<std::ifstream> file(
+      new std::ifstream(filename, std::ios::in | std::ios::binary));
+  if (!file->is_open())
+  {
+    return false;
+  }
+  d_ownedStream = std::move(file);
+  d_stream = d_ownedStream.get();
+  d_begin = d_storage.data();
+  return true;
+}
+
+void Smt2FastLexer::initStream(std::istream& input)
+{
+  d_stream = &input;
+  d_begin = d_storage.data();
+}
+
+void Smt2FastLexer::initString(const std::string& input)
+{
+  d_storage.assign(input.begin(), input.end());
+  d_begin = d_storage.data();
+  d_end = d_storage.size();
+}
+
+bool Smt2FastLexer::refill(size_t required)
+{
+  if (d_stream == nullptr)
+  {
+    return false;
+  }
+  // discard everything before the current token
+  if (d_tokStart > 0)
+  {
+    std::memmove(d_storage.data(), d_storage.data() + d_tokStart,
+                 d_end - d_tokStart);
+    d_pos -= d_tokStart;
+    d_end -= d_tokStart;
+    required -= d_tokStart;
+    d_tokEnd = d_tokEnd > d_tokStart ? d_tokEnd - d_tokStart : 0;
+    d_tokStart = 0;
+  }
+  while (d_end < required)
+  {
+    if (d_stream->eof() || d_stream->fail())
+    {
+      d_begin = d_storage.data();
+      return false;
+    }
+    if (d_storage.size() < d_end + s_chunkSize)
+    {
+      d_storage.resize(d_end + s_chunkSize);
+    }
+    char* dest = d_storage.data() + d_end;
+    if (d_ownedStream != nullptr)
+    {
+      // a file, read full chunks
+      d_stream->read(dest, s_chunkSize);
+      d_end += d_stream->gcount();
+    }
+    else
+    {
+      // possibly interactive, never wait for more than one line of input
+      d_stream->get(dest, s_chunkSize - 1, '\n');
+      d_end += d_stream->gcount();
+      if (d_stream->fail() && !d_stream->eof())
+      {
+        // an empty line sets the failbit
+        d_stream->clear();
+      }
+      if (d_stream->peek() == '\n')
+      {
+        d_storage[d_end++] = static_cast<char>(d_stream->get());
+      }
+    }
+  }
+  d_begin = d_storage.data();
+  return true;
+}
+
+void Smt2FastLexer::skipWhitespace()
+{
+  while (true)
+  {
+    d_tokStart = d_pos;
+    int c = peekChar();
+    if (isWhitespace(c))
+    {
+      advance();
+    }
+    else if (c == ';')
+    {
+      while (c != -1 && c != '\n' && c != '\r')
+      {
+        advance();
+        d_tokStart = d_pos;
+        c = peekChar();
+      }
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+void Smt2FastLexer::lexSymbolChars()
+{
+  int c = peekChar();
+  while (isAlpha(c) || isDigit(c) || isSymbolChar(c))
+  {
+    advance();
+    c = peekChar();
+  }
+}
+
+Smt2Token Smt2FastLexer::peekToken()
+{
+  if (!d_peeked)
+  {
+    skipWhitespace();
+    d_tokLine = d_line;
+    d_tokColumn = d_column;
+    d_token = lexToken();
+    d_peeked = true;
+  }
+  return d_token;
+}
+
+Smt2Token Smt2FastLexer::lexToken()
+{
+  d_tokStart = d_pos;
+  int c = peekChar();
+  if (c == -1)
+  {
+    d_tokEnd = d_pos;
+    return Smt2Token::EOF_TOK;
+  }
+  advance();
+  Smt2Token ret;
+  switch (c)
+  {
+    case '(': ret = Smt2Token::LPAREN_TOK; break;
+    case ')': ret = Smt2Token::RPAREN_TOK; break;
+    case '|':
+    {
+      c = peekChar();
+      while (c != -1 && c != '|' && c != '\\')
+      {
+        advance();
+        c = peekChar();
+      }
+      if (c != '|')
+      {
+        d_tokEnd = d_pos;
+        return Smt2Token::UNTERMINATED;
+      }
+      // exclude the bars from the token text
+      d_tokEnd = d_pos;
+      advance();
+      ++d_tokStart;
+      return Smt2Token::QUOTED_SYMBOL;
+    }
+    case '"':
+    {
+      while (true)
+      {
+        c = peekChar();
+        if (c == -1)
+        {
+          d_tokEnd = d_pos;
+          return Smt2Token::UNTERMINATED;
+        }
+        if (c == '"')
+        {
+          if (d_escapeDupDblQuote && peekChar(1) == '"')
+          {
+            advance();
+            advance();
+            continue;
+          }
+          break;
+        }
+        if (!d_escapeDupDblQuote && c == '\\')
+        {
+          advance();
+          if (peekChar() == -1)
+          {
+            d_tokEnd = d_pos;
+            return Smt2Token::UNTERMINATED;
+          }
+        }
+        advance();
+      }
+      // exclude the quotes from the token text
+      d_tokEnd = d_pos;
+      advance();
+      ++d_tokStart;
+      return Smt2Token::STRING;
+    }
+    case ':':
+      lexSymbolChars();
+      ret = d_pos - d_tokStart > 1 ? Smt2Token::KEYWORD : Smt2Token::INVALID;
+      break;
+    case '#':
+    {
+      int kind = peekChar();
+      if (kind == 'x' || kind == 'b')
+      {
+        advance();
+        c = peekChar();
+        size_t ndigits = 0;
+        while (kind == 'x' ? isHexDigit(c) : (c == '0' || c == '1'))
+        {
+          advance();
+          c = peekChar();
+          ++ndigits;
+        }
+        if (ndigits > 0)
+        {
+          ret = kind == 'x' ? Smt2Token::HEX : Smt2Token::BINARY;
+          break;
+        }
+      }
+      ret = Smt2Token::INVALID;
+      break;
+    }
+    default:
+      if (isDigit(c))
+      {
+        c = peekChar();
+        while (isDigit(c))
+        {
+          advance();
+          c = peekChar();
+        }
+        ret = Smt2Token::NUMERAL;
+        if (c == '.' && isDigit(peekChar(1)))
+        {
+          advance();
+          c = peekChar();
+          while (isDigit(c))
+          {
+            advance();
+            c = peekChar();
+          }
+          ret = Smt2Token::DECIMAL;
+        }
+      }
+      else if (isAlpha(c) || isSymbolChar(c))
+      {
+        lexSymbolChars();
+        ret = Smt2Token::SYMBOL;
+      }
+      else
+      {
+        ret = Smt2Token::INVALID;
+      }
+      break;
+  }
+  d_tokEnd = d_pos;
+  return ret;
+}
+
+std::string Smt2FastLexer::getLineText() const
+{
+  size_t start = d_tokStart;
+  while (start > 0 && d_begin[start - 1] != '\n')
+  {
+    --start;
+  }
+  size_t end = d_tokStart;
+  while (end < d_end && d_begin[end] != '\n' && d_begin[end] != '\r')
+  {
+    ++end;
+  }
+  return std::string(d_begin + start, end - start);
+}
+
+}  // namespace parser
+}  // namespace cvc5
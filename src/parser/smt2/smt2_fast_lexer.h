@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A hand-written, zero-copy lexer for SMT-LIB version 2.
+ */
+
+#include "cvc5parser_private.h"
+
+#ifndef CVC5__PARSER__SMT2__SMT2_FAST_LEXER_H
+#define CVC5__PARSER__SMT2__SMT2_FAST_LEXER_H
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cvc5 {
+namespace parser {
+
+/** The tokens produced by the Smt2FastLexer. */
+enum class Smt2Token
+{
+  /** End of input. */
+  EOF_TOK,
+  LPAREN_TOK,
+  RPAREN_TOK,
+  /** A simple symbol, including reserved words such as `assert` or `_`. */
+  SYMBOL,
+  /** A |quoted| symbol, the text excludes the bars. */
+  QUOTED_SYMBOL,
+  /** A keyword, the text includes the leading colon. */
+  KEYWORD,
+  NUMERAL,
+  DECIMAL,
+  /** A hexadecimal literal, the text includes the #x prefix. */
+  HEX,
+  /** A binary literal, the text includes the #b prefix. */
+  BINARY,
+  /** A string literal, the text excludes the surrounding quotes. */
+  STRING,
+  /** An unterminated string or quoted symbol. */
+  UNTERMINATED,
+  /** A character that cannot start any token. */
+  INVALID,
+};
+
+std::ostream& operator<<(std::ostream& os, Smt2Token t);
+
+/**
+ * A lexer for SMT-LIB version 2 that never materializes token objects.
+ *
+ * The lexer works on a single contiguous character buffer. For files, this is
+ * (if requested) the memory-mapped file, or the file contents; for strings,
+ * it is the string itself. For streams (such as standard input), the buffer
+ * is refilled in chunks: when the end of the buffer is reached, the
+ * characters of the token being lexed are moved to the front and the
+ * remainder of the buffer is filled from the stream. This way, arbitrarily
+ * large inputs can be processed with a buffer that is only as large as the
+ * largest token, and no input is read before it is needed, which is
+ * important for interactive use.
+ *
+ * The text of a token is returned as a view into this buffer. It is valid
+ * until the next token is requested via peekToken() after a call to
+ * consumeToken().
+ */
+class Smt2FastLexer
+{
+ public:
+  Smt2FastLexer();
+  ~Smt2FastLexer();
+
+  /**
+   * Use the file with the given name as input. If useMmap is true (and the
+   * platform supports it), the file is memory-mapped, otherwise it is read
+   * in chunks as a stream.
+   *
+   * @return false if the file could not be opened.
+   */
+  bool initFile(const std::string& filename, bool useMmap);
+  /** Use the given stream as input. The stream must outlive the lexer. */
+  void initStream(std::istream& input);
+  /** Use (a copy of) the given string as input. */
+  void initString(const std::string& input);
+
+  /**
+   * Get the next token without consuming it. Calling this repeatedly without
+   * a call to consumeToken() in between returns the same token.
+   */
+  Smt2Token peekToken();
+  /** Get the text of the token last returned by peekToken(). */
+  std::string_view tokenText() const
+  {
+    return std::string_view(d_begin + d_tokStart, d_tokEnd - d_tokStart);
+  }
+  /** Consume the token last returned by peekToken(). */
+  void consumeToken() { d_peeked = false; }
+
+  /** Get the line of the current token (1-based). */
+  size_t getLine() const { return d_tokLine; }
+  /** Get the column of the current token (0-based). */
+  size_t getColumn() const { return d_tokColumn; }
+  /** Get the contents of the line of the current token, for error messages. */
+  std::string getLineText() const;
+
+  /**
+   * Whether "" is an escape sequence for a double quote within string
+   * literals (SMT-LIB >= 2.5). If false, the backslash is the escape
+   * character instead.
+   */
+  void setEscapeDupDblQuote(bool v) { d_escapeDupDblQuote = v; }
+
+ private:
+  /** The size of a chunk read from a stream at once. */
+  static constexpr size_t s_chunkSize = 1 << 16;
+
+  /**
+   * Return the character at the given offset from the current position, or
+   * -1 at the end of input. May refill (and move) the buffer when reading
+   * from a stream.
+   */
+  int peekChar(size_t offset = 0)
+  {
+    if (d_pos + offset < d_end || refill(d_pos + offset + 1))
+    {
+      return static_cast<unsigned char>(d_begin[d_pos + offset]);
+    }
+    return -1;
+  }
+  /** Advance the current position by one character. */
+  void advance()
+  {
+    if (d_begin[d_pos] == '\n')
+    {
+      ++d_line;
+      d_column = 0;
+    }
+    else
+    {
+      ++d_column;
+    }
+    ++d_pos;
+  }
+  /**
+   * Read more input from the stream until the buffer holds at least
+   * `required` characters. Characters before the start of the current token
+   * are discarded. Returns false if the input ends before that.
+   */
+  bool refill(size_t required);
+  /** Skip whitespace and comments. */
+  void skipWhitespace();
+  /** Lex the next token starting at the current position. */
+  Smt2Token lexToken();
+  /** Advance over all characters that may appear in a simple symbol. */
+  void lexSymbolChars();
+
+  /** Start of the buffer. */
+  const char* d_begin;
+  /** Current position and end of the valid part of the buffer. */
+  size_t d_pos;
+  size_t d_end;
+  /** Start and end of the text of the current token. */
+  size_t d_tokStart;
+  size_t d_tokEnd;
+  /** Current line and column. */
+  size_t d_line;
+  size_t d_column;
+  /** Line and column of the current token. */
+  size_t d_tokLine;
+  size_t d_tokColumn;
+  /** The current token, if d_peeked is true. */
+  Smt2Token d_token;
+  bool d_peeked;
+  bool d_escapeDupDblQuote;
+
+  /** The stream to refill from, or null if the buffer holds all input. */
+  std::istream* d_stream;
+  /** A stream owned by the lexer (for non-memory-mapped files). */
+  std::unique_ptr<std::istream> d_ownedStream;
+  /** Storage for streamed and string input. */
+  std::vector<char> d_storage;
+  /** The memory-mapped file, if any. */
+  void* d_mmapData;
+  size_t d_mmapSize;
+}; /* class Smt2FastLexer */
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC5__PARSER__SMT2__SMT2_FAST_LEXER_H */
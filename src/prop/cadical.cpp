@@ -12,12 +12,16 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors and
+ * CDCL(T) engine).
  */
 
 #include "prop/cadical.h"
 
 #include "base/check.h"
+#include "context/context.h"
+#include "prop/theory_proxy.h"
+#include "util/resource_manager.h"
 #include "util/statistics_registry.h"
 
 namespace cvc5 {
@@ -62,6 +66,12 @@ CadicalSolver::CadicalSolver(StatisticsRegistry& registry,
       //       literals are represented as the negation of the index.
       d_nextVarIdx(1),
       d_inSatMode(false),
+      d_context(nullptr),
+      d_proxy(nullptr),
+      d_inSearch(false),
+      d_modelPushed(false),
+      d_interrupted(false),
+      d_terminator(d_interrupted),
       d_statistics(registry, name)
 {
 }
@@ -81,14 +91,28 @@ void CadicalSolver::init()
 CadicalSolver::~CadicalSolver() {}
 
 ClauseId CadicalSolver::addClause(SatClause& clause, bool removable)
+{
+  if (d_inSearch)
+  {
+    d_lemmas.push_back(clause);
+    return ClauseIdError;
+  }
+  addClauseInternal(clause);
+  ++d_statistics.d_numClauses;
+  return ClauseIdError;
+}
+
+void CadicalSolver::addClauseInternal(const SatClause& clause)
 {
   for (const SatLiteral& lit : clause)
   {
     d_solver->add(toCadicalLit(lit));
   }
+  if (!d_activation.empty())
+  {
+    d_solver->add(-toCadicalVar(d_activation.back()));
+  }
   d_solver->add(0);
-  ++d_statistics.d_numClauses;
-  return ClauseIdError;
 }
 
 ClauseId CadicalSolver::addXorClause(SatClause& clause,
@@ -103,6 +127,15 @@ SatVariable CadicalSolver::newVar(bool isTheoryAtom,
                                   bool canErase)
 {
   ++d_statistics.d_numVariables;
+  if (d_proxy != nullptr)
+  {
+    d_theoryAtoms.resize(d_nextVarIdx + 1, false);
+    d_theoryAtoms[d_nextVarIdx] = isTheoryAtom;
+    if (preRegister && d_modelPushed)
+    {
+      d_toRegister.push_back(d_nextVarIdx);
+    }
+  }
   return d_nextVarIdx++;
 }
 
@@ -112,6 +145,10 @@ SatVariable CadicalSolver::falseVar() { return d_false; }
 
 SatValue CadicalSolver::solve()
 {
+  if (d_proxy != nullptr)
+  {
+    return solveCDCLT({});
+  }
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
   SatValue res = toSatValue(d_solver->solve());
@@ -127,6 +164,10 @@ SatValue CadicalSolver::solve(long unsigned int&)
 
 SatValue CadicalSolver::solve(const std::vector<SatLiteral>& assumptions)
 {
+  if (d_proxy != nullptr)
+  {
+    return solveCDCLT(assumptions);
+  }
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
   for (const SatLiteral& lit : assumptions)
@@ -157,10 +198,26 @@ void CadicalSolver::getUnsatAssumptions(std::vector<SatLiteral>& assumptions)
   }
 }
 
-void CadicalSolver::interrupt() { d_solver->terminate(); }
+void CadicalSolver::interrupt()
+{
+  d_interrupted.store(true);
+  d_solver->terminate();
+}
 
 SatValue CadicalSolver::value(SatLiteral l)
 {
+  if (d_proxy != nullptr)
+  {
+    // only the assignment under check (or the model) has values
+    SatVariable var = l.getSatVariable();
+    if (!d_modelPushed || var >= d_model.size())
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    SatValue res = d_model[var];
+    return (res == SAT_VALUE_UNKNOWN || !l.isNegated()) ? res
+                                                        : invertValue(res);
+  }
   Assert(d_inSatMode);
   return toSatValueLit(d_solver->val(toCadicalLit(l)));
 }
@@ -173,18 +230,183 @@ SatValue CadicalSolver::modelValue(SatLiteral l)
 
 unsigned CadicalSolver::getAssertionLevel() const
 {
-  Unreachable() << "CaDiCaL does not support assertion levels.";
+  return d_activation.size();
 }
 
 bool CadicalSolver::ok() const { return d_inSatMode; }
 
+void CadicalSolver::initialize(context::Context* context,
+                               prop::TheoryProxy* theoryProxy,
+                               context::UserContext* userContext,
+                               ProofNodeManager* pnm)
+{
+  Assert(pnm == nullptr) << "CaDiCaL does not produce proofs";
+  d_context = context;
+  d_proxy = theoryProxy;
+  d_theoryAtoms.resize(d_nextVarIdx, false);
+  d_solver->connect_terminator(&d_terminator);
+}
+
+void CadicalSolver::push()
+{
+  popModel();
+  d_context->push();
+  d_activation.push_back(newVar());
+}
+
+void CadicalSolver::pop()
+{
+  Assert(!d_activation.empty());
+  popModel();
+  // permanently disable the clauses of the popped level
+  d_solver->add(-toCadicalVar(d_activation.back()));
+  d_solver->add(0);
+  d_activation.pop_back();
+  d_context->pop();
+}
+
+void CadicalSolver::resetTrail() { popModel(); }
+
+bool CadicalSolver::properExplanation(SatLiteral lit, SatLiteral expl) const
+{
+  return true;
+}
+
+void CadicalSolver::requirePhase(SatLiteral lit)
+{
+  d_solver->phase(toCadicalLit(lit));
+}
+
+bool CadicalSolver::isDecision(SatVariable decn) const { return false; }
+
+std::shared_ptr<ProofNode> CadicalSolver::getProof() { return nullptr; }
+
+SatValue CadicalSolver::solveCDCLT(const std::vector<SatLiteral>& assumptions)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
+  popModel();
+  d_assumptions = assumptions;
+  SatValue res = SAT_VALUE_UNKNOWN;
+  while (!d_interrupted.load())
+  {
+    for (const SatLiteral& lit : d_assumptions)
+    {
+      d_solver->assume(toCadicalLit(lit));
+    }
+    for (SatVariable var : d_activation)
+    {
+      d_solver->assume(toCadicalVar(var));
+    }
+    ++d_statistics.d_numSatCalls;
+    res = toSatValue(d_solver->solve());
+    if (res != SAT_VALUE_TRUE)
+    {
+      break;
+    }
+    bool accepted = checkModel();
+    if (d_interrupted.load())
+    {
+      res = SAT_VALUE_UNKNOWN;
+      break;
+    }
+    if (accepted)
+    {
+      break;
+    }
+    // refine the Boolean abstraction and search again
+    popModel();
+    for (const SatClause& clause : d_lemmas)
+    {
+      addClauseInternal(clause);
+    }
+    d_statistics.d_numLemmas += d_lemmas.size();
+    d_statistics.d_numClauses += d_lemmas.size();
+    d_lemmas.clear();
+    d_proxy->notifyRestart();
+    res = SAT_VALUE_UNKNOWN;
+  }
+  d_inSatMode = (res == SAT_VALUE_TRUE);
+  d_interrupted.store(false);
+  return res;
+}
+
+bool CadicalSolver::checkModel()
+{
+  Assert(!d_modelPushed);
+  Assert(d_lemmas.empty());
+  ++d_statistics.d_numTheoryChecks;
+  // variables that do not occur in any clause are unknown to CaDiCaL
+  SatVariable maxVar = static_cast<SatVariable>(d_solver->vars());
+  d_model.assign(d_nextVarIdx, SAT_VALUE_UNKNOWN);
+  for (SatVariable var = 1; var < d_nextVarIdx && var <= maxVar; ++var)
+  {
+    int val = d_solver->val(toCadicalVar(var));
+    if (val != 0)
+    {
+      d_model[var] = toSatValueLit(val);
+    }
+  }
+
+  d_context->push();
+  d_modelPushed = true;
+  d_inSearch = true;
+  for (SatVariable var = 1; var < d_nextVarIdx; ++var)
+  {
+    if (d_theoryAtoms[var] && d_model[var] != SAT_VALUE_UNKNOWN)
+    {
+      d_proxy->enqueueTheoryLiteral(
+          SatLiteral(var, d_model[var] == SAT_VALUE_FALSE));
+    }
+  }
+  do
+  {
+    d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+    // Propagations that contradict the assignment are conflicts, which have
+    // to be explained. All others are implied by the assignment anyway.
+    SatClause propagated;
+    d_proxy->theoryPropagate(propagated);
+    for (const SatLiteral& lit : propagated)
+    {
+      if (value(lit) == SAT_VALUE_FALSE)
+      {
+        SatClause explanation;
+        d_proxy->explainPropagation(lit, explanation);
+        d_lemmas.push_back(explanation);
+      }
+    }
+  } while (d_lemmas.empty() && d_proxy->theoryNeedCheck()
+           && !d_interrupted.load());
+  d_inSearch = false;
+  return d_lemmas.empty();
+}
+
+void CadicalSolver::popModel()
+{
+  if (!d_modelPushed)
+  {
+    return;
+  }
+  d_context->pop();
+  d_modelPushed = false;
+  d_inSatMode = false;
+  // variables created during the check were registered in the popped level
+  for (SatVariable var : d_toRegister)
+  {
+    d_proxy->variableNotify(var);
+  }
+  d_toRegister.clear();
+}
+
 CadicalSolver::Statistics::Statistics(StatisticsRegistry& registry,
                                       const std::string& prefix)
     : d_numSatCalls(registry.registerInt(prefix + "cadical::calls_to_solve", 0)),
       d_numVariables(registry.registerInt(prefix + "cadical::variables", 0)),
       d_numClauses(registry.registerInt(prefix + "cadical::clauses", 0)),
-      d_solveTime(registry.registerTimer(prefix + "cadical::solve_time"))
-  {
+      d_solveTime(registry.registerTimer(prefix + "cadical::solve_time")),
+      d_numTheoryChecks(
+          registry.registerInt(prefix + "cadical::theory_checks", 0)),
+      d_numLemmas(registry.registerInt(prefix + "cadical::lemmas", 0))
+{
 }
 
 }  // namespace prop
@@ -12,7 +12,8 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors and
+ * CDCL(T) engine).
  */
 
 #include "cvc5_private.h"
@@ -20,6 +21,9 @@
 #ifndef CVC5__PROP__CADICAL_H
 #define CVC5__PROP__CADICAL_H
 
+#include <atomic>
+#include <vector>
+
 #include "prop/sat_solver.h"
 
 #include <cadical.hpp>
@@ -27,7 +31,23 @@
 namespace cvc5 {
 namespace prop {
 
-class CadicalSolver : public SatSolver
+/**
+ * CaDiCaL as plain SAT solver (e.g. for bit-blasting) or as SAT solver of the
+ * CDCL(T) engine, in which case initialize() must be called.
+ *
+ * The CaDiCaL version we use does not allow to interact with its search,
+ * hence the CDCL(T) engine is a lazy loop: every satisfying assignment found
+ * by CaDiCaL is asserted to the theories as a whole in a new level of the SAT
+ * context, followed by a full effort check. Lemmas (and conflicts) obtained
+ * from the check are buffered, added after the SAT context level was popped
+ * and the loop continues. If the theories do not object, the assignment is a
+ * model and the SAT context level is kept until resetTrail().
+ *
+ * User levels are implemented with activation literals: clauses added at user
+ * level i > 0 contain the negation of the activation literal of level i, which
+ * is assumed while the level exists, and asserted to false once it is popped.
+ */
+class CadicalSolver : public CDCLTSatSolverInterface
 {
   friend class SatSolverFactory;
 
@@ -62,7 +82,40 @@ class CadicalSolver : public SatSolver
 
   bool ok() const override;
 
+  void initialize(context::Context* context,
+                  prop::TheoryProxy* theoryProxy,
+                  context::UserContext* userContext,
+                  ProofNodeManager* pnm) override;
+
+  void push() override;
+
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  std::shared_ptr<ProofNode> getProof() override;
+
  private:
+  /** Stops the search of CaDiCaL once the solver was interrupted. */
+  class Terminator : public CaDiCaL::Terminator
+  {
+   public:
+    Terminator(const std::atomic<bool>& interrupted)
+        : d_interrupted(interrupted)
+    {
+    }
+    bool terminate() override { return d_interrupted.load(); }
+
+   private:
+    const std::atomic<bool>& d_interrupted;
+  };
+
   /**
    * Private to disallow creation outside of SatSolverFactory.
    * Function init() must be called after creation.
@@ -74,6 +127,22 @@ class CadicalSolver : public SatSolver
    */
   void init();
 
+  /** Adds clause to CaDiCaL, relative to the current user level. */
+  void addClauseInternal(const SatClause& clause);
+  /**
+   * The lazy CDCL(T) loop, see the class documentation. Returns the result
+   * for the given assumptions.
+   */
+  SatValue solveCDCLT(const std::vector<SatLiteral>& assumptions);
+  /**
+   * Asserts the current satisfying assignment to the theories and checks it.
+   * Returns true if the theories accept it, otherwise the buffered lemmas
+   * have to be added.
+   */
+  bool checkModel();
+  /** Pops the SAT context level of the last checked assignment, if any. */
+  void popModel();
+
   std::unique_ptr<CaDiCaL::Solver> d_solver;
   /**
    * Stores the current set of assumptions provided via solve() and is used to
@@ -86,12 +155,40 @@ class CadicalSolver : public SatSolver
   SatVariable d_true;
   SatVariable d_false;
 
+  /** The SAT context, only set for the CDCL(T) engine. */
+  context::Context* d_context;
+  /** The theory proxy, only set for the CDCL(T) engine. */
+  TheoryProxy* d_proxy;
+  /** Whether the variable with the same index is a theory atom. */
+  std::vector<bool> d_theoryAtoms;
+  /** The activation variable of every user level. */
+  std::vector<SatVariable> d_activation;
+  /** Whether an assignment is being checked, clauses are buffered meanwhile. */
+  bool d_inSearch;
+  /** Whether the SAT context level of a checked assignment exists. */
+  bool d_modelPushed;
+  /** The assignment that was last found, indexed by variable. */
+  std::vector<SatValue> d_model;
+  /** The clauses added while checking an assignment. */
+  std::vector<SatClause> d_lemmas;
+  /**
+   * Variables created while checking an assignment that are registered with
+   * the theories again once its SAT context level is popped.
+   */
+  std::vector<SatVariable> d_toRegister;
+  /** Set by interrupt(), may be accessed concurrently. */
+  std::atomic<bool> d_interrupted;
+  /** Terminates CaDiCaL once d_interrupted is set. */
+  Terminator d_terminator;
+
   struct Statistics
   {
     IntStat d_numSatCalls;
     IntStat d_numVariables;
     IntStat d_numClauses;
     TimerStat d_solveTime;
+    IntStat d_numTheoryChecks;
+    IntStat d_numLemmas;
     Statistics(StatisticsRegistry& registry, const std::string& prefix);
   };
 
@@ -15,7 +15,9 @@
  */
 #include "prop/cnf_stream.h"
 
+#include <algorithm>
 #include <queue>
+#include <thread>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -32,6 +34,7 @@
 #include "smt/smt_statistics_registry.h"
 #include "theory/theory.h"
 #include "theory/theory_engine.h"
+#include "util/hash.h"
 
 namespace cvc5 {
 namespace prop {
@@ -42,13 +45,18 @@ CnfStream::CnfStream(SatSolver* satSolver,
                      OutputManager* outMgr,
                      ResourceManager* rm,
                      FormulaLitPolicy flpol,
-                     std::string name)
+                     std::string name,
+                     bool optimize)
     : d_satSolver(satSolver),
       d_outMgr(outMgr),
       d_booleanVariables(context),
       d_notifyFormulas(context),
       d_nodeToLiteralMap(context),
       d_literalToNodeMap(context),
+      d_optimize(optimize && flpol != FormulaLitPolicy::TRACK_AND_NOTIFY),
+      d_gates(context),
+      d_gateDefinitions(context),
+      d_gatePolarity(context),
       d_flitPolicy(flpol),
       d_registrar(registrar),
       d_name(name),
@@ -144,6 +152,11 @@ void CnfStream::ensureLiteral(TNode n)
   TimerStat::CodeTimer codeTimer(d_stats.d_cnfConversionTime, true);
   if (hasLiteral(n))
   {
+    if (d_optimize)
+    {
+      // the literal may only be defined for one polarity so far
+      definePolarity(getLiteral(n), POL_BOTH);
+    }
     ensureMappingForLiteral(n);
     return;
   }
@@ -473,11 +486,24 @@ void CnfStream::handleIte(TNode iteNode)
   assertClause(iteNode, iteLit, condLit, ~elseLit);
 }
 
-SatLiteral CnfStream::toCNF(TNode node, bool negated)
+SatLiteral CnfStream::toCNF(TNode node, bool negated, bool oneSided)
 {
   Trace("cnf") << "toCNF(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
 
+  if (d_optimize)
+  {
+    buildGates(node);
+    SatLiteral lit = getLiteral(node);
+    if (negated)
+    {
+      lit = ~lit;
+    }
+    definePolarity(lit, oneSided ? POL_POS : POL_BOTH);
+    Trace("cnf") << "toCNF(): resulting literal: " << lit << "\n";
+    return lit;
+  }
+
   TNode cur;
   SatLiteral nodeLit;
   std::vector<TNode> visit;
@@ -546,6 +572,421 @@ SatLiteral CnfStream::toCNF(TNode node, bool negated)
   return negated ? ~nodeLit : nodeLit;
 }
 
+size_t CnfStream::GateHashFunction::operator()(const Gate& g) const
+{
+  uint64_t hash = fnv1a::fnv1a_64(static_cast<uint64_t>(g.d_kind));
+  for (const SatLiteral& l : g.d_inputs)
+  {
+    hash = fnv1a::fnv1a_64(l.toInt(), hash);
+  }
+  return static_cast<size_t>(hash);
+}
+
+namespace {
+
+/** Whether node is a Boolean connective that is translated into a gate. */
+bool isGateKind(TNode node)
+{
+  switch (node.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::XOR:
+    case kind::IMPLIES:
+    case kind::ITE: return true;
+    case kind::EQUAL: return node[0].getType().isBoolean();
+    default: return false;
+  }
+}
+
+/** The number of clauses of the Tseitin encoding of node. */
+int64_t tseitinClauses(TNode node)
+{
+  switch (node.getKind())
+  {
+    case kind::AND:
+    case kind::OR: return node.getNumChildren() + 1;
+    case kind::IMPLIES: return 3;
+    case kind::ITE: return 6;
+    default: return 4;
+  }
+}
+
+}  // namespace
+
+void CnfStream::buildGates(TNode node)
+{
+  // Count the references to the nodes without literal, only nodes that are
+  // referenced once are merged into their parent gate.
+  RefCountMap refs;
+  std::vector<TNode> visit;
+  visit.push_back(node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (hasLiteral(cur) || ++refs[cur] > 1 || !isGateKind(cur))
+    {
+      continue;
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  }
+
+  std::unordered_map<TNode, bool> cache;
+  std::vector<TNode> inputs;
+  visit.push_back(node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    Assert(cur.getType().isBoolean());
+
+    if (hasLiteral(cur))
+    {
+      visit.pop_back();
+      continue;
+    }
+
+    const auto& it = cache.find(cur);
+    if (it == cache.end())
+    {
+      cache.emplace(cur, false);
+      Kind k = cur.getKind();
+      if (k == kind::AND || k == kind::OR)
+      {
+        inputs.clear();
+        collectGateInputs(cur, refs, inputs, nullptr);
+        visit.insert(visit.end(), inputs.begin(), inputs.end());
+      }
+      else if (isGateKind(cur))
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+      continue;
+    }
+    else if (!it->second)
+    {
+      it->second = true;
+      if (cur.getKind() == kind::NOT)
+      {
+        Assert(hasLiteral(cur[0]));
+      }
+      else if (isGateKind(cur))
+      {
+        Assert(!d_removable)
+            << "Removable clauses can not contain Boolean structure";
+        mapToLiteral(cur, defineGate(cur, refs));
+      }
+      else
+      {
+        convertAtom(cur);
+      }
+    }
+    visit.pop_back();
+  }
+}
+
+void CnfStream::collectGateInputs(TNode node,
+                                  const RefCountMap& refs,
+                                  std::vector<TNode>& inputs,
+                                  std::vector<TNode>* flattened) const
+{
+  Kind k = node.getKind();
+  std::vector<TNode> visit(node.begin(), node.end());
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (cur.getKind() == k && !hasLiteral(cur))
+    {
+      RefCountMap::const_iterator it = refs.find(cur);
+      if (it != refs.end() && it->second == 1)
+      {
+        if (flattened != nullptr)
+        {
+          flattened->push_back(cur);
+        }
+        visit.insert(visit.end(), cur.begin(), cur.end());
+        continue;
+      }
+    }
+    inputs.push_back(cur);
+  }
+}
+
+SatLiteral CnfStream::defineGate(TNode node, const RefCountMap& refs)
+{
+  Trace("cnf") << "defineGate(" << node << ")\n";
+  std::vector<TNode> flattened;
+  SatLiteral res;
+  switch (node.getKind())
+  {
+    case kind::AND:
+    case kind::OR:
+    {
+      // (or a_1 ... a_n) is (not (and (not a_1) ... (not a_n)))
+      bool isOr = node.getKind() == kind::OR;
+      std::vector<TNode> inputs;
+      collectGateInputs(node, refs, inputs, &flattened);
+      std::vector<SatLiteral> lits;
+      for (TNode in : inputs)
+      {
+        SatLiteral lit = getLiteral(in);
+        lits.push_back(isOr ? ~lit : lit);
+      }
+      res = mkAndGate(lits);
+      if (isOr)
+      {
+        res = ~res;
+      }
+      break;
+    }
+    case kind::IMPLIES:
+    {
+      // (=> a b) is (not (and a (not b)))
+      std::vector<SatLiteral> lits{getLiteral(node[0]), ~getLiteral(node[1])};
+      res = ~mkAndGate(lits);
+      break;
+    }
+    case kind::XOR:
+      res = mkXorGate(getLiteral(node[0]), getLiteral(node[1]));
+      break;
+    case kind::EQUAL:
+      res = ~mkXorGate(getLiteral(node[0]), getLiteral(node[1]));
+      break;
+    case kind::ITE:
+      res = mkIteGate(
+          getLiteral(node[0]), getLiteral(node[1]), getLiteral(node[2]));
+      break;
+    default: Unreachable() << "Unexpected gate " << node;
+  }
+  int64_t tseitin = tseitinClauses(node);
+  for (TNode f : flattened)
+  {
+    tseitin += tseitinClauses(f);
+  }
+  d_stats.d_clausesSaved += tseitin;
+  d_stats.d_gatesFlattened += flattened.size();
+  return res;
+}
+
+SatLiteral CnfStream::mkAndGate(std::vector<SatLiteral>& lits)
+{
+  Assert(!lits.empty());
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+  // complementary literals are adjacent after sorting
+  for (size_t i = 1, size = lits.size(); i < size; ++i)
+  {
+    if (lits[i] == ~lits[i - 1])
+    {
+      return getConstantLiteral(false);
+    }
+  }
+  if (lits.size() == 1)
+  {
+    return lits[0];
+  }
+  return mkGate(Gate{GateKind::AND, lits});
+}
+
+SatLiteral CnfStream::mkXorGate(SatLiteral a, SatLiteral b)
+{
+  // pull the negations out of the gate
+  bool negated = a.isNegated() != b.isNegated();
+  a = SatLiteral(a.getSatVariable());
+  b = SatLiteral(b.getSatVariable());
+  if (a == b)
+  {
+    return getConstantLiteral(negated);
+  }
+  if (b < a)
+  {
+    std::swap(a, b);
+  }
+  SatLiteral res = mkGate(Gate{GateKind::XOR, {a, b}});
+  return negated ? ~res : res;
+}
+
+SatLiteral CnfStream::mkIteGate(SatLiteral c, SatLiteral t, SatLiteral e)
+{
+  // (ite (not c) t e) is (ite c e t)
+  if (c.isNegated())
+  {
+    c = ~c;
+    std::swap(t, e);
+  }
+  if (t == e)
+  {
+    return t;
+  }
+  // (ite c (not t) e) is (not (ite c t (not e)))
+  bool negated = t.isNegated();
+  if (negated)
+  {
+    t = ~t;
+    e = ~e;
+  }
+  SatLiteral res = mkGate(Gate{GateKind::ITE, {c, t, e}});
+  return negated ? ~res : res;
+}
+
+SatLiteral CnfStream::mkGate(const Gate& g)
+{
+  auto it = d_gates.find(g);
+  if (it != d_gates.end())
+  {
+    ++d_stats.d_gatesShared;
+    return SatLiteral((*it).second);
+  }
+  SatVariable var = d_satSolver->newVar(false, false, true);
+  d_gates.insert(g, var);
+  d_gateDefinitions.insert(var, g);
+  d_gatePolarity.insert(var, 0);
+  return SatLiteral(var);
+}
+
+SatLiteral CnfStream::getConstantLiteral(bool value)
+{
+  Node c = NodeManager::currentNM()->mkConst(value);
+  if (!hasLiteral(c))
+  {
+    convertAtom(c);
+  }
+  return getLiteral(c);
+}
+
+void CnfStream::definePolarity(SatLiteral lit, uint8_t pol)
+{
+  // flips the polarity for a negated literal
+  auto polarityOf = [](SatLiteral l, uint8_t p) -> uint8_t {
+    if (!l.isNegated() || p == POL_BOTH)
+    {
+      return p;
+    }
+    return p ^ POL_BOTH;
+  };
+  // Definitional clauses must not be removed, regardless of the clause that
+  // made them necessary.
+  bool backupRemovable = d_removable;
+  d_removable = false;
+  std::vector<std::pair<SatVariable, uint8_t>> visit;
+  visit.emplace_back(lit.getSatVariable(), polarityOf(lit, pol));
+  while (!visit.empty())
+  {
+    SatVariable var = visit.back().first;
+    uint8_t p = visit.back().second;
+    visit.pop_back();
+    auto it = d_gatePolarity.find(var);
+    if (it == d_gatePolarity.end())
+    {
+      // not a gate of the optimized encoding
+      continue;
+    }
+    uint8_t defined = (*it).second;
+    uint8_t missing = p & ~defined;
+    if (missing == 0)
+    {
+      continue;
+    }
+    d_gatePolarity.insert(var, defined | missing);
+    const Gate& g = d_gateDefinitions[var];
+    assertGateClauses(var, g, missing);
+    for (size_t i = 0, size = g.d_inputs.size(); i < size; ++i)
+    {
+      SatLiteral in = g.d_inputs[i];
+      // the inputs of XOR gates and the conditions of ITE gates occur in
+      // both polarities
+      uint8_t inPol = missing;
+      if (g.d_kind == GateKind::XOR || (g.d_kind == GateKind::ITE && i == 0))
+      {
+        inPol = POL_BOTH;
+      }
+      visit.emplace_back(in.getSatVariable(), polarityOf(in, inPol));
+    }
+  }
+  d_removable = backupRemovable;
+}
+
+void CnfStream::assertGateClauses(SatVariable var, const Gate& g, uint8_t pol)
+{
+  SatLiteral out(var);
+  int64_t asserted = 0;
+  const std::vector<SatLiteral>& in = g.d_inputs;
+  switch (g.d_kind)
+  {
+    case GateKind::AND:
+      if (pol & POL_POS)
+      {
+        // out -> (a_1 & ... & a_n)
+        for (const SatLiteral& a : in)
+        {
+          assertClause(TNode::null(), ~out, a);
+        }
+        asserted += in.size();
+      }
+      if (pol & POL_NEG)
+      {
+        // (a_1 & ... & a_n) -> out
+        SatClause clause;
+        for (const SatLiteral& a : in)
+        {
+          clause.push_back(~a);
+        }
+        clause.push_back(out);
+        assertClause(TNode::null(), clause);
+        asserted += 1;
+      }
+      break;
+    case GateKind::XOR:
+      if (pol & POL_POS)
+      {
+        // out -> (a xor b)
+        assertClause(TNode::null(), ~out, in[0], in[1]);
+        assertClause(TNode::null(), ~out, ~in[0], ~in[1]);
+        asserted += 2;
+      }
+      if (pol & POL_NEG)
+      {
+        // (a xor b) -> out
+        assertClause(TNode::null(), out, ~in[0], in[1]);
+        assertClause(TNode::null(), out, in[0], ~in[1]);
+        asserted += 2;
+      }
+      break;
+    case GateKind::ITE:
+      if (pol & POL_POS)
+      {
+        // out -> (ite c t e)
+        assertClause(TNode::null(), ~out, ~in[0], in[1]);
+        assertClause(TNode::null(), ~out, in[0], in[2]);
+        asserted += 2;
+      }
+      if (pol & POL_NEG)
+      {
+        // (ite c t e) -> out
+        assertClause(TNode::null(), out, ~in[0], ~in[1]);
+        assertClause(TNode::null(), out, in[0], ~in[2]);
+        asserted += 2;
+      }
+      break;
+  }
+  d_stats.d_clausesSaved += -asserted;
+}
+
+void CnfStream::mapToLiteral(TNode node, SatLiteral lit)
+{
+  Trace("cnf") << "mapToLiteral(" << node << ") => " << lit << "\n";
+  Assert(node.getKind() != kind::NOT);
+  d_nodeToLiteralMap.insert(node, lit);
+  d_nodeToLiteralMap.insert(node.notNode(), ~lit);
+  if (d_flitPolicy == FormulaLitPolicy::TRACK || Dump.isOn("clauses"))
+  {
+    d_literalToNodeMap.insert_safe(lit, node);
+    d_literalToNodeMap.insert_safe(~lit, node.notNode());
+  }
+}
+
 void CnfStream::convertAndAssertAnd(TNode node, bool negated)
 {
   Assert(node.getKind() == kind::AND);
@@ -564,7 +1005,7 @@ void CnfStream::convertAndAssertAnd(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, true);
+      clause[i] = toCNF(*disjunct, true, true);
     }
     Assert(disjunct == node.end());
     assertClause(node.negate(), clause);
@@ -583,7 +1024,7 @@ void CnfStream::convertAndAssertOr(TNode node, bool negated)
     TNode::const_iterator disjunct = node.begin();
     for(int i = 0; i < nChildren; ++ disjunct, ++ i) {
       Assert(disjunct != node.end());
-      clause[i] = toCNF(*disjunct, false);
+      clause[i] = toCNF(*disjunct, false, true);
     }
     Assert(disjunct == node.end());
     assertClause(node, clause);
@@ -671,11 +1112,11 @@ void CnfStream::convertAndAssertImplies(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // p => q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral np = toCNF(node[0], true, true);
+    SatLiteral q = toCNF(node[1], false, true);
     // Construct the clause ~p || q
     SatClause clause(2);
-    clause[0] = ~p;
+    clause[0] = np;
     clause[1] = q;
     assertClause(node, clause);
   } else {// Construct the
@@ -692,8 +1133,8 @@ void CnfStream::convertAndAssertIte(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   // ITE(p, q, r)
   SatLiteral p = toCNF(node[0], false);
-  SatLiteral q = toCNF(node[1], negated);
-  SatLiteral r = toCNF(node[2], negated);
+  SatLiteral q = toCNF(node[1], negated, true);
+  SatLiteral r = toCNF(node[2], negated, true);
   // Construct the clauses:
   // (p => q) and (!p => r)
   //
@@ -758,15 +1199,297 @@ void CnfStream::convertAndAssert(TNode node, bool negated)
         nnode = node.negate();
       }
       // Atoms
-      assertClause(nnode, toCNF(node, negated));
+      assertClause(nnode, toCNF(node, negated, true));
   }
     break;
   }
 }
 
+namespace {
+
+/** Whether n is a connective that gets a definitional literal. */
+bool isConnective(TNode n)
+{
+  Kind k = n.getKind();
+  return k == kind::AND || k == kind::OR || k == kind::XOR
+         || k == kind::IMPLIES || k == kind::ITE
+         || (k == kind::EQUAL && n[0].getType().isBoolean());
+}
+
+}  // namespace
+
+void CnfStream::convertInParallel(const std::vector<Node>& assertions,
+                                  const std::vector<Node>& definitions,
+                                  size_t numThreads)
+{
+  if (d_optimize || numThreads <= 1)
+  {
+    for (const Node& a : assertions)
+    {
+      convertAndAssert(a, false, false);
+    }
+    for (const Node& d : definitions)
+    {
+      ensureLiteral(d);
+    }
+    return;
+  }
+  Trace("cnf") << "convertInParallel(" << assertions.size() << " assertions, "
+               << definitions.size() << " definitions)\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_cnfConversionTime, true);
+  d_removable = false;
+
+  // Introduce all literals sequentially. The top-level structure of the
+  // assertions is handled by convertAndAssert() below.
+  std::vector<ParallelGate> gates;
+  std::vector<SatLiteral> inputs;
+  for (const Node& a : assertions)
+  {
+    collectAssertedGates(a, false, gates, inputs);
+  }
+  for (const Node& d : definitions)
+  {
+    collectParallelGates(d, gates, inputs);
+  }
+
+  // Generate the definitional clauses of consecutive ranges of gates.
+  size_t numGates = gates.size();
+  numThreads = std::max<size_t>(
+      1,
+      std::min(numThreads,
+               (numGates + s_minParallelGates - 1) / s_minParallelGates));
+  std::vector<std::vector<std::pair<size_t, SatClause>>> buffers(numThreads);
+  auto encodeRange = [&gates, &inputs, &buffers, numGates, numThreads](
+                         size_t t) {
+    std::vector<SatClause> clauses;
+    for (size_t i = numGates * t / numThreads,
+                end = numGates * (t + 1) / numThreads;
+         i < end;
+         ++i)
+    {
+      clauses.clear();
+      encodeParallelGate(gates[i], inputs, clauses);
+      for (SatClause& c : clauses)
+      {
+        buffers[t].emplace_back(i, std::move(c));
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < numThreads; ++t)
+  {
+    threads.emplace_back(encodeRange, t);
+  }
+  encodeRange(0);
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Merge the buffers in order.
+  for (std::vector<std::pair<size_t, SatClause>>& buffer : buffers)
+  {
+    for (std::pair<size_t, SatClause>& c : buffer)
+    {
+      assertClause(gates[c.first].d_node, c.second);
+    }
+  }
+  for (const Node& a : assertions)
+  {
+    convertAndAssert(a, false);
+  }
+  for (const Node& d : definitions)
+  {
+    ensureLiteral(d);
+  }
+}
+
+void CnfStream::collectAssertedGates(TNode node,
+                                     bool negated,
+                                     std::vector<ParallelGate>& gates,
+                                     std::vector<SatLiteral>& inputs)
+{
+  // follows convertAndAssert(), which converts the top-level structure into
+  // clauses directly and only calls toCNF() on the operands below
+  switch (node.getKind())
+  {
+    case kind::NOT:
+      collectAssertedGates(node[0], !negated, gates, inputs);
+      break;
+    case kind::AND:
+    case kind::OR:
+      if (negated == (node.getKind() == kind::OR))
+      {
+        // a conjunction, each conjunct is asserted separately
+        for (TNode child : node)
+        {
+          collectAssertedGates(child, negated, gates, inputs);
+        }
+        break;
+      }
+      // a disjunction, which becomes a clause over its children
+      for (TNode child : node)
+      {
+        collectParallelGates(child, gates, inputs);
+      }
+      break;
+    case kind::IMPLIES:
+      if (negated)
+      {
+        collectAssertedGates(node[0], false, gates, inputs);
+        collectAssertedGates(node[1], true, gates, inputs);
+        break;
+      }
+      collectParallelGates(node[0], gates, inputs);
+      collectParallelGates(node[1], gates, inputs);
+      break;
+    case kind::XOR:
+    case kind::ITE:
+      for (TNode child : node)
+      {
+        collectParallelGates(child, gates, inputs);
+      }
+      break;
+    case kind::EQUAL:
+      if (node[0].getType().isBoolean())
+      {
+        collectParallelGates(node[0], gates, inputs);
+        collectParallelGates(node[1], gates, inputs);
+        break;
+      }
+      CVC5_FALLTHROUGH;
+    default: collectParallelGates(node, gates, inputs); break;
+  }
+}
+
+void CnfStream::collectParallelGates(TNode node,
+                                     std::vector<ParallelGate>& gates,
+                                     std::vector<SatLiteral>& inputs)
+{
+  std::vector<TNode> visit;
+  std::unordered_map<TNode, bool> visited;
+  visit.push_back(node);
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    Assert(cur.getType().isBoolean());
+    if (hasLiteral(cur))
+    {
+      visit.pop_back();
+      continue;
+    }
+    auto it = visited.find(cur);
+    if (it == visited.end())
+    {
+      visited.emplace(cur, false);
+      if (cur.getKind() == kind::NOT || isConnective(cur))
+      {
+        visit.insert(visit.end(), cur.rbegin(), cur.rend());
+      }
+      continue;
+    }
+    if (!it->second)
+    {
+      it->second = true;
+      if (cur.getKind() == kind::NOT)
+      {
+        Assert(hasLiteral(cur[0]));
+      }
+      else if (isConnective(cur))
+      {
+        ParallelGate g;
+        g.d_node = cur;
+        g.d_kind = cur.getKind();
+        g.d_lit = newLiteral(cur);
+        g.d_begin = inputs.size();
+        for (TNode child : cur)
+        {
+          inputs.push_back(getLiteral(child));
+        }
+        g.d_end = inputs.size();
+        gates.push_back(g);
+      }
+      else
+      {
+        convertAtom(cur);
+      }
+    }
+    visit.pop_back();
+  }
+}
+
+void CnfStream::encodeParallelGate(const ParallelGate& g,
+                                   const std::vector<SatLiteral>& inputs,
+                                   std::vector<SatClause>& clauses)
+{
+  SatLiteral lit = g.d_lit;
+  const SatLiteral* in = inputs.data() + g.d_begin;
+  size_t size = g.d_end - g.d_begin;
+  // the clauses are the same as those of handleAnd(), handleOr(), ...
+  switch (g.d_kind)
+  {
+    case kind::AND:
+    {
+      SatClause clause(size + 1);
+      for (size_t i = 0; i < size; ++i)
+      {
+        clauses.push_back({~lit, in[i]});
+        clause[i] = ~in[i];
+      }
+      clause[size] = lit;
+      clauses.push_back(std::move(clause));
+      break;
+    }
+    case kind::OR:
+    {
+      SatClause clause(size + 1);
+      for (size_t i = 0; i < size; ++i)
+      {
+        clauses.push_back({lit, ~in[i]});
+        clause[i] = in[i];
+      }
+      clause[size] = ~lit;
+      clauses.push_back(std::move(clause));
+      break;
+    }
+    case kind::IMPLIES:
+      clauses.push_back({~lit, ~in[0], in[1]});
+      clauses.push_back({in[0], lit});
+      clauses.push_back({~in[1], lit});
+      break;
+    case kind::EQUAL:
+      clauses.push_back({~in[0], in[1], ~lit});
+      clauses.push_back({in[0], ~in[1], ~lit});
+      clauses.push_back({~in[0], ~in[1], lit});
+      clauses.push_back({in[0], in[1], lit});
+      break;
+    case kind::XOR:
+      clauses.push_back({in[0], in[1], ~lit});
+      clauses.push_back({~in[0], ~in[1], ~lit});
+      clauses.push_back({in[0], ~in[1], lit});
+      clauses.push_back({~in[0], in[1], lit});
+      break;
+    case kind::ITE:
+      clauses.push_back({~lit, in[1], in[2]});
+      clauses.push_back({~lit, ~in[0], in[1]});
+      clauses.push_back({~lit, in[0], in[2]});
+      clauses.push_back({lit, ~in[1], ~in[2]});
+      clauses.push_back({lit, ~in[0], ~in[1]});
+      clauses.push_back({lit, in[0], ~in[2]});
+      break;
+    default: Unreachable();
+  }
+}
+
 CnfStream::Statistics::Statistics(const std::string& name)
     : d_cnfConversionTime(smtStatisticsRegistry().registerTimer(
-        name + "::CnfStream::cnfConversionTime"))
+        name + "::CnfStream::cnfConversionTime")),
+      d_clausesSaved(smtStatisticsRegistry().registerInt(
+          name + "::CnfStream::clausesSaved")),
+      d_gatesShared(smtStatisticsRegistry().registerInt(
+          name + "::CnfStream::gatesShared")),
+      d_gatesFlattened(smtStatisticsRegistry().registerInt(
+          name + "::CnfStream::gatesFlattened"))
 {
 }
 
@@ -26,6 +26,10 @@
 #ifndef CVC5__PROP__CNF_STREAM_H
 #define CVC5__PROP__CNF_STREAM_H
 
+#include <unordered_map>
+#include <vector>
+
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
 #include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
@@ -63,6 +67,22 @@ enum class FormulaLitPolicy : uint32_t
  * The general idea is to introduce a new literal that will be equivalent to
  * each subexpression in the constructed equi-satisfiable formula, then
  * substitute the new literal for the formula, and so on, recursively.
+ *
+ * If constructed with optimize = true, the CNF stream instead uses an
+ * optimized encoding:
+ * - Boolean connectives are translated into normalized gates (AND over a set
+ *   of literals, XOR, ITE) before any clause is emitted. Gates are
+ *   structurally hashed, hence e.g. (and a b), (and b a) and
+ *   (not (or (not a) (not b))) share a single SAT variable.
+ * - Nested AND (resp. OR) nodes that are only referenced once within the
+ *   converted formula are merged into their parent gate, which saves their
+ *   variables and definitional clauses.
+ * - Definitional clauses are only emitted for the polarities in which a gate
+ *   is used (Plaisted-Greenbaum). The missing polarity is added once a later
+ *   formula, or ensureLiteral(), requires it.
+ * With this encoding, the literal of a formula only implies (resp. is implied
+ * by) the formula unless it was obtained via ensureLiteral(). It must not be
+ * combined with proofs.
  */
 class CnfStream {
   friend PropEngine;
@@ -91,6 +111,8 @@ class CnfStream {
    * not-theory literals).
    * @param name string identifier to distinguish between different instances
    * even for non-theory literals.
+   * @param optimize whether to use the optimized encoding described above. It
+   * is ignored for FormulaLitPolicy::TRACK_AND_NOTIFY.
    */
   CnfStream(SatSolver* satSolver,
             Registrar* registrar,
@@ -98,7 +120,8 @@ class CnfStream {
             OutputManager* outMgr,
             ResourceManager* rm,
             FormulaLitPolicy flpol = FormulaLitPolicy::INTERNAL,
-            std::string name = "");
+            std::string name = "",
+            bool optimize = false);
   /**
    * Convert a given formula to CNF and assert it to the SAT solver.
    *
@@ -112,6 +135,24 @@ class CnfStream {
                         bool removable,
                         bool negated,
                         bool input = false);
+  /**
+   * Converts the given formulas as convertAndAssert() (neither removable nor
+   * negated) and ensureLiteral() would, respectively, but uses up to
+   * numThreads threads for the definitional clauses of the Boolean structure.
+   *
+   * The literals of all new connectives are introduced first, in a
+   * deterministic order. The definitional clauses of a connective then only
+   * depend on its literal and the literals of its children, hence the
+   * connectives are split into consecutive ranges and every thread generates
+   * the clauses of one range into its own buffer. The buffers are added to
+   * the SAT solver in order, such that the result does not depend on the
+   * scheduling of the threads.
+   *
+   * Falls back to the sequential conversion for the optimized encoding.
+   */
+  void convertInParallel(const std::vector<Node>& assertions,
+                         const std::vector<Node>& definitions,
+                         size_t numThreads);
   /**
    * Get the node that is represented by the given SatLiteral.
    * @param literal the literal from the sat solver
@@ -187,9 +228,11 @@ class CnfStream {
    *
    * @param node the formula to transform
    * @param negated whether the literal is negated
+   * @param oneSided whether the returned literal only needs to imply the
+   * (possibly negated) formula, which the optimized encoding exploits
    * @return the literal representing the root of the formula
    */
-  SatLiteral toCNF(TNode node, bool negated = false);
+  SatLiteral toCNF(TNode node, bool negated = false, bool oneSided = false);
 
   /**
    * Specific clausifiers that clausify a formula based on the given formula
@@ -202,6 +245,119 @@ class CnfStream {
   void handleAnd(TNode node);
   void handleOr(TNode node);
 
+  /** Polarity of a gate definition: the gate literal implies the gate. */
+  static constexpr uint8_t POL_POS = 1;
+  /** Polarity of a gate definition: the gate implies the gate literal. */
+  static constexpr uint8_t POL_NEG = 2;
+  /** Both polarities, i.e., the gate literal is equivalent to the gate. */
+  static constexpr uint8_t POL_BOTH = POL_POS | POL_NEG;
+
+  /** The kinds of gates of the optimized encoding. */
+  enum class GateKind : uint32_t
+  {
+    AND,
+    XOR,
+    ITE
+  };
+  /**
+   * A gate of the optimized encoding, in normal form: the inputs of an AND
+   * are sorted and free of duplicates, the inputs of an XOR are sorted and
+   * not negated, and the inputs c, t, e of an ITE have c and t not negated.
+   */
+  struct Gate
+  {
+    GateKind d_kind;
+    std::vector<SatLiteral> d_inputs;
+    bool operator==(const Gate& g) const
+    {
+      return d_kind == g.d_kind && d_inputs == g.d_inputs;
+    }
+  };
+  struct GateHashFunction
+  {
+    size_t operator()(const Gate& g) const;
+  };
+  /** Reference counts of the nodes without literal in a formula. */
+  typedef std::unordered_map<TNode, uint32_t> RefCountMap;
+
+  /**
+   * Translates the Boolean structure of node that has no literal yet into
+   * gates of the optimized encoding and assigns literals to these nodes. Does
+   * not emit definitional clauses, see definePolarity().
+   */
+  void buildGates(TNode node);
+  /**
+   * Collects the children of the AND or OR node, where children of the same
+   * kind that have no literal and are referenced only once (according to
+   * refs) are replaced by their children, recursively. Stores these nodes in
+   * flattened, if given.
+   */
+  void collectGateInputs(TNode node,
+                         const RefCountMap& refs,
+                         std::vector<TNode>& inputs,
+                         std::vector<TNode>* flattened) const;
+  /** Returns the literal of the gate for node, whose inputs have literals. */
+  SatLiteral defineGate(TNode node, const RefCountMap& refs);
+  /** Returns the literal for the conjunction of lits. */
+  SatLiteral mkAndGate(std::vector<SatLiteral>& lits);
+  /** Returns the literal for the exclusive or of a and b. */
+  SatLiteral mkXorGate(SatLiteral a, SatLiteral b);
+  /** Returns the literal for the if-then-else of c, t and e. */
+  SatLiteral mkIteGate(SatLiteral c, SatLiteral t, SatLiteral e);
+  /** Returns the (positive) literal of the normalized gate g. */
+  SatLiteral mkGate(const Gate& g);
+  /** Returns the literal of the given Boolean constant. */
+  SatLiteral getConstantLiteral(bool value);
+  /**
+   * Ensures that the definitional clauses of the gate of lit are asserted for
+   * polarity pol (relative to lit), along with those of its inputs.
+   */
+  void definePolarity(SatLiteral lit, uint8_t pol);
+  /** Asserts the definitional clauses of gate g with output var for pol. */
+  void assertGateClauses(SatVariable var, const Gate& g, uint8_t pol);
+  /** Maps node to lit, without introducing a new variable. */
+  void mapToLiteral(TNode node, SatLiteral lit);
+
+  /** A connective whose definitional clauses are generated concurrently. */
+  struct ParallelGate
+  {
+    /** The connective */
+    TNode d_node;
+    /** The kind of d_node, such that threads need not access d_node */
+    Kind d_kind;
+    /** The literal of d_node */
+    SatLiteral d_lit;
+    /** The literals of the children are stored in [d_begin, d_end) */
+    size_t d_begin;
+    size_t d_end;
+  };
+  /** Connectives with fewer gates are not split over several threads. */
+  static constexpr size_t s_minParallelGates = 1024;
+  /**
+   * Calls collectParallelGates() on the operands that convertAndAssert(node,
+   * negated) converts by toCNF(), such that the connectives it asserts
+   * directly get no literal.
+   */
+  void collectAssertedGates(TNode node,
+                            bool negated,
+                            std::vector<ParallelGate>& gates,
+                            std::vector<SatLiteral>& inputs);
+  /**
+   * Introduces literals for the Boolean structure of node that has no literal
+   * yet, without asserting any clauses. Stores the new connectives in gates,
+   * children before parents, and the literals of their children in inputs.
+   */
+  void collectParallelGates(TNode node,
+                            std::vector<ParallelGate>& gates,
+                            std::vector<SatLiteral>& inputs);
+  /**
+   * Generates the definitional clauses of g into clauses, where inputs holds
+   * the literals of the children. Does not access any node.
+   */
+  static void encodeParallelGate(const ParallelGate& g,
+                                 const std::vector<SatLiteral>& inputs,
+                                 std::vector<SatClause>& clauses);
+
   /** Stores the literal of the given node in d_literalToNodeMap.
    *
    * Note that n must already have a literal associated to it in
@@ -227,6 +383,21 @@ class CnfStream {
   /** Map from literals to nodes */
   LiteralToNodeMap d_literalToNodeMap;
 
+  /** Whether to use the optimized encoding */
+  const bool d_optimize;
+
+  /** Map from gates to their variables, for structural hashing */
+  context::CDInsertHashMap<Gate, SatVariable, GateHashFunction> d_gates;
+
+  /** Map from gate variables to their gates */
+  context::CDInsertHashMap<SatVariable, Gate> d_gateDefinitions;
+
+  /**
+   * Map from gate variables to the polarities for which definitional clauses
+   * were asserted
+   */
+  context::CDHashMap<SatVariable, uint8_t> d_gatePolarity;
+
   /**
    * True if the lit-to-Node map should be kept for all lits, not just
    * theory lits.  This is true if e.g. replay logging is on, which
@@ -315,6 +486,15 @@ class CnfStream {
   {
     Statistics(const std::string& name);
     TimerStat d_cnfConversionTime;
+    /**
+     * Number of clauses the plain Tseitin encoding would have asserted but the
+     * optimized encoding did not
+     */
+    IntStat d_clausesSaved;
+    /** Number of gates that were found by structural hashing */
+    IntStat d_gatesShared;
+    /** Number of nodes that were merged into their parent gate */
+    IntStat d_gatesFlattened;
   } d_stats;
 
 }; /* class CnfStream */
@@ -24,6 +24,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <iostream>
 #include <unordered_set>
+#include <vector>
 
 #include "base/check.h"
 #include "base/output.h"
@@ -183,7 +184,11 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       //
       ,
       learntsize_adjust_start_confl(100),
-      learntsize_adjust_inc(1.5)
+      learntsize_adjust_inc(1.5),
+      tiered_db(options::satTieredClauseDb()),
+      inprocessing(options::satInprocessing()),
+      inprocess_interval(options::satInprocessingInterval()),
+      export_size(options::satExportSize())
 
       // Statistics: (formerly in 'SolverStats')
       //
@@ -199,7 +204,11 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      inprocessings(0),
+      subsumed_learnts(0),
+      vivified_clauses(0),
+      vivified_literals(0)
 
       ,
       ok(true),
@@ -211,7 +220,13 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       simpDB_props(0),
       order_heap(VarOrderLt(activity)),
       progress_estimate(0),
-      remove_satisfied(!enableIncremental)
+      remove_satisfied(!enableIncremental),
+      learnts_kept(0),
+      probing(false),
+      next_inprocess(inprocess_interval),
+      inprocess_props(0),
+      lbd_counter(0),
+      lookahead_qhead(0)
 
       // Resource constraints:
       //
@@ -686,7 +701,7 @@ void Solver::cancelUntil(int level) {
             Var      x  = var(trail[c]);
             assigns [x] = l_Undef;
             vardata[x].d_trail_index = -1;
-            if ((phase_saving > 1 ||
+            if (!probing && (phase_saving > 1 ||
                  ((phase_saving == 1) && c > trail_lim.last())
                  ) && ((polarity[x] & 0x2) == 0)) {
               polarity[x] = sign(trail[c]);
@@ -855,6 +870,42 @@ Lit Solver::pickBranchLit()
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  computeLbd : (lits : Lits)  ->  [uint32_t]
+|
+|  Description:
+|    Compute the literal block distance of a clause, i.e. the number of distinct decision levels
+|    of its literals. Unassigned literals are counted individually.
+|________________________________________________________________________________________________@*/
+template <class Lits>
+uint32_t Solver::computeLbd(const Lits& lits)
+{
+  ++lbd_counter;
+  uint32_t lbd = 0;
+  for (int i = 0; i < lits.size(); i++)
+  {
+    Var x = var(lits[i]);
+    if (value(x) == l_Undef)
+    {
+      ++lbd;
+      continue;
+    }
+    int l = level(x);
+    if (l >= lbd_stamps.size())
+    {
+      lbd_stamps.growTo(l + 1, 0);
+    }
+    if (lbd_stamps[l] != lbd_counter)
+    {
+      lbd_stamps[l] = lbd_counter;
+      ++lbd;
+    }
+  }
+  return lbd;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
@@ -903,7 +954,20 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         Clause& c = ca[confl];
         max_resolution_level = std::max(max_resolution_level, c.level());
 
-        if (c.removable()) claBumpActivity(c);
+        if (c.removable())
+        {
+          claBumpActivity(c);
+          if (tiered_db)
+          {
+            // the clause may have become more relevant
+            c.used(true);
+            if (c.lbd() > 2)
+            {
+              uint32_t lbd = computeLbd(c);
+              if (lbd < c.lbd()) c.lbd(lbd);
+            }
+          }
+        }
       }
 
         if (Trace.isOn("pf::sat"))
@@ -1167,7 +1231,7 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
   vardata[var(p)] = VarData(
       from, decisionLevel(), assertionLevel, intro_level(var(p)), trail.size());
   trail.push_(p);
-  if (theory[var(p)])
+  if (theory[var(p)] && !probing)
   {
     // Enqueue to the theory
     d_proxy->enqueueTheoryLiteral(MinisatSatSolver::toSatLiteral(p));
@@ -1393,6 +1457,10 @@ CRef Solver::propagateBool()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|
+|    With 'tiered_db', only the clauses of the local tier are candidates for removal: clauses
+|    with an LBD of at most 2 (core tier) are always kept, clauses with an LBD of at most 6
+|    (tier 2) are kept as long as they are used in conflict analysis between two reductions.
 |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
     ClauseAllocator& ca;
@@ -1403,19 +1471,41 @@ struct reduceDB_lt {
 void Solver::reduceDB()
 {
     int     i, j;
-    double  extra_lim = cla_inc / clauses_removable.size();    // Remove any clause below this activity
 
-    sort(clauses_removable, reduceDB_lt(ca));
+    vec<CRef> local;
+    if (tiered_db){
+        // Separate the clauses of the local tier:
+        for (i = j = 0; i < clauses_removable.size(); i++){
+            Clause& c = ca[clauses_removable[i]];
+            if (c.lbd() <= 2 || (c.lbd() <= 6 && c.used()))
+                clauses_removable[j++] = clauses_removable[i];
+            else
+                local.push(clauses_removable[i]);
+            c.used(false);
+        }
+        clauses_removable.shrink(i - j);
+        learnts_kept = clauses_removable.size();
+    }
+
+    vec<CRef>& cs = tiered_db ? local : clauses_removable;
+    double  extra_lim = cla_inc / cs.size();    // Remove any clause below this activity
+
+    sort(cs, reduceDB_lt(ca));
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
-    for (i = j = 0; i < clauses_removable.size(); i++){
-        Clause& c = ca[clauses_removable[i]];
-        if (c.size() > 2 && !locked(c) && (i < clauses_removable.size() / 2 || c.activity() < extra_lim))
-            removeClause(clauses_removable[i]);
+    for (i = j = 0; i < cs.size(); i++){
+        Clause& c = ca[cs[i]];
+        if (c.size() > 2 && !locked(c) && (i < cs.size() / 2 || c.activity() < extra_lim))
+            removeClause(cs[i]);
         else
-            clauses_removable[j++] = clauses_removable[i];
+            cs[j++] = cs[i];
+    }
+    cs.shrink(i - j);
+    if (tiered_db){
+        // Add back the remaining clauses of the local tier:
+        for (i = 0; i < local.size(); i++)
+            clauses_removable.push(local[i]);
     }
-    clauses_removable.shrink(i - j);
     checkGarbage();
 }
 
@@ -1493,6 +1583,249 @@ bool Solver::simplify()
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : [void]  ->  [void]
+|
+|  Description:
+|    Simplify the learnt clauses at decision level zero. Only removable clauses are touched: input
+|    clauses and non-removable lemmas may be needed by the theories or in later user contexts, and
+|    no variable is eliminated, hence theory atoms stay intact. Not used if proofs are needed, as
+|    the simplified clauses have no resolution proof.
+|________________________________________________________________________________________________@*/
+void Solver::inprocess()
+{
+  Assert(decisionLevel() == 0);
+  Assert(qhead == trail.size());
+  next_inprocess = conflicts + inprocess_interval;
+  if (needProof())
+  {
+    return;
+  }
+  Debug("minisat") << "Solver::inprocess()" << std::endl;
+  ++inprocessings;
+  subsumeLearnts();
+  vivify();
+  inprocess_props = propagations;
+  checkGarbage();
+}
+
+void Solver::subsumeLearnts()
+{
+  // Occurrence lists of the learnt clauses
+  std::vector<std::vector<CRef>> occs(2 * nVars());
+  vec<CRef> cands;
+  for (int i = 0; i < clauses_removable.size(); i++)
+  {
+    const Clause& c = ca[clauses_removable[i]];
+    for (int k = 0; k < c.size(); k++)
+    {
+      occs[toInt(c[k])].push_back(clauses_removable[i]);
+    }
+    cands.push(clauses_removable[i]);
+  }
+  // Shorter clauses are more likely to subsume others
+  sort(cands, [this](CRef x, CRef y) { return ca[x].size() < ca[y].size(); });
+
+  int64_t steps = 0;
+  const int64_t max_steps = 10 * (learnts_literals + clauses_removable.size());
+  for (int i = 0; i < cands.size() && steps < max_steps; i++)
+  {
+    CRef cr = cands[i];
+    if (ca[cr].mark() == 1)
+    {
+      continue;
+    }
+    Clause& c = ca[cr];
+    // Every subsumed clause contains the literal of c with the fewest occurrences
+    Lit best = c[0];
+    for (int k = 0; k < c.size(); k++)
+    {
+      seen[var(c[k])] = sign(c[k]) ? 2 : 1;
+      if (occs[toInt(c[k])].size() < occs[toInt(best)].size())
+      {
+        best = c[k];
+      }
+    }
+    for (CRef dr : occs[toInt(best)])
+    {
+      Clause& d = ca[dr];
+      // A clause of a higher user level than d must not replace it
+      if (dr == cr || d.mark() == 1 || d.size() < c.size()
+          || d.level() < c.level() || locked(d))
+      {
+        continue;
+      }
+      int found = 0;
+      for (int k = 0; k < d.size(); k++)
+      {
+        if (seen[var(d[k])] == (sign(d[k]) ? 2 : 1))
+        {
+          ++found;
+        }
+      }
+      steps += d.size();
+      if (found == c.size())
+      {
+        if (d.lbd() < c.lbd()) c.lbd(d.lbd());
+        removeClause(dr);
+        ++subsumed_learnts;
+      }
+    }
+    for (int k = 0; k < c.size(); k++)
+    {
+      seen[var(c[k])] = 0;
+    }
+  }
+
+  int i, j;
+  for (i = j = 0; i < clauses_removable.size(); i++)
+  {
+    if (ca[clauses_removable[i]].mark() != 1)
+    {
+      clauses_removable[j++] = clauses_removable[i];
+    }
+  }
+  clauses_removable.shrink(i - j);
+}
+
+void Solver::vivify()
+{
+  ScopedBool scoped_probing(probing, true);
+  // Spend at most a tenth of the propagations since the last round
+  int64_t limit = propagations
+                  + std::max<int64_t>(10000, (propagations - inprocess_props) / 10);
+  for (int i = 0; i < clauses_removable.size() && propagations < limit; i++)
+  {
+    clauses_removable[i] = vivifyClause(clauses_removable[i]);
+  }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  lookaheadPush : (p : Lit) (assigned : int&)  ->  [bool]
+|
+|  Description:
+|    Assign 'p' at a new decision level and propagate it Boolean-wise, without notifying the
+|    theories. Returns false on a conflict. In any case, 'assigned' is set to the number of
+|    literals assigned on the new level, and the level must be undone by 'lookaheadPop()'.
+|    Literals that are pending at decision level zero are propagated on the new level, so that
+|    the state of level zero is the same after the last pop.
+|________________________________________________________________________________________________@*/
+bool Solver::lookaheadPush(Lit p, int& assigned)
+{
+  ScopedBool scoped_probing(probing, true);
+  if (decisionLevel() == 0)
+  {
+    lookahead_qhead = qhead;
+  }
+  int before = trail.size();
+  newDecisionLevel();
+  bool noConflict = value(p) != l_False;
+  if (value(p) == l_Undef)
+  {
+    uncheckedEnqueue(p);
+  }
+  if (noConflict)
+  {
+    noConflict = propagateBool() == CRef_Undef;
+  }
+  assigned = trail.size() - before;
+  return noConflict;
+}
+
+void Solver::lookaheadPop()
+{
+  Assert(decisionLevel() > 0);
+  ScopedBool scoped_probing(probing, true);
+  cancelUntil(decisionLevel() - 1);
+  if (decisionLevel() == 0)
+  {
+    qhead = lookahead_qhead;
+  }
+}
+
+void Solver::takeExportedClauses(vec<Lit>& out)
+{
+  exported_lits.moveTo(out);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  vivifyClause : (cr : CRef)  ->  [CRef]
+|
+|  Description:
+|    Assign the negations of the literals of the (detached) clause one after another and
+|    propagate them Boolean-wise. A literal that becomes false is implied by the previous ones
+|    and can be dropped; a literal that becomes true, or a conflict, ends the clause early. If the
+|    clause gets shorter, it is replaced by a new clause of the current user level, since the
+|    propagations may have used clauses of that level.
+|________________________________________________________________________________________________@*/
+CRef Solver::vivifyClause(CRef cr)
+{
+  Assert(decisionLevel() == 0);
+  Assert(probing);
+  {
+    const Clause& c = ca[cr];
+    if (c.size() <= 2 || c.vivified() || satisfied(c))
+    {
+      return cr;
+    }
+  }
+  detachClause(cr, true);
+
+  Clause& c = ca[cr];
+  c.vivified(true);
+  vivify_lits.clear();
+  newDecisionLevel();
+  for (int k = 0; k < c.size(); k++)
+  {
+    Lit p = c[k];
+    if (value(p) == l_False)
+    {
+      continue;
+    }
+    vivify_lits.push(p);
+    if (value(p) == l_True)
+    {
+      break;
+    }
+    uncheckedEnqueue(~p);
+    if (propagateBool() != CRef_Undef)
+    {
+      break;
+    }
+  }
+  cancelUntil(0);
+
+  if (vivify_lits.size() < 2 || vivify_lits.size() == c.size())
+  {
+    attachClause(cr);
+    return cr;
+  }
+
+  Trace("minisat::vivify") << "vivified clause of size " << c.size()
+                           << " to size " << vivify_lits.size() << std::endl;
+  ++vivified_clauses;
+  vivified_literals += c.size() - vivify_lits.size();
+  float act = c.activity();
+  uint32_t lbd = c.lbd();
+  bool used = c.used();
+  // c is detached and not locked (it is not satisfied)
+  c.mark(1);
+  ca.free(cr);
+
+  CRef ncr = ca.alloc(assertionLevel, vivify_lits, true);
+  Clause& nc = ca[ncr];
+  nc.activity() = act;
+  nc.lbd(std::min(lbd, static_cast<uint32_t>(vivify_lits.size())));
+  nc.used(used);
+  nc.vivified(true);
+  attachClause(ncr);
+  return ncr;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
@@ -1545,8 +1878,20 @@ lbool Solver::search(int nof_conflicts)
       // Analyze the conflict
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
+      uint32_t lbd = tiered_db ? computeLbd(learnt_clause) : 0;
       cancelUntil(backtrack_level);
 
+      // Record short clauses that survive all pops for exporting
+      if (learnt_clause.size() <= export_size && !assertionLevelOnly()
+          && max_level == 0)
+      {
+        for (int i = 0; i < learnt_clause.size(); i++)
+        {
+          exported_lits.push(learnt_clause[i]);
+        }
+        exported_lits.push(lit_Undef);
+      }
+
       // Assert the conflict clause and the asserting literal
       if (learnt_clause.size() == 1)
       {
@@ -1564,6 +1909,7 @@ lbool Solver::search(int nof_conflicts)
         clauses_removable.push(cr);
         attachClause(cr);
         claBumpActivity(ca[cr]);
+        ca[cr].lbd(lbd);
         uncheckedEnqueue(learnt_clause[0], cr);
         if (needProof())
         {
@@ -1653,7 +1999,12 @@ lbool Solver::search(int nof_conflicts)
         return l_False;
       }
 
-      if (clauses_removable.size() - nAssigns() >= max_learnts)
+      if (decisionLevel() == 0 && inprocessing && conflicts >= next_inprocess)
+      {
+        inprocess();
+      }
+
+      if (clauses_removable.size() - nAssigns() - learnts_kept >= max_learnts)
       {
         // Reduce the set of learnt clauses:
         reduceDB();
@@ -1994,6 +2345,7 @@ void Solver::pop()
   // Remove the clauses
   removeClausesAboveLevel(clauses_persistent, assertionLevel);
   removeClausesAboveLevel(clauses_removable, assertionLevel);
+  learnts_kept = 0;
   Debug("minisat") << cvc5::pop;
   // Pop the SAT context to notify everyone
   d_context->pop();  // SAT context for cvc5
@@ -2095,6 +2447,10 @@ CRef Solver::updateLemmas() {
 
       lemma_ref = ca.alloc(clauseLevel, lemma, removable);
       if (removable) {
+        if (tiered_db)
+        {
+          ca[lemma_ref].lbd(computeLbd(lemma));
+        }
         clauses_removable.push(lemma_ref);
       } else {
         clauses_persistent.push(lemma_ref);
@@ -2156,6 +2512,9 @@ void ClauseAllocator::reloc(CRef& cr, ClauseAllocator& to)
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].lbd(c.lbd());
+  to[cr].used(c.used());
+  to[cr].vivified(c.vivified());
   if (to[cr].removable())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
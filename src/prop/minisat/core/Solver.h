@@ -292,6 +292,18 @@ public:
  int nFreeVars() const;
  bool isDecision(Var x) const;  // is the given var a decision?
 
+ // Lookahead for cube generation and export of learnt clauses:
+ //
+ bool lookaheadPush(Lit p, int& assigned);  // Assign 'p' at a new decision
+                                            // level and propagate it
+                                            // Boolean-wise. Returns false on a
+                                            // conflict; 'assigned' is the
+                                            // number of assigned literals.
+ void lookaheadPop();  // Undo the last 'lookaheadPush()'.
+ void takeExportedClauses(
+     vec<Lit>& out);  // Move the learnt clauses recorded due to 'export_size'
+                      // to 'out', each followed by 'lit_Undef'.
+
  // Debugging SMT explanations
  //
  bool properExplanation(Lit l, Lit expl)
@@ -350,6 +362,12 @@ public:
 
  int learntsize_adjust_start_confl;
  double learntsize_adjust_inc;
+ bool tiered_db;     // Keep learnt clauses in tiers by their LBD in 'reduceDB'.
+ bool inprocessing;  // Periodically subsume and vivify learnt clauses.
+ int64_t inprocess_interval;  // Number of conflicts between two inprocessing
+                              // rounds.
+ int export_size;  // Record learnt clauses of at most this size that do not
+                  // depend on user levels, see 'takeExportedClauses()'.
 
  // Statistics: (read-only member variable)
  //
@@ -357,6 +375,7 @@ public:
      resources_consumed;
  int64_t dec_vars, clauses_literals, learnts_literals, max_literals,
      tot_literals;
+ int64_t inprocessings, subsumed_learnts, vivified_clauses, vivified_literals;
 
 protected:
 
@@ -467,6 +486,21 @@ protected:
     double              max_learnts;
     double              learntsize_adjust_confl;
     int                 learntsize_adjust_cnt;
+    int                 learnts_kept;       // Number of learnt clauses kept by the last tiered 'reduceDB'.
+
+    // Inprocessing:
+    //
+    bool                probing;            // Assignments are only propagated Boolean-wise, see 'vivify()'.
+    int64_t             next_inprocess;     // Number of conflicts at which to run 'inprocess()' next.
+    int64_t             inprocess_props;    // Number of propagations at the end of the last 'inprocess()'.
+    vec<uint64_t>       lbd_stamps;         // For each decision level, the last 'computeLbd()' call that saw it.
+    uint64_t            lbd_counter;        // Number of 'computeLbd()' calls.
+    vec<Lit>            vivify_lits;
+
+    // Lookahead and clause export:
+    //
+    int                 lookahead_qhead;    // 'qhead' before the first 'lookaheadPush()'.
+    vec<Lit>            exported_lits;      // Learnt clauses to export, each followed by 'lit_Undef'.
 
     // Resource contraints:
     //
@@ -496,6 +530,12 @@ protected:
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    template <class Lits>
+    uint32_t computeLbd       (const Lits& lits);                                      // Number of distinct decision levels of the (assigned) literals.
+    void     inprocess        ();                                                      // Subsume and vivify learnt clauses at decision level zero.
+    void     subsumeLearnts   ();                                                      // Remove learnt clauses that are subsumed by other learnt clauses.
+    void     vivify           ();                                                      // Shorten learnt clauses by probing the negation of their literals.
+    CRef     vivifyClause     (CRef cr);                                               // Vivify a single clause, returns its (new) reference.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
 
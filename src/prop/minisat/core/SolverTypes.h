@@ -192,7 +192,10 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned size      : 27;
-        unsigned level     : 32; }                            header;
+        unsigned level     : 32;
+        unsigned lbd       : 30;
+        unsigned used      : 1;
+        unsigned vivified  : 1; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -206,6 +209,9 @@ class Clause {
         header.reloced   = 0;
         header.size      = ps.size();
         header.level     = level;
+        header.lbd       = 0;
+        header.used      = 0;
+        header.vivified  = 0;
 
         for (int i = 0; i < ps.size(); i++) data[i].lit = ps[i];
 
@@ -239,6 +245,15 @@ public:
     bool         has_extra   ()      const   { return header.has_extra; }
     uint32_t     mark        ()      const   { return header.mark; }
     void         mark        (uint32_t m)    { header.mark = m; }
+    // Literal block distance, only maintained for removable clauses:
+    uint32_t     lbd         ()      const   { return header.lbd; }
+    void         lbd         (uint32_t l)    { header.lbd = l < (1u << 30) ? l : (1u << 30) - 1; }
+    // Whether the clause took part in conflict analysis since the last reduceDB():
+    bool         used        ()      const   { return header.used; }
+    void         used        (bool b)        { header.used = b; }
+    // Whether vivification was already tried on this clause:
+    bool         vivified    ()      const   { return header.vivified; }
+    void         vivified    (bool b)        { header.vivified = b; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
     bool         reloced     ()      const   { return header.reloced; }
@@ -268,6 +268,35 @@ int32_t MinisatSatSolver::getIntroLevel(SatVariable v) const
   return d_minisat->intro_level(v);
 }
 
+bool MinisatSatSolver::lookaheadPush(SatLiteral lit, uint64_t& numAssigned)
+{
+  int assigned = 0;
+  bool res = d_minisat->lookaheadPush(toMinisatLit(lit), assigned);
+  numAssigned = assigned;
+  return res;
+}
+
+void MinisatSatSolver::lookaheadPop() { d_minisat->lookaheadPop(); }
+
+void MinisatSatSolver::getExportedClauses(std::vector<SatClause>& clauses)
+{
+  Minisat::vec<Minisat::Lit> lits;
+  d_minisat->takeExportedClauses(lits);
+  SatClause clause;
+  for (int i = 0, size = lits.size(); i < size; ++i)
+  {
+    if (lits[i] == Minisat::lit_Undef)
+    {
+      clauses.push_back(clause);
+      clause.clear();
+    }
+    else
+    {
+      clause.push_back(toSatLiteral(lits[i]));
+    }
+  }
+}
+
 SatProofManager* MinisatSatSolver::getProofManager()
 {
   return d_minisat->getProofManager();
@@ -311,7 +340,15 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry& registry)
       d_statMaxLiterals(
           registry.registerReference<int64_t>("sat::max_literals")),
       d_statTotLiterals(
-          registry.registerReference<int64_t>("sat::tot_literals"))
+          registry.registerReference<int64_t>("sat::tot_literals")),
+      d_statInprocessings(
+          registry.registerReference<int64_t>("sat::inprocessings")),
+      d_statSubsumedLearnts(
+          registry.registerReference<int64_t>("sat::subsumed_learnts")),
+      d_statVivifiedClauses(
+          registry.registerReference<int64_t>("sat::vivified_clauses")),
+      d_statVivifiedLiterals(
+          registry.registerReference<int64_t>("sat::vivified_literals"))
 {
 }
 
@@ -325,6 +362,10 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
   d_statLearntsLiterals.set(minisat->learnts_literals);
   d_statMaxLiterals.set(minisat->max_literals);
   d_statTotLiterals.set(minisat->tot_literals);
+  d_statInprocessings.set(minisat->inprocessings);
+  d_statSubsumedLearnts.set(minisat->subsumed_learnts);
+  d_statVivifiedClauses.set(minisat->vivified_clauses);
+  d_statVivifiedLiterals.set(minisat->vivified_literals);
 }
 void MinisatSatSolver::Statistics::deinit()
 {
@@ -337,6 +378,10 @@ void MinisatSatSolver::Statistics::deinit()
   d_statLearntsLiterals.reset();
   d_statMaxLiterals.reset();
   d_statTotLiterals.reset();
+  d_statInprocessings.reset();
+  d_statSubsumedLearnts.reset();
+  d_statVivifiedClauses.reset();
+  d_statVivifiedLiterals.reset();
 }
 
 }  // namespace prop
@@ -106,6 +106,14 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
    */
   int32_t getIntroLevel(SatVariable v) const override;
 
+  bool supportsLookahead() const override { return true; }
+
+  bool lookaheadPush(SatLiteral lit, uint64_t& numAssigned) override;
+
+  void lookaheadPop() override;
+
+  void getExportedClauses(std::vector<SatClause>& clauses) override;
+
   /** Retrieve a pointer to the underlying solver. */
   Minisat::SimpSolver* getSolver() { return d_minisat; }
 
@@ -140,6 +148,8 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
    ReferenceStat<int64_t> d_statConflicts, d_statClausesLiterals;
    ReferenceStat<int64_t> d_statLearntsLiterals, d_statMaxLiterals;
    ReferenceStat<int64_t> d_statTotLiterals;
+   ReferenceStat<int64_t> d_statInprocessings, d_statSubsumedLearnts;
+   ReferenceStat<int64_t> d_statVivifiedClauses, d_statVivifiedLiterals;
 
   public:
    Statistics(StatisticsRegistry& registry);
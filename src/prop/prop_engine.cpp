@@ -28,6 +28,7 @@
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "prop/cnf_stream.h"
 #include "prop/minisat/minisat.h"
@@ -105,7 +106,15 @@ PropEngine::PropEngine(TheoryEngine* te,
     d_decisionEngine.reset(new decision::DecisionEngineEmpty(satContext, rm));
   }
 
-  d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  if (options::satSolver() == options::CDCLTSatSolverMode::CADICAL)
+  {
+    d_satSolver =
+        SatSolverFactory::createCDCLTCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  }
 
   // CNF stream and theory proxy required pointers to each other, make the
   // theory proxy first
@@ -116,13 +125,19 @@ PropEngine::PropEngine(TheoryEngine* te,
                                   satContext,
                                   userContext,
                                   pnm);
+  // the optimized encoding is not supported by the proof-producing CNF stream
+  bool optimizeCnf =
+      options::cnfOptimize()
+      && (pnm == nullptr
+          || options::unsatCoresMode() == options::UnsatCoresMode::ASSUMPTIONS);
   d_cnfStream = new CnfStream(d_satSolver,
                               d_theoryProxy,
                               userContext,
                               &d_outMgr,
                               rm,
                               FormulaLitPolicy::TRACK,
-                              "prop");
+                              "prop",
+                              optimizeCnf);
 
   // connect theory proxy
   d_theoryProxy->finishInit(d_cnfStream);
@@ -386,7 +401,10 @@ void PropEngine::printSatisfyingAssignment(){
   }
 }
 
-Result PropEngine::checkSat() {
+Result PropEngine::checkSat() { return checkSat(std::vector<Node>()); }
+
+Result PropEngine::checkSat(const std::vector<Node>& literals)
+{
   Assert(!d_inCheckSat) << "Sat solver in solve()!";
   Debug("prop") << "PropEngine::checkSat()" << std::endl;
 
@@ -407,7 +425,7 @@ Result PropEngine::checkSat() {
 
   // Check the problem
   SatValue result;
-  if (d_assumptions.size() == 0)
+  if (d_assumptions.size() == 0 && literals.empty())
   {
     result = d_satSolver->solve();
   }
@@ -418,6 +436,11 @@ Result PropEngine::checkSat() {
     {
       assumptions.push_back(d_cnfStream->getLiteral(node));
     }
+    for (const Node& node : literals)
+    {
+      Assert(d_cnfStream->hasLiteral(node));
+      assumptions.push_back(d_cnfStream->getLiteral(node));
+    }
     result = d_satSolver->solve(assumptions);
   }
 
@@ -446,6 +469,118 @@ Result PropEngine::checkSat() {
   return Result(result == SAT_VALUE_TRUE ? Result::SAT : Result::UNSAT);
 }
 
+bool PropEngine::getCubes(const std::vector<Node>& atoms,
+                          size_t depth,
+                          std::vector<std::vector<Node>>& cubes)
+{
+  Assert(!d_inCheckSat) << "Sat solver in solve()!";
+  if (!d_satSolver->supportsLookahead())
+  {
+    return false;
+  }
+  if (!d_satSolver->ok())
+  {
+    return true;
+  }
+  std::vector<SatLiteral> lits;
+  for (const Node& a : atoms)
+  {
+    Assert(d_cnfStream->hasLiteral(a));
+    lits.push_back(d_cnfStream->getLiteral(a));
+  }
+  std::vector<SatLiteral> cube;
+  splitCube(lits, depth, cube, cubes);
+  Trace("prop-cube") << "PropEngine::getCubes: " << cubes.size()
+                     << " cubes of depth " << depth << " on " << atoms.size()
+                     << " atoms" << std::endl;
+  return true;
+}
+
+void PropEngine::splitCube(const std::vector<SatLiteral>& atoms,
+                           size_t depth,
+                           std::vector<SatLiteral>& cube,
+                           std::vector<std::vector<Node>>& cubes)
+{
+  SatLiteral best = undefSatLiteral;
+  bool forced = false;
+  if (depth > 0)
+  {
+    uint64_t bestScore = 0;
+    for (const SatLiteral& a : atoms)
+    {
+      if (d_satSolver->value(a) != SAT_VALUE_UNKNOWN)
+      {
+        continue;
+      }
+      uint64_t npos = 0;
+      uint64_t nneg = 0;
+      bool pos = d_satSolver->lookaheadPush(a, npos);
+      d_satSolver->lookaheadPop();
+      bool neg = d_satSolver->lookaheadPush(~a, nneg);
+      d_satSolver->lookaheadPop();
+      if (!pos && !neg)
+      {
+        // the cube is refuted
+        return;
+      }
+      if (!pos || !neg)
+      {
+        // a failed literal, the other polarity is implied
+        best = pos ? a : ~a;
+        forced = true;
+        break;
+      }
+      uint64_t score = (npos + 1) * (nneg + 1);
+      if (best.isNull() || score > bestScore)
+      {
+        best = a;
+        bestScore = score;
+      }
+    }
+  }
+  if (best.isNull())
+  {
+    std::vector<Node> lits;
+    for (const SatLiteral& lit : cube)
+    {
+      lits.push_back(d_cnfStream->getNode(lit));
+    }
+    cubes.push_back(lits);
+    return;
+  }
+  for (const SatLiteral& lit : {best, ~best})
+  {
+    uint64_t assigned = 0;
+    if (d_satSolver->lookaheadPush(lit, assigned))
+    {
+      cube.push_back(lit);
+      splitCube(atoms, forced ? depth : depth - 1, cube, cubes);
+      cube.pop_back();
+    }
+    d_satSolver->lookaheadPop();
+    if (forced)
+    {
+      break;
+    }
+  }
+}
+
+void PropEngine::getExportedClauses(std::vector<Node>& clauses)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<SatClause> satClauses;
+  d_satSolver->getExportedClauses(satClauses);
+  for (const SatClause& c : satClauses)
+  {
+    std::vector<Node> lits;
+    for (const SatLiteral& lit : c)
+    {
+      lits.push_back(d_cnfStream->getNode(lit));
+    }
+    clauses.push_back(lits.size() == 1 ? lits[0] : nm->mkNode(kind::OR, lits));
+  }
+}
+
 Node PropEngine::getValue(TNode node) const
 {
   Assert(node.getType().isBoolean());
@@ -695,11 +830,16 @@ bool PropEngine::isProofEnabled() const { return d_pfCnfStream != nullptr; }
 void PropEngine::getUnsatCore(std::vector<Node>& core)
 {
   Assert(options::unsatCoresMode() == options::UnsatCoresMode::ASSUMPTIONS);
+  getUnsatAssumptions(core);
+}
+
+void PropEngine::getUnsatAssumptions(std::vector<Node>& literals)
+{
   std::vector<SatLiteral> unsat_assumptions;
   d_satSolver->getUnsatAssumptions(unsat_assumptions);
   for (const SatLiteral& lit : unsat_assumptions)
   {
-    core.push_back(d_cnfStream->getNode(lit));
+    literals.push_back(d_cnfStream->getNode(lit));
   }
 }
 
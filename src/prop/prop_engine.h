@@ -23,6 +23,7 @@
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "proof/trust_node.h"
+#include "prop/sat_solver_types.h"
 #include "prop/skolem_def_manager.h"
 #include "theory/output_channel.h"
 #include "util/result.h"
@@ -178,6 +179,42 @@ class PropEngine
    */
   Result checkSat();
 
+  /**
+   * Checks the current context for satisfiability under the given literals,
+   * which must have associated SAT literals. The literals are passed to the
+   * SAT solver as assumptions, so that no push or pop is necessary and the
+   * learned clauses are kept for subsequent calls.
+   */
+  Result checkSat(const std::vector<Node>& literals);
+
+  /**
+   * Split the search space of the current assertions into cubes, i.e.,
+   * conjunctions of literals whose disjunction is implied by the assertions,
+   * by lookahead on the given atoms, which must have associated SAT literals.
+   *
+   * Each split assigns both polarities of the unassigned atom that maximizes
+   * the product of the numbers of literals propagated (Boolean-wise) by its
+   * two polarities. Atoms for which one polarity leads to a conflict are
+   * assigned the other polarity without counting as a split, and cubes that
+   * lead to a conflict are dropped. The assignments are undone afterwards.
+   *
+   * @param atoms The atoms to split on.
+   * @param depth The maximal number of splits per cube.
+   * @param cubes Updated to the cubes. If it is empty, the assertions are
+   * unsatisfiable.
+   * @return false if the SAT solver does not support lookahead.
+   */
+  bool getCubes(const std::vector<Node>& atoms,
+                size_t depth,
+                std::vector<std::vector<Node>>& cubes);
+
+  /**
+   * Get the clauses learned since the last call whose size is at most
+   * --sat-export-size and that do not depend on assertions of user levels
+   * above zero.
+   */
+  void getExportedClauses(std::vector<Node>& clauses);
+
   /**
    * Get the value of a boolean variable.
    *
@@ -305,6 +342,12 @@ class PropEngine
   /** Retrieve unsat core from SAT solver for assumption-based unsat cores. */
   void getUnsatCore(std::vector<Node>& core);
 
+  /**
+   * Get the literals among the assumptions of the last call to checkSat that
+   * the SAT solver used to derive unsatisfiability.
+   */
+  void getUnsatAssumptions(std::vector<Node>& literals);
+
   /** Return the prop engine proof for assumption-based unsat cores. */
   std::shared_ptr<ProofNode> getRefutation();
 
@@ -322,6 +365,16 @@ class PropEngine
    * on an activity heuristic
    */
   void assertTrustedLemmaInternal(TrustNode trn, bool removable);
+
+  /**
+   * Split the current cube (whose literals are assigned in the SAT solver by
+   * lookahead) further with atoms, by at most depth splits, and add the
+   * resulting cubes to cubes. Helper for getCubes.
+   */
+  void splitCube(const std::vector<SatLiteral>& atoms,
+                 size_t depth,
+                 std::vector<SatLiteral>& cube,
+                 std::vector<std::vector<Node>>& cubes);
   /**
    * Assert node as a formula to the CNF stream
    * @param node The formula to assert
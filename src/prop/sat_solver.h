@@ -20,6 +20,7 @@
 
 #include <string>
 
+#include "base/check.h"
 #include "context/cdlist.h"
 #include "context/context.h"
 #include "expr/node.h"
@@ -180,6 +181,30 @@ class CDCLTSatSolverInterface : public SatSolver
 
   virtual std::shared_ptr<ProofNode> getProof() = 0;
 
+  /** Whether lookaheadPush() and lookaheadPop() are supported. */
+  virtual bool supportsLookahead() const { return false; }
+
+  /**
+   * Assign `lit` at a new decision level and propagate it, Boolean-wise only
+   * and without notifying the theories. Returns false on a conflict. In any
+   * case, `numAssigned` is set to the number of literals assigned on the new
+   * level, which must be undone by lookaheadPop().
+   */
+  virtual bool lookaheadPush(SatLiteral lit, uint64_t& numAssigned)
+  {
+    Unimplemented();
+  }
+
+  /** Undo the last call to lookaheadPush(). */
+  virtual void lookaheadPop() { Unimplemented(); }
+
+  /**
+   * Get the learned clauses of at most --sat-export-size literals that were
+   * recorded since the last call. These clauses do not depend on clauses of
+   * any user level above zero.
+   */
+  virtual void getExportedClauses(std::vector<SatClause>& clauses) {}
+
 }; /* class CDCLTSatSolverInterface */
 
 inline std::ostream& operator <<(std::ostream& out, prop::SatLiteral lit) {
@@ -38,6 +38,14 @@ MinisatSatSolver* SatSolverFactory::createCDCLTMinisat(
   return new MinisatSatSolver(registry);
 }
 
+CDCLTSatSolverInterface* SatSolverFactory::createCDCLTCadical(
+    StatisticsRegistry& registry)
+{
+  CadicalSolver* res = new CadicalSolver(registry, "prop::");
+  res->init();
+  return res;
+}
+
 SatSolver* SatSolverFactory::createCryptoMinisat(StatisticsRegistry& registry,
                                                  const std::string& name)
 {
@@ -214,6 +214,28 @@ void Assertions::addDefineFunDefinition(Node n, bool global)
   }
 }
 
+void Assertions::copyAssertions(const Assertions& as)
+{
+  if (d_produceAssertions && as.d_produceAssertions)
+  {
+    for (const Node& n : as.d_assertionList)
+    {
+      d_assertionList.push_back(n);
+    }
+  }
+  if (d_globalDefineFunLemmas != nullptr
+      && as.d_globalDefineFunLemmas != nullptr)
+  {
+    d_globalDefineFunLemmas->insert(d_globalDefineFunLemmas->end(),
+                                    as.d_globalDefineFunLemmas->begin(),
+                                    as.d_globalDefineFunLemmas->end());
+  }
+  for (const Node& n : as.d_assertions.ref())
+  {
+    d_assertions.push_back(n, false, true);
+  }
+}
+
 void Assertions::ensureBoolean(const Node& n)
 {
   TypeNode type = n.getType(options::typeChecking());
@@ -91,6 +91,12 @@ class Assertions
    * subsequent check-sat calls.
    */
   void addDefineFunDefinition(Node n, bool global);
+  /**
+   * Copy the assertions of as into this object: the assertion list, the
+   * global definitions and the assertions that have not been preprocessed
+   * yet. Both objects must use the same node manager.
+   */
+  void copyAssertions(const Assertions& as);
   /**
    * Get the assertions pipeline, which contains the set of assertions we are
    * currently processing.
@@ -25,6 +25,7 @@
 #include "smt/node_command.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_engine_scope.h"
+#include "util/statistics_registry.h"
 
 namespace cvc5 {
 namespace smt {
@@ -103,5 +104,29 @@ void SmtNodeManagerListener::nmNotifyNewSkolem(TNode n,
   d_dm.addToDump(c, "skolems");
 }
 
+GcStatisticsListener::GcStatisticsListener(StatisticsRegistry& sr)
+    : d_reclaimed(sr.registerInt("expr::NodeManager::zombiesReclaimed")),
+      d_pauseTime(sr.registerInt("expr::NodeManager::zombiePauseTime")),
+      d_maxPause(sr.registerInt("expr::NodeManager::zombieMaxPause")),
+      d_pauses(sr.registerHistogram<uint32_t>(
+          "expr::NodeManager::zombiePausesLog2"))
+{
+}
+
+void GcStatisticsListener::nmNotifyReclaimZombies(size_t reclaimed,
+                                                  uint64_t micros)
+{
+  d_reclaimed += reclaimed;
+  d_pauseTime += micros;
+  d_maxPause.maxAssign(micros);
+  uint32_t bucket = 0;
+  while (micros > 1)
+  {
+    micros >>= 1;
+    ++bucket;
+  }
+  d_pauses << bucket;
+}
+
 }  // namespace smt
 }  // namespace cvc5
@@ -22,6 +22,7 @@
 
 #include "base/listener.h"
 #include "expr/node.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -75,6 +76,31 @@ class SmtNodeManagerListener : public NodeManagerListener
   OutputManager& d_outMgr;
 };
 
+/**
+ * A listener for node manager calls that collects statistics on the
+ * reclamation of zombies, in particular on the length of the pauses.
+ */
+class GcStatisticsListener : public NodeManagerListener
+{
+ public:
+  GcStatisticsListener(StatisticsRegistry& sr);
+  /** Notify when zombies were reclaimed */
+  void nmNotifyReclaimZombies(size_t reclaimed, uint64_t micros) override;
+
+ private:
+  /** Number of reclaimed zombies */
+  IntStat d_reclaimed;
+  /** Total time spent reclaiming zombies, in microseconds */
+  IntStat d_pauseTime;
+  /** Longest pause, in microseconds */
+  IntStat d_maxPause;
+  /**
+   * Number of pauses by length: entry k counts the pauses of at least 2^k
+   * and less than 2^(k+1) microseconds (entry 0 also counts shorter pauses).
+   */
+  HistogramStat<uint32_t> d_pauses;
+};
+
 }  // namespace smt
 }  // namespace cvc5
 
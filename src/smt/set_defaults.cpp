@@ -118,6 +118,23 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
   Assert(options::unsatCores()
          == (options::unsatCoresMode() != options::UnsatCoresMode::OFF));
 
+  // CaDiCaL as SAT solver of the CDCL(T) engine does not produce proofs
+  if (options::satSolver() == options::CDCLTSatSolverMode::CADICAL
+      && options::produceProofs()
+      && options::unsatCoresMode() != options::UnsatCoresMode::ASSUMPTIONS)
+  {
+    if (opts.prop.satSolverWasSetByUser)
+    {
+      throw OptionException(
+          "CaDiCaL as SAT solver does not support proofs or unsat cores "
+          "other than --unsat-cores-mode=assumptions");
+    }
+    Notice() << "SmtEngine: using minisat as SAT solver since proofs were "
+                "requested."
+             << std::endl;
+    opts.prop.satSolver = options::CDCLTSatSolverMode::MINISAT;
+  }
+
   if (opts.bv.bitvectorAigSimplificationsWasSetByUser)
   {
     Notice() << "SmtEngine: setting bitvectorAig" << std::endl;
@@ -22,6 +22,7 @@
 #include "decision/decision_engine.h"
 #include "expr/bound_var_manager.h"
 #include "expr/node.h"
+#include "expr/skolem_manager.h"
 #include "options/base_options.h"
 #include "options/expr_options.h"
 #include "options/language.h"
@@ -29,6 +30,7 @@
 #include "options/option_exception.h"
 #include "options/printer_options.h"
 #include "options/proof_options.h"
+#include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "options/theory_options.h"
 #include "printer/printer.h"
@@ -63,6 +65,7 @@
 #include "theory/rewriter.h"
 #include "theory/smt_engine_subsolver.h"
 #include "theory/theory_engine.h"
+#include "theory/trust_substitutions.h"
 #include "util/random.h"
 #include "util/rational.h"
 #include "util/resource_manager.h"
@@ -126,6 +129,18 @@ SmtEngine::SmtEngine(NodeManager* nm, Options* optr)
   getResourceManager()->registerListener(d_routListener.get());
   // make statistics
   d_stats.reset(new SmtEngineStatistics());
+  {
+    // the node value allocator is owned by the node manager
+    const expr::NodeValueAllocator::Statistics& nvstats =
+        getNodeManager()->getNodeValueAllocatorStatistics();
+    d_stats->d_nvSlabAllocations.set(nvstats.d_slabAllocations);
+    d_stats->d_nvRecycled.set(nvstats.d_recycled);
+    d_stats->d_nvLargeAllocations.set(nvstats.d_largeAllocations);
+    d_stats->d_nvSlabsAcquired.set(nvstats.d_slabsAcquired);
+    d_stats->d_nvSlabsReleased.set(nvstats.d_slabsReleased);
+  }
+  d_gcListener.reset(new GcStatisticsListener(d_env->getStatisticsRegistry()));
+  getNodeManager()->subscribeEvents(d_gcListener.get());
   // reset the preprocessor
   d_pp.reset(
       new smt::Preprocessor(*this, *d_env.get(), *d_absValues.get(), *d_stats));
@@ -194,6 +209,15 @@ void SmtEngine::finishInit()
   // set the random seed
   Random::getRandom().setSeed(d_env->getOptions().driver.seed);
 
+  // configure the collection of unused nodes, which internal subsolvers leave
+  // to the solver that owns the node manager they share
+  if (!d_isInternalSubsolver)
+  {
+    getNodeManager()->setZombieCollectionPolicy(
+        d_env->getOptions().expr.gcZombieThreshold,
+        d_env->getOptions().expr.gcPauseBudget);
+  }
+
   // Call finish init on the options manager. This inializes the resource
   // manager based on the options, and sets up the best default options
   // based on our heuristics.
@@ -320,6 +344,8 @@ SmtEngine::~SmtEngine()
     d_smtSolver.reset(nullptr);
 
     d_stats.reset(nullptr);
+    getNodeManager()->unsubscribeEvents(d_gcListener.get());
+    d_gcListener.reset(nullptr);
     getNodeManager()->unsubscribeEvents(d_snmListener.get());
     d_snmListener.reset(nullptr);
     d_routListener.reset(nullptr);
@@ -943,13 +969,223 @@ Result SmtEngine::checkSatInternal(const std::vector<Node>& assumptions,
     // make the solver resume a working state after an interupt, then we would
     // implement a different callback and use it here, e.g.
     // d_state.notifyCheckSatInterupt.
-    Result::UnknownExplanation why = getResourceManager()->outOfResources()
-                                         ? Result::RESOURCEOUT
-                                         : Result::TIMEOUT;
+    ResourceManager* rm = getResourceManager();
+    Result::UnknownExplanation why = rm->interrupted()
+                                         ? Result::INTERRUPTED
+                                         : (rm->outOfResources()
+                                                ? Result::RESOURCEOUT
+                                                : Result::TIMEOUT);
+    rm->clearInterrupt();
     return Result(Result::SAT_UNKNOWN, why, d_state->getFilename());
   }
 }
 
+std::vector<Result> SmtEngine::checkSatAssumingBatch(
+    const std::vector<std::vector<Node>>& assumptions,
+    const std::vector<Node>& terms,
+    std::vector<std::vector<Node>>& values,
+    std::vector<std::vector<Node>>& unsatAssumptions)
+{
+  SmtScope smts(this);
+  finishInit();
+  Trace("smt") << "SmtEngine::checkSatAssumingBatch(" << assumptions.size()
+               << " sets)" << endl;
+  size_t nsets = assumptions.size();
+  std::vector<Result> results(nsets);
+  values.assign(nsets, std::vector<Node>());
+  unsatAssumptions.assign(nsets, std::vector<Node>());
+  if (nsets == 0)
+  {
+    return results;
+  }
+  if (!terms.empty() && !d_env->getOptions().smt.produceModels)
+  {
+    throw ModalException(
+        "Cannot get values in a batch check when produce-models option is "
+        "off.");
+  }
+  const Options& opts = d_env->getOptions();
+  // checks the i-th set on its own
+  auto checkIndividually = [&](size_t i) {
+    results[i] = checkSatInternal(assumptions[i], true, false);
+    Result::Sat sat = results[i].asSatisfiabilityResult().isSat();
+    if (sat == Result::SAT && !terms.empty())
+    {
+      values[i] = getValues(terms);
+    }
+    else if (sat == Result::UNSAT)
+    {
+      unsatAssumptions[i] =
+          opts.smt.unsatAssumptions ? getUnsatAssumptions() : assumptions[i];
+    }
+  };
+  if (!opts.base.incrementalSolving || opts.smt.produceProofs
+      || opts.smt.unsatCores || opts.quantifiers.globalNegate)
+  {
+    // the definitions below are not tracked by proofs and unsat cores, we
+    // resort to individual checks
+    for (size_t i = 0; i < nsets; i++)
+    {
+      checkIndividually(i);
+    }
+    return results;
+  }
+
+  // one push for the entire batch, the definitions are popped afterwards
+  d_state->notifyCheckSat(true);
+  d_asserts->initializeCheckSat({}, false, false);
+  NodeManager* nm = getNodeManager();
+  SkolemManager* sm = nm->getSkolemManager();
+  // define each distinct assumption by a fresh Boolean variable
+  std::unordered_map<Node, Node> defs;
+  std::vector<Node> vars;
+  for (const std::vector<Node>& as : assumptions)
+  {
+    for (const Node& a : as)
+    {
+      if (defs.find(a) != defs.end())
+      {
+        continue;
+      }
+      Node e = d_absValues->substituteAbstractValues(a);
+      if (!e.getType().isBoolean())
+      {
+        std::stringstream ss;
+        ss << "Expected a Boolean assumption, got " << a;
+        throw TypeCheckingExceptionPrivate(a, ss.str());
+      }
+      Node p = sm->mkDummySkolem(
+          "a", nm->booleanType(), "a variable defining a batch assumption");
+      defs[a] = p;
+      vars.push_back(p);
+      d_asserts->assertFormula(nm->mkNode(kind::IMPLIES, p, e), false);
+    }
+  }
+  d_smtSolver->processAssertions(*d_asserts);
+
+  // compute the SAT literals of each set
+  prop::PropEngine* pe = getPropEngine();
+  theory::TrustSubstitutionMap& tls = d_env->getTopLevelSubstitutions();
+  std::unordered_map<Node, Node> lits;
+  for (const Node& p : vars)
+  {
+    lits[p] = Rewriter::rewrite(tls.apply(p));
+  }
+  // maps SAT literals to the assumptions they define
+  std::unordered_map<Node, std::vector<Node>> litToAssump;
+  std::vector<std::vector<Node>> setLits(nsets);
+  std::vector<size_t> order;
+  // the sets with an assumption that has no SAT literal
+  std::vector<size_t> individual;
+  for (size_t i = 0; i < nsets; i++)
+  {
+    bool isFalse = false;
+    bool hasLiterals = true;
+    for (const Node& a : assumptions[i])
+    {
+      const Node& lit = lits[defs[a]];
+      if (lit.isConst())
+      {
+        if (!lit.getConst<bool>())
+        {
+          // the assumption is false after preprocessing
+          results[i] = Result(Result::UNSAT, d_state->getFilename());
+          unsatAssumptions[i].push_back(a);
+          isFalse = true;
+          break;
+        }
+      }
+      else if (pe->isSatLiteral(lit))
+      {
+        setLits[i].push_back(lit);
+        litToAssump[lit].push_back(a);
+      }
+      else
+      {
+        // the assumption cannot be passed to the SAT solver, the set is
+        // checked on its own after the batch
+        Trace("smt") << "SmtEngine::checkSatAssumingBatch: " << a
+                     << " has no SAT literal" << endl;
+        hasLiterals = false;
+      }
+    }
+    if (!hasLiterals && !isFalse)
+    {
+      individual.push_back(i);
+    }
+    else if (!isFalse)
+    {
+      std::sort(setLits[i].begin(), setLits[i].end());
+      setLits[i].erase(std::unique(setLits[i].begin(), setLits[i].end()),
+                       setLits[i].end());
+      order.push_back(i);
+    }
+  }
+  // Check the sets in lexicographic order of their literals. Consecutive sets
+  // then tend to share a prefix, which keeps the SAT solver closer to the
+  // trail and the lemmas of the previous check.
+  std::stable_sort(order.begin(), order.end(), [&setLits](size_t i, size_t j) {
+    return setLits[i] < setLits[j];
+  });
+
+  Result last = order.empty() ? results[0] : Result();
+  for (size_t i : order)
+  {
+    // resets the SAT solver trail and does the postsolve of the last check
+    d_state->doPendingPops();
+    results[i] = d_smtSolver->checkSatisfiabilityAssuming(setLits[i]);
+    last = results[i];
+    Trace("smt") << "SmtEngine::checkSatAssumingBatch: " << assumptions[i]
+                 << " => " << results[i] << endl;
+    Result::Sat sat = results[i].asSatisfiabilityResult().isSat();
+    if (sat == Result::SAT && !terms.empty())
+    {
+      values[i] = getValues(terms);
+    }
+    else if (sat == Result::UNSAT)
+    {
+      std::vector<Node> core;
+      pe->getUnsatAssumptions(core);
+      std::unordered_set<Node> ucore;
+      for (const Node& lit : core)
+      {
+        for (const Node& a : litToAssump[lit])
+        {
+          if (ucore.insert(a).second)
+          {
+            unsatAssumptions[i].push_back(a);
+          }
+        }
+      }
+    }
+  }
+  // pop the definitions
+  d_state->notifyCheckSatResult(true, last);
+  for (size_t i : individual)
+  {
+    checkIndividually(i);
+  }
+  return results;
+}
+
+std::vector<std::vector<Node>> SmtEngine::getCubes(size_t depth)
+{
+  SmtScope smts(this);
+  finishInit();
+  Trace("smt") << "SMT getCubes(" << depth << ")" << endl;
+  d_state->doPendingPops();
+  return d_smtSolver->getCubes(*d_asserts, depth);
+}
+
+std::vector<Node> SmtEngine::getLearnedClauses()
+{
+  SmtScope smts(this);
+  finishInit();
+  std::vector<Node> clauses;
+  getPropEngine()->getExportedClauses(clauses);
+  return clauses;
+}
+
 std::vector<Node> SmtEngine::getUnsatAssumptions(void)
 {
   Trace("smt") << "SMT getUnsatAssumptions()" << endl;
@@ -1797,6 +2033,42 @@ void SmtEngine::resetAssertions()
   d_smtSolver->resetAssertions();
 }
 
+void SmtEngine::copyPreprocessedState(SmtEngine& smt)
+{
+  Assert(getNodeManager() == smt.getNodeManager());
+  const Options& opts = smt.getOptions();
+  if (opts.smt.produceProofs || opts.smt.unsatCores
+      || opts.quantifiers.globalNegate)
+  {
+    throw ModalException(
+        "Cannot copy the preprocessed state with proofs, unsat cores or "
+        "global negation enabled");
+  }
+  if (!smt.d_state->isFullyInited())
+  {
+    // nothing asserted yet
+    return;
+  }
+  {
+    SmtScope smts(&smt);
+    smt.d_state->doPendingPops();
+  }
+  SmtScope smts(this);
+  finishInit();
+  d_state->doPendingPops();
+  Trace("smt") << "SMT copyPreprocessedState()" << endl;
+  // definitions and variables solved for during preprocessing
+  theory::TrustSubstitutionMap& tls = d_env->getTopLevelSubstitutions();
+  for (const std::pair<const Node, Node>& p :
+       smt.d_env->getTopLevelSubstitutions().get())
+  {
+    tls.addSubstitution(p.first, p.second);
+  }
+  d_asserts->copyAssertions(*smt.d_asserts);
+  d_smtSolver->assertPreprocessed(
+      smt.d_smtSolver->getPreprocessedAssertions());
+}
+
 void SmtEngine::interrupt()
 {
   if (!d_state->isFullyInited())
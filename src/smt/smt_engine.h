@@ -83,6 +83,7 @@ class Assertions;
 class DumpManager;
 class ResourceOutListener;
 class SmtNodeManagerListener;
+class GcStatisticsListener;
 class OptionsManager;
 class Preprocessor;
 class CheckModels;
@@ -390,6 +391,56 @@ class CVC5_EXPORT SmtEngine
   Result checkSat(const std::vector<Node>& assumptions,
                   bool inUnsatCore = true);
 
+  /**
+   * Check satisfiability of the current assertions under each of the given
+   * sets of assumptions, and return one result per set.
+   *
+   * In incremental mode, the assertions are preprocessed once and every
+   * distinct assumption is defined by a fresh Boolean variable in a single
+   * pushed context. The sets are then checked in one SAT solver with these
+   * variables as SAT assumptions, so that there is no push, pop or
+   * preprocessing per set and the learned clauses and lemmas are shared
+   * between the checks. The sets are checked in an order that places sets with
+   * common assumptions next to each other. If proofs, unsat cores or global
+   * negation are enabled, this falls back to one call to checkSat per set.
+   *
+   * @param assumptions The sets of assumptions.
+   * @param terms Terms whose values are computed for each satisfiable set.
+   * @param values Updated to hold, for each set, the values of terms if the
+   * set is satisfiable, or the empty vector otherwise.
+   * @param unsatAssumptions Updated to hold, for each set, a subset of the
+   * set that is unsatisfiable together with the assertions if the set is
+   * unsatisfiable, or the empty vector otherwise.
+   * @return The result of each set. The state of the SmtEngine afterwards is
+   * that of the check of the last set that was checked.
+   *
+   * @throw Exception
+   */
+  std::vector<Result> checkSatAssumingBatch(
+      const std::vector<std::vector<Node>>& assumptions,
+      const std::vector<Node>& terms,
+      std::vector<std::vector<Node>>& values,
+      std::vector<std::vector<Node>>& unsatAssumptions);
+
+  /**
+   * Split the search space of the current assertions into cubes, i.e.,
+   * conjunctions of literals whose disjunction is implied by the assertions,
+   * with at most depth splits per cube. The literals are over atoms of the
+   * preprocessed assertions. If no cube is returned, the assertions are
+   * unsatisfiable.
+   *
+   * @throw Exception
+   */
+  std::vector<std::vector<Node>> getCubes(size_t depth);
+
+  /**
+   * Get the clauses the SAT solver learned since the last call that have at
+   * most --sat-export-size literals and do not depend on assumptions or
+   * assertions of user levels above zero. These are implied by the
+   * assertions of user level zero.
+   */
+  std::vector<Node> getLearnedClauses();
+
   /**
    * Returns a set of so-called "failed" assumptions.
    *
@@ -715,6 +766,21 @@ class CVC5_EXPORT SmtEngine
   /** Reset all assertions, global declarations, etc.  */
   void resetAssertions();
 
+  /**
+   * Copy the assertions of smt into this SmtEngine, in the form in which
+   * they were passed to the SAT solver of smt after preprocessing, along with
+   * the top-level substitutions and the assertions that have not been
+   * preprocessed yet. The assertions of all user context levels of smt are
+   * added at the base level of this SmtEngine.
+   *
+   * Both SmtEngines must use the same node manager, and this SmtEngine must
+   * not have any assertions yet. This is not supported if proofs or unsat
+   * cores are enabled, or if smt uses global negation.
+   *
+   * @throw ModalException
+   */
+  void copyPreprocessedState(SmtEngine& smt);
+
   /**
    * Interrupt a running query.  This can be called from another thread
    * or from a signal handler.  Throws a ModalException if the SmtEngine
@@ -1059,6 +1125,8 @@ class CVC5_EXPORT SmtEngine
   std::unique_ptr<smt::ResourceOutListener> d_routListener;
   /** Node manager listener */
   std::unique_ptr<smt::SmtNodeManagerListener> d_snmListener;
+  /** Node manager listener for statistics on zombie reclamation */
+  std::unique_ptr<smt::GcStatisticsListener> d_gcListener;
 
   /** The SMT solver */
   std::unique_ptr<smt::SmtSolver> d_smtSolver;
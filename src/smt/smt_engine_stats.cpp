@@ -39,7 +39,17 @@ SmtEngineStatistics::SmtEngineStatistics(const std::string& name)
       d_processAssertionsTime(smtStatisticsRegistry().registerTimer(
           name + "processAssertionsTime")),
       d_simplifiedToFalse(
-          smtStatisticsRegistry().registerInt(name + "simplifiedToFalse"))
+          smtStatisticsRegistry().registerInt(name + "simplifiedToFalse")),
+      d_nvSlabAllocations(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeValueAllocator::slabAllocations")),
+      d_nvRecycled(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeValueAllocator::recycled")),
+      d_nvLargeAllocations(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeValueAllocator::largeAllocations")),
+      d_nvSlabsAcquired(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeValueAllocator::slabsAcquired")),
+      d_nvSlabsReleased(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeValueAllocator::slabsReleased"))
 {
 }
 
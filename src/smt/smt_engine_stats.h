@@ -47,6 +47,17 @@ struct SmtEngineStatistics
 
   /** Has something simplified to false? */
   IntStat d_simplifiedToFalse;
+
+  /** Node values allocated from slabs of the NodeValueAllocator */
+  ReferenceStat<uint64_t> d_nvSlabAllocations;
+  /** Slab allocations that reused a previously freed node value */
+  ReferenceStat<uint64_t> d_nvRecycled;
+  /** Node values too large for slabs */
+  ReferenceStat<uint64_t> d_nvLargeAllocations;
+  /** Slabs obtained from the system */
+  ReferenceStat<uint64_t> d_nvSlabsAcquired;
+  /** Slabs given back to the system */
+  ReferenceStat<uint64_t> d_nvSlabsReleased;
 }; /* struct SmtEngineStatistics */
 
 }  // namespace smt
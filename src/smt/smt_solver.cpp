@@ -15,6 +15,8 @@
 
 #include "smt/smt_solver.h"
 
+#include "expr/node_algorithm.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "prop/prop_engine.h"
 #include "smt/assertions.h"
@@ -44,7 +46,8 @@ SmtSolver::SmtSolver(SmtEngine& smt,
       d_stats(stats),
       d_pnm(nullptr),
       d_theoryEngine(nullptr),
-      d_propEngine(nullptr)
+      d_propEngine(nullptr),
+      d_ppAssertions(env.getUserContext())
 {
 }
 
@@ -154,7 +157,13 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
   {
     Result::UnknownExplanation why =
         rm->outOfResources() ? Result::RESOURCEOUT : Result::TIMEOUT;
-    return Result(Result::ENTAILMENT_UNKNOWN, why, filename);
+    if (rm->interrupted())
+    {
+      // an interrupt only applies to a single call
+      why = Result::INTERRUPTED;
+      rm->clearInterrupt();
+    }
+    return Result(Result::SAT_UNKNOWN, why, filename);
   }
   rm->beginCall();
 
@@ -216,6 +225,114 @@ Result SmtSolver::checkSatisfiability(Assertions& as,
   return r;
 }
 
+Result SmtSolver::checkSatisfiabilityAssuming(
+    const std::vector<Node>& literals)
+{
+  Assert(d_smt.isFullyInited());
+  const std::string& filename = d_state.getFilename();
+  ResourceManager* rm = d_env.getResourceManager();
+  if (rm->out())
+  {
+    Result::UnknownExplanation why =
+        rm->outOfResources() ? Result::RESOURCEOUT : Result::TIMEOUT;
+    if (rm->interrupted())
+    {
+      why = Result::INTERRUPTED;
+      rm->clearInterrupt();
+    }
+    return Result(Result::SAT_UNKNOWN, why, filename);
+  }
+  rm->beginCall();
+  TimerStat::CodeTimer solveTimer(d_stats.d_solveTime);
+  Trace("smt") << "SmtSolver::checkSatisfiabilityAssuming(" << literals << ")"
+               << endl;
+  Result result = d_propEngine->checkSat(literals);
+  rm->endCall();
+  if ((options::solveRealAsInt() || options::solveIntAsBV() > 0)
+      && result.asSatisfiabilityResult().isSat() == Result::UNSAT)
+  {
+    result = Result(Result::SAT_UNKNOWN, Result::UNKNOWN_REASON);
+  }
+  Result r = Result(result, filename);
+  d_state.notifyCheckSatResult(false, r);
+  return r;
+}
+
+namespace {
+/** Whether n is a Boolean connective whose children are formulas. */
+bool isBooleanConnective(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::NOT:
+    case kind::AND:
+    case kind::OR:
+    case kind::IMPLIES:
+    case kind::XOR: return true;
+    case kind::ITE:
+    case kind::EQUAL: return n[1].getType().isBoolean();
+    default: return false;
+  }
+}
+}  // namespace
+
+std::vector<std::vector<Node>> SmtSolver::getCubes(Assertions& as,
+                                                   size_t depth)
+{
+  Assert(d_smt.isFullyInited());
+  // make sure the prop layer has all of the assertions
+  as.initializeCheckSat({}, false, false);
+  processAssertions(as);
+
+  // count the occurrences of the atoms in the preprocessed assertions
+  std::unordered_map<Node, size_t> occs;
+  std::unordered_set<TNode> visited;
+  std::vector<TNode> visit;
+  for (const std::pair<Node, Node>& a : d_ppAssertions)
+  {
+    visit.push_back(a.first);
+  }
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!isBooleanConnective(cur))
+    {
+      occs[cur]++;
+    }
+    else if (visited.insert(cur).second)
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  }
+  std::vector<Node> atoms;
+  for (const std::pair<const Node, size_t>& o : occs)
+  {
+    const Node& a = o.first;
+    if (!a.isConst() && !a.isClosure() && d_propEngine->isSatLiteral(a)
+        && !expr::hasSubtermKind(kind::SKOLEM, a))
+    {
+      atoms.push_back(a);
+    }
+  }
+  std::sort(atoms.begin(), atoms.end(), [&occs](const Node& a, const Node& b) {
+    size_t oa = occs[a];
+    size_t ob = occs[b];
+    return oa > ob || (oa == ob && a.getId() < b.getId());
+  });
+  if (atoms.size() > options::cubeCandidates())
+  {
+    atoms.resize(options::cubeCandidates());
+  }
+
+  std::vector<std::vector<Node>> cubes;
+  if (!d_propEngine->getCubes(atoms, depth, cubes))
+  {
+    cubes.push_back(std::vector<Node>());
+  }
+  return cubes;
+}
+
 void SmtSolver::processAssertions(Assertions& as)
 {
   TimerStat::CodeTimer paTimer(d_stats.d_processAssertionsTime);
@@ -244,6 +361,12 @@ void SmtSolver::processAssertions(Assertions& as)
     // definitions, as the decision justification heuristic treates the latter
     // specially.
     preprocessing::IteSkolemMap& ism = ap.getIteSkolemMap();
+    for (size_t i = 0, asize = assertions.size(); i < asize; i++)
+    {
+      preprocessing::IteSkolemMap::iterator it = ism.find(i);
+      d_ppAssertions.push_back(std::pair<Node, Node>(
+          assertions[i], it == ism.end() ? Node::null() : it->second));
+    }
     d_propEngine->assertInputFormulas(assertions, ism);
   }
 
@@ -251,6 +374,33 @@ void SmtSolver::processAssertions(Assertions& as)
   as.clearCurrent();
 }
 
+void SmtSolver::assertPreprocessed(
+    const context::CDList<std::pair<Node, Node>>& assertions)
+{
+  Assert(d_state.isFullyInited());
+  std::vector<Node> formulas;
+  std::unordered_map<size_t, Node> skolemMap;
+  for (const std::pair<Node, Node>& a : assertions)
+  {
+    if (!a.second.isNull())
+    {
+      skolemMap[formulas.size()] = a.second;
+    }
+    formulas.push_back(a.first);
+    d_ppAssertions.push_back(a);
+  }
+  if (!formulas.empty())
+  {
+    d_propEngine->assertInputFormulas(formulas, skolemMap);
+  }
+}
+
+const context::CDList<std::pair<Node, Node>>&
+SmtSolver::getPreprocessedAssertions() const
+{
+  return d_ppAssertions;
+}
+
 void SmtSolver::setProofNodeManager(ProofNodeManager* pnm) { d_pnm = pnm; }
 
 TheoryEngine* SmtSolver::getTheoryEngine() { return d_theoryEngine.get(); }
@@ -18,8 +18,10 @@
 #ifndef CVC5__SMT__SMT_SOLVER_H
 #define CVC5__SMT__SMT_SOLVER_H
 
+#include <utility>
 #include <vector>
 
+#include "context/cdlist.h"
 #include "expr/node.h"
 #include "theory/logic_info.h"
 #include "util/result.h"
@@ -111,12 +113,43 @@ class SmtSolver
                              const std::vector<Node>& assumptions,
                              bool inUnsatCore,
                              bool isEntailmentCheck);
+  /**
+   * Split the search space of the assertions into cubes, see
+   * PropEngine::getCubes. This first processes the assertions in as. The
+   * atoms considered for splitting are the --cube-candidates atoms of the
+   * preprocessed assertions with the most occurrences, except for atoms
+   * containing skolems. If the SAT solver does not support lookahead, the
+   * only cube is the empty one.
+   */
+  std::vector<std::vector<Node>> getCubes(Assertions& as, size_t depth);
+  /**
+   * Check satisfiability of the assertions that were already pushed to the
+   * prop engine under the given literals, which must have associated SAT
+   * literals. The literals are assumptions of the SAT solver: nothing is
+   * preprocessed and the context is not changed, so that the learned clauses
+   * and lemmas of a call are kept for subsequent calls.
+   */
+  Result checkSatisfiabilityAssuming(const std::vector<Node>& literals);
   /**
    * Process the assertions that have been asserted in as. This moves the set of
    * assertions that have been buffered into as, preprocesses them, pushes them
    * into the SMT solver, and clears the buffer.
    */
   void processAssertions(Assertions& as);
+  /**
+   * Assert formulas that were preprocessed by another SmtSolver using the same
+   * node manager directly to the prop engine, without preprocessing them
+   * again. Each formula is paired with the skolem it is the definition of,
+   * or the null node if it is not a skolem definition.
+   */
+  void assertPreprocessed(
+      const context::CDList<std::pair<Node, Node>>& assertions);
+  /**
+   * Get the preprocessed formulas that were asserted to the prop engine in
+   * the current user context, paired with the skolems they define.
+   */
+  const context::CDList<std::pair<Node, Node>>& getPreprocessedAssertions()
+      const;
   /**
    * Set proof node manager. Enables proofs in this SmtSolver. Should be
    * called before finishInit.
@@ -153,6 +186,12 @@ class SmtSolver
   std::unique_ptr<TheoryEngine> d_theoryEngine;
   /** The propositional engine */
   std::unique_ptr<prop::PropEngine> d_propEngine;
+  /**
+   * The formulas asserted to the prop engine, paired with the skolems they
+   * define (if any). This allows to copy the state after preprocessing to
+   * another SmtSolver.
+   */
+  context::CDList<std::pair<Node, Node>> d_ppAssertions;
 };
 
 }  // namespace smt
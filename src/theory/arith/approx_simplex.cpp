@@ -31,10 +31,7 @@
 #include "theory/arith/cut_log.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/normal_form.h"
-
-#ifdef CVC5_USE_GLPK
 #include "theory/arith/partial_model.h"
-#endif
 
 using namespace std;
 
@@ -322,6 +319,57 @@ Maybe<Rational> ApproximateSimplex::estimateWithCFE(double d)
   return estimateWithCFE(d, s_defaultMaxDenom);
 }
 
+DeltaRational ApproximateSimplex::estimateAssignment(ArithVar vi,
+                                                     double newAssign) const
+{
+  const DeltaRational& oldAssign = d_vars.getAssignment(vi);
+
+  if (d_vars.hasLowerBound(vi)
+      && roughlyEqual(newAssign,
+                      d_vars.getLowerBound(vi).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getLowerBound(vi);
+  }
+  else if (d_vars.hasUpperBound(vi)
+           && roughlyEqual(newAssign,
+                           d_vars.getUpperBound(vi).approx(SMALL_FIXED_DELTA)))
+  {
+    return d_vars.getUpperBound(vi);
+  }
+
+  double rounded = round(newAssign);
+  if (roughlyEqual(newAssign, rounded))
+  {
+    newAssign = rounded;
+  }
+
+  DeltaRational proposal;
+  if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
+  {
+    proposal = maybe_new.value();
+  }
+  else
+  {
+    // failed to estimate the old value. defaulting to the current.
+    proposal = d_vars.getAssignment(vi);
+  }
+
+  if (roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA)))
+  {
+    proposal = d_vars.getAssignment(vi);
+  }
+
+  if (d_vars.strictlyLessThanLowerBound(vi, proposal))
+  {
+    proposal = d_vars.getLowerBound(vi);
+  }
+  else if (d_vars.strictlyGreaterThanUpperBound(vi, proposal))
+  {
+    proposal = d_vars.getUpperBound(vi);
+  }
+  return proposal;
+}
+
 class ApproxNoOp : public ApproximateSimplex {
 public:
   ApproxNoOp(const ArithVariables& v, TreeLog& l, ApproximateStatistics& s)
@@ -1072,76 +1120,7 @@ ApproximateSimplex::Solution ApproxGLPK::extractSolution(bool mip) const
         newAssign = (isAux ? glp_get_row_prim(prob, glpk_index)
                      :  glp_get_col_prim(prob, glpk_index));
       }
-      const DeltaRational& oldAssign = d_vars.getAssignment(vi);
-
-      if (d_vars.hasLowerBound(vi)
-          && roughlyEqual(newAssign,
-                          d_vars.getLowerBound(vi).approx(SMALL_FIXED_DELTA)))
-      {
-        // CVC5Message() << "  to lb" << endl;
-
-        newValues.set(vi, d_vars.getLowerBound(vi));
-      }
-      else if (d_vars.hasUpperBound(vi)
-               && roughlyEqual(
-                   newAssign,
-                   d_vars.getUpperBound(vi).approx(SMALL_FIXED_DELTA)))
-      {
-        newValues.set(vi, d_vars.getUpperBound(vi));
-        // CVC5Message() << "  to ub" << endl;
-      }
-      else
-      {
-        double rounded = round(newAssign);
-        if (roughlyEqual(newAssign, rounded))
-        {
-          // CVC5Message() << "roughly equal " << rounded << " " << newAssign <<
-          // " " << oldAssign << endl;
-          newAssign = rounded;
-        }
-        else
-        {
-          // CVC5Message() << "not roughly equal " << rounded << " " <<
-          // newAssign << " " << oldAssign << endl;
-        }
-
-        DeltaRational proposal;
-        if (Maybe<Rational> maybe_new = estimateWithCFE(newAssign))
-        {
-          proposal = maybe_new.value();
-        }
-        else
-        {
-          // failed to estimate the old value. defaulting to the current.
-          proposal = d_vars.getAssignment(vi);
-        }
-
-        if (roughlyEqual(newAssign, oldAssign.approx(SMALL_FIXED_DELTA)))
-        {
-          // CVC5Message() << "  to prev value" << newAssign << " " << oldAssign
-          // << endl;
-          proposal = d_vars.getAssignment(vi);
-        }
-
-        if (d_vars.strictlyLessThanLowerBound(vi, proposal))
-        {
-          // CVC5Message() << "  round to lb " << d_vars.getLowerBound(vi) <<
-          // endl;
-          proposal = d_vars.getLowerBound(vi);
-        }
-        else if (d_vars.strictlyGreaterThanUpperBound(vi, proposal))
-        {
-          // CVC5Message() << "  round to ub " << d_vars.getUpperBound(vi) <<
-          // endl;
-          proposal = d_vars.getUpperBound(vi);
-        }
-        else
-        {
-          // CVC5Message() << "  use proposal" << proposal << " " << oldAssign
-          // << endl;
-        }
-        newValues.set(vi, proposal);
-      }
+      newValues.set(vi, estimateAssignment(vi, newAssign));
     }
   }
   return sol;
@@ -145,6 +145,14 @@ class ApproximateSimplex{
   virtual double sumInfeasibilities(bool mip) const = 0;
 
  protected:
+  /**
+   * Returns an exact value for variable v that approximates the value
+   * computed by the approximate solver: the bound of v if it is roughly
+   * equal, the current assignment if it is roughly equal, and a continued
+   * fraction estimate (within the bounds of v) otherwise.
+   */
+  DeltaRational estimateAssignment(ArithVar v, double value) const;
+
   const ArithVariables& d_vars;
   TreeLog& d_log;
   ApproximateStatistics& d_stats;
@@ -0,0 +1,470 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A built-in floating-point simplex for approximating the real relaxation.
+ */
+
+#include "theory/arith/fp_simplex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/output.h"
+#include "theory/arith/normal_form.h"
+#include "theory/arith/partial_model.h"
+
+using namespace std;
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+namespace {
+
+/** Reduced costs below this value are considered zero. */
+const double s_costTolerance = 1e-9;
+/** Tableau entries below this value are not used as pivots. */
+const double s_pivotTolerance = 1e-9;
+/** Tableau entries below this value are dropped after a pivot. */
+const double s_dropTolerance = 1e-12;
+/** The number of degenerate steps after which Bland's rule is used. */
+const int s_degenerateLimit = 50;
+/** The number of steps after which the basic values are recomputed. */
+const int s_refreshInterval = 100;
+
+/** A breakpoint or a blocking variable in the ratio test. */
+struct RatioCandidate
+{
+  /** The row of the basic variable. */
+  size_t d_row;
+  /** The rate of change of the basic variable. */
+  double d_alpha;
+  /** The distance of the entering variable at which the bound is reached. */
+  double d_ratio;
+  /** The bound that is reached. */
+  double d_bound;
+};
+
+}  // namespace
+
+FloatingPointSimplex::FloatingPointSimplex(const ArithVariables& vars,
+                                           TreeLog& l,
+                                           ApproximateStatistics& s)
+    : ApproximateSimplex(vars, l, s), d_solved(false)
+{
+  const double inf = numeric_limits<double>::infinity();
+  size_t n = d_vars.getNumberOfVariables();
+  d_lower.assign(n, -inf);
+  d_upper.assign(n, inf);
+  d_values.assign(n, 0);
+  d_cols.resize(n);
+  std::vector<ArithVar> aux;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    if (d_vars.hasLowerBound(v))
+    {
+      d_lower[v] = d_vars.getLowerBound(v).approx(SMALL_FIXED_DELTA);
+    }
+    if (d_vars.hasUpperBound(v))
+    {
+      d_upper[v] = d_vars.getUpperBound(v).approx(SMALL_FIXED_DELTA);
+    }
+    d_values[v] = d_vars.getAssignment(v).approx(SMALL_FIXED_DELTA);
+    if (d_vars.isAuxiliary(v))
+    {
+      aux.push_back(v);
+    }
+    else
+    {
+      // the original variables start as non-basic, within their bounds
+      d_values[v] = std::max(std::min(d_values[v], d_upper[v]), d_lower[v]);
+    }
+  }
+
+  // start from the basis of the auxiliary variables, defined by their
+  // polynomials over the original variables
+  d_rowOf.assign(n, aux.size());
+  d_rows.resize(aux.size());
+  for (size_t r = 0, nrows = aux.size(); r < nrows; ++r)
+  {
+    ArithVar v = aux[r];
+    d_basic.push_back(v);
+    d_rowOf[v] = r;
+    Polynomial p = Polynomial::parsePolynomial(d_vars.asNode(v));
+    for (Polynomial::iterator j = p.begin(), end = p.end(); j != end; ++j)
+    {
+      const Monomial& mono = *j;
+      Node var = mono.getVarList().getNode();
+      Assert(d_vars.hasArithVar(var));
+      ArithVar av = d_vars.asArithVar(var);
+      Assert(!d_vars.isAuxiliary(av));
+      d_rows[r][av] += mono.getConstant().getValue().getDouble();
+      d_cols[av].insert(r);
+    }
+  }
+  recomputeBasicValues();
+}
+
+double FloatingPointSimplex::tolerance(double b)
+{
+  // infinite bounds need no tolerance (and would give inf - inf)
+  return std::isinf(b) ? 0 : SMALL_FIXED_DELTA * std::max(1.0, std::abs(b));
+}
+
+bool FloatingPointSimplex::belowLower(ArithVar v) const
+{
+  return d_values[v] < d_lower[v] - tolerance(d_lower[v]);
+}
+
+bool FloatingPointSimplex::aboveUpper(ArithVar v) const
+{
+  return d_values[v] > d_upper[v] + tolerance(d_upper[v]);
+}
+
+void FloatingPointSimplex::recomputeBasicValues()
+{
+  for (size_t r = 0, nrows = d_rows.size(); r < nrows; ++r)
+  {
+    double sum = 0;
+    for (const std::pair<const ArithVar, double>& e : d_rows[r])
+    {
+      sum += e.second * d_values[e.first];
+    }
+    d_values[d_basic[r]] = sum;
+  }
+}
+
+double FloatingPointSimplex::sumInfeasibilities(bool mip) const
+{
+  double sum = 0;
+  for (ArithVar b : d_basic)
+  {
+    if (belowLower(b))
+    {
+      sum += d_lower[b] - d_values[b];
+    }
+    else if (aboveUpper(b))
+    {
+      sum += d_values[b] - d_upper[b];
+    }
+  }
+  return sum;
+}
+
+bool FloatingPointSimplex::computeGradient(
+    std::unordered_map<ArithVar, double>& grad) const
+{
+  bool infeasible = false;
+  for (size_t r = 0, nrows = d_rows.size(); r < nrows; ++r)
+  {
+    ArithVar b = d_basic[r];
+    double sign = belowLower(b) ? -1 : (aboveUpper(b) ? 1 : 0);
+    if (sign == 0)
+    {
+      continue;
+    }
+    infeasible = true;
+    for (const std::pair<const ArithVar, double>& e : d_rows[r])
+    {
+      grad[e.first] += sign * e.second;
+    }
+  }
+  return infeasible;
+}
+
+ArithVar FloatingPointSimplex::selectEntering(
+    const std::unordered_map<ArithVar, double>& grad, bool bland, int& dir) const
+{
+  ArithVar best = ARITHVAR_SENTINEL;
+  double bestGain = 0;
+  for (const std::pair<const ArithVar, double>& g : grad)
+  {
+    ArithVar v = g.first;
+    int vdir = 0;
+    if (g.second < -s_costTolerance
+        && d_values[v] < d_upper[v] - tolerance(d_upper[v]))
+    {
+      vdir = 1;
+    }
+    else if (g.second > s_costTolerance
+             && d_values[v] > d_lower[v] + tolerance(d_lower[v]))
+    {
+      vdir = -1;
+    }
+    if (vdir == 0)
+    {
+      continue;
+    }
+    double gain = std::abs(g.second);
+    bool better = best == ARITHVAR_SENTINEL
+                  || (bland ? v < best
+                            : (gain > bestGain || (gain == bestGain && v < best)));
+    if (better)
+    {
+      best = v;
+      bestGain = gain;
+      dir = vdir;
+    }
+  }
+  return best;
+}
+
+bool FloatingPointSimplex::ratioTest(ArithVar entering,
+                                     int dir,
+                                     double slope,
+                                     Step& step) const
+{
+  const double inf = numeric_limits<double>::infinity();
+  double range = dir > 0 ? d_upper[entering] - d_values[entering]
+                         : d_values[entering] - d_lower[entering];
+  std::vector<RatioCandidate> blocking;
+  std::vector<RatioCandidate> breakpoints;
+  for (size_t r : d_cols[entering])
+  {
+    ArithVar b = d_basic[r];
+    double alpha = d_rows[r].at(entering) * dir;
+    if (std::abs(alpha) < s_pivotTolerance)
+    {
+      continue;
+    }
+    double x = d_values[b];
+    double l = d_lower[b];
+    double u = d_upper[b];
+    if (belowLower(b) || aboveUpper(b))
+    {
+      // an infeasible variable moving towards its violated bound becomes
+      // feasible there, and blocks at its other bound
+      if (alpha > 0 && belowLower(b))
+      {
+        breakpoints.push_back({r, alpha, (l - x) / alpha, l});
+        if (u < inf)
+        {
+          blocking.push_back({r, alpha, (u - x) / alpha, u});
+        }
+      }
+      else if (alpha < 0 && aboveUpper(b))
+      {
+        breakpoints.push_back({r, alpha, (x - u) / -alpha, u});
+        if (l > -inf)
+        {
+          blocking.push_back({r, alpha, (x - l) / -alpha, l});
+        }
+      }
+    }
+    else if (alpha > 0 && u < inf)
+    {
+      blocking.push_back({r, alpha, std::max(0.0, (u - x) / alpha), u});
+    }
+    else if (alpha < 0 && l > -inf)
+    {
+      blocking.push_back({r, alpha, std::max(0.0, (x - l) / -alpha), l});
+    }
+  }
+
+  // Harris' ratio test: relax the bounds by the tolerance to get a maximal
+  // step, then choose the largest pivot among the candidates within it
+  double harris = inf;
+  for (const RatioCandidate& c : blocking)
+  {
+    harris = std::min(harris,
+                      c.d_ratio + tolerance(c.d_bound) / std::abs(c.d_alpha));
+  }
+  const RatioCandidate* block = nullptr;
+  for (const RatioCandidate& c : blocking)
+  {
+    if (c.d_ratio <= harris
+        && (block == nullptr
+            || std::abs(c.d_alpha) > std::abs(block->d_alpha)))
+    {
+      block = &c;
+    }
+  }
+  double limit = std::min(block == nullptr ? inf : block->d_ratio, range);
+
+  // pass over the breakpoints while the sum of infeasibilities decreases
+  std::sort(breakpoints.begin(),
+            breakpoints.end(),
+            [](const RatioCandidate& a, const RatioCandidate& b) {
+              return a.d_ratio < b.d_ratio;
+            });
+  for (const RatioCandidate& c : breakpoints)
+  {
+    if (c.d_ratio > limit)
+    {
+      break;
+    }
+    slope += std::abs(c.d_alpha);
+    if (slope >= -s_costTolerance)
+    {
+      step.d_length = c.d_ratio;
+      step.d_row = c.d_row;
+      step.d_leavingValue = c.d_bound;
+      return true;
+    }
+  }
+  if (limit == inf)
+  {
+    return false;
+  }
+  if (range <= limit)
+  {
+    // the entering variable reaches its other bound first
+    step.d_length = range;
+    step.d_row = d_rows.size();
+    return true;
+  }
+  step.d_length = block->d_ratio;
+  step.d_row = block->d_row;
+  step.d_leavingValue = block->d_bound;
+  return true;
+}
+
+void FloatingPointSimplex::pivot(size_t r, ArithVar entering)
+{
+  Row& row = d_rows[r];
+  ArithVar leaving = d_basic[r];
+  double a = row.at(entering);
+  Assert(std::abs(a) >= s_pivotTolerance);
+
+  // solve the row for the entering variable
+  Row newRow;
+  newRow.reserve(row.size());
+  newRow[leaving] = 1 / a;
+  for (const std::pair<const ArithVar, double>& e : row)
+  {
+    if (e.first != entering)
+    {
+      newRow[e.first] = -e.second / a;
+    }
+  }
+  d_cols[entering].erase(r);
+  d_cols[leaving].insert(r);
+
+  // substitute it into the other rows
+  std::vector<size_t> others(d_cols[entering].begin(), d_cols[entering].end());
+  d_cols[entering].clear();
+  for (size_t i : others)
+  {
+    Row& ri = d_rows[i];
+    double f = ri.at(entering);
+    ri.erase(entering);
+    for (const std::pair<const ArithVar, double>& e : newRow)
+    {
+      Row::iterator it = ri.find(e.first);
+      if (it == ri.end())
+      {
+        double c = f * e.second;
+        if (std::abs(c) > s_dropTolerance)
+        {
+          ri.emplace(e.first, c);
+          d_cols[e.first].insert(i);
+        }
+      }
+      else
+      {
+        it->second += f * e.second;
+        if (std::abs(it->second) <= s_dropTolerance)
+        {
+          ri.erase(it);
+          d_cols[e.first].erase(i);
+        }
+      }
+    }
+  }
+  row.swap(newRow);
+  d_basic[r] = entering;
+  d_rowOf[entering] = r;
+  d_rowOf[leaving] = d_rows.size();
+}
+
+LinResult FloatingPointSimplex::solveRelaxation()
+{
+  d_solved = true;
+  int degenerate = 0;
+  for (int iter = 0;; ++iter)
+  {
+    if (iter > 0 && iter % s_refreshInterval == 0)
+    {
+      recomputeBasicValues();
+    }
+    std::unordered_map<ArithVar, double> grad;
+    if (!computeGradient(grad))
+    {
+      Debug("arith::fpSimplex") << "feasible after " << iter << endl;
+      return LinFeasible;
+    }
+    int dir = 0;
+    ArithVar entering =
+        selectEntering(grad, degenerate > s_degenerateLimit, dir);
+    if (entering == ARITHVAR_SENTINEL)
+    {
+      Debug("arith::fpSimplex") << "infeasible after " << iter << ", sum "
+                                << sumInfeasibilities(false) << endl;
+      return LinInfeasible;
+    }
+    if (iter >= d_pivotLimit)
+    {
+      return LinExhausted;
+    }
+    Step step;
+    if (!ratioTest(entering, dir, -std::abs(grad[entering]), step))
+    {
+      // cannot happen in exact arithmetic, as the sum of infeasibilities is
+      // bounded from below
+      return LinUnknown;
+    }
+    double delta = dir * step.d_length;
+    d_values[entering] += delta;
+    for (size_t r : d_cols[entering])
+    {
+      d_values[d_basic[r]] += d_rows[r].at(entering) * delta;
+    }
+    if (step.d_row == d_rows.size())
+    {
+      d_values[entering] = dir > 0 ? d_upper[entering] : d_lower[entering];
+    }
+    else
+    {
+      d_values[d_basic[step.d_row]] = step.d_leavingValue;
+      pivot(step.d_row, entering);
+    }
+    degenerate = step.d_length > 0 ? 0 : degenerate + 1;
+  }
+}
+
+ApproximateSimplex::Solution FloatingPointSimplex::extractRelaxation() const
+{
+  Assert(d_solved);
+  Solution sol;
+  for (ArithVariables::var_iterator vi = d_vars.var_begin(),
+                                    vi_end = d_vars.var_end();
+       vi != vi_end;
+       ++vi)
+  {
+    ArithVar v = *vi;
+    if (d_rowOf[v] != d_rows.size())
+    {
+      sol.newBasis.add(v);
+    }
+    sol.newValues.set(v, estimateAssignment(v, d_values[v]));
+  }
+  return sol;
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A built-in floating-point simplex for approximating the real relaxation.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__ARITH__FP_SIMPLEX_H
+#define CVC5__THEORY__ARITH__FP_SIMPLEX_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "theory/arith/approx_simplex.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+/**
+ * A primal simplex in double precision that searches for a feasible basis of
+ * the real relaxation of the current bounds. Like the GLPK backend, it works
+ * on the problem given by ArithVariables: every auxiliary variable is defined
+ * by a linear polynomial over the original variables, and the search starts
+ * from the basis of all auxiliary variables, with the original variables at
+ * their current assignment.
+ *
+ * The search minimizes the sum of infeasibilities of the basic variables
+ * (phase one). The entering variable is chosen by the largest reduced cost,
+ * falling back to Bland's rule after a run of degenerate pivots. The ratio
+ * test passes over the breakpoints at which infeasible basic variables become
+ * feasible as long as the objective keeps decreasing, flips the bound of the
+ * entering variable instead of pivoting when that is the first breakpoint,
+ * and chooses the leaving variable among the blocking ones by Harris' two
+ * pass rule.
+ *
+ * The result is only a candidate: extractRelaxation() snaps the values to
+ * the exact bounds where possible, and the caller installs the basis and
+ * values in exact arithmetic (see AttemptSolutionSDP), which repairs any
+ * rounding errors.
+ */
+class FloatingPointSimplex : public ApproximateSimplex
+{
+ public:
+  FloatingPointSimplex(const ArithVariables& vars,
+                       TreeLog& l,
+                       ApproximateStatistics& s);
+
+  /**
+   * Runs the phase one simplex for at most the pivot limit. Returns
+   * LinFeasible if a basis with no infeasibility (up to the tolerance) was
+   * found, LinInfeasible if the sum of infeasibilities cannot be decreased,
+   * and LinExhausted if the pivot limit was reached.
+   */
+  LinResult solveRelaxation() override;
+  /** Returns the basis and the values of the last call to solveRelaxation(). */
+  Solution extractRelaxation() const override;
+  /** Returns the sum of infeasibilities of the current values. */
+  double sumInfeasibilities(bool mip) const override;
+
+  /** The floating-point simplex does not solve integer problems. */
+  MipResult solveMIP(bool activelyLog) override { return MipUnknown; }
+  Solution extractMIP() const override { return Solution(); }
+  ArithVar getBranchVar(const NodeLog& nl) const override
+  {
+    return ARITHVAR_SENTINEL;
+  }
+  std::vector<const CutInfo*> getValidCuts(const NodeLog& node) override
+  {
+    return std::vector<const CutInfo*>();
+  }
+  void tryCut(int nid, CutInfo& cut) override {}
+  /** There is no objective, only the sum of infeasibilities. */
+  void setOptCoeffs(const ArithRatPairVec& ref) override {}
+  ArithRatPairVec heuristicOptCoeffs() const override
+  {
+    return ArithRatPairVec();
+  }
+
+ private:
+  /** A row, mapping the non-basic variables to their coefficients. */
+  using Row = std::unordered_map<ArithVar, double>;
+  /** The result of a ratio test. */
+  struct Step
+  {
+    /** The distance to move the entering variable. */
+    double d_length = 0;
+    /** The row of the leaving variable, or d_rows.size() for a bound flip. */
+    size_t d_row = 0;
+    /** The value that the leaving variable takes. */
+    double d_leavingValue = 0;
+  };
+
+  /** Whether v violates its lower bound, or its upper bound. */
+  bool belowLower(ArithVar v) const;
+  bool aboveUpper(ArithVar v) const;
+  /** The tolerance for comparing the value of v with its bound b. */
+  static double tolerance(double b);
+  /**
+   * Computes the gradient of the sum of infeasibilities w.r.t. the non-basic
+   * variables. Returns false if all basic variables are feasible.
+   */
+  bool computeGradient(std::unordered_map<ArithVar, double>& grad) const;
+  /**
+   * Chooses a non-basic variable and a direction (+1 or -1) such that moving
+   * it decreases the sum of infeasibilities, with gradient grad. Returns
+   * ARITHVAR_SENTINEL if there is none.
+   */
+  ArithVar selectEntering(const std::unordered_map<ArithVar, double>& grad,
+                          bool bland,
+                          int& dir) const;
+  /**
+   * Runs the ratio test for moving entering in direction dir, where slope is
+   * the (negative) initial rate of change of the sum of infeasibilities.
+   * Returns false if the step is unbounded.
+   */
+  bool ratioTest(ArithVar entering, int dir, double slope, Step& step) const;
+  /** Makes entering basic in row r. */
+  void pivot(size_t r, ArithVar entering);
+  /** Recomputes the values of the basic variables from the rows. */
+  void recomputeBasicValues();
+
+  /** The lower and upper bounds, or -/+ infinity. */
+  std::vector<double> d_lower;
+  std::vector<double> d_upper;
+  /** The current values. */
+  std::vector<double> d_values;
+  /** The rows of the basic variables. */
+  std::vector<Row> d_rows;
+  /** The basic variable of each row. */
+  std::vector<ArithVar> d_basic;
+  /** The row of each basic variable, or d_rows.size() if it is non-basic. */
+  std::vector<size_t> d_rowOf;
+  /** The rows in which each non-basic variable occurs. */
+  std::vector<std::unordered_set<size_t>> d_cols;
+  /** Whether solveRelaxation() was called. */
+  bool d_solved;
+};
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__ARITH__FP_SIMPLEX_H */
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -206,6 +207,10 @@ public:
 
   uint32_t size() const{ return d_size; }
   uint32_t capacity() const{ return d_entries.capacity(); }
+  /** The number of entries in use plus the number of freed entries. */
+  uint32_t slots() const { return d_entries.size(); }
+
+  void reserve(uint32_t n) { d_entries.reserve(n); }
 
 
 private:
@@ -392,9 +397,22 @@ protected:
   /* The row that is in the merge buffer. */
   RowIndex d_rowInMergeBuffer;
 
+  /*
+   * The entries of the row in the merge buffer as (column, entry) pairs, in
+   * the order of the row. Row additions walk this array instead of the links
+   * of the row.
+   */
+  typedef std::vector<std::pair<ArithVar, EntryID> > MergeRow;
+  MergeRow d_mergeRow;
+
   uint32_t d_entriesInUse;
   MatrixEntryVector<T> d_entries;
 
+  /* The number of entries added since the last call to compact(). */
+  uint32_t d_entriesSinceCompaction;
+  /* If false, maybeCompact() never compacts. */
+  bool d_compactionEnabled;
+
   std::vector<RowIndex> d_pool;
 
   T d_zero;
@@ -408,8 +426,11 @@ public:
     d_columns(),
     d_mergeBuffer(),
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
+    d_mergeRow(),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesSinceCompaction(0),
+    d_compactionEnabled(true),
     d_zero(0)
   {}
 
@@ -418,8 +439,11 @@ public:
     d_columns(),
     d_mergeBuffer(),
     d_rowInMergeBuffer(ROW_INDEX_SENTINEL),
+    d_mergeRow(),
     d_entriesInUse(0),
     d_entries(),
+    d_entriesSinceCompaction(0),
+    d_compactionEnabled(true),
     d_zero(zero)
   {}
 
@@ -428,8 +452,11 @@ public:
     d_columns(),
     d_mergeBuffer(m.d_mergeBuffer),
     d_rowInMergeBuffer(m.d_rowInMergeBuffer),
+    d_mergeRow(m.d_mergeRow),
     d_entriesInUse(m.d_entriesInUse),
     d_entries(m.d_entries),
+    d_entriesSinceCompaction(m.d_entriesSinceCompaction),
+    d_compactionEnabled(m.d_compactionEnabled),
     d_zero(m.d_zero)
   {
     d_columns.clear();
@@ -447,8 +474,11 @@ public:
   Matrix& operator=(const Matrix& m){
     d_mergeBuffer = (m.d_mergeBuffer);
     d_rowInMergeBuffer = (m.d_rowInMergeBuffer);
+    d_mergeRow = (m.d_mergeRow);
     d_entriesInUse = (m.d_entriesInUse);
     d_entries = (m.d_entries);
+    d_entriesSinceCompaction = (m.d_entriesSinceCompaction);
+    d_compactionEnabled = (m.d_compactionEnabled);
     d_zero = (m.d_zero);
     d_columns.clear();
     for(typename ColumnTable::const_iterator c=m.d_columns.begin(), cend = m.d_columns.end(); c!=cend; ++c){
@@ -479,6 +509,7 @@ protected:
     Assert(newEntry.getCoefficient() != 0);
 
     ++d_entriesInUse;
+    ++d_entriesSinceCompaction;
 
     d_rows[row].insert(newId);
     d_columns[col].insert(newId);
@@ -597,6 +628,7 @@ public:
       const MatrixEntry<T>& entry = *i;
       ArithVar colVar = entry.getColVar();
       d_mergeBuffer.set(colVar, std::make_pair(id, false));
+      d_mergeRow.push_back(std::make_pair(colVar, id));
     }
 
     d_rowInMergeBuffer = rid;
@@ -607,6 +639,7 @@ public:
 
     d_rowInMergeBuffer = ROW_INDEX_SENTINEL;
     d_mergeBuffer.purge();
+    d_mergeRow.clear();
   }
 
   /* to *= mult */
@@ -673,18 +706,14 @@ public:
       }
     }
 
-    i = getRow(d_rowInMergeBuffer).begin();
-    i_end = getRow(d_rowInMergeBuffer).end();
-
-    for(; i != i_end; ++i){
-      const Entry& entry = *i;
-      ArithVar colVar = entry.getColVar();
+    for(const std::pair<ArithVar, EntryID>& p : d_mergeRow){
+      ArithVar colVar = p.first;
 
       if(d_mergeBuffer[colVar].second){
         d_mergeBuffer.get(colVar).second = false;
       }else{
         Assert(!(d_mergeBuffer[colVar]).second);
-        T newCoeff =  mult * entry.getCoefficient();
+        T newCoeff =  mult * d_entries[p.second].getCoefficient();
         addEntry(to, colVar, newCoeff);
       }
     }
@@ -738,18 +767,14 @@ public:
       }
     }
 
-    i = getRow(d_rowInMergeBuffer).begin();
-    i_end = getRow(d_rowInMergeBuffer).end();
-
-    for(; i != i_end; ++i){
-      const Entry& entry = *i;
-      ArithVar colVar = entry.getColVar();
+    for(const std::pair<ArithVar, EntryID>& p : d_mergeRow){
+      ArithVar colVar = p.first;
 
       if(d_mergeBuffer[colVar].second){
         d_mergeBuffer.get(colVar).second = false;
       }else{
         Assert(!(d_mergeBuffer[colVar]).second);
-        T newCoeff =  mult * entry.getCoefficient();
+        T newCoeff =  mult * d_entries[p.second].getCoefficient();
         addEntry(to, colVar, newCoeff);
 
         cb.update(to, colVar, 0,  newCoeff.sgn());
@@ -892,6 +917,86 @@ public:
     }
   }
 
+  /**
+   * Renumbers the entries so that the entries of each row are contiguous and
+   * the rows are stored one after the other by increasing index, and releases
+   * the slots of removed entries. Rows and columns are relinked in their
+   * current order, so iteration is unaffected.
+   *
+   * The merge buffer must be empty.
+   */
+  void compact(){
+    Assert(d_rowInMergeBuffer == ROW_INDEX_SENTINEL);
+    Assert(d_mergeBuffer.empty());
+
+    std::vector<EntryID> newIds(d_entries.slots(), ENTRYID_SENTINEL);
+    MatrixEntryVector<T> compacted;
+    compacted.reserve(d_entries.size());
+
+    for(RowIndex rid = 0, N = d_rows.size(); rid < N; ++rid){
+      EntryID prev = ENTRYID_SENTINEL;
+      for(RowIterator i = getRow(rid).begin(); !i.atEnd(); ++i){
+        Entry& entry = d_entries.get(i.getID());
+        EntryID newId = compacted.newEntry();
+        Entry& newEntry = compacted.get(newId);
+        newEntry = Entry(rid, entry.getColVar(), d_zero);
+        std::swap(newEntry.getCoefficient(), entry.getCoefficient());
+        newEntry.setPrevRowEntryID(prev);
+        if(prev != ENTRYID_SENTINEL){
+          compacted.get(prev).setNextRowEntryID(newId);
+        }
+        newIds[i.getID()] = newId;
+        prev = newId;
+      }
+    }
+
+    for(ArithVar v = 0, N = d_columns.size(); v < N; ++v){
+      EntryID prev = ENTRYID_SENTINEL;
+      for(ColIterator i = getColumn(v).begin(); !i.atEnd(); ++i){
+        EntryID newId = newIds[i.getID()];
+        compacted.get(newId).setPrevColEntryID(prev);
+        if(prev != ENTRYID_SENTINEL){
+          compacted.get(prev).setNextColEntryID(newId);
+        }
+        prev = newId;
+      }
+    }
+
+    for(RowVectorT& row : d_rows){
+      EntryID head = row.getHead();
+      row = RowVectorT(head == ENTRYID_SENTINEL ? head : newIds[head],
+                       row.getSize(),
+                       &d_entries);
+    }
+    for(ColumnVectorT& col : d_columns){
+      EntryID head = col.getHead();
+      col = ColumnVectorT(head == ENTRYID_SENTINEL ? head : newIds[head],
+                          col.getSize(),
+                          &d_entries);
+    }
+    d_entries = std::move(compacted);
+    d_entriesSinceCompaction = 0;
+  }
+
+  /**
+   * Compacts the matrix once more entries have been added since the last
+   * compaction than there are entries in use. Row additions during pivots
+   * allocate entries wherever a slot is free, so after enough fill-in the
+   * rows are scattered over the entry vector. Compaction is linear in the
+   * size of the matrix, so the amortized cost per added entry is constant.
+   *
+   * The merge buffer must be empty.
+   */
+  void maybeCompact(){
+    static const uint32_t s_minEntries = 256;
+    if(d_compactionEnabled
+       && d_entriesSinceCompaction > std::max(d_entriesInUse, s_minEntries)){
+      compact();
+    }
+  }
+
+  void setCompactionEnabled(bool enabled) { d_compactionEnabled = enabled; }
+
   void removeRow(RowIndex rid){
     RowIterator i = getRow(rid).begin();
     RowIterator i_end = getRow(rid).end();
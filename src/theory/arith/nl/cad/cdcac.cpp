@@ -18,6 +18,9 @@
 
 #ifdef CVC5_POLY_IMP
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "options/arith_options.h"
 #include "theory/arith/nl/cad/lazard_evaluation.h"
 #include "theory/arith/nl/cad/projections.h"
@@ -491,6 +494,10 @@ CACInterval CDCAC::intervalFromCharacterization(
 std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
                                               bool returnFirstInterval)
 {
+  if (curVariable == 0 && options::nlCadIncremental() && checkLastModel())
+  {
+    return {};
+  }
   if (isProofEnabled())
   {
     d_proof->startRecursive();
@@ -498,6 +505,11 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
   Trace("cdcac") << "Looking for unsat cover for "
                  << d_variableOrdering[curVariable] << std::endl;
   std::vector<CACInterval> intervals = getUnsatIntervals(curVariable);
+  if (curVariable == 0 && options::nlCadIncremental() && !isProofEnabled())
+  {
+    addLearnedIntervals(intervals);
+    pruneRedundantIntervals(intervals);
+  }
 
   if (Trace.isOn("cdcac"))
   {
@@ -531,6 +543,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
     {
       // We have a full assignment. SAT!
       Trace("cdcac") << "Found full assignment: " << d_assignment << std::endl;
+      if (options::nlCadIncremental())
+      {
+        storeModel();
+      }
       return {};
     }
     if (isProofEnabled())
@@ -555,6 +571,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
         intervalFromCharacterization(characterization, curVariable, sample);
     newInterval.d_origins = collectConstraints(cov);
     intervals.emplace_back(newInterval);
+    if (curVariable == 0 && options::nlCadIncremental() && !isProofEnabled())
+    {
+      learnInterval(newInterval);
+    }
     if (isProofEnabled())
     {
       auto cell = d_proof->constructCell(
@@ -681,6 +701,88 @@ void CDCAC::pruneRedundantIntervals(std::vector<CACInterval>& intervals)
   }
 }
 
+bool CDCAC::checkLastModel()
+{
+  if (d_lastModel.empty())
+  {
+    return false;
+  }
+  d_assignment.clear();
+  for (const auto& var : d_variableOrdering)
+  {
+    auto it = d_lastModel.find(var);
+    if (it == d_lastModel.end())
+    {
+      d_assignment.clear();
+      return false;
+    }
+    d_assignment.set(var, it->second);
+  }
+  for (const auto& c : d_constraints.getConstraints())
+  {
+    if (!evaluate_constraint(std::get<0>(c), d_assignment, std::get<1>(c)))
+    {
+      d_assignment.clear();
+      return false;
+    }
+  }
+  Trace("cdcac") << "Last model is still a model: " << d_assignment
+                 << std::endl;
+  return true;
+}
+
+void CDCAC::storeModel()
+{
+  for (const auto& var : d_variableOrdering)
+  {
+    d_lastModel[var] = d_assignment.get(var);
+  }
+}
+
+void CDCAC::addLearnedIntervals(std::vector<CACInterval>& intervals)
+{
+  std::unordered_set<Node> asserted;
+  for (const auto& c : d_constraints.getConstraints())
+  {
+    asserted.insert(std::get<2>(c));
+  }
+  for (const auto& li : d_learnedIntervals)
+  {
+    if (!(li.first == d_variableOrdering[0]))
+    {
+      continue;
+    }
+    const std::vector<Node>& origins = li.second.d_origins;
+    if (std::all_of(origins.begin(), origins.end(), [&asserted](const Node& n) {
+          return asserted.find(n) != asserted.end();
+        }))
+    {
+      Trace("cdcac") << "Reusing " << li.second.d_interval << " from "
+                     << origins << std::endl;
+      intervals.emplace_back(li.second);
+    }
+  }
+}
+
+void CDCAC::learnInterval(const CACInterval& interval)
+{
+  // bounds the memory used by the intervals and the time spent checking them
+  static const size_t s_maxLearnedIntervals = 1024;
+  const poly::Variable& var = d_variableOrdering[0];
+  for (const auto& li : d_learnedIntervals)
+  {
+    if (li.first == var && li.second == interval)
+    {
+      return;
+    }
+  }
+  if (d_learnedIntervals.size() >= s_maxLearnedIntervals)
+  {
+    d_learnedIntervals.erase(d_learnedIntervals.begin());
+  }
+  d_learnedIntervals.emplace_back(var, interval);
+}
+
 }  // namespace cad
 }  // namespace nl
 }  // namespace arith
@@ -23,6 +23,8 @@
 
 #include <poly/polyxx.h>
 
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "theory/arith/nl/cad/cdcac_utils.h"
@@ -136,6 +138,10 @@ class CDCAC
    * @param returnFirstInterval If true, the function returns after the first
    * interval obtained from a recursive call. The result is not (necessarily) an
    * unsat cover, but merely a list of infeasible intervals.
+   *
+   * With --nl-cad-incremental, the search first tries the model of the last
+   * satisfiable check, and starts the covering for the first variable with
+   * the intervals learned in earlier checks whose origins are all asserted.
    */
   std::vector<CACInterval> getUnsatCover(std::size_t curVariable = 0,
                                          bool returnFirstInterval = false);
@@ -185,6 +191,22 @@ class CDCAC
    */
   void pruneRedundantIntervals(std::vector<CACInterval>& intervals);
 
+  /**
+   * Checks whether the model of the last satisfiable check assigns all
+   * variables and satisfies all constraints. If so, it becomes the current
+   * assignment.
+   */
+  bool checkLastModel();
+  /** Stores the current (full) assignment for checkLastModel(). */
+  void storeModel();
+  /**
+   * Adds the intervals for the first variable learned in earlier checks whose
+   * origins are all among the current constraints.
+   */
+  void addLearnedIntervals(std::vector<CACInterval>& intervals);
+  /** Remembers an interval for the first variable obtained by recursion. */
+  void learnInterval(const CACInterval& interval);
+
   /**
    * The current assignment. When the method terminates with SAT, it contains a
    * model for the input constraints.
@@ -203,6 +225,21 @@ class CDCAC
   /** The linear assignment used as an initial guess. */
   std::vector<poly::Value> d_initialAssignment;
 
+  /**
+   * The values of the satisfying assignments of earlier checks, the latest
+   * value for every variable.
+   */
+  std::map<poly::Variable, poly::Value> d_lastModel;
+
+  /**
+   * Intervals for the first variable learned in earlier checks, together with
+   * that variable. For every value in such an interval, the constraints in its
+   * origins are infeasible. This does not depend on the variable ordering or
+   * on the other constraints, so an interval can be reused whenever its
+   * origins are asserted again. Oldest first.
+   */
+  std::vector<std::pair<poly::Variable, CACInterval>> d_learnedIntervals;
+
   /** The proof generator */
   std::unique_ptr<CADProofGenerator> d_proof;
 };
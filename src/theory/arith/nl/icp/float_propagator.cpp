@@ -0,0 +1,269 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Interval constraint propagation over outward rounded double intervals.
+ */
+
+#include "theory/arith/nl/icp/float_propagator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+namespace {
+
+constexpr double s_inf = std::numeric_limits<double>::infinity();
+constexpr double s_max = std::numeric_limits<double>::max();
+constexpr double s_eps = std::numeric_limits<double>::epsilon();
+constexpr double s_tiny = std::numeric_limits<double>::denorm_min();
+
+/**
+ * A contraction is only reported if it moves a bound by this fraction of the
+ * width of the interval. Otherwise propagation converges slowly towards a
+ * bound that is never reached.
+ */
+constexpr double s_minContraction = 1e-3;
+
+/**
+ * Returns a lower bound for a value that was computed as x with an absolute
+ * error of at most err. An overflow to +oo becomes the largest double.
+ */
+inline double down(double x, double err)
+{
+  if (x == s_inf) return s_max;
+  if (x == -s_inf) return x;
+  return x - (err + s_tiny);
+}
+
+/**
+ * Returns an upper bound for a value that was computed as x with an absolute
+ * error of at most err. An overflow to -oo becomes the smallest double.
+ */
+inline double up(double x, double err)
+{
+  if (x == -s_inf) return -s_max;
+  if (x == s_inf) return x;
+  return x + (err + s_tiny);
+}
+
+/** Multiplication where zero times infinity is zero. */
+inline double mul(double a, double b)
+{
+  return (a == 0 || b == 0) ? 0 : a * b;
+}
+
+/** [lo, hi] := [a, b] * [c, d] */
+inline void mulInterval(
+    double a, double b, double c, double d, double& lo, double& hi)
+{
+  double p1 = mul(a, c);
+  double p2 = mul(a, d);
+  double p3 = mul(b, c);
+  double p4 = mul(b, d);
+  double mn = std::min(std::min(p1, p2), std::min(p3, p4));
+  double mx = std::max(std::max(p1, p2), std::max(p3, p4));
+  lo = down(mn, s_eps * std::abs(mn));
+  hi = up(mx, s_eps * std::abs(mx));
+}
+
+/** [lo, hi] := [l, u]^k */
+inline void powInterval(double l, double u, unsigned k, double& lo, double& hi)
+{
+  double pl = std::pow(l, k);
+  double pu = std::pow(u, k);
+  double ops = k + 1;
+  if (k % 2 == 1 || l >= 0)
+  {
+    lo = down(pl, ops * s_eps * std::abs(pl));
+    hi = up(pu, ops * s_eps * std::abs(pu));
+  }
+  else if (u <= 0)
+  {
+    lo = down(pu, ops * s_eps * std::abs(pu));
+    hi = up(pl, ops * s_eps * std::abs(pl));
+  }
+  else
+  {
+    double mx = std::max(pl, pu);
+    lo = 0;
+    hi = up(mx, ops * s_eps * mx);
+  }
+}
+
+/**
+ * Whether moving a bound of [lower, upper] from old to tightened is a
+ * contraction worth reporting.
+ */
+inline bool significant(double old, double tightened, double lower, double upper)
+{
+  if (std::isinf(old))
+  {
+    return !std::isinf(tightened);
+  }
+  double width = upper - lower;
+  if (!std::isfinite(width))
+  {
+    width = std::max(1.0, std::abs(old));
+  }
+  return std::abs(tightened - old) > s_minContraction * width;
+}
+
+}  // namespace
+
+std::size_t FloatPropagator::addVariable(double lower, double upper)
+{
+  d_lower.emplace_back(lower);
+  d_upper.emplace_back(upper);
+  return d_lower.size() - 1;
+}
+
+void FloatPropagator::addCandidate(std::size_t lhs,
+                                   bool lower,
+                                   bool upper,
+                                   double multLower,
+                                   double multUpper)
+{
+  Assert(lhs < d_lower.size());
+  d_lhs.emplace_back(lhs);
+  d_boundsLower.emplace_back(lower);
+  d_boundsUpper.emplace_back(upper);
+  d_multLower.emplace_back(multLower);
+  d_multUpper.emplace_back(multUpper);
+  d_candBegin.emplace_back(d_candBegin.back());
+}
+
+void FloatPropagator::addMonomial(double coeffLower,
+                                  double coeffUpper,
+                                  const std::vector<Factor>& factors)
+{
+  Assert(!d_lhs.empty()) << "A monomial needs a candidate";
+  for (const Factor& f : factors)
+  {
+    Assert(f.first < d_lower.size());
+    d_factorVar.emplace_back(f.first);
+    d_factorExp.emplace_back(f.second);
+  }
+  d_coeffLower.emplace_back(coeffLower);
+  d_coeffUpper.emplace_back(coeffUpper);
+  d_monoBegin.emplace_back(d_factorVar.size());
+  ++d_candBegin.back();
+}
+
+std::vector<std::size_t> FloatPropagator::propagate(std::size_t maxSweeps)
+{
+  d_factorLower.resize(d_factorVar.size());
+  d_factorUpper.resize(d_factorVar.size());
+  d_monoLower.resize(d_coeffLower.size());
+  d_monoUpper.resize(d_coeffLower.size());
+
+  std::vector<bool> seen(d_lhs.size(), false);
+  std::vector<std::size_t> contracted;
+  for (std::size_t i = 0; i < maxSweeps && !d_conflict; ++i)
+  {
+    if (!sweep(seen, contracted))
+    {
+      break;
+    }
+  }
+  return contracted;
+}
+
+bool FloatPropagator::sweep(std::vector<bool>& seen,
+                            std::vector<std::size_t>& contracted)
+{
+  // evaluate all factors over the current bounds
+  for (std::size_t f = 0, n = d_factorVar.size(); f < n; ++f)
+  {
+    std::size_t v = d_factorVar[f];
+    powInterval(d_lower[v],
+                d_upper[v],
+                d_factorExp[f],
+                d_factorLower[f],
+                d_factorUpper[f]);
+  }
+  // evaluate all monomials
+  for (std::size_t m = 0, n = d_coeffLower.size(); m < n; ++m)
+  {
+    double lo = d_coeffLower[m];
+    double hi = d_coeffUpper[m];
+    for (std::size_t f = d_monoBegin[m]; f < d_monoBegin[m + 1]; ++f)
+    {
+      mulInterval(lo, hi, d_factorLower[f], d_factorUpper[f], lo, hi);
+    }
+    d_monoLower[m] = lo;
+    d_monoUpper[m] = hi;
+  }
+  // evaluate all candidates and contract their left hand sides
+  bool changed = false;
+  for (std::size_t c = 0, n = d_lhs.size(); c < n; ++c)
+  {
+    double lo = 0;
+    double hi = 0;
+    double absLo = 0;
+    double absHi = 0;
+    for (std::size_t m = d_candBegin[c]; m < d_candBegin[c + 1]; ++m)
+    {
+      lo += d_monoLower[m];
+      hi += d_monoUpper[m];
+      absLo += std::abs(d_monoLower[m]);
+      absHi += std::abs(d_monoUpper[m]);
+    }
+    double terms = d_candBegin[c + 1] - d_candBegin[c];
+    lo = down(lo, terms * s_eps * absLo);
+    hi = up(hi, terms * s_eps * absHi);
+    mulInterval(d_multLower[c], d_multUpper[c], lo, hi, lo, hi);
+
+    std::size_t v = d_lhs[c];
+    bool contracts = false;
+    if (d_boundsLower[c] && lo > d_lower[v]
+        && significant(d_lower[v], lo, d_lower[v], d_upper[v]))
+    {
+      d_lower[v] = lo;
+      contracts = true;
+    }
+    if (d_boundsUpper[c] && hi < d_upper[v]
+        && significant(d_upper[v], hi, d_lower[v], d_upper[v]))
+    {
+      d_upper[v] = hi;
+      contracts = true;
+    }
+    if (contracts)
+    {
+      changed = true;
+      if (!seen[c])
+      {
+        seen[c] = true;
+        contracted.emplace_back(c);
+      }
+      if (d_lower[v] > d_upper[v])
+      {
+        d_conflict = true;
+        return true;
+      }
+    }
+  }
+  return changed;
+}
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
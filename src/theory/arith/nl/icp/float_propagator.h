@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Interval constraint propagation over outward rounded double intervals.
+ */
+
+#ifndef CVC5__THEORY__ARITH__ICP__FLOAT_PROPAGATOR_H
+#define CVC5__THEORY__ARITH__ICP__FLOAT_PROPAGATOR_H
+
+#include "cvc5_private.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+/**
+ * A cheap approximation of ICP-style propagation. Candidates have the same
+ * shape as icp::Candidate,
+ *
+ *   lhs  ~rel~  mult * (sum of monomials)
+ *
+ * but all coefficients and bounds are closed double intervals that enclose
+ * the exact ones: every arithmetic operation rounds its lower bound down and
+ * its upper bound up. Hence every contraction found here is implied by the
+ * exact candidates, up to the strictness of bounds and up to rounding.
+ *
+ * The data is stored as structure of arrays: the variable bounds, the
+ * (variable, exponent) factors, the monomials and the candidates each live in
+ * flat arrays. A sweep evaluates all factors and then all monomials over the
+ * variable bounds at the start of the sweep. It then evaluates the candidates
+ * in order and intersects each result into the bounds of its lhs right away.
+ * Hence later candidates of a sweep use monomial values from the start of the
+ * sweep, but are compared against bounds that were already contracted in this
+ * sweep. The factor and monomial passes are simple loops over contiguous
+ * arrays that the compiler can vectorize.
+ *
+ * The result is not used directly: it tells which candidates are worth
+ * propagating with exact intervals, see ICPSolver::check().
+ */
+class FloatPropagator
+{
+ public:
+  /** A factor var^exponent of a monomial. */
+  using Factor = std::pair<std::size_t, unsigned>;
+
+  /** Adds a variable with the given bounds and returns its index. */
+  std::size_t addVariable(double lower, double upper);
+  /**
+   * Starts a new candidate for the variable lhs, which may contract the lower
+   * bound (if lower is true) and the upper bound (if upper is true) of lhs.
+   * The right hand side is multiplied by [multLower, multUpper].
+   */
+  void addCandidate(std::size_t lhs,
+                    bool lower,
+                    bool upper,
+                    double multLower,
+                    double multUpper);
+  /** Adds a monomial to the right hand side of the last candidate. */
+  void addMonomial(double coeffLower,
+                   double coeffUpper,
+                   const std::vector<Factor>& factors);
+
+  /**
+   * Runs at most maxSweeps sweeps, until no candidate contracts a bound
+   * noticeably or some variable has no value left. Returns the candidates that
+   * contracted a bound, in the order of their first contraction.
+   */
+  std::vector<std::size_t> propagate(std::size_t maxSweeps);
+
+  /** Whether the bounds of some variable became empty. */
+  bool inConflict() const { return d_conflict; }
+  /** The current bounds of variable v. */
+  double getLower(std::size_t v) const { return d_lower[v]; }
+  double getUpper(std::size_t v) const { return d_upper[v]; }
+
+ private:
+  /**
+   * Runs a single sweep and adds the candidates that contracted a bound to
+   * contracted. Returns whether some bound was contracted.
+   */
+  bool sweep(std::vector<bool>& seen, std::vector<std::size_t>& contracted);
+
+  /** The bounds of the variables. */
+  std::vector<double> d_lower;
+  std::vector<double> d_upper;
+
+  /** The variable and exponent of every factor. */
+  std::vector<std::size_t> d_factorVar;
+  std::vector<unsigned> d_factorExp;
+  /** The value of every factor in the current sweep. */
+  std::vector<double> d_factorLower;
+  std::vector<double> d_factorUpper;
+
+  /** The coefficient of every monomial. */
+  std::vector<double> d_coeffLower;
+  std::vector<double> d_coeffUpper;
+  /** The factors of monomial m are [d_monoBegin[m], d_monoBegin[m + 1]). */
+  std::vector<std::size_t> d_monoBegin{0};
+  /** The value of every monomial in the current sweep. */
+  std::vector<double> d_monoLower;
+  std::vector<double> d_monoUpper;
+
+  /** The left hand side variable of every candidate. */
+  std::vector<std::size_t> d_lhs;
+  /** Whether a candidate bounds its lhs from below, or from above. */
+  std::vector<bool> d_boundsLower;
+  std::vector<bool> d_boundsUpper;
+  /** The multiplier of every candidate. */
+  std::vector<double> d_multLower;
+  std::vector<double> d_multUpper;
+  /** The monomials of candidate c are [d_candBegin[c], d_candBegin[c + 1]). */
+  std::vector<std::size_t> d_candBegin{0};
+
+  /** Whether the bounds of some variable became empty. */
+  bool d_conflict = false;
+};
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
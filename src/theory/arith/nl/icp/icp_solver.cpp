@@ -15,13 +15,18 @@
 
 #include "theory/arith/nl/icp/icp_solver.h"
 
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <map>
 
 #include "base/check.h"
 #include "base/output.h"
 #include "expr/node_algorithm.h"
+#include "options/arith_options.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/inference_manager.h"
+#include "theory/arith/nl/icp/float_propagator.h"
 #include "theory/arith/nl/poly_conversion.h"
 #include "theory/arith/normal_form.h"
 #include "theory/rewriter.h"
@@ -63,6 +68,37 @@ inline std::ostream& operator<<(std::ostream& os, const IAWrapper& iaw)
   }
   return os << " }";
 }
+
+/** Returns [lo, hi] with lo <= r <= hi. */
+void toDoubleInterval(const Rational& r, double& lo, double& hi)
+{
+  double d = r.getDouble();
+  lo = std::nextafter(d, -std::numeric_limits<double>::infinity());
+  hi = std::nextafter(d, std::numeric_limits<double>::infinity());
+}
+
+/** Collects the monomials of a polynomial for lp_polynomial_traverse. */
+struct CollectFloatMonomials
+{
+  FloatPropagator& d_fp;
+  std::map<poly::Variable, std::size_t>& d_vars;
+};
+void collect_float_monomials(const lp_polynomial_context_t* ctx,
+                             lp_monomial_t* m,
+                             void* data)
+{
+  CollectFloatMonomials* d = static_cast<CollectFloatMonomials*>(data);
+  double lo, hi;
+  toDoubleInterval(poly_utils::toRational(poly::Integer(&m->a)), lo, hi);
+  std::vector<FloatPropagator::Factor> factors;
+  for (std::size_t i = 0; i < m->n; ++i)
+  {
+    auto it = d->d_vars.find(poly::Variable(m->p[i].x));
+    Assert(it != d->d_vars.end());
+    factors.emplace_back(it->second, m->p[i].d);
+  }
+  d->d_fp.addMonomial(lo, hi, factors);
+}
 }  // namespace
 
 std::vector<Node> ICPSolver::collectVariables(const Node& n) const
@@ -253,6 +289,49 @@ PropagationResult ICPSolver::doPropagationRound()
   return res;
 }
 
+std::vector<std::size_t> ICPSolver::doFloatPropagation() const
+{
+  FloatPropagator fp;
+  std::map<poly::Variable, std::size_t> vars;
+  for (const auto& v : d_mapper.mVarpolyCVC)
+  {
+    double lo = -std::numeric_limits<double>::infinity();
+    double hi = std::numeric_limits<double>::infinity();
+    if (d_state.d_assignment.has(v.first))
+    {
+      const poly::Interval& i = d_state.d_assignment.get(v.first);
+      double tmp;
+      if (!is_minus_infinity(get_lower(i)))
+      {
+        toDoubleInterval(poly_utils::toRationalBelow(get_lower(i)), lo, tmp);
+      }
+      if (!is_plus_infinity(get_upper(i)))
+      {
+        toDoubleInterval(poly_utils::toRationalAbove(get_upper(i)), tmp, hi);
+      }
+    }
+    vars.emplace(v.first, fp.addVariable(lo, hi));
+  }
+  CollectFloatMonomials cfm{fp, vars};
+  for (const auto& c : d_state.d_candidates)
+  {
+    bool lower = c.rel != poly::SignCondition::LT
+                 && c.rel != poly::SignCondition::LE;
+    bool upper = c.rel != poly::SignCondition::GT
+                 && c.rel != poly::SignCondition::GE;
+    double lo, hi;
+    toDoubleInterval(poly_utils::toRational(c.rhsmult), lo, hi);
+    fp.addCandidate(vars[c.lhs], lower, upper, lo, hi);
+    lp_polynomial_traverse(
+        c.rhs.get_internal(), collect_float_monomials, &cfm);
+  }
+  std::vector<std::size_t> res = fp.propagate(d_floatSweeps);
+  Trace("nl-icp") << "Float propagation contracted with " << res.size()
+                  << " of " << d_state.d_candidates.size() << " candidates"
+                  << (fp.inConflict() ? " to a conflict" : "") << std::endl;
+  return res;
+}
+
 std::vector<Node> ICPSolver::generateLemmas() const
 {
   auto nm = NodeManager::currentNM();
@@ -327,6 +406,17 @@ void ICPSolver::check()
 {
   initOrigins();
   d_state.d_assignment = getBounds(d_mapper, d_state.d_bounds);
+  if (options::nlICPFloat())
+  {
+    // Only the candidates that contract the double intervals are propagated
+    // exactly, in the order in which they contracted.
+    std::vector<Candidate> selected;
+    for (std::size_t c : doFloatPropagation())
+    {
+      selected.emplace_back(d_state.d_candidates[c]);
+    }
+    d_state.d_candidates = std::move(selected);
+  }
   bool did_progress = false;
   bool progress = false;
   do
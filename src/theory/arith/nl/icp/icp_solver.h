@@ -100,6 +100,8 @@ class ICPSolver
   std::int64_t d_budget = 0;
   /** The budget increment for new candidates and strong contractions */
   static constexpr std::int64_t d_budgetIncrement = 10;
+  /** The maximal number of sweeps of the propagation over doubles */
+  static constexpr std::size_t d_floatSweeps = 20;
 
   /** Collect all variables from a node */
   std::vector<Node> collectVariables(const Node& n) const;
@@ -119,6 +121,14 @@ class ICPSolver
    */
   PropagationResult doPropagationRound();
 
+  /**
+   * Propagates all candidates over outward rounded double intervals (see
+   * FloatPropagator), starting from the current assignment. Returns the
+   * indices of the candidates that contracted some bound, in the order of
+   * their first contraction.
+   */
+  std::vector<std::size_t> doFloatPropagation() const;
+
   /**
    * Construct lemmas for all bounds that have been improved.
    * For every improved bound, all origins are collected and a lemma of the form
@@ -108,7 +108,7 @@ bool Strategy::isStrategyInit() const { return !d_interleaving.empty(); }
 void Strategy::initializeStrategy()
 {
   StepSequence one;
-  if (options::nlICP())
+  if (options::nlICP() || options::nlICPFloat())
   {
     one << InferStep::ICP << InferStep::BREAK;
   }
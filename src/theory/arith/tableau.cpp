@@ -31,6 +31,9 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
   Assert(d_mergeBuffer.empty());
 
   Debug("tableau") << "Tableau::pivot(" <<  oldBasic <<", " << newBasic <<")"  << endl;
+  Trace("arith::pivot-log") << "pivot " << oldBasic << " " << newBasic << endl;
+
+  maybeCompact();
 
   RowIndex ridx = basicToRowIndex(oldBasic);
 
@@ -39,22 +42,24 @@ void Tableau::pivot(ArithVar oldBasic, ArithVar newBasic, CoefficientChangeCallb
 
   loadRowIntoBuffer(ridx);
 
-  ColIterator colIter = colIterator(newBasic);
-  while(!colIter.atEnd()){
-    EntryID id = colIter.getID();
-    Entry& entry = d_entries.get(id);
-
-    ++colIter; //needs to be incremented before the variable is removed
-    if(entry.getRowIndex() == ridx){ continue; }
-
-    RowIndex to = entry.getRowIndex();
-    Rational coeff = entry.getCoefficient();
+  // Collect the rows to eliminate newBasic from before changing any of them:
+  // each row addition removes the entry of newBasic on its row.
+  Assert(d_pivotRows.empty());
+  for(ColIterator colIter = colIterator(newBasic); !colIter.atEnd(); ++colIter){
+    const Entry& entry = *colIter;
+    if(entry.getRowIndex() != ridx){
+      d_pivotRows.emplace_back(entry.getRowIndex(), entry.getCoefficient());
+    }
+  }
+  for(const std::pair<RowIndex, Rational>& p : d_pivotRows){
+    RowIndex to = p.first;
     if(cb.canUseRow(to)){
-      rowPlusBufferTimesConstant(to, coeff, cb);
+      rowPlusBufferTimesConstant(to, p.second, cb);
     }else{
-      rowPlusBufferTimesConstant(to, coeff);
+      rowPlusBufferTimesConstant(to, p.second);
     }
   }
+  d_pivotRows.clear();
   clearBuffer();
 
   //Clear the column for used for this variable
@@ -106,6 +111,15 @@ void Tableau::addRow(ArithVar basic,
   Assert(coefficients.size() == variables.size());
   Assert(!isBasic(basic));
 
+  if(Trace.isOn("arith::pivot-log")){
+    Trace("arith::pivot-log") << "row " << basic << " " << variables.size();
+    for(size_t i = 0, N = variables.size(); i < N; ++i){
+      Trace("arith::pivot-log")
+          << " " << variables[i] << " " << coefficients[i];
+    }
+    Trace("arith::pivot-log") << endl;
+  }
+
   RowIndex newRow = Matrix<Rational>::addRow(coefficients, variables);
   addEntry(newRow, basic, Rational(-1));
 
@@ -147,6 +161,7 @@ void Tableau::addRow(ArithVar basic,
 }
 
 void Tableau::removeBasicRow(ArithVar basic){
+  Trace("arith::pivot-log") << "remove " << basic << endl;
   RowIndex rid = basicToRowIndex(basic);
 
   removeRow(rid);
@@ -156,6 +171,8 @@ void Tableau::removeBasicRow(ArithVar basic){
 
 void Tableau::substitutePlusTimesConstant(ArithVar to, ArithVar from, const Rational& mult,  CoefficientChangeCallback& cb){
   if(!mult.isZero()){
+    Trace("arith::pivot-log")
+        << "substitute " << to << " " << from << " " << mult << endl;
     RowIndex to_idx = basicToRowIndex(to);
     addEntry(to_idx, from, mult); // Add an entry to be cancelled out
     RowIndex from_idx = basicToRowIndex(from);
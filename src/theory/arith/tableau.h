@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "theory/arith/arithvar.h"
@@ -36,6 +37,14 @@ namespace arith {
  * Each row has a basic variable with coefficient -1 that is solved.
  * Tableau is optimized for pivoting.
  * The tableau should only be updated via pivot calls.
+ *
+ * All updates are written to Trace("arith::pivot-log"), one per line:
+ *   row <basic> <n> <var_1> <coeff_1> ... <var_n> <coeff_n>
+ *   pivot <oldBasic> <newBasic>
+ *   remove <basic>
+ *   substitute <to> <from> <mult>
+ *   add <basic> <col> <mult>
+ * Replaying such a log reproduces the pivots of a real run.
  */
 class Tableau : public Matrix<Rational> {
 public:
@@ -49,6 +58,9 @@ private:
   typedef DenseMap<ArithVar> RowIndexToBasicMap;
   RowIndexToBasicMap d_rowIndex2basic;
 
+  // The rows updated by the current pivot and their multipliers.
+  std::vector<std::pair<RowIndex, Rational> > d_pivotRows;
+
 public:
 
   Tableau() : Matrix<Rational>(Rational(0)) {}
@@ -140,6 +152,8 @@ public:
   void substitutePlusTimesConstant(ArithVar to, ArithVar from, const Rational& mult,  CoefficientChangeCallback& cb);
 
   void directlyAddToCoefficient(ArithVar rowVar, ArithVar col, const Rational& mult,  CoefficientChangeCallback& cb){
+    Trace("arith::pivot-log")
+        << "add " << rowVar << " " << col << " " << mult << std::endl;
     RowIndex ridx = basicToRowIndex(rowVar);
     manipulateRowEntry(ridx, col, mult, cb);
   }
@@ -54,6 +54,7 @@
 #include "theory/arith/cut_log.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
+#include "theory/arith/fp_simplex.h"
 #include "theory/arith/linear_equality.h"
 #include "theory/arith/matrix.h"
 #include "theory/arith/nl/nonlinear_extension.h"
@@ -2970,21 +2971,28 @@ bool TheoryArithPrivate::solveRealRelaxation(Theory::Effort effortLevel){
     << " " << safeToCallApprox()
     << endl;
 
-  bool noPivotLimitPass1 = noPivotLimit && !useApprox;
+  // the built-in floating-point simplex replaces the external solver
+  bool useFpSimplex = options::fpSimplex();
+
+  bool noPivotLimitPass1 = noPivotLimit && !useApprox && !useFpSimplex;
   d_qflraStatus = simplex.findModel(noPivotLimitPass1);
 
   Debug("TheoryArithPrivate::solveRealRelaxation")
     << "solveRealRelaxation()" << " pass1 " << d_qflraStatus << endl;
 
-  if(d_qflraStatus == Result::SAT_UNKNOWN && useApprox && safeToCallApprox()){
+  if (d_qflraStatus == Result::SAT_UNKNOWN && (useApprox || useFpSimplex)
+      && safeToCallApprox())
+  {
     // pass2: fancy-final
     static const int32_t relaxationLimit = 10000;
-    Assert(ApproximateSimplex::enabled());
+    Assert(useFpSimplex || ApproximateSimplex::enabled());
 
     TreeLog& tl = getTreeLog();
     ApproximateStatistics& stats = getApproxStats();
     ApproximateSimplex* approxSolver =
-      ApproximateSimplex::mkApproximateSimplexSolver(d_partialModel, tl, stats);
+        useFpSimplex ? new FloatingPointSimplex(d_partialModel, tl, stats)
+                     : ApproximateSimplex::mkApproximateSimplexSolver(
+                         d_partialModel, tl, stats);
 
     approxSolver->setPivotLimit(relaxationLimit);
 
@@ -16,6 +16,7 @@
 #include "theory/bv/bv_solver_bitblast.h"
 
 #include "options/bv_options.h"
+#include "options/prop_options.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/theory_bv.h"
@@ -159,6 +160,13 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
 
   NodeManager* nm = NodeManager::currentNM();
 
+  /*
+   * Bit-blasted facts are collected and converted to CNF at once, which
+   * allows to generate their clauses with multiple threads.
+   */
+  std::vector<Node> bbAssertions;
+  std::vector<Node> bbDefinitions;
+
   /* Process input assertions bit-blast queue. */
   while (!d_bbInputFacts.empty())
   {
@@ -174,14 +182,14 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
       else
       {
         d_bitblaster->bbAtom(fact);
-        Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
-        d_cnfStream->convertAndAssert(bb_fact, false, false);
+        bbAssertions.push_back(d_bitblaster->getStoredBBAtom(fact));
       }
     }
     d_assertions.push_back(fact);
   }
 
-  /* Process bit-blast queue and store SAT literals. */
+  /* Process bit-blast queue. */
+  std::vector<Node> facts;
   while (!d_bbFacts.empty())
   {
     Node fact = d_bbFacts.front();
@@ -189,19 +197,32 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
     /* Bit-blast fact and cache literal. */
     if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
     {
-      prop::SatLiteral lit;
       if (fact.getKind() == kind::BITVECTOR_EAGER_ATOM)
       {
         handleEagerAtom(fact, false);
-        lit = d_cnfStream->getLiteral(fact[0]);
+        prop::SatLiteral lit = d_cnfStream->getLiteral(fact[0]);
+        d_factLiteralCache[fact] = lit;
+        d_literalFactCache[lit] = fact;
       }
       else
       {
         d_bitblaster->bbAtom(fact);
-        Node bb_fact = d_bitblaster->getStoredBBAtom(fact);
-        d_cnfStream->ensureLiteral(bb_fact);
-        lit = d_cnfStream->getLiteral(bb_fact);
+        bbDefinitions.push_back(d_bitblaster->getStoredBBAtom(fact));
       }
+    }
+    facts.push_back(fact);
+  }
+
+  d_cnfStream->convertInParallel(
+      bbAssertions, bbDefinitions, options::bvBitblastThreads());
+
+  /* Store SAT literals of the bit-blasted facts. */
+  for (const Node& fact : facts)
+  {
+    if (d_factLiteralCache.find(fact) == d_factLiteralCache.end())
+    {
+      prop::SatLiteral lit =
+          d_cnfStream->getLiteral(d_bitblaster->getStoredBBAtom(fact));
       d_factLiteralCache[fact] = lit;
       d_literalFactCache[lit] = fact;
     }
@@ -369,7 +390,8 @@ void BVSolverBitblast::initSatSolver()
                                         nullptr,
                                         smt::currentResourceManager(),
                                         prop::FormulaLitPolicy::INTERNAL,
-                                        "theory::bv::BVSolverBitblast"));
+                                        "theory::bv::BVSolverBitblast",
+                                        options::cnfOptimize()));
 }
 
 Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A cache of theory lemmas that survives user context pops.
+ */
+
+#include "theory/lemma_cache.h"
+
+#include "smt/smt_statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+
+LemmaCache::LemmaCache(context::UserContext* u)
+    : d_asserted(u),
+      d_stored(
+          smtStatisticsRegistry().registerInt("theory::LemmaCache::stored")),
+      d_replayed(
+          smtStatisticsRegistry().registerInt("theory::LemmaCache::replayed")),
+      d_hits(smtStatisticsRegistry().registerHistogram<InferenceId>(
+          "theory::LemmaCache::hits"))
+{
+}
+
+void LemmaCache::notifyLemma(TNode rewritten,
+                             InferenceId id,
+                             LemmaProperty p,
+                             TheoryId from)
+{
+  d_asserted.insert(rewritten, false);
+  if (d_index.find(rewritten) != d_index.end())
+  {
+    return;
+  }
+  Trace("lemma-cache") << "LemmaCache: store " << id << " " << rewritten
+                       << std::endl;
+  d_index[rewritten] = d_lemmas.size();
+  d_lemmas.push_back(Entry{rewritten, id, p, from});
+  ++d_stored;
+}
+
+bool LemmaCache::isReplayed(TNode rewritten, InferenceId id)
+{
+  auto it = d_asserted.find(rewritten);
+  if (it == d_asserted.end() || !(*it).second)
+  {
+    return false;
+  }
+  Trace("lemma-cache") << "LemmaCache: hit " << id << " " << rewritten
+                       << std::endl;
+  d_hits << id;
+  return true;
+}
+
+bool LemmaCache::isAsserted(const Entry& e) const
+{
+  return d_asserted.find(e.d_rewritten) != d_asserted.end();
+}
+
+void LemmaCache::markReplayed(const Entry& e)
+{
+  Trace("lemma-cache") << "LemmaCache: replay " << e.d_id << " "
+                       << e.d_rewritten << std::endl;
+  d_asserted.insert(e.d_rewritten, true);
+  ++d_replayed;
+}
+
+}  // namespace theory
+}  // namespace cvc5
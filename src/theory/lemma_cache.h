@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A cache of theory lemmas that survives user context pops.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__LEMMA_CACHE_H
+#define CVC5__THEORY__LEMMA_CACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "theory/inference_id.h"
+#include "theory/output_channel.h"
+#include "theory/theory_id.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace theory {
+
+/**
+ * A user-context-independent store of the lemmas sent by the inference
+ * managers of the theories. Theory lemmas are valid, but lemmas sent in a
+ * user context are removed from the SAT solver when that context is popped,
+ * and are typically rediscovered in the next check-sat call. This class
+ * remembers them so that TheoryEngine can replay them at the beginning of
+ * later check-sat calls, before the theories rediscover them.
+ *
+ * Lemmas are identified by their rewritten form. In each user context, this
+ * class tracks which lemmas are currently asserted (sent or replayed), so
+ * that rediscovered replayed lemmas can be dropped; these are counted as
+ * hits per inference id.
+ */
+class LemmaCache
+{
+ public:
+  /** A lemma in the cache */
+  struct Entry
+  {
+    /**
+     * The rewritten form of the lemma, which identifies it and is the form
+     * that is replayed
+     */
+    Node d_rewritten;
+    /** The inference that produced it */
+    InferenceId d_id;
+    /** The property it was sent with */
+    LemmaProperty d_property;
+    /** The theory that sent it */
+    TheoryId d_from;
+  };
+  using const_iterator = std::vector<Entry>::const_iterator;
+
+  LemmaCache(context::UserContext* u);
+
+  /**
+   * Called when a lemma with the given rewritten form was sent with the given
+   * inference id, property and theory. Adds it to the cache and marks it as
+   * asserted in the current user context.
+   */
+  void notifyLemma(TNode rewritten,
+                   InferenceId id,
+                   LemmaProperty p,
+                   TheoryId from);
+  /**
+   * Whether the lemma with the given rewritten form was replayed in the
+   * current user context. If so, counts a hit for id, and the lemma need not
+   * be sent again.
+   */
+  bool isReplayed(TNode rewritten, InferenceId id);
+  /** Whether the given entry is asserted in the current user context */
+  bool isAsserted(const Entry& e) const;
+  /** Marks the given entry as replayed in the current user context */
+  void markReplayed(const Entry& e);
+
+  /** Iterates over the cached lemmas, in the order they were first sent */
+  const_iterator begin() const { return d_lemmas.begin(); }
+  const_iterator end() const { return d_lemmas.end(); }
+  /** The number of cached lemmas */
+  size_t size() const { return d_lemmas.size(); }
+
+ private:
+  /** The cached lemmas */
+  std::vector<Entry> d_lemmas;
+  /** Map from rewritten lemmas to their index in d_lemmas */
+  std::unordered_map<Node, size_t> d_index;
+  /**
+   * The lemmas asserted in the current user context, mapped to whether they
+   * were replayed (rather than sent by a theory).
+   */
+  context::CDHashMap<Node, bool> d_asserted;
+  /** Number of lemmas stored in the cache */
+  IntStat d_stored;
+  /** Number of lemmas replayed from the cache */
+  IntStat d_replayed;
+  /** Number of rediscovered replayed lemmas, per inference id */
+  HistogramStat<InferenceId> d_hits;
+};
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__LEMMA_CACHE_H */
@@ -16,6 +16,7 @@
 #include "theory/theory_engine.h"
 
 #include <sstream>
+#include <unordered_set>
 
 #include "base/map_util.h"
 #include "decision/decision_engine.h"
@@ -36,6 +37,7 @@
 #include "smt/output_manager.h"
 #include "theory/combination_care_graph.h"
 #include "theory/decision_manager.h"
+#include "theory/lemma_cache.h"
 #include "theory/quantifiers/first_order_model.h"
 #include "theory/quantifiers_engine.h"
 #include "theory/relevance_manager.h"
@@ -270,6 +272,11 @@ TheoryEngine::TheoryEngine(Env& env,
   {
     d_sortInfer.reset(new SortInference);
   }
+  // replayed lemmas have no proofs, hence the cache is not used with proofs
+  if (options::lemmaCache() && d_pnm == nullptr)
+  {
+    d_lemmaCache.reset(new LemmaCache(d_env.getUserContext()));
+  }
 
   d_true = NodeManager::currentNM()->mkConst<bool>(true);
   d_false = NodeManager::currentNM()->mkConst<bool>(false);
@@ -672,6 +679,11 @@ bool TheoryEngine::presolve() {
   d_decManager->presolve();
 
   try {
+    if (d_lemmaCache != nullptr)
+    {
+      replayCachedLemmas();
+    }
+
     // Definition of the statement that is to be run by every theory
 #ifdef CVC5_FOR_EACH_THEORY_STATEMENT
 #undef CVC5_FOR_EACH_THEORY_STATEMENT
@@ -695,6 +707,57 @@ bool TheoryEngine::presolve() {
   return false;
 }/* TheoryEngine::presolve() */
 
+void TheoryEngine::replayCachedLemmas()
+{
+  // Only lemmas whose atoms are already known to the SAT solver are
+  // replayed, which avoids introducing atoms of queries that were popped.
+  // The atoms are those of the rewritten lemma, which is also the form that
+  // is replayed. Lemmas are replayed in the order they were first sent, hence
+  // atoms introduced by a replayed lemma may enable the replay of later ones.
+  std::unordered_set<TNode> visited;
+  std::vector<TNode> visit;
+  for (const LemmaCache::Entry& e : *d_lemmaCache)
+  {
+    if (d_lemmaCache->isAsserted(e))
+    {
+      continue;
+    }
+    bool known = true;
+    visit.push_back(e.d_rewritten);
+    do
+    {
+      TNode cur = visit.back();
+      visit.pop_back();
+      if (!visited.insert(cur).second || cur.isConst())
+      {
+        continue;
+      }
+      Kind k = cur.getKind();
+      if (k == kind::NOT || k == kind::AND || k == kind::OR
+          || k == kind::IMPLIES || k == kind::XOR
+          || (k == kind::ITE && cur.getType().isBoolean())
+          || (k == kind::EQUAL && cur[0].getType().isBoolean()))
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+      else if (!d_propEngine->isSatLiteral(cur))
+      {
+        known = false;
+      }
+    } while (known && !visit.empty());
+    visit.clear();
+    visited.clear();
+    if (known)
+    {
+      d_lemmaCache->markReplayed(e);
+      lemma(TrustNode::mkTrustLemma(e.d_rewritten, nullptr),
+            e.d_property,
+            THEORY_LAST,
+            e.d_from);
+    }
+  }
+}
+
 void TheoryEngine::postsolve() {
   // no longer in SAT mode
   d_inSatMode = false;
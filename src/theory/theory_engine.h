@@ -83,6 +83,7 @@ class TheoryModel;
 class CombinationEngine;
 class SharedSolver;
 class DecisionManager;
+class LemmaCache;
 class RelevanceManager;
 
 }  // namespace theory
@@ -286,6 +287,14 @@ class TheoryEngine {
   /** sort inference module */
   std::unique_ptr<theory::SortInference> d_sortInfer;
 
+  /** The lemma cache, if --lemma-cache is enabled */
+  std::unique_ptr<theory::LemmaCache> d_lemmaCache;
+  /**
+   * Replays the cached lemmas that are not asserted in the current user
+   * context and whose atoms already have SAT literals.
+   */
+  void replayCachedLemmas();
+
   /** Time spent in theory combination */
   TimerStat d_combineTheoriesTime;
 
@@ -673,6 +682,9 @@ class TheoryEngine {
 public:
  theory::SortInference* getSortInference() { return d_sortInfer.get(); }
 
+ /** get the lemma cache, which is non-null if --lemma-cache is enabled */
+ theory::LemmaCache* getLemmaCache() { return d_lemmaCache.get(); }
+
  /** Prints the assertions to the debug stream */
  void printAssertions(const char* tag);
 
@@ -17,6 +17,7 @@
 
 #include "smt/smt_engine_scope.h"
 #include "smt/smt_statistics_registry.h"
+#include "theory/lemma_cache.h"
 #include "theory/output_channel.h"
 #include "theory/rewriter.h"
 #include "theory/theory.h"
@@ -250,11 +251,26 @@ bool TheoryInferenceManager::trustedLemma(const TrustNode& tlem,
       return false;
     }
   }
+  // if the lemma was replayed from the lemma cache, it need not be sent again
+  LemmaCache* lc = d_theory.getValuation().getLemmaCache();
+  Node rewritten;
+  if (lc != nullptr)
+  {
+    rewritten = Rewriter::rewrite(tlem.getNode());
+    if (lc->isReplayed(rewritten, id))
+    {
+      return false;
+    }
+  }
   d_lemmaIdStats << id;
   smt::currentResourceManager()->spendResource(id);
   Trace("im") << "(lemma " << id << " " << tlem.getProven() << ")" << std::endl;
   d_numCurrentLemmas++;
   d_out.trustedLemma(tlem, p);
+  if (lc != nullptr)
+  {
+    lc->notifyLemma(rewritten, id, p, d_theory.getId());
+  }
   return true;
 }
 
@@ -238,7 +238,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.insert(node, newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -249,14 +249,10 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_equalityGraph.push_back(+null_edge);
   // Mark the no-individual trigger
   d_nodeIndividualTrigger.push_back(+null_set_id);
-  // Mark non-constant by default
-  d_isConstant.push_back(false);
+  // Mark the node as internal, non-constant and non-equality by default
+  d_nodeFlags.push_back(EQ_FLAG_INTERNAL);
   // No terms to evaluate by defaul
   d_subtermsToEvaluate.push_back(0);
-  // Mark equality nodes
-  d_isEquality.push_back(false);
-  // Mark the node as internal by default
-  d_isInternal.push_back(true);
   // Add the equality node to the nodes
   d_equalityNodes.push_back(EqualityNode(newId));
 
@@ -294,7 +290,7 @@ void EqualityEngine::addFunctionKind(Kind fun,
 
 void EqualityEngine::subtermEvaluates(EqualityNodeId id)  {
   Debug("equality::evaluation") << d_name << "::eq::subtermEvaluates(" << d_nodes[id] << "): " << d_subtermsToEvaluate[id] << std::endl;
-  Assert(!d_isInternal[id]);
+  Assert(!isInternalId(id));
   Assert(d_subtermsToEvaluate[id] > 0);
   if ((-- d_subtermsToEvaluate[id]) == 0) {
     d_evaluationQueue.push(id);
@@ -328,8 +324,8 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
     EqualityNodeId t0id = getNodeId(t[0]);
     EqualityNodeId t1id = getNodeId(t[1]);
     result = newApplicationNode(t, t0id, t1id, APP_EQUALITY);
-    d_isInternal[result] = false;
-    d_isConstant[result] = false;
+    setFlag(result, EQ_FLAG_INTERNAL, false);
+    setFlag(result, EQ_FLAG_CONSTANT, false);
   }
   else if (t.getNumChildren() > 0 && d_congruenceKinds[tk])
   {
@@ -346,8 +342,8 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
       // Add the application
       result = newApplicationNode(t, result, tiId, isInterpreted ? APP_INTERPRETED : APP_UNINTERPRETED);
     }
-    d_isInternal[result] = false;
-    d_isConstant[result] = t.isConst();
+    setFlag(result, EQ_FLAG_INTERNAL, false);
+    setFlag(result, EQ_FLAG_CONSTANT, t.isConst());
     // If interpreted, set the number of non-interpreted children
     if (isInterpreted) {
       // How many children are not constants yet
@@ -365,22 +361,22 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
     // Otherwise we just create the new id
     result = newNode(t);
     // Is this an operator
-    d_isInternal[result] = isOperator;
-    d_isConstant[result] = !isOperator && t.isConst();
+    setFlag(result, EQ_FLAG_INTERNAL, isOperator);
+    setFlag(result, EQ_FLAG_CONSTANT, !isOperator && t.isConst());
   }
 
   if (tk == kind::EQUAL)
   {
     // We set this here as this only applies to actual terms, not the
     // intermediate application terms
-    d_isEquality[result] = true;
+    setFlag(result, EQ_FLAG_EQUALITY, true);
   }
   else
   {
     // Notify e.g. the theory that owns this equality engine that there is a
     // new equivalence class.
     d_notify->eqNotifyNewClass(t);
-    if (d_constantsAreTriggers && d_isConstant[result])
+    if (d_constantsAreTriggers && isConstantId(result))
     {
       // Non-Boolean constants are trigger terms for all tags
       EqualityNodeId tId = getNodeId(t);
@@ -404,7 +400,7 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
   }
 
   // If this is not an internal node, add it to the master
-  if (d_masterEqualityEngine && !d_isInternal[result]) {
+  if (d_masterEqualityEngine && !isInternalId(result)) {
     d_masterEqualityEngine->addTermInternal(t);
   }
 
@@ -417,12 +413,12 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
 }
 
 bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
+  return d_nodeIds.find(t) != null_id;
 }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
   Assert(hasTerm(node)) << node;
-  return (*d_nodeIds.find(node)).second;
+  return d_nodeIds.find(node);
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -517,7 +513,7 @@ bool EqualityEngine::assertEquality(TNode eq,
     EqualityNodeId b = getNodeId(eq[1]);
     EqualityNodeId aClassId = getEqualityNode(a).getFind();
     EqualityNodeId bClassId = getEqualityNode(b).getFind();
-    if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
+    if (isConstantId(aClassId) && isConstantId(bClassId)) {
       return true;
     }
 
@@ -577,7 +573,7 @@ TNode EqualityEngine::getRepresentative(TNode t) const {
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
   EqualityNodeId representativeId = getEqualityNode(t).getFind();
-  Assert(!d_isInternal[representativeId]);
+  Assert(!isInternalId(representativeId));
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
@@ -607,8 +603,8 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Check for constant merges
-  bool class1isConstant = d_isConstant[class1Id];
-  bool class2isConstant = d_isConstant[class2Id];
+  bool class1isConstant = isConstantId(class1Id);
+  bool class2isConstant = isConstantId(class2Id);
   Assert(class1isConstant || !class2isConstant)
       << "Should always merge into constants";
   Assert(!class1isConstant || !class2isConstant) << "Don't merge constants";
@@ -681,7 +677,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
 
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
-  if (!d_isEquality[class2Id]) {
+  if (!isEqualityId(class2Id)) {
     Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
@@ -699,7 +695,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         const FunctionApplication& fun =
             d_applications[useNode.getApplicationId()].d_normalized;
         // If it's interpreted and we can interpret
-        if (fun.isInterpreted() && class1isConstant && !d_isInternal[currentId])
+        if (fun.isInterpreted() && class1isConstant && !isInternalId(currentId))
         {
           // Get the actual term id
           TNode term = d_nodes[funId];
@@ -944,10 +940,8 @@ void EqualityEngine::backtrack() {
     d_applications.resize(d_nodesCount);
     d_nodeTriggers.resize(d_nodesCount);
     d_nodeIndividualTrigger.resize(d_nodesCount);
-    d_isConstant.resize(d_nodesCount);
+    d_nodeFlags.resize(d_nodesCount);
     d_subtermsToEvaluate.resize(d_nodesCount);
-    d_isEquality.resize(d_nodesCount);
-    d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
   }
@@ -1010,7 +1004,7 @@ void EqualityEngine::buildEqConclusion(EqualityNodeId id1,
   // only try to build build if full applications corresponding to the given ids
   // have the same congruence n-ary non-APPLY_* kind, since the internal nodes
   // may be full nodes.
-  if ((d_isInternal[id1] || d_isInternal[id2])
+  if ((isInternalId(id1) || isInternalId(id2))
       && (k1 != k2 || k1 == kind::APPLY_UF || k1 == kind::APPLY_CONSTRUCTOR
           || k1 == kind::APPLY_SELECTOR || k1 == kind::APPLY_TESTER
           || !NodeManager::isNAryKind(k1)))
@@ -1028,7 +1022,7 @@ void EqualityEngine::buildEqConclusion(EqualityNodeId id1,
     EqualityNodeId equalityNodeId = i == 0 ? id1 : id2;
     Node equalityNode = d_nodes[equalityNodeId];
     // if not an internal node, just retrieve it
-    if (!d_isInternal[equalityNodeId])
+    if (!isInternalId(equalityNodeId))
     {
       eq[i] = equalityNode;
       continue;
@@ -1393,8 +1387,8 @@ void EqualityEngine::getExplanation(
       //
       // Note that this is robust for HOL because in that case function
       // symbols are not internal nodes
-      if (d_isInternal[t1Id] && d_nodes[t1Id].getNumChildren() == 0
-          && !d_isConstant[t1Id])
+      if (isInternalId(t1Id) && d_nodes[t1Id].getNumChildren() == 0
+          && !isConstantId(t1Id))
       {
         eqp->d_node = Node::null();
       }
@@ -1904,8 +1898,8 @@ void EqualityEngine::propagate() {
       continue;
     }
 
-    Debug("equality::internal") << d_name << "::eq::propagate(): t1: " << (d_isInternal[t1classId] ? "internal" : "proper") << std::endl;
-    Debug("equality::internal") << d_name << "::eq::propagate(): t2: " << (d_isInternal[t2classId] ? "internal" : "proper") << std::endl;
+    Debug("equality::internal") << d_name << "::eq::propagate(): t1: " << (isInternalId(t1classId) ? "internal" : "proper") << std::endl;
+    Debug("equality::internal") << d_name << "::eq::propagate(): t2: " << (isInternalId(t2classId) ? "internal" : "proper") << std::endl;
 
     // Get the nodes of the representatives
     EqualityNode& node1 = getEqualityNode(t1classId);
@@ -1919,7 +1913,7 @@ void EqualityEngine::propagate() {
         current.d_t1Id, current.d_t2Id, current.d_type, current.d_reason);
 
     // If constants are being merged we're done
-    if (d_isConstant[t1classId] && d_isConstant[t2classId]) {
+    if (isConstantId(t1classId) && isConstantId(t2classId)) {
       // When merging constants we are inconsistent, hence done
       d_done = true;
       // But in order to keep invariants (edges = 2*equalities) we put an equalities in
@@ -1938,18 +1932,18 @@ void EqualityEngine::propagate() {
 
     // Figure out the merge preference
     EqualityNodeId mergeInto = t1classId;
-    if (d_isInternal[t2classId] != d_isInternal[t1classId]) {
+    if (isInternalId(t2classId) != isInternalId(t1classId)) {
       // We always keep non-internal nodes as representatives: if any node in
       // the class is non-internal, then the representative will be non-internal
-      if (d_isInternal[t1classId]) {
+      if (isInternalId(t1classId)) {
         mergeInto = t2classId;
       } else {
         mergeInto = t1classId;
       }
-    } else if (d_isConstant[t2classId] != d_isConstant[t1classId]) {
+    } else if (isConstantId(t2classId) != isConstantId(t1classId)) {
       // We always keep constants as representatives: if any (at most one) node
       // in the class in a constant, then the representative will be a constant
-      if (d_isConstant[t2classId]) {
+      if (isConstantId(t2classId)) {
         mergeInto = t2classId;
       } else {
         mergeInto = t1classId;
@@ -1981,7 +1975,7 @@ void EqualityEngine::propagate() {
     }
 
     // If not merging internal nodes, notify the master
-    if (d_masterEqualityEngine && !d_isInternal[t1classId] && !d_isInternal[t2classId]) {
+    if (d_masterEqualityEngine && !isInternalId(t1classId) && !isInternalId(t2classId)) {
       d_masterEqualityEngine->assertEqualityInternal(d_nodes[t1classId], d_nodes[t2classId], TNode::null());
       d_masterEqualityEngine->propagate();
     }
@@ -2119,7 +2113,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
 
   // Check for constants
-  if (d_isConstant[t1ClassId] && d_isConstant[t2ClassId] && t1ClassId != t2ClassId) {
+  if (isConstantId(t1ClassId) && isConstantId(t2ClassId) && t1ClassId != t2ClassId) {
     if (ensureProof) {
       nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t1Id, t1ClassId));
       nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t2Id, t2ClassId));
@@ -2228,7 +2222,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
     // side of such disequalities, that have the tag on, are put in a set.
     TaggedEqualitiesSet disequalitiesToNotify;
     TheoryIdSet tags = TheoryIdSetUtil::setInsert(tag);
-    getDisequalities(!d_isConstant[classId], classId, tags, disequalitiesToNotify);
+    getDisequalities(!isConstantId(classId), classId, tags, disequalitiesToNotify);
 
     // Trigger data
     TheoryIdSet newSetTags;
@@ -2309,7 +2303,7 @@ void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized,
     {
       enqueue(MergeCandidate(funId, d_trueId, MERGED_THROUGH_REFLEXIVITY, TNode::null()));
     }
-    else if (d_isConstant[funNormalized.d_a] && d_isConstant[funNormalized.d_b])
+    else if (isConstantId(funNormalized.d_a) && isConstantId(funNormalized.d_b))
     {
       enqueue(MergeCandidate(funId, d_falseId, MERGED_THROUGH_CONSTANTS, TNode::null()));
     }
@@ -2521,7 +2515,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
           // Get the trigger set
           TriggerTermSetRef toCompareTriggerSetRef = d_nodeIndividualTrigger[toCompareRep];
           // We only care if we're not both constants and there are trigger terms in the other class
-          if ((allowConstants || !d_isConstant[toCompareRep]) && toCompareTriggerSetRef != null_set_id) {
+          if ((allowConstants || !isConstantId(toCompareRep)) && toCompareTriggerSetRef != null_set_id) {
             // Tags of the other gey
             TriggerTermSet& toCompareTriggerSet = getTriggerTermSet(toCompareTriggerSetRef);
             // We only care if there are things in inputTags that is also in toCompareTags
@@ -133,7 +133,7 @@ private:
   KindMap d_congruenceKindsExtOperators;
 
   /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId> d_nodeIds;
+  NodeIdIndex d_nodeIds;
 
   /** Map from function applications to their ids */
   typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
@@ -318,10 +318,51 @@ private:
   std::vector<TriggerId> d_nodeTriggers;
 
   /**
-   * Map from ids to whether they are constants (constants are always
-   * representatives of their class.
+   * Map from ids to their flags (see EqualityNodeFlag), i.e. whether they
+   * are constants (constants are always representatives of their class),
+   * equalities or internal nodes.
    */
-  std::vector<bool> d_isConstant;
+  std::vector<uint8_t> d_nodeFlags;
+
+  /** Returns whether the node with the given id has the flag */
+  bool hasFlag(EqualityNodeId id, EqualityNodeFlag flag) const
+  {
+    return (d_nodeFlags[id] & flag) != 0;
+  }
+
+  /** Sets or clears the flag of the node with the given id */
+  void setFlag(EqualityNodeId id, EqualityNodeFlag flag, bool value)
+  {
+    if (value)
+    {
+      d_nodeFlags[id] |= flag;
+    }
+    else
+    {
+      d_nodeFlags[id] &= ~flag;
+    }
+  }
+
+  /** Whether the node with the given id is a constant */
+  bool isConstantId(EqualityNodeId id) const
+  {
+    return hasFlag(id, EQ_FLAG_CONSTANT);
+  }
+
+  /** Whether the node with the given id is an equality */
+  bool isEqualityId(EqualityNodeId id) const
+  {
+    return hasFlag(id, EQ_FLAG_EQUALITY);
+  }
+
+  /**
+   * Whether the node with the given id is internal. An internal node is a
+   * node that corresponds to a partially currified node, for example.
+   */
+  bool isInternalId(EqualityNodeId id) const
+  {
+    return hasFlag(id, EQ_FLAG_INTERNAL);
+  }
 
   /**
    * Map from ids of proper terms, to the number of non-constant direct subterms. If we update an interpreted
@@ -359,20 +400,9 @@ private:
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return isConstantId(getEqualityNode(id).getFind());
   }
 
-  /**
-   * Map from ids to whether they are Boolean.
-   */
-  std::vector<bool> d_isEquality;
-
-  /**
-   * Map from ids to whether the nods is internal. An internal node is a node
-   * that corresponds to a partially currified node, for example.
-   */
-  std::vector<bool> d_isInternal;
-
   /**
    * Adds the trigger with triggerId to the beginning of the trigger list of the node with id nodeId.
    */
@@ -670,7 +700,7 @@ private:
   /**
    * Add a kind to treat as function applications.
    * When extOperator is true, this equality engine will treat the operators of this kind
-   * as "external" e.g. not internal nodes (see d_isInternal). This means that we will
+   * as "external" e.g. not internal nodes (see isInternalId). This means that we will
    * consider equivalence classes containing the operators of such terms, and "hasTerm" will
    * return true.
    */
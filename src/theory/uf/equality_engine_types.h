@@ -24,7 +24,9 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
+#include "base/check.h"
 #include "util/hash.h"
 
 namespace cvc5 {
@@ -358,6 +360,169 @@ struct TriggerInfo {
   }
 };
 
+/**
+ * Flags of an equality node, packed into one byte per node so that all
+ * flags of a node are read with a single load.
+ */
+enum EqualityNodeFlag : uint8_t
+{
+  /** The node is a constant (constants are always representatives) */
+  EQ_FLAG_CONSTANT = 1,
+  /** The node is an equality */
+  EQ_FLAG_EQUALITY = 2,
+  /** The node is internal, e.g. a partially currified application */
+  EQ_FLAG_INTERNAL = 4,
+};
+
+/**
+ * A flat map from terms to their equality node ids. The terms are keyed by
+ * their node value id, the map uses open addressing with linear probing in
+ * a single array, and removal shifts the following entries back so that no
+ * tombstones are needed. The map does not own the terms, which must be kept
+ * alive elsewhere (by the equality engine's node table).
+ */
+class NodeIdIndex
+{
+ public:
+  NodeIdIndex() : d_size(0), d_bits(0) {}
+
+  /** Returns the id of t, or null_id if t is not in the map. */
+  EqualityNodeId find(TNode t) const
+  {
+    if (d_size == 0)
+    {
+      return null_id;
+    }
+    uint64_t key = t.getId();
+    size_t mask = d_slots.size() - 1;
+    for (size_t i = home(key);; i = (i + 1) & mask)
+    {
+      const Slot& slot = d_slots[i];
+      if (slot.d_id == null_id)
+      {
+        return null_id;
+      }
+      if (slot.d_key == key)
+      {
+        return slot.d_id;
+      }
+    }
+  }
+
+  /**
+   * Maps t to id. If t is already in the map, its id is replaced (this
+   * happens for the partial applications of a curried term, which all
+   * have the term as their original node).
+   */
+  void insert(TNode t, EqualityNodeId id)
+  {
+    if ((d_size + 1) * 2 > d_slots.size())
+    {
+      grow();
+    }
+    if (place(t.getId(), id))
+    {
+      ++d_size;
+    }
+  }
+
+  /** Removes t from the map, if it is in the map. */
+  void erase(TNode t)
+  {
+    if (d_size == 0)
+    {
+      return;
+    }
+    uint64_t key = t.getId();
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(key);
+    while (d_slots[i].d_key != key || d_slots[i].d_id == null_id)
+    {
+      if (d_slots[i].d_id == null_id)
+      {
+        return;
+      }
+      i = (i + 1) & mask;
+    }
+    // move back the entries whose probe sequence passes through slot i
+    for (size_t j = (i + 1) & mask; d_slots[j].d_id != null_id;
+         j = (j + 1) & mask)
+    {
+      size_t k = home(d_slots[j].d_key);
+      bool reachable = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+      if (!reachable)
+      {
+        d_slots[i] = d_slots[j];
+        i = j;
+      }
+    }
+    d_slots[i].d_id = null_id;
+    --d_size;
+  }
+
+  /** The number of terms in the map. */
+  size_t size() const { return d_size; }
+
+ private:
+  /** A slot of the table, empty if d_id is null_id. */
+  struct Slot
+  {
+    uint64_t d_key;
+    EqualityNodeId d_id;
+  };
+
+  /** The home slot of a key. */
+  size_t home(uint64_t key) const
+  {
+    return static_cast<size_t>((key * 0x9e3779b97f4a7c15ULL) >> (64 - d_bits));
+  }
+
+  /**
+   * Puts (key, id) in the slot of key or the first free slot of its probe
+   * sequence. Returns true if the key was not in the table.
+   */
+  bool place(uint64_t key, EqualityNodeId id)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(key);
+    while (d_slots[i].d_id != null_id)
+    {
+      if (d_slots[i].d_key == key)
+      {
+        d_slots[i].d_id = id;
+        return false;
+      }
+      i = (i + 1) & mask;
+    }
+    d_slots[i].d_key = key;
+    d_slots[i].d_id = id;
+    return true;
+  }
+
+  /** Doubles the size of the table. */
+  void grow()
+  {
+    std::vector<Slot> old;
+    old.swap(d_slots);
+    d_bits = d_bits == 0 ? 4 : d_bits + 1;
+    d_slots.assign(static_cast<size_t>(1) << d_bits, Slot{0, null_id});
+    for (const Slot& slot : old)
+    {
+      if (slot.d_id != null_id)
+      {
+        place(slot.d_key, slot.d_id);
+      }
+    }
+  }
+
+  /** The table, the size is a power of two */
+  std::vector<Slot> d_slots;
+  /** The number of terms in the table */
+  size_t d_size;
+  /** The binary logarithm of the size of the table */
+  uint32_t d_bits;
+};
+
 } // namespace eq
 } // namespace theory
 }  // namespace cvc5
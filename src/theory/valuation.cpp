@@ -134,6 +134,16 @@ SortInference* Valuation::getSortInference()
   return d_engine->getSortInference();
 }
 
+LemmaCache* Valuation::getLemmaCache()
+{
+  if (d_engine == nullptr)
+  {
+    // no theory engine, thus we don't have a lemma cache
+    return nullptr;
+  }
+  return d_engine->getLemmaCache();
+}
+
 void Valuation::setUnevaluatedKind(Kind k)
 {
   TheoryModel* m = getModel();
@@ -34,6 +34,7 @@ namespace theory {
 
 struct Assertion;
 class TheoryModel;
+class LemmaCache;
 class SortInference;
 
 /**
@@ -120,6 +121,11 @@ public:
    * and is non-null when options::sortInference is true.
    */
   SortInference* getSortInference();
+  /**
+   * Returns a pointer to the lemma cache, which lives in TheoryEngine and is
+   * non-null when options::lemmaCache is true.
+   */
+  LemmaCache* getLemmaCache();
 
   //-------------------------------------- static configuration of the model
   /**
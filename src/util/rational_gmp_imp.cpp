@@ -13,6 +13,7 @@
  * A multi-precision rational constant.
  */
 #include <cmath>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -31,6 +32,199 @@ std::ostream& operator<<(std::ostream& os, const Rational& q){
   return os << q.toString();
 }
 
+Rational::Rational(const Integer& n, const Integer& d) : d_num(0), d_den(1)
+{
+  if (n.fitsSignedLong() && d.fitsSignedLong())
+  {
+    setFraction(n.getLong(), d.getLong());
+    return;
+  }
+  mpq_class val(n.get_mpz(), d.get_mpz());
+  val.canonicalize();
+  takeValue(val);
+}
+
+Rational::Rational(const Integer& n) : d_num(0), d_den(1)
+{
+  if (n.fitsSignedLong())
+  {
+    setFraction(n.getLong(), 1);
+    return;
+  }
+  mpq_class val(n.get_mpz());
+  takeValue(val);
+}
+
+void Rational::setValue(const mpq_class& val)
+{
+  mpq_class copy(val);
+  takeValue(copy);
+}
+
+void Rational::takeValue(mpq_class& val)
+{
+  const mpz_class& num = val.get_num();
+  const mpz_class& den = val.get_den();
+  if (mpz_fits_slong_p(num.get_mpz_t()) && mpz_fits_slong_p(den.get_mpz_t())
+      && mpz_cmp_si(num.get_mpz_t(), LONG_MIN) != 0)
+  {
+    d_num = mpz_get_si(num.get_mpz_t());
+    d_den = mpz_get_si(den.get_mpz_t());
+    d_big.reset();
+    return;
+  }
+  d_num = 0;
+  d_den = 1;
+  if (d_big == nullptr)
+  {
+    d_big = std::make_unique<mpq_class>();
+  }
+  d_big->swap(val);
+}
+
+void Rational::canonicalize(long n, long d)
+{
+  if (d == 0 || n == LONG_MIN || d == LONG_MIN)
+  {
+    // GMP reports a division by zero
+    mpq_class val(n, d);
+    val.canonicalize();
+    takeValue(val);
+    return;
+  }
+  if (d < 0)
+  {
+    n = -n;
+    d = -d;
+  }
+  long g = std::gcd(n, d);
+  d_num = n / g;
+  d_den = d / g;
+  d_big.reset();
+}
+
+void Rational::setUnsigned(unsigned long n, unsigned long d)
+{
+  if (d != 0 && n <= LONG_MAX && d <= LONG_MAX)
+  {
+    setFraction(static_cast<long>(n), static_cast<long>(d));
+    return;
+  }
+  mpq_class val(n, d);
+  val.canonicalize();
+  takeValue(val);
+}
+
+bool Rational::addSmall(long n, long d)
+{
+  long num, den;
+  if (d_den == d)
+  {
+    if (__builtin_add_overflow(d_num, n, &num) || num == LONG_MIN)
+    {
+      return false;
+    }
+    long g = d == 1 ? 1 : std::gcd(num, d);
+    d_num = num / g;
+    d_den = d / g;
+    return true;
+  }
+  // a/b + c/d = (a*(d/g) + c*(b/g)) / (b*(d/g)) where g = gcd(b, d), and the
+  // gcd of this numerator and denominator divides g
+  long g = std::gcd(d_den, d);
+  long t1, t2;
+  if (__builtin_mul_overflow(d_num, d / g, &t1)
+      || __builtin_mul_overflow(n, d_den / g, &t2)
+      || __builtin_add_overflow(t1, t2, &num) || num == LONG_MIN)
+  {
+    return false;
+  }
+  long g2 = g == 1 ? 1 : std::gcd(num, g);
+  if (__builtin_mul_overflow(d_den / g, d / g2, &den))
+  {
+    return false;
+  }
+  d_num = num / g2;
+  d_den = den;
+  return true;
+}
+
+bool Rational::mulSmall(long n, long d)
+{
+  if (d_num == 0 || n == 0)
+  {
+    d_num = 0;
+    d_den = 1;
+    return true;
+  }
+  // cancel crosswise, the results are then coprime
+  long g1 = std::gcd(d_num, d);
+  long g2 = std::gcd(n, d_den);
+  long num, den;
+  if (__builtin_mul_overflow(d_num / g1, n / g2, &num) || num == LONG_MIN
+      || __builtin_mul_overflow(d_den / g2, d / g1, &den))
+  {
+    return false;
+  }
+  d_num = num;
+  d_den = den;
+  return true;
+}
+
+void Rational::addSlow(const Rational& y, bool subtract)
+{
+  mpq_class tx, ty, res;
+  const mpq_class& x = toMpq(tx);
+  const mpq_class& yv = y.toMpq(ty);
+  if (subtract)
+  {
+    mpq_sub(res.get_mpq_t(), x.get_mpq_t(), yv.get_mpq_t());
+  }
+  else
+  {
+    mpq_add(res.get_mpq_t(), x.get_mpq_t(), yv.get_mpq_t());
+  }
+  takeValue(res);
+}
+
+void Rational::mulSlow(const Rational& y, bool divide)
+{
+  mpq_class tx, ty, res;
+  const mpq_class& x = toMpq(tx);
+  const mpq_class& yv = y.toMpq(ty);
+  if (divide)
+  {
+    res = x / yv;
+  }
+  else
+  {
+    mpq_mul(res.get_mpq_t(), x.get_mpq_t(), yv.get_mpq_t());
+  }
+  takeValue(res);
+}
+
+int Rational::cmpSlow(const Rational& x) const
+{
+  // Don't use mpq_class's cmp() function.
+  // The name ends up conflicting with this function.
+  mpq_class tthis, tx;
+  return mpq_cmp(toMpq(tthis).get_mpq_t(), x.toMpq(tx).get_mpq_t());
+}
+
+std::string Rational::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    std::string res = std::to_string(d_num);
+    if (d_den != 1)
+    {
+      res += "/" + std::to_string(d_den);
+    }
+    return res;
+  }
+  return getValue().get_str(base);
+}
+
 
 /* Computes a rational given a decimal string. The rational
  * version of <code>xxx.yyy</code> is <code>xxxyyy/(10^3)</code>.
@@ -89,9 +283,9 @@ Maybe<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class val;
+    mpq_set_d(val.get_mpq_t(), d);
+    return Rational(val);
   }
   return Maybe<Rational>();
 }
@@ -20,6 +20,8 @@
 
 #include <gmp.h>
 
+#include <climits>
+#include <memory>
 #include <string>
 
 #include "cvc5_export.h"  // remove when Cvc language support is removed
@@ -38,6 +40,12 @@ namespace cvc5 {
  * literature.) A consequence is that that the numerator and denominator may be
  * different than the values used to construct the Rational.
  *
+ * Rationals whose numerator and denominator fit into a long (excluding
+ * LONG_MIN) are stored inline and their arithmetic is done on machine words,
+ * with a fallback to GMP on overflow. Only other values allocate a GMP
+ * rational. The representation is unique: a value is stored in GMP if and
+ * only if it does not fit into the inline representation.
+ *
  * NOTE: The correct way to create a Rational from an int is to use one of the
  * int numerator/int denominator constructors with the denominator 1.  Trying
  * to construct a Rational with a single int, e.g., Rational(0), will put you
@@ -53,7 +61,7 @@ class CVC5_EXPORT Rational
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {}
+  Rational(const mpq_class& val) : d_num(0), d_den(1) { setValue(val); }
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -64,7 +72,7 @@ class CVC5_EXPORT Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -73,96 +81,112 @@ class CVC5_EXPORT Rational
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10) : d_value(s, base)
+  explicit Rational(const char* s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class val(s, base);
+    val.canonicalize();
+    takeValue(val);
   }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base)
+  Rational(const std::string& s, unsigned base = 10) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    mpq_class val(s, base);
+    val.canonicalize();
+    takeValue(val);
   }
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q)
+      : d_num(q.d_num),
+        d_den(q.d_den),
+        d_big(q.d_big == nullptr ? nullptr
+                                 : std::make_unique<mpq_class>(*q.d_big))
+  {
+  }
+  Rational(Rational&& q) = default;
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
+  Rational(signed int n) : d_num(0), d_den(1) { setFraction(n, 1); }
+  Rational(unsigned int n) : d_num(0), d_den(1) { setUnsigned(n, 1); }
+  Rational(signed long int n) : d_num(0), d_den(1) { setFraction(n, 1); }
+  Rational(unsigned long int n) : d_num(0), d_den(1) { setUnsigned(n, 1); }
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
+  Rational(int64_t n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(static_cast<long>(n), 1);
   }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
+  Rational(uint64_t n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(static_cast<unsigned long>(n), 1);
   }
 #endif /* CVC5_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n, d)
+  Rational(signed int n, signed int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n, d)
+  Rational(unsigned int n, unsigned int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(n, d);
   }
-  Rational(signed long int n, signed long int d) : d_value(n, d)
+  Rational(signed long int n, signed long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(n, d);
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n, d)
+  Rational(unsigned long int n, unsigned long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(n, d);
   }
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n, int64_t d)
-      : d_value(static_cast<long>(n), static_cast<long>(d))
+  Rational(int64_t n, int64_t d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setFraction(static_cast<long>(n), static_cast<long>(d));
   }
-  Rational(uint64_t n, uint64_t d)
-      : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+  Rational(uint64_t n, uint64_t d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(static_cast<unsigned long>(n), static_cast<unsigned long>(d));
   }
 #endif /* CVC5_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d)
-      : d_value(n.get_mpz(), d.get_mpz())
-  {
-    d_value.canonicalize();
-  }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
+  Rational(const Integer& n, const Integer& d);
+  Rational(const Integer& n);
   ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns the value as a GMP rational, to enable public access of GMP data.
+   * Note that this makes a deep copy.
    */
-  const mpq_class& getValue() const { return d_value; }
+  mpq_class getValue() const
+  {
+    mpq_class val;
+    return toMpq(val);
+  }
 
   /**
    * Returns the value of numerator of the Rational.
    * Note that this makes a deep copy of the numerator.
    */
-  Integer getNumerator() const { return Integer(d_value.get_num()); }
+  Integer getNumerator() const
+  {
+    return isSmall() ? Integer(d_num) : Integer(d_big->get_num());
+  }
 
   /**
    * Returns the value of denominator of the Rational.
    * Note that this makes a deep copy of the denominator.
    */
-  Integer getDenominator() const { return Integer(d_value.get_den()); }
+  Integer getDenominator() const
+  {
+    return isSmall() ? Integer(d_den) : Integer(d_big->get_den());
+  }
 
   static Maybe<Rational> fromDouble(double d);
 
@@ -171,30 +195,50 @@ class CVC5_EXPORT Rational
    * approximate: truncation may occur, overflow may result in
    * infinity, and underflow may result in zero.
    */
-  double getDouble() const { return d_value.get_d(); }
+  double getDouble() const
+  {
+    return isSmall() ? static_cast<double>(d_num) / d_den : d_big->get_d();
+  }
 
   Rational inverse() const
   {
+    if (isSmall() && d_num != 0)
+    {
+      return d_num > 0 ? mkSmall(d_den, d_num) : mkSmall(-d_den, -d_num);
+    }
     return Rational(getDenominator(), getNumerator());
   }
 
   int cmp(const Rational& x) const
   {
-    // Don't use mpq_class's cmp() function.
-    // The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    if (isSmall() && x.isSmall())
+    {
+      long l, r;
+      if (d_den == x.d_den)
+      {
+        l = d_num;
+        r = x.d_num;
+      }
+      else if (__builtin_mul_overflow(d_num, x.d_den, &l)
+               || __builtin_mul_overflow(x.d_num, d_den, &r))
+      {
+        return cmpSlow(x);
+      }
+      return l < r ? -1 : (l == r ? 0 : 1);
+    }
+    return cmpSlow(x);
   }
 
-  int sgn() const { return mpq_sgn(d_value.get_mpq_t()); }
+  int sgn() const
+  {
+    return isSmall() ? (d_num > 0) - (d_num < 0) : mpq_sgn(d_big->get_mpq_t());
+  }
 
-  bool isZero() const { return sgn() == 0; }
+  bool isZero() const { return isSmall() && d_num == 0; }
 
-  bool isOne() const { return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0; }
+  bool isOne() const { return isSmall() && d_num == 1 && d_den == 1; }
 
-  bool isNegativeOne() const
-  {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
-  }
+  bool isNegativeOne() const { return isSmall() && d_num == -1 && d_den == 1; }
 
   Rational abs() const
   {
@@ -210,15 +254,25 @@ class CVC5_EXPORT Rational
 
   Integer floor() const
   {
+    if (isSmall())
+    {
+      long q = d_num / d_den;
+      return Integer(d_num % d_den < 0 ? q - 1 : q);
+    }
     mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_fdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
   Integer ceiling() const
   {
+    if (isSmall())
+    {
+      long q = d_num / d_den;
+      return Integer(d_num % d_den > 0 ? q + 1 : q);
+    }
     mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
+    mpz_cdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
     return Integer(q);
   }
 
@@ -227,69 +281,121 @@ class CVC5_EXPORT Rational
   Rational& operator=(const Rational& x)
   {
     if (this == &x) return *this;
-    d_value = x.d_value;
+    d_num = x.d_num;
+    d_den = x.d_den;
+    if (x.isSmall())
+    {
+      d_big.reset();
+    }
+    else if (isSmall())
+    {
+      d_big = std::make_unique<mpq_class>(*x.d_big);
+    }
+    else
+    {
+      *d_big = *x.d_big;
+    }
     return *this;
   }
+  Rational& operator=(Rational&& x) = default;
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational operator-() const
+  {
+    return isSmall() ? mkSmall(-d_num, d_den) : Rational(-(*d_big));
+  }
 
-  bool operator==(const Rational& y) const { return d_value == y.d_value; }
+  bool operator==(const Rational& y) const
+  {
+    // the representation is unique
+    if (isSmall() != y.isSmall())
+    {
+      return false;
+    }
+    return isSmall() ? d_num == y.d_num && d_den == y.d_den
+                     : *d_big == *y.d_big;
+  }
 
-  bool operator!=(const Rational& y) const { return d_value != y.d_value; }
+  bool operator!=(const Rational& y) const { return !(*this == y); }
 
-  bool operator<(const Rational& y) const { return d_value < y.d_value; }
+  bool operator<(const Rational& y) const { return cmp(y) < 0; }
 
-  bool operator<=(const Rational& y) const { return d_value <= y.d_value; }
+  bool operator<=(const Rational& y) const { return cmp(y) <= 0; }
 
-  bool operator>(const Rational& y) const { return d_value > y.d_value; }
+  bool operator>(const Rational& y) const { return cmp(y) > 0; }
 
-  bool operator>=(const Rational& y) const { return d_value >= y.d_value; }
+  bool operator>=(const Rational& y) const { return cmp(y) >= 0; }
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational res(*this);
+    res += y;
+    return res;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational res(*this);
+    res -= y;
+    return res;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational res(*this);
+    res *= y;
+    return res;
   }
   Rational operator/(const Rational& y) const
   {
-    return Rational(d_value / y.d_value);
+    Rational res(*this);
+    res /= y;
+    return res;
   }
 
   Rational& operator+=(const Rational& y)
   {
-    d_value += y.d_value;
+    if (!isSmall() || !y.isSmall() || !addSmall(y.d_num, y.d_den))
+    {
+      addSlow(y, false);
+    }
     return (*this);
   }
   Rational& operator-=(const Rational& y)
   {
-    d_value -= y.d_value;
+    if (!isSmall() || !y.isSmall() || !addSmall(-y.d_num, y.d_den))
+    {
+      addSlow(y, true);
+    }
     return (*this);
   }
 
   Rational& operator*=(const Rational& y)
   {
-    d_value *= y.d_value;
+    if (!isSmall() || !y.isSmall() || !mulSmall(y.d_num, y.d_den))
+    {
+      mulSlow(y, false);
+    }
     return (*this);
   }
 
   Rational& operator/=(const Rational& y)
   {
-    d_value /= y.d_value;
+    // division by zero is left to GMP
+    if (!isSmall() || !y.isSmall() || y.d_num == 0
+        || !(y.d_num > 0 ? mulSmall(y.d_den, y.d_num)
+                         : mulSmall(-y.d_den, -y.d_num)))
+    {
+      mulSlow(y, true);
+    }
     return (*this);
   }
 
-  bool isIntegral() const { return getDenominator() == 1; }
+  bool isIntegral() const
+  {
+    return isSmall() ? d_den == 1 : mpz_cmp_ui(d_big->get_den_mpz_t(), 1) == 0;
+  }
 
   /** Returns a string representing the rational in the given base. */
-  std::string toString(int base = 10) const { return d_value.get_str(base); }
+  std::string toString(int base = 10) const;
 
   /**
    * Computes the hash of the rational from hashes of the numerator and the
@@ -297,14 +403,24 @@ class CVC5_EXPORT Rational
    */
   size_t hash() const
   {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
+    if (isSmall())
+    {
+      // agrees with gmpz_hash() on single limbs
+      return static_cast<size_t>(d_num < 0 ? -d_num : d_num)
+             xor static_cast<size_t>(d_den);
+    }
+    size_t numeratorHash = gmpz_hash(d_big->get_num_mpz_t());
+    size_t denominatorHash = gmpz_hash(d_big->get_den_mpz_t());
 
     return numeratorHash xor denominatorHash;
   }
 
   uint32_t complexity() const
   {
+    if (isSmall())
+    {
+      return bitLength(d_num) + bitLength(d_den);
+    }
     uint32_t numLen = getNumerator().length();
     uint32_t denLen = getDenominator().length();
     return numLen + denLen;
@@ -314,11 +430,85 @@ class CVC5_EXPORT Rational
   int absCmp(const Rational& q) const;
 
  private:
+  /** Constructs the canonical small rational n/d, for mkSmall(). */
+  struct SmallTag
+  {
+  };
+  Rational(long n, long d, SmallTag) : d_num(n), d_den(d) {}
+  /** Returns n/d, which must be canonical and fit the small representation. */
+  static Rational mkSmall(long n, long d) { return Rational(n, d, SmallTag()); }
+
+  /** Whether the value is stored in d_num and d_den. */
+  bool isSmall() const { return d_big == nullptr; }
+  /** Returns the value as a GMP rational, using tmp for small values. */
+  const mpq_class& toMpq(mpq_class& tmp) const
+  {
+    if (!isSmall())
+    {
+      return *d_big;
+    }
+    mpq_set_si(tmp.get_mpq_t(), d_num, static_cast<unsigned long>(d_den));
+    return tmp;
+  }
+  /** Sets the value to the canonical GMP rational val. */
+  void setValue(const mpq_class& val);
+  /** Sets the value to the canonical GMP rational val, which is consumed. */
+  void takeValue(mpq_class& val);
+  /** Sets the value to n/d, canonicalizing it. */
+  void setFraction(long n, long d)
+  {
+    if (d == 1 && n != LONG_MIN)
+    {
+      d_num = n;
+      d_den = 1;
+      d_big.reset();
+      return;
+    }
+    canonicalize(n, d);
+  }
+  /** Sets the value to n/d, canonicalizing it, for any n and d. */
+  void canonicalize(long n, long d);
+  /** Sets the value to n/d, canonicalizing it. */
+  void setUnsigned(unsigned long n, unsigned long d);
+  /**
+   * Adds n/d to this small rational on machine words. Returns false, without
+   * changing the value, if an intermediate result overflows.
+   */
+  bool addSmall(long n, long d);
+  /**
+   * Multiplies this small rational by n/d (where d > 0) on machine words.
+   * Returns false, without changing the value, on overflow.
+   */
+  bool mulSmall(long n, long d);
+  /** Adds (or subtracts) y using GMP. */
+  void addSlow(const Rational& y, bool subtract);
+  /** Multiplies with (or divides by) y using GMP. */
+  void mulSlow(const Rational& y, bool divide);
+  /** Compares with x using GMP. */
+  int cmpSlow(const Rational& x) const;
+  /** The number of bits of |n|, or 1 if n is zero. */
+  static uint32_t bitLength(long n)
+  {
+    if (n == 0)
+    {
+      return 1;
+    }
+    unsigned long u = n < 0 ? -static_cast<unsigned long>(n) : n;
+    return sizeof(unsigned long) * 8 - __builtin_clzl(u);
+  }
+
+  /**
+   * The numerator and the (positive) denominator of the value if d_big is
+   * null. Both are coprime and different from LONG_MIN, such that they can be
+   * negated without overflow.
+   */
+  long d_num;
+  long d_den;
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * Stores the value of the rational in a C++ GMP rational class if it does
+   * not fit into d_num and d_den, null otherwise.
    */
-  mpq_class d_value;
+  std::unique_ptr<mpq_class> d_big;
 
 }; /* class Rational */
 
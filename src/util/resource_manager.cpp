@@ -158,6 +158,7 @@ ResourceManager::ResourceManager(StatisticsRegistry& stats,
       d_cumulativeTimeUsed(0),
       d_cumulativeResourceUsed(0),
       d_thisCallResourceUsed(0),
+      d_interruptRequested(false),
       d_statistics(new ResourceManager::Statistics(stats))
 {
   d_statistics->d_resourceUnitsUsed.set(d_cumulativeResourceUsed);
@@ -211,6 +212,11 @@ void ResourceManager::spendResource(uint64_t amount)
       Trace("limit") << "ResourceManager::spendResource: elapsed time"
                      << d_perCallTimer.elapsed() << std::endl;
     }
+    if (interrupted())
+    {
+      Trace("limit") << "ResourceManager::spendResource: interrupt requested"
+                     << std::endl;
+    }
 
     for (Listener* l : d_listeners)
     {
@@ -261,6 +267,7 @@ void ResourceManager::endCall()
   d_cumulativeTimeUsed += d_perCallTimer.elapsed();
   d_perCallTimer.set(0);
   d_thisCallResourceUsed = 0;
+  clearInterrupt();
 }
 
 bool ResourceManager::limitOn() const
@@ -297,6 +304,21 @@ bool ResourceManager::outOfTime() const
   return d_perCallTimer.expired();
 }
 
+bool ResourceManager::interrupted() const
+{
+  return d_interruptRequested.load(std::memory_order_relaxed);
+}
+
+void ResourceManager::interrupt()
+{
+  d_interruptRequested.store(true, std::memory_order_relaxed);
+}
+
+void ResourceManager::clearInterrupt()
+{
+  d_interruptRequested.store(false, std::memory_order_relaxed);
+}
+
 void ResourceManager::registerListener(Listener* listener)
 {
   return d_listeners.push_back(listener);
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -134,8 +135,13 @@ class ResourceManager
   bool outOfResources() const;
   /** Checks whether time has been exhausted. */
   bool outOfTime() const;
-  /** Checks whether any limit has been exhausted. */
-  bool out() const { return outOfResources() || outOfTime(); }
+  /** Checks whether an interrupt was requested via interrupt(). */
+  bool interrupted() const;
+  /**
+   * Checks whether any limit has been exhausted or the current call was
+   * interrupted.
+   */
+  bool out() const { return interrupted() || outOfResources() || outOfTime(); }
 
   /** Retrieves amount of resources used overall. */
   uint64_t getResourceUsage() const;
@@ -168,8 +174,19 @@ class ResourceManager
   void endCall();
 
   /**
-   * Registers a listener that is notified on a resource out or (per-call)
-   * timeout.
+   * Requests that the current (or, if no call is active, the next) call is
+   * interrupted. Unlike all other methods of this class, this method may be
+   * called from a different thread than the one using this resource manager.
+   * The request is honored upon the next call to spendResource() and is
+   * cleared by endCall() or clearInterrupt().
+   */
+  void interrupt();
+  /** Withdraws a pending interrupt request. */
+  void clearInterrupt();
+
+  /**
+   * Registers a listener that is notified on a resource out, (per-call)
+   * timeout or interrupt.
    */
   void registerListener(Listener* listener);
 
@@ -192,6 +209,9 @@ class ResourceManager
    */
   uint64_t d_thisCallResourceBudget;
 
+  /** Whether an interrupt was requested, possibly by another thread. */
+  std::atomic<bool> d_interruptRequested;
+
   /** Receives a notification on reaching a limit. */
   std::vector<Listener*> d_listeners;
 
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Benchmark of merges, explanations and congruence closure in
+ * cvc5::theory::eq::EqualityEngine.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::eq;
+
+namespace test {
+
+class BenchTheoryUfEqualityEngine : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    d_context.reset(new context::Context());
+    d_ee.reset(new EqualityEngine(d_context.get(), "ee_test::", false));
+    d_ee->addFunctionKind(APPLY_UF);
+    TypeNode u = d_nodeManager->mkSort("U");
+    d_f = d_skolemManager->mkDummySkolem("f",
+                                         d_nodeManager->mkFunctionType(u, u));
+    for (size_t i = 0; i < s_numTerms; ++i)
+    {
+      d_x.push_back(
+          d_skolemManager->mkDummySkolem("x" + std::to_string(i), u));
+    }
+  }
+
+  void TearDown() override
+  {
+    d_ee.reset();
+    d_context.reset();
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** Returns f applied depth times to t */
+  Node apply(Node t, size_t depth)
+  {
+    for (size_t i = 0; i < depth; ++i)
+    {
+      t = d_nodeManager->mkNode(APPLY_UF, d_f, t);
+    }
+    return t;
+  }
+
+  /** The number of skolems */
+  static constexpr size_t s_numTerms = 2000;
+  std::unique_ptr<smt::SmtScope> d_scope;
+  std::unique_ptr<context::Context> d_context;
+  std::unique_ptr<EqualityEngine> d_ee;
+  Node d_f;
+  std::vector<Node> d_x;
+};
+
+TEST_F(BenchTheoryUfEqualityEngine, merge_explain_congruence_throughput)
+{
+  constexpr size_t depth = 3;
+  std::vector<Node> terms;
+  for (const Node& x : d_x)
+  {
+    terms.push_back(apply(x, depth));
+    d_ee->addTerm(terms.back());
+  }
+  std::vector<Node> eqs;
+  for (size_t i = 0; i + 1 < s_numTerms; ++i)
+  {
+    eqs.push_back(d_x[i].eqNode(d_x[i + 1]));
+  }
+
+  double mergeTime = 0;
+  double explainTime = 0;
+  size_t explanations = 0;
+  for (size_t round = 0; round < 10; ++round)
+  {
+    d_context->push();
+    auto start = std::chrono::steady_clock::now();
+    // each merge of two skolems triggers depth congruence merges
+    for (const Node& eq : eqs)
+    {
+      d_ee->assertEquality(eq, true, eq);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < s_numTerms; i += 97)
+    {
+      std::vector<TNode> assumptions;
+      d_ee->explainEquality(terms[0], terms[i], true, assumptions);
+      ASSERT_EQ(assumptions.size(), i);
+      ++explanations;
+    }
+    auto end = std::chrono::steady_clock::now();
+    mergeTime += std::chrono::duration<double, std::milli>(mid - start).count();
+    explainTime += std::chrono::duration<double, std::milli>(end - mid).count();
+    ASSERT_TRUE(d_ee->areEqual(terms.front(), terms.back()));
+    d_context->pop();
+    ASSERT_FALSE(d_ee->areEqual(terms.front(), terms.back()));
+  }
+  RecordProperty("merges", std::to_string(10 * eqs.size() * (depth + 1)));
+  RecordProperty("merge_ms", std::to_string(mergeTime));
+  RecordProperty("explanations", std::to_string(explanations));
+  RecordProperty("explain_ms", std::to_string(explainTime));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Benchmark of pivoting in cvc5::theory::arith::Tableau, with and without
+ * compaction. It replays a log recorded with -t arith::pivot-log if the
+ * environment variable CVC5_PIVOT_LOG names one, and a random run otherwise.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory::arith;
+
+namespace test {
+
+/** Counts the sign changes reported by the tableau. */
+class CountingCCCB : public CoefficientChangeCallback
+{
+ public:
+  void update(RowIndex ridx, ArithVar nb, int oldSgn, int currSgn) override
+  {
+    ++d_updates;
+  }
+  void multiplyRow(RowIndex ridx, int sgn) override {}
+  bool canUseRow(RowIndex ridx) const override { return true; }
+
+  uint64_t d_updates = 0;
+};
+
+class BenchTheoryArithTableau : public TestInternal
+{
+ protected:
+  /**
+   * Records a log of a random run in the format of Trace("arith::pivot-log"):
+   * numRows rows over numVars variables, followed by numPivots pivots on
+   * random entries of random rows.
+   */
+  std::string recordRandomRun(uint32_t seed,
+                              size_t numRows,
+                              size_t numVars,
+                              size_t numPivots)
+  {
+    std::mt19937 rng(seed);
+    std::stringstream log;
+    Tableau t;
+    t.increaseSizeTo(numRows + numVars);
+    NoEffectCCCB cb;
+    std::vector<ArithVar> basics;
+    for (size_t r = 0; r < numRows; ++r)
+    {
+      ArithVar basic = numVars + r;
+      std::vector<Rational> coeffs;
+      std::vector<ArithVar> vars;
+      for (ArithVar v = 0; v < numVars; ++v)
+      {
+        if (rng() % numVars < 4)
+        {
+          int c = static_cast<int>(rng() % 5) - 2;
+          vars.push_back(v);
+          coeffs.push_back(Rational(c == 0 ? 3 : c));
+        }
+      }
+      if (vars.empty())
+      {
+        vars.push_back(rng() % numVars);
+        coeffs.push_back(Rational(1));
+      }
+      log << "row " << basic << " " << vars.size();
+      for (size_t i = 0; i < vars.size(); ++i)
+      {
+        log << " " << vars[i] << " " << coeffs[i];
+      }
+      log << std::endl;
+      t.addRow(basic, coeffs, vars);
+      basics.push_back(basic);
+    }
+    for (size_t i = 0; i < numPivots; ++i)
+    {
+      size_t r = rng() % basics.size();
+      ArithVar basic = basics[r];
+      std::vector<ArithVar> candidates;
+      for (Tableau::RowIterator it = t.basicRowIterator(basic); !it.atEnd();
+           ++it)
+      {
+        if ((*it).getColVar() != basic)
+        {
+          candidates.push_back((*it).getColVar());
+        }
+      }
+      ArithVar entering = candidates[rng() % candidates.size()];
+      log << "pivot " << basic << " " << entering << std::endl;
+      t.pivot(basic, entering, cb);
+      basics[r] = entering;
+    }
+    return log.str();
+  }
+
+  /** Replays a pivot log on t, and returns the number of pivots. */
+  size_t replay(Tableau& t, std::istream& log, CoefficientChangeCallback& cb)
+  {
+    size_t pivots = 0;
+    std::string cmd;
+    while (log >> cmd)
+    {
+      if (cmd == "row")
+      {
+        ArithVar basic;
+        size_t n;
+        log >> basic >> n;
+        std::vector<ArithVar> vars(n);
+        std::vector<Rational> coeffs;
+        ArithVar maxVar = basic;
+        for (size_t i = 0; i < n; ++i)
+        {
+          std::string c;
+          log >> vars[i] >> c;
+          coeffs.push_back(Rational(c));
+          maxVar = std::max(maxVar, vars[i]);
+        }
+        t.increaseSizeTo(maxVar + 1);
+        t.addRow(basic, coeffs, vars);
+      }
+      else if (cmd == "pivot")
+      {
+        ArithVar oldBasic, newBasic;
+        log >> oldBasic >> newBasic;
+        t.pivot(oldBasic, newBasic, cb);
+        ++pivots;
+      }
+      else if (cmd == "remove")
+      {
+        ArithVar basic;
+        log >> basic;
+        t.removeBasicRow(basic);
+      }
+      else
+      {
+        ArithVar x, y;
+        std::string c;
+        log >> x >> y >> c;
+        t.increaseSizeTo(std::max(x, y) + 1);
+        if (cmd == "substitute")
+        {
+          t.substitutePlusTimesConstant(x, y, Rational(c), cb);
+        }
+        else
+        {
+          EXPECT_EQ(cmd, "add");
+          t.directlyAddToCoefficient(x, y, Rational(c), cb);
+        }
+      }
+    }
+    return pivots;
+  }
+
+  /** Returns the rows of t in iteration order. */
+  std::vector<std::string> rows(const Tableau& t)
+  {
+    std::vector<std::string> res;
+    for (Tableau::BasicIterator it = t.beginBasic(); it != t.endBasic(); ++it)
+    {
+      std::stringstream ss;
+      ss << *it << ":";
+      for (Tableau::RowIterator e = t.basicRowIterator(*it); !e.atEnd(); ++e)
+      {
+        ss << " " << (*e).getColVar() << "*" << (*e).getCoefficient();
+      }
+      res.push_back(ss.str());
+    }
+    return res;
+  }
+};
+
+TEST_F(BenchTheoryArithTableau, pivot_throughput)
+{
+  // A log recorded with -t arith::pivot-log can be replayed instead of a
+  // random run.
+  std::string log;
+  if (const char* path = std::getenv("CVC5_PIVOT_LOG"))
+  {
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+    std::stringstream ss;
+    ss << file.rdbuf();
+    log = ss.str();
+  }
+  else
+  {
+    log = recordRandomRun(2, 1000, 2000, 1500);
+  }
+
+  double times[2];
+  std::vector<std::string> results[2];
+  size_t pivots = 0;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    Tableau t;
+    t.setCompactionEnabled(i == 1);
+    CountingCCCB cb;
+    std::stringstream in(log);
+    auto start = std::chrono::steady_clock::now();
+    pivots = replay(t, in, cb);
+    auto end = std::chrono::steady_clock::now();
+    times[i] = std::chrono::duration<double, std::milli>(end - start).count();
+    results[i] = rows(t);
+  }
+  ASSERT_EQ(results[0], results[1]);
+  RecordProperty("pivots", std::to_string(pivots));
+  RecordProperty("linked_ms", std::to_string(times[0]));
+  RecordProperty("compacted_ms", std::to_string(times[1]));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Benchmark of the trail-based context-dependent data structures against the
+ * ones that save and restore their state.
+ */
+
+#include <chrono>
+#include <string>
+
+#include "context/cdhashmap.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
+#include "context/trail_cdhashmap.h"
+#include "context/trail_cdlist.h"
+#include "context/trail_cdo.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+class BenchContextUndoTrail : public TestContext
+{
+ protected:
+  /**
+   * Runs a workload of pushes, pops and modifications similar to a CDCL(T)
+   * search on the given map, object and list, returns the time in
+   * milliseconds.
+   */
+  template <class Map, class Obj, class List>
+  double pushPopWorkload(Map& map, Obj& obj, List& list)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t round = 0; round < 2000; ++round)
+    {
+      uint32_t depth = 1 + round % 16;
+      for (uint32_t level = 0; level < depth; ++level)
+      {
+        d_context->push();
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+          uint32_t key = (round * 31 + level * 7 + i) % 512;
+          map.insert(key, round);
+          obj = obj + 1;
+          list.push_back(key);
+        }
+      }
+      d_context->popto(0);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+};
+
+TEST_F(BenchContextUndoTrail, push_pop_throughput)
+{
+  double copyTime, trailTime;
+  {
+    CDHashMap<uint32_t, uint32_t> map(d_context.get());
+    CDO<uint32_t> obj(d_context.get(), 0);
+    CDList<uint32_t> list(d_context.get());
+    copyTime = pushPopWorkload(map, obj, list);
+  }
+  {
+    TrailCDHashMap<uint32_t, uint32_t> map(d_context.get());
+    TrailCDO<uint32_t> obj(d_context.get(), 0);
+    TrailCDList<uint32_t> list(d_context.get());
+    trailTime = pushPopWorkload(map, obj, list);
+  }
+  RecordProperty("save_restore_ms", std::to_string(copyTime));
+  RecordProperty("undo_trail_ms", std::to_string(trailTime));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,18 @@
+; COMMAND-LINE: --fp-simplex --heuristic-pivots=0 --standard-effort-variable-order-pivots=0 --stats --stats-expert
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e '/^theory::arith::z::arith::relax::feasible::res = [1-9]/{s/.*/floating-point simplex found a feasible basis/p;q}'
+; EXPECT: sat
+; EXPECT-ERROR: floating-point simplex found a feasible basis
+; Without exact pivots, the initial assignment violates the bounds of the
+; rows, so the floating-point simplex (pass 2) is run.
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= (+ x y) 4.0))
+(assert (<= (- x y) 1.0))
+(assert (<= (+ (* 2.0 x) (* 3.0 y) z) 20.0))
+(assert (>= (- z x) 0.5))
+(assert (>= x 0.0))
+(assert (>= y 0.0))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --fp-simplex --heuristic-pivots=0 --standard-effort-variable-order-pivots=0 --stats --stats-expert
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e '/^theory::arith::z::arith::relax::infeasible = [1-9]/{s/.*/floating-point simplex found no feasible basis/p;q}'
+; EXPECT: unsat
+; EXPECT-ERROR: floating-point simplex found no feasible basis
+; Without exact pivots, the initial assignment violates the bounds of the
+; rows, so the floating-point simplex (pass 2) is run.
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (>= (+ x y) 4.0))
+(assert (<= (+ x (* 2.0 y)) 3.0))
+(assert (>= x 0.0))
+(assert (<= x 1.0))
+(check-sat)
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --incremental --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(assert (or p (> x y)))
+(assert (or (not p) (= (f x) (f y))))
+(assert (>= y 0))
+(check-sat)
+(push 1)
+(assert (= x y))
+(assert (not (= (f x) (f y))))
+(check-sat)
+(pop 1)
+(assert (distinct (f x) (f y)))
+(check-sat)
+(check-sat-assuming ((<= x y)))
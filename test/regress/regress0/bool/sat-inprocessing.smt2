@@ -0,0 +1,106 @@
+; COMMAND-LINE: --incremental --sat-inprocessing --sat-inprocessing-interval=20 --sat-tiered-db
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun x0 () U)
+(declare-fun x1 () U)
+(declare-fun x2 () U)
+(declare-fun x3 () U)
+(declare-fun x4 () U)
+(declare-fun x5 () U)
+(declare-fun h0 () U)
+(declare-fun h1 () U)
+(declare-fun h2 () U)
+(declare-fun h3 () U)
+(declare-fun h4 () U)
+(assert (distinct h0 h1 h2 h3 h4))
+(check-sat)
+(push 1)
+(assert (or (= (f x0) h0) (= (f x0) h1) (= (f x0) h2) (= (f x0) h3) (= (f x0) h4)))
+(assert (or (= (f x1) h0) (= (f x1) h1) (= (f x1) h2) (= (f x1) h3) (= (f x1) h4)))
+(assert (or (= (f x2) h0) (= (f x2) h1) (= (f x2) h2) (= (f x2) h3) (= (f x2) h4)))
+(assert (or (= (f x3) h0) (= (f x3) h1) (= (f x3) h2) (= (f x3) h3) (= (f x3) h4)))
+(assert (or (= (f x4) h0) (= (f x4) h1) (= (f x4) h2) (= (f x4) h3) (= (f x4) h4)))
+(assert (or (= (f x5) h0) (= (f x5) h1) (= (f x5) h2) (= (f x5) h3) (= (f x5) h4)))
+(assert (or (not (= (f x0) h0)) (not (= (f x1) h0))))
+(assert (or (not (= (f x0) h0)) (not (= (f x2) h0))))
+(assert (or (not (= (f x0) h0)) (not (= (f x3) h0))))
+(assert (or (not (= (f x0) h0)) (not (= (f x4) h0))))
+(assert (or (not (= (f x0) h0)) (not (= (f x5) h0))))
+(assert (or (not (= (f x1) h0)) (not (= (f x2) h0))))
+(assert (or (not (= (f x1) h0)) (not (= (f x3) h0))))
+(assert (or (not (= (f x1) h0)) (not (= (f x4) h0))))
+(assert (or (not (= (f x1) h0)) (not (= (f x5) h0))))
+(assert (or (not (= (f x2) h0)) (not (= (f x3) h0))))
+(assert (or (not (= (f x2) h0)) (not (= (f x4) h0))))
+(assert (or (not (= (f x2) h0)) (not (= (f x5) h0))))
+(assert (or (not (= (f x3) h0)) (not (= (f x4) h0))))
+(assert (or (not (= (f x3) h0)) (not (= (f x5) h0))))
+(assert (or (not (= (f x4) h0)) (not (= (f x5) h0))))
+(assert (or (not (= (f x0) h1)) (not (= (f x1) h1))))
+(assert (or (not (= (f x0) h1)) (not (= (f x2) h1))))
+(assert (or (not (= (f x0) h1)) (not (= (f x3) h1))))
+(assert (or (not (= (f x0) h1)) (not (= (f x4) h1))))
+(assert (or (not (= (f x0) h1)) (not (= (f x5) h1))))
+(assert (or (not (= (f x1) h1)) (not (= (f x2) h1))))
+(assert (or (not (= (f x1) h1)) (not (= (f x3) h1))))
+(assert (or (not (= (f x1) h1)) (not (= (f x4) h1))))
+(assert (or (not (= (f x1) h1)) (not (= (f x5) h1))))
+(assert (or (not (= (f x2) h1)) (not (= (f x3) h1))))
+(assert (or (not (= (f x2) h1)) (not (= (f x4) h1))))
+(assert (or (not (= (f x2) h1)) (not (= (f x5) h1))))
+(assert (or (not (= (f x3) h1)) (not (= (f x4) h1))))
+(assert (or (not (= (f x3) h1)) (not (= (f x5) h1))))
+(assert (or (not (= (f x4) h1)) (not (= (f x5) h1))))
+(assert (or (not (= (f x0) h2)) (not (= (f x1) h2))))
+(assert (or (not (= (f x0) h2)) (not (= (f x2) h2))))
+(assert (or (not (= (f x0) h2)) (not (= (f x3) h2))))
+(assert (or (not (= (f x0) h2)) (not (= (f x4) h2))))
+(assert (or (not (= (f x0) h2)) (not (= (f x5) h2))))
+(assert (or (not (= (f x1) h2)) (not (= (f x2) h2))))
+(assert (or (not (= (f x1) h2)) (not (= (f x3) h2))))
+(assert (or (not (= (f x1) h2)) (not (= (f x4) h2))))
+(assert (or (not (= (f x1) h2)) (not (= (f x5) h2))))
+(assert (or (not (= (f x2) h2)) (not (= (f x3) h2))))
+(assert (or (not (= (f x2) h2)) (not (= (f x4) h2))))
+(assert (or (not (= (f x2) h2)) (not (= (f x5) h2))))
+(assert (or (not (= (f x3) h2)) (not (= (f x4) h2))))
+(assert (or (not (= (f x3) h2)) (not (= (f x5) h2))))
+(assert (or (not (= (f x4) h2)) (not (= (f x5) h2))))
+(assert (or (not (= (f x0) h3)) (not (= (f x1) h3))))
+(assert (or (not (= (f x0) h3)) (not (= (f x2) h3))))
+(assert (or (not (= (f x0) h3)) (not (= (f x3) h3))))
+(assert (or (not (= (f x0) h3)) (not (= (f x4) h3))))
+(assert (or (not (= (f x0) h3)) (not (= (f x5) h3))))
+(assert (or (not (= (f x1) h3)) (not (= (f x2) h3))))
+(assert (or (not (= (f x1) h3)) (not (= (f x3) h3))))
+(assert (or (not (= (f x1) h3)) (not (= (f x4) h3))))
+(assert (or (not (= (f x1) h3)) (not (= (f x5) h3))))
+(assert (or (not (= (f x2) h3)) (not (= (f x3) h3))))
+(assert (or (not (= (f x2) h3)) (not (= (f x4) h3))))
+(assert (or (not (= (f x2) h3)) (not (= (f x5) h3))))
+(assert (or (not (= (f x3) h3)) (not (= (f x4) h3))))
+(assert (or (not (= (f x3) h3)) (not (= (f x5) h3))))
+(assert (or (not (= (f x4) h3)) (not (= (f x5) h3))))
+(assert (or (not (= (f x0) h4)) (not (= (f x1) h4))))
+(assert (or (not (= (f x0) h4)) (not (= (f x2) h4))))
+(assert (or (not (= (f x0) h4)) (not (= (f x3) h4))))
+(assert (or (not (= (f x0) h4)) (not (= (f x4) h4))))
+(assert (or (not (= (f x0) h4)) (not (= (f x5) h4))))
+(assert (or (not (= (f x1) h4)) (not (= (f x2) h4))))
+(assert (or (not (= (f x1) h4)) (not (= (f x3) h4))))
+(assert (or (not (= (f x1) h4)) (not (= (f x4) h4))))
+(assert (or (not (= (f x1) h4)) (not (= (f x5) h4))))
+(assert (or (not (= (f x2) h4)) (not (= (f x3) h4))))
+(assert (or (not (= (f x2) h4)) (not (= (f x4) h4))))
+(assert (or (not (= (f x2) h4)) (not (= (f x5) h4))))
+(assert (or (not (= (f x3) h4)) (not (= (f x4) h4))))
+(assert (or (not (= (f x3) h4)) (not (= (f x5) h4))))
+(assert (or (not (= (f x4) h4)) (not (= (f x5) h4))))
+(check-sat)
+(pop 1)
+(assert (= (f x0) h0))
+(check-sat)
@@ -0,0 +1,20 @@
+; COMMAND-LINE: --bv-solver=bitblast --bv-bitblast-threads=4
+; COMMAND-LINE: --bv-solver=bitblast --bv-bitblast-threads=4 --bv-assert-input
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(set-option :incremental true)
+(declare-fun x () (_ BitVec 32))
+(declare-fun y () (_ BitVec 32))
+(declare-fun z () (_ BitVec 32))
+(assert (= (bvmul x y) z))
+(assert (bvult #x00000001 x))
+(assert (bvult #x00000001 y))
+(assert (= z #x0000008f))
+(check-sat)
+(push 1)
+(assert (bvult x #x00000100))
+(assert (bvult y #x00000100))
+(assert (= (bvudiv z x) #x00000000))
+(check-sat)
+(pop 1)
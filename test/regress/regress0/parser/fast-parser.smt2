@@ -0,0 +1,30 @@
+; COMMAND-LINE: --fast-parser --incremental --produce-models
+; EXPECT: sat
+; EXPECT: ((x 3))
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic ALL)
+(set-info :status sat)
+(declare-datatype Lst ((nil) (cons (hd Int) (tl Lst))))
+(declare-sort U 0)
+(define-sort Arr () (Array Int Int))
+(declare-fun x () Int)
+(declare-const a Arr)
+(declare-fun f (U) Int)
+(declare-const u U)
+(define-fun g ((y Int) (z Int)) Int (let ((s (+ y z))) (* 2 s)))
+(assert (! (= (g x 1) 8) :named goal))
+(assert (= (select a x) (f u)))
+(assert (forall ((v Int)) (! (or (> v 0) (<= v 0)) :pattern ((g v 0)))))
+(assert ((_ is cons) (cons x nil)))
+(assert (= ((_ extract 3 0) #x1f) #b1111))
+(assert (= (str.len "a""b") 3))
+(check-sat)
+(get-value (x))
+(push 1)
+(assert (< x 0))
+(check-sat)
+(pop 1)
+(check-sat-assuming ((> x 2)))
+(check-sat-assuming ((distinct x 3)))
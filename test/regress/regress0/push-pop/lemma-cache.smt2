@@ -0,0 +1,33 @@
+; COMMAND-LINE: --incremental --lemma-cache --stats --stats-expert
+; REQUIRES: statistics
+; ERROR-SCRUBBER: sed -n -e '/^theory::LemmaCache::replayed = [1-9]/{s/.*/cached lemmas were replayed/p;q}'
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT-ERROR: cached lemmas were replayed
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(declare-fun r () Bool)
+(assert (forall ((z U)) (or (not (P z)) (Q z))))
+; make the atoms of the instantiation lemma known at the base level, so that
+; the lemma is replayed when they are asserted again
+(assert (or (P a) (Q a) r))
+(push 1)
+(assert (P a))
+(assert (not (Q a)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (not (P a)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (P a))
+(assert (not (Q a)))
+(check-sat)
+(pop 1)
+(check-sat)
@@ -172,14 +172,15 @@ def run_benchmark(dump, wrapper, scrubber, error_scrubber, cvc5_binary,
     return (output.strip(), error.strip(), exit_status)
 
 
-def run_regression(check_unsat_cores, check_proofs, dump, use_skip_return_code,
-                   skip_timeout, wrapper, cvc5_binary, benchmark_path,
-                   timeout):
+def run_regression(check_unsat_cores, check_proofs, dump, fast_parser,
+                   use_skip_return_code, skip_timeout, wrapper, cvc5_binary,
+                   benchmark_path, timeout):
     """Determines the expected output for a benchmark, runs cvc5 on it and then
     checks whether the output corresponds to the expected output. Optionally
     uses a wrapper `wrapper`, tests unsat cores (if check_unsat_cores is true),
     checks proofs (if check_proofs is true), or dumps a benchmark and uses that as
-    the input (if dump is true). `use_skip_return_code` enables/disables
+    the input (if dump is true). SMT-LIB 2 benchmarks are read with the fast
+    parser if fast_parser is true. `use_skip_return_code` enables/disables
     returning 77 when a test is skipped."""
 
     if not os.access(cvc5_binary, os.X_OK):
@@ -204,6 +205,8 @@ def run_regression(check_unsat_cores, check_proofs, dump, use_skip_return_code,
     elif benchmark_ext == '.smt2':
         status_regex = r'set-info\s*:status\s*(sat|unsat)'
         comment_char = ';'
+        if fast_parser:
+            basic_command_line_args.append('--fast-parser')
     elif benchmark_ext == '.cvc':
         pass
     elif benchmark_ext == '.p':
@@ -434,6 +437,7 @@ def main():
         description=
         'Runs benchmark and checks for correct exit status and output.')
     parser.add_argument('--dump', action='store_true')
+    parser.add_argument('--fast-parser', action='store_true')
     parser.add_argument('--use-skip-return-code', action='store_true')
     parser.add_argument('--skip-timeout', action='store_true')
     parser.add_argument('--check-unsat-cores', action='store_true',
@@ -463,8 +467,9 @@ def main():
     timeout = float(os.getenv('TEST_TIMEOUT', '600'))
 
     return run_regression(args.check_unsat_cores, args.check_proofs, args.dump,
-                          args.use_skip_return_code, args.skip_timeout,
-                          wrapper, cvc5_binary, args.benchmark, timeout)
+                          args.fast_parser, args.use_skip_return_code,
+                          args.skip_timeout, wrapper, cvc5_binary,
+                          args.benchmark, timeout)
 
 
 if __name__ == "__main__":
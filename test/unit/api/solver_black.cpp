@@ -1982,6 +1982,102 @@ TEST_F(TestApiBlackSolver, checkSatAssuming2)
   ASSERT_THROW(slv.checkSatAssuming(d_solver.mkTrue()), CVC5ApiException);
 }
 
+TEST_F(TestApiBlackSolver, checkSatAssumingBatch)
+{
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term y = d_solver.mkConst(intSort, "y");
+  Term zero = d_solver.mkInteger(0);
+  Term ten = d_solver.mkInteger(10);
+  Term xPos = d_solver.mkTerm(GT, x, zero);
+  Term yPos = d_solver.mkTerm(GT, y, zero);
+  Term xBig = d_solver.mkTerm(GT, x, ten);
+  ASSERT_THROW(d_solver.checkSatAssumingBatch({{xPos}}), CVC5ApiException);
+
+  d_solver.setOption("incremental", "true");
+  d_solver.setOption("produce-models", "true");
+  d_solver.setOption("produce-assertions", "true");
+  d_solver.assertFormula(
+      d_solver.mkTerm(LEQ, d_solver.mkTerm(PLUS, x, y), ten));
+  std::vector<std::vector<Term>> values;
+  std::vector<std::vector<Term>> unsat;
+  std::vector<cvc5::api::Result> res = d_solver.checkSatAssumingBatch(
+      {{xPos, yPos}, {xBig, yPos}, {}, {xBig, d_solver.mkFalse()}, {xBig}},
+      {x},
+      values,
+      unsat);
+  ASSERT_EQ(res.size(), 5);
+  ASSERT_EQ(values.size(), 5);
+  ASSERT_EQ(unsat.size(), 5);
+  ASSERT_TRUE(res[0].isSat());
+  ASSERT_TRUE(res[1].isUnsat());
+  ASSERT_TRUE(res[2].isSat());
+  ASSERT_TRUE(res[3].isUnsat());
+  ASSERT_TRUE(res[4].isSat());
+  ASSERT_EQ(values[0].size(), 1);
+  ASSERT_TRUE(values[1].empty());
+  ASSERT_EQ(unsat[3], std::vector<Term>{d_solver.mkFalse()});
+  ASSERT_EQ(values[4].size(), 1);
+  ASSERT_GT(std::stoi(values[4][0].getIntegerValue()), 10);
+  for (const Term& t : unsat[1])
+  {
+    ASSERT_TRUE(t == xBig || t == yPos);
+  }
+  // the batch does not change the assertions
+  ASSERT_TRUE(d_solver.checkSatAssuming({xBig, yPos}).isUnsat());
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+  ASSERT_EQ(d_solver.getAssertions().size(), 1);
+
+  ASSERT_THROW(d_solver.checkSatAssumingBatch({{xPos, Term()}}),
+               CVC5ApiException);
+  ASSERT_THROW(d_solver.checkSatAssumingBatch({{x}}), CVC5ApiException);
+  Solver slv;
+  slv.setOption("incremental", "true");
+  ASSERT_THROW(slv.checkSatAssumingBatch({{xPos}}), CVC5ApiException);
+}
+
+TEST_F(TestApiBlackSolver, getCubes)
+{
+  Sort boolSort = d_solver.getBooleanSort();
+  Term a = d_solver.mkConst(boolSort, "a");
+  Term b = d_solver.mkConst(boolSort, "b");
+  Term c = d_solver.mkConst(boolSort, "c");
+  ASSERT_THROW(d_solver.getLearnedClauses(), CVC5ApiException);
+
+  d_solver.setOption("incremental", "true");
+  d_solver.setOption("sat-export-size", "4");
+  d_solver.assertFormula(d_solver.mkTerm(OR, a, b));
+  d_solver.assertFormula(d_solver.mkTerm(OR, a.notTerm(), c));
+  d_solver.assertFormula(d_solver.mkTerm(OR, b.notTerm(), c.notTerm()));
+  std::vector<std::vector<Term>> cubes = d_solver.getCubes(2);
+  ASSERT_FALSE(cubes.empty());
+  size_t numSat = 0;
+  for (const std::vector<Term>& cube : cubes)
+  {
+    ASSERT_LE(cube.size(), 3);
+    for (const Term& lit : cube)
+    {
+      ASSERT_TRUE(lit.getSort().isBoolean());
+    }
+    cvc5::api::Result res = d_solver.checkSatAssuming(cube);
+    ASSERT_FALSE(res.isSatUnknown());
+    numSat += res.isSat() ? 1 : 0;
+  }
+  ASSERT_GT(numSat, 0);
+  for (const Term& cl : d_solver.getLearnedClauses())
+  {
+    ASSERT_TRUE(cl.getSort().isBoolean());
+  }
+
+  // the cubes of unsatisfiable assertions are all unsatisfiable
+  d_solver.assertFormula(d_solver.mkTerm(OR, b, c.notTerm()));
+  d_solver.assertFormula(d_solver.mkTerm(OR, a.notTerm(), b.notTerm()));
+  for (const std::vector<Term>& cube : d_solver.getCubes(2))
+  {
+    ASSERT_TRUE(d_solver.checkSatAssuming(cube).isUnsat());
+  }
+}
+
 TEST_F(TestApiBlackSolver, setLogic)
 {
   ASSERT_NO_THROW(d_solver.setLogic("AUFLIRA"));
@@ -2014,6 +2110,20 @@ TEST_F(TestApiBlackSolver, resetAssertions)
   d_solver.checkSatAssuming({slt, ule});
 }
 
+TEST_F(TestApiBlackSolver, interrupt)
+{
+  d_solver.setOption("incremental", "true");
+  Sort boolSort = d_solver.getBooleanSort();
+  Term x = d_solver.mkConst(boolSort, "x");
+  d_solver.assertFormula(x);
+  ASSERT_NO_THROW(d_solver.interrupt());
+  cvc5::api::Result res = d_solver.checkSat();
+  ASSERT_TRUE(res.isSatUnknown());
+  ASSERT_EQ(res.getUnknownExplanation(), cvc5::api::Result::INTERRUPTED);
+  // the interrupt only affects a single call
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+}
+
 TEST_F(TestApiBlackSolver, mkSygusVar)
 {
   Sort boolSort = d_solver.getBooleanSort();
@@ -2243,6 +2353,122 @@ TEST_F(TestApiBlackSolver, getSynthSolutions)
   ASSERT_THROW(slv.getSynthSolutions({x}), CVC5ApiException);
 }
 
+TEST_F(TestApiBlackSolver, clone)
+{
+  d_solver.setOption("incremental", "true");
+  d_solver.setOption("produce-models", "true");
+  d_solver.setOption("produce-assertions", "true");
+  d_solver.setLogic("QF_LIA");
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term y = d_solver.mkConst(intSort, "y");
+  Term zero = d_solver.mkInteger(0);
+  // x is eliminated by preprocessing
+  d_solver.assertFormula(d_solver.mkTerm(
+      EQUAL, x, d_solver.mkTerm(PLUS, y, d_solver.mkInteger(1))));
+  d_solver.assertFormula(d_solver.mkTerm(GT, y, zero));
+  ASSERT_TRUE(d_solver.checkSat().isSat());
+
+  std::unique_ptr<Solver> fork;
+  ASSERT_NO_THROW(fork = d_solver.clone());
+  Term fx = fork->importTerm(x);
+  Term fy = fork->importTerm(y);
+  ASSERT_THROW(fork->assertFormula(d_solver.mkTerm(LT, x, zero)),
+               CVC5ApiException);
+  ASSERT_EQ(fork->importSort(intSort), fork->getIntegerSort());
+  ASSERT_EQ(fork->getAssertions().size(), 2);
+
+  // both branches are independent
+  d_solver.assertFormula(d_solver.mkTerm(LT, x, d_solver.mkInteger(2)));
+  ASSERT_TRUE(d_solver.checkSat().isUnsat());
+  fork->assertFormula(fork->mkTerm(EQUAL, fy, fork->mkInteger(4)));
+  ASSERT_TRUE(fork->checkSat().isSat());
+  ASSERT_EQ(fork->getValue(fx), fork->mkInteger(5));
+
+  Solver slv;
+  ASSERT_THROW(slv.importTerm(x), CVC5ApiException);
+  ASSERT_THROW(slv.importSort(intSort), CVC5ApiException);
+}
+
+TEST_F(TestApiBlackSolver, saveLoadBinary)
+{
+  d_solver.setOption("produce-assertions", "true");
+  Sort intSort = d_solver.getIntegerSort();
+  Term x = d_solver.mkConst(intSort, "x");
+  Term b = d_solver.mkVar(intSort, "b");
+  Term body = d_solver.mkTerm(PLUS, b, d_solver.mkInteger(1));
+  Term f = d_solver.defineFun("f", {b}, intSort, body);
+  Term c = d_solver.defineFun("c", {}, intSort, d_solver.mkInteger(3));
+  d_solver.assertFormula(
+      d_solver.mkTerm(EQUAL, d_solver.mkTerm(APPLY_UF, f, x), c));
+  // the definitions are part of the assertions
+  std::vector<Term> assertions = d_solver.getAssertions();
+  ASSERT_EQ(assertions.size(), 3);
+
+  std::vector<Term> definedFuns = {f, c};
+  std::vector<Term> definitions = {
+      d_solver.mkTerm(LAMBDA, d_solver.mkTerm(BOUND_VAR_LIST, b), body),
+      d_solver.mkInteger(3)};
+  std::stringstream out;
+  ASSERT_THROW(d_solver.saveBinary(out, assertions, {x}, {}, definedFuns, {}),
+               CVC5ApiException);
+  ASSERT_NO_THROW(
+      d_solver.saveBinary(out, assertions, {x}, {}, definedFuns, definitions));
+
+  Solver slv;
+  std::vector<Term> lassertions, ldeclTerms, ldefinedFuns, ldefinitions;
+  std::vector<Sort> ldeclSorts;
+  std::stringstream in(out.str());
+  ASSERT_NO_THROW(slv.loadBinary(
+      in, lassertions, ldeclTerms, ldeclSorts, ldefinedFuns, ldefinitions));
+  ASSERT_EQ(lassertions.size(), 1);
+  ASSERT_EQ(ldeclTerms.size(), 1);
+  ASSERT_TRUE(ldeclSorts.empty());
+  ASSERT_EQ(ldefinedFuns.size(), 2);
+  ASSERT_EQ(ldefinitions.size(), 2);
+  ASSERT_EQ(ldefinedFuns[0].toString(), "f");
+  ASSERT_EQ(ldefinitions[0].getKind(), LAMBDA);
+  ASSERT_EQ(ldefinitions[1], slv.mkInteger(3));
+
+  // with the definitions restored, f(x) = c forces x = 2
+  Term lb = ldefinitions[0][0][0];
+  slv.defineFun(ldefinedFuns[0], {lb}, ldefinitions[0][1]);
+  slv.defineFun(ldefinedFuns[1], {}, ldefinitions[1]);
+  slv.assertFormula(lassertions[0]);
+  slv.assertFormula(slv.mkTerm(DISTINCT, ldeclTerms[0], slv.mkInteger(2)));
+  ASSERT_TRUE(slv.checkSat().isUnsat());
+}
+
+TEST_F(TestApiBlackSolver, saveLoadBinaryDefinedConstant)
+{
+  d_solver.setOption("produce-assertions", "true");
+  Sort intSort = d_solver.getIntegerSort();
+  Term five = d_solver.mkInteger(5);
+  Term c = d_solver.defineFun("c", {}, intSort, five);
+  // a user assertion about c, which is not its definition
+  Term cIsSeven = d_solver.mkTerm(EQUAL, c, d_solver.mkInteger(7));
+  d_solver.assertFormula(cIsSeven);
+  std::vector<Term> assertions = d_solver.getAssertions();
+  ASSERT_EQ(assertions.size(), 2);
+
+  std::stringstream out;
+  ASSERT_NO_THROW(d_solver.saveBinary(out, assertions, {}, {}, {c}, {five}));
+
+  Solver slv;
+  std::vector<Term> lassertions, ldeclTerms, ldefinedFuns, ldefinitions;
+  std::vector<Sort> ldeclSorts;
+  std::stringstream in(out.str());
+  ASSERT_NO_THROW(slv.loadBinary(
+      in, lassertions, ldeclTerms, ldeclSorts, ldefinedFuns, ldefinitions));
+  ASSERT_EQ(lassertions.size(), 1);
+  ASSERT_EQ(lassertions[0].getKind(), EQUAL);
+  ASSERT_EQ(lassertions[0][1], slv.mkInteger(7));
+
+  slv.defineFun(ldefinedFuns[0], {}, ldefinitions[0]);
+  slv.assertFormula(lassertions[0]);
+  ASSERT_TRUE(slv.checkSat().isUnsat());
+}
+
 TEST_F(TestApiBlackSolver, tupleProject)
 {
   std::vector<Sort> sorts = {d_solver.getBooleanSort(),
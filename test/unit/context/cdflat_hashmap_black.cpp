@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::context::CDFlatHashMap and CDFlatHashSet.
+ */
+
+#include <map>
+#include <vector>
+
+#include "context/cdflat_hashmap.h"
+#include "context/cdflat_hashset.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+/** A bad hash function that forces long probe sequences. */
+struct CollidingHash
+{
+  size_t operator()(int i) const { return static_cast<size_t>(i % 3); }
+};
+
+class TestContextBlackCDFlatHashMap : public TestContext
+{
+};
+
+TEST_F(TestContextBlackCDFlatHashMap, simple_sequence)
+{
+  CDFlatHashMap<int, int> map(d_context.get());
+  ASSERT_TRUE(map.empty());
+
+  ASSERT_TRUE(map.insert(3, 4));
+  ASSERT_EQ(map.size(), 1);
+  ASSERT_EQ(map[3], 4);
+
+  d_context->push();
+  ASSERT_TRUE(map.insert(5, 6));
+  ASSERT_TRUE(map.insert(9, 8));
+  ASSERT_FALSE(map.insert(3, 7));
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map[3], 7);
+  ASSERT_EQ(map.count(5), 1);
+
+  d_context->push();
+  ASSERT_FALSE(map.insert_safe(5, 0));
+  ASSERT_TRUE(map.insert_safe(1, 2));
+  ASSERT_EQ(map[5], 6);
+  ASSERT_EQ(map.size(), 4);
+
+  d_context->pop();
+  ASSERT_FALSE(map.contains(1));
+  ASSERT_EQ(map.find(1), map.end());
+  ASSERT_EQ(map.size(), 3);
+
+  d_context->pop();
+  ASSERT_EQ(map.size(), 1);
+  ASSERT_EQ(map[3], 4);
+  ASSERT_FALSE(map.contains(5));
+  ASSERT_FALSE(map.contains(9));
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, insertion_order)
+{
+  CDFlatHashMap<int, int> map(d_context.get());
+  d_context->push();
+  for (int i = 100; i > 0; --i)
+  {
+    map.insert(i, -i);
+  }
+  int expected = 100;
+  for (const auto& p : map)
+  {
+    ASSERT_EQ(p.first, expected);
+    ASSERT_EQ(p.second, -expected);
+    --expected;
+  }
+  d_context->pop();
+  ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, collisions_and_tombstones)
+{
+  CDFlatHashMap<int, int, CollidingHash> map(d_context.get());
+  std::map<int, int> reference;
+  for (int round = 0; round < 20; ++round)
+  {
+    d_context->push();
+    for (int i = 0; i < 50; ++i)
+    {
+      int k = round * 50 + i;
+      map.insert(k, k);
+    }
+    d_context->pop();
+    // insert some entries permanently, reusing the tombstoned slots
+    map.insert(round, round * round);
+    reference[round] = round * round;
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& p : reference)
+    {
+      ASSERT_TRUE(map.contains(p.first));
+      ASSERT_EQ(map[p.first], p.second);
+    }
+    ASSERT_FALSE(map.contains(round * 50 + 49 + 1000));
+  }
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, nested_overwrites)
+{
+  CDFlatHashMap<int, int> map(d_context.get());
+  map.insert(1, 0);
+  for (int level = 1; level <= 10; ++level)
+  {
+    d_context->push();
+    map.insert(1, level);
+    map.insert(1, level * 100);
+    map.insert(level + 1, level);
+  }
+  for (int level = 10; level >= 1; --level)
+  {
+    ASSERT_EQ(map[1], level * 100);
+    ASSERT_EQ(map.size(), static_cast<size_t>(level + 1));
+    d_context->pop();
+  }
+  ASSERT_EQ(map[1], 0);
+  ASSERT_EQ(map.size(), 1);
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, hashset)
+{
+  CDFlatHashSet<int> set(d_context.get());
+  ASSERT_TRUE(set.insert(1));
+  d_context->push();
+  ASSERT_FALSE(set.insert(1));
+  for (int i = 2; i < 1000; ++i)
+  {
+    ASSERT_TRUE(set.insert(i));
+  }
+  ASSERT_EQ(set.size(), 999);
+  ASSERT_EQ(*set.begin(), 1);
+  d_context->pop();
+  ASSERT_EQ(set.size(), 1);
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_FALSE(set.contains(2));
+  ASSERT_TRUE(set.insert(2));
+}
+}  // namespace test
+}  // namespace cvc5
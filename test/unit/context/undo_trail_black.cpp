@@ -0,0 +1,211 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the trail-based context-dependent data structures.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
+#include "context/trail_cdhashmap.h"
+#include "context/trail_cdhashset.h"
+#include "context/trail_cdlist.h"
+#include "context/trail_cdo.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+class TestContextBlackUndoTrail : public TestContext
+{
+ protected:
+  /**
+   * Runs pushes, pops and modifications similar to a CDCL(T) search on the
+   * given map, object and list, and checks that every pop restores them.
+   */
+  template <class Map, class Obj, class List>
+  void pushPopWorkload(Map& map, Obj& obj, List& list)
+  {
+    for (uint32_t round = 0; round < 100; ++round)
+    {
+      uint32_t depth = 1 + round % 16;
+      for (uint32_t level = 0; level < depth; ++level)
+      {
+        d_context->push();
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+          uint32_t key = (round * 31 + level * 7 + i) % 512;
+          map.insert(key, round);
+          obj = obj + 1;
+          list.push_back(key);
+        }
+      }
+      ASSERT_EQ(obj.get(), 8 * depth);
+      ASSERT_EQ(list.size(), 8 * depth);
+      d_context->pop();
+      ASSERT_EQ(obj.get(), 8 * (depth - 1));
+      ASSERT_EQ(list.size(), 8 * (depth - 1));
+      d_context->popto(0);
+      ASSERT_EQ(obj.get(), 0);
+      ASSERT_TRUE(list.empty());
+      ASSERT_TRUE(map.empty());
+    }
+  }
+};
+
+TEST_F(TestContextBlackUndoTrail, trail_cdo)
+{
+  TrailCDO<int> a(d_context.get(), 5);
+  TrailCDO<std::string> s(d_context.get());
+  ASSERT_EQ(a, 5);
+  d_context->push();
+  a = 10;
+  a = 11;
+  s = "one";
+  d_context->push();
+  a = 12;
+  d_context->push();
+  ASSERT_EQ(a.get(), 12);
+  ASSERT_EQ(s.get(), "one");
+  d_context->pop();
+  d_context->pop();
+  ASSERT_EQ(a.get(), 11);
+  d_context->pop();
+  ASSERT_EQ(a.get(), 5);
+  ASSERT_EQ(s.get(), "");
+  ASSERT_EQ(d_context->getTrail().size(), 0);
+}
+
+TEST_F(TestContextBlackUndoTrail, trail_cdlist)
+{
+  TrailCDList<std::string> list(d_context.get());
+  list.push_back("a");
+  d_context->push();
+  list.push_back("b");
+  list.emplace_back(2, 'c');
+  ASSERT_EQ(list.size(), 3);
+  ASSERT_EQ(list.back(), "cc");
+  d_context->push();
+  d_context->push();
+  list.push_back("d");
+  d_context->popto(1);
+  ASSERT_EQ(list.size(), 3);
+  d_context->pop();
+  ASSERT_EQ(list.size(), 1);
+  ASSERT_EQ(list[0], "a");
+}
+
+TEST_F(TestContextBlackUndoTrail, trail_cdhashmap)
+{
+  TrailCDHashMap<int, std::string> map(d_context.get());
+  ASSERT_TRUE(map.insert(1, "one"));
+  d_context->push();
+  ASSERT_TRUE(map.insert(2, "two"));
+  ASSERT_FALSE(map.insert(1, "uno"));
+  d_context->push();
+  ASSERT_FALSE(map.insert(1, "eins"));
+  ASSERT_TRUE(map.insert(3, "three"));
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map[1], "eins");
+  d_context->pop();
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map[1], "uno");
+  ASSERT_FALSE(map.contains(3));
+  d_context->pop();
+  ASSERT_EQ(map.size(), 1);
+  ASSERT_EQ(map[1], "one");
+  ASSERT_EQ(map.find(2), map.end());
+}
+
+TEST_F(TestContextBlackUndoTrail, trail_cdhashset)
+{
+  TrailCDHashSet<int> set(d_context.get());
+  set.insert(1);
+  d_context->push();
+  ASSERT_TRUE(set.insert(2));
+  ASSERT_FALSE(set.insert(1));
+  ASSERT_FALSE(set.insert(2));
+  ASSERT_EQ(set.size(), 2);
+  d_context->pop();
+  ASSERT_EQ(set.size(), 1);
+  ASSERT_TRUE(set.contains(1));
+  ASSERT_FALSE(set.contains(2));
+}
+
+TEST_F(TestContextBlackUndoTrail, destroyed_objects)
+{
+  TrailCDO<int> a(d_context.get(), 0);
+  d_context->push();
+  {
+    // the records of b stay on the trail until the pop
+    TrailCDHashMap<int, std::string> b(d_context.get());
+    b.insert(1, "one");
+  }
+  // c reuses the object table entry of b
+  TrailCDHashSet<int> c(d_context.get());
+  a = 1;
+  d_context->push();
+  c.insert(1);
+  d_context->pop();
+  ASSERT_FALSE(c.contains(1));
+  d_context->pop();
+  ASSERT_EQ(a.get(), 0);
+}
+
+TEST_F(TestContextBlackUndoTrail, many_records)
+{
+  // spans several chunks of the trail
+  TrailCDHashMap<int, std::vector<int>> map(d_context.get());
+  std::vector<int> large(1000, 1);
+  for (int level = 0; level < 4; ++level)
+  {
+    d_context->push();
+    for (int i = 0; i < 20000; ++i)
+    {
+      map.insert(i % 100, std::vector<int>(1, level));
+    }
+    map.insert(-1, large);
+  }
+  ASSERT_EQ(map[0][0], 3);
+  d_context->pop();
+  ASSERT_EQ(map[0][0], 2);
+  ASSERT_EQ(map[-1].size(), 1000);
+  d_context->popto(0);
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(d_context->getTrail().size(), 0);
+}
+
+TEST_F(TestContextBlackUndoTrail, push_pop_workload)
+{
+  {
+    CDHashMap<uint32_t, uint32_t> map(d_context.get());
+    CDO<uint32_t> obj(d_context.get(), 0);
+    CDList<uint32_t> list(d_context.get());
+    pushPopWorkload(map, obj, list);
+  }
+  {
+    TrailCDHashMap<uint32_t, uint32_t> map(d_context.get());
+    TrailCDO<uint32_t> obj(d_context.get(), 0);
+    TrailCDList<uint32_t> list(d_context.get());
+    pushPopWorkload(map, obj, list);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -49,6 +49,19 @@ class TestNodeBlackAttribute : public TestNode
   {
   };
   using BoolAttribute = expr::Attribute<BoolAttributeId, bool>;
+  struct DenseIntAttributeId
+  {
+  };
+  using DenseIntAttribute =
+      expr::Attribute<DenseIntAttributeId, uint64_t, true>;
+  struct DenseNodeAttributeId
+  {
+  };
+  using DenseNodeAttribute = expr::Attribute<DenseNodeAttributeId, Node, true>;
+  struct DenseBoolAttributeId
+  {
+  };
+  using DenseBoolAttribute = expr::Attribute<DenseBoolAttributeId, bool, true>;
 };
 
 TEST_F(TestNodeBlackAttribute, ints)
@@ -123,5 +136,44 @@ TEST_F(TestNodeBlackAttribute, bools)
   delete node;
 }
 
+TEST_F(TestNodeBlackAttribute, dense)
+{
+  TypeNode booleanType = d_nodeManager->booleanType();
+  Node* node = new Node(d_skolemManager->mkDummySkolem("b", booleanType));
+  Node other = d_skolemManager->mkDummySkolem("b", booleanType);
+  Node val = d_skolemManager->mkDummySkolem("b", booleanType);
+
+  DenseIntAttribute iattr;
+  uint64_t idata = 0;
+  ASSERT_FALSE(node->hasAttribute(iattr));
+  ASSERT_FALSE(node->getAttribute(iattr, idata));
+  node->setAttribute(iattr, 63489);
+  ASSERT_TRUE(node->getAttribute(iattr, idata));
+  ASSERT_EQ(idata, 63489u);
+  ASSERT_FALSE(other.hasAttribute(iattr));
+
+  DenseNodeAttribute nattr;
+  ASSERT_TRUE(node->getAttribute(nattr).isNull());
+  node->setAttribute(nattr, val);
+  ASSERT_TRUE(node->hasAttribute(nattr));
+  ASSERT_EQ(node->getAttribute(nattr), val);
+  ASSERT_FALSE(other.hasAttribute(nattr));
+
+  DenseBoolAttribute battr;
+  bool bdata = true;
+  ASSERT_TRUE(node->getAttribute(battr, bdata));
+  ASSERT_FALSE(bdata);
+  node->setAttribute(battr, true);
+  ASSERT_TRUE(node->getAttribute(battr));
+  ASSERT_FALSE(other.getAttribute(battr));
+  node->setAttribute(battr, false);
+  ASSERT_FALSE(node->getAttribute(battr));
+
+  // deleting the node drops its dense attributes and releases val
+  delete node;
+  d_nodeManager->reclaimZombiesUntil(0);
+  ASSERT_FALSE(other.hasAttribute(nattr));
+}
+
 }  // namespace test
 }  // namespace cvc5
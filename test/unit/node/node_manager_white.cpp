@@ -16,6 +16,9 @@
 #include <string>
 
 #include "expr/node_manager.h"
+#include "options/expr_options.h"
+#include "options/options.h"
+#include "smt/smt_engine.h"
 #include "test_node.h"
 #include "util/integer.h"
 #include "util/rational.h"
@@ -79,5 +82,60 @@ TEST_F(TestNodeWhiteNodeManager, topological_sort)
     ASSERT_EQ(NodeManager::TopologicalSort(roots), result);
   }
 }
+
+TEST_F(TestNodeWhiteNodeManager, incremental_zombie_collection)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  Node x = d_skolemManager->mkDummySkolem("x", boolType);
+  std::vector<Node> ys;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    ys.push_back(d_skolemManager->mkDummySkolem("y", boolType));
+  }
+  d_nodeManager->reclaimZombies();
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+
+  // zombify 200 nodes, oldest first
+  std::vector<uint64_t> ids;
+  for (const Node& y : ys)
+  {
+    ids.push_back(d_nodeManager->mkNode(kind::AND, x, y).getId());
+  }
+  ASSERT_EQ(d_nodeManager->d_zombies.size(), 200u);
+  ASSERT_EQ(d_nodeManager->d_zombieQueue.size(), 200u);
+
+  // an incremental collection keeps the 50 youngest zombies
+  d_nodeManager->setZombieCollectionPolicy(100, 0);
+  d_nodeManager->reclaimZombies(true);
+  ASSERT_EQ(d_nodeManager->d_zombies.size(), 50u);
+  ASSERT_EQ(d_nodeManager->d_zombieQueue.front()->getId(), ids[150]);
+
+  // resurrect the oldest remaining zombie, it survives a full collection
+  Node n = d_nodeManager->mkNode(kind::AND, x, ys[150]);
+  ASSERT_EQ(n.getId(), ids[150]);
+  d_nodeManager->reclaimZombies();
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+  ASSERT_TRUE(d_nodeManager->d_zombieQueue.empty());
+  ASSERT_EQ(n.getNumChildren(), 2u);
+  ASSERT_EQ(n[1], ys[150]);
+}
+
+TEST_F(TestNodeWhiteNodeManager, zombie_policy_of_subsolver)
+{
+  Options opts;
+  opts.expr.gcZombieThreshold = 100;
+  SmtEngine smt(d_nodeManager.get(), &opts);
+  smt.finishInit();
+  ASSERT_EQ(d_nodeManager->d_zombieThreshold, 100u);
+
+  // an internal subsolver shares the node manager, but not its policy
+  Options subOpts;
+  subOpts.copyValues(opts);
+  subOpts.expr.gcZombieThreshold = 10;
+  SmtEngine sub(d_nodeManager.get(), &subOpts);
+  sub.setIsInternalSubsolver();
+  sub.finishInit();
+  ASSERT_EQ(d_nodeManager->d_zombieThreshold, 100u);
+}
 }  // namespace test
 }  // namespace cvc5
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::expr::NodeSerializer and NodeDeserializer.
+ */
+
+#include <sstream>
+
+#include "base/exception.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/node_serializer.h"
+#include "test_node.h"
+#include "util/bitvector.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+using namespace expr;
+using namespace kind;
+
+namespace test {
+
+class TestNodeBlackNodeSerializer : public TestNode
+{
+};
+
+TEST_F(TestNodeBlackNodeSerializer, constants)
+{
+  Node bv =
+      d_nodeManager->mkConst(BitVector(70, Integer("123456789abcdef01", 16)));
+  Node ext = d_nodeManager->mkNode(
+      d_nodeManager->mkConst(BitVectorExtract(65, 2)), bv);
+  Node str = d_nodeManager->mkConst(String("a\\u{10}b", true));
+  Node num = d_nodeManager->mkConst(Rational(-7, 3));
+  Node big = d_nodeManager->mkConst(Rational("123456789012345678901234567890"));
+  std::vector<Node> nodes = {
+      d_nodeManager->mkNode(EQUAL, ext, ext),
+      d_nodeManager->mkNode(STRING_LENGTH, str),
+      d_nodeManager->mkNode(PLUS, num, big, num),
+      d_nodeManager->mkConst(true),
+      ext};
+
+  std::stringstream ss;
+  NodeSerializer ns(ss);
+  ns.writeNodes(nodes);
+  ns.writeTypes({d_nodeManager->mkFunctionType(*d_intTypeNode, *d_bvTypeNode)});
+
+  NodeDeserializer nd(d_nodeManager.get(), ss);
+  // constants are hash-consed, so we get the same nodes back
+  ASSERT_EQ(nd.readNodes(), nodes);
+  std::vector<TypeNode> types = nd.readTypes();
+  ASSERT_EQ(types.size(), 1);
+  ASSERT_EQ(types[0],
+            d_nodeManager->mkFunctionType(*d_intTypeNode, *d_bvTypeNode));
+}
+
+TEST_F(TestNodeBlackNodeSerializer, variables)
+{
+  TypeNode u = d_nodeManager->mkSort("U");
+  Node x = d_nodeManager->mkBoundVar("x", u);
+  Node y = d_nodeManager->mkBoundVar("y", *d_intTypeNode);
+  Node body = d_nodeManager->mkNode(
+      AND,
+      d_nodeManager->mkNode(EQUAL, x, x),
+      d_nodeManager->mkNode(GT, y, d_nodeManager->mkConst(Rational(0))));
+  Node q = d_nodeManager->mkNode(
+      FORALL, d_nodeManager->mkNode(BOUND_VAR_LIST, x, y), body);
+
+  std::stringstream ss;
+  NodeSerializer ns(ss);
+  ns.writeTypes({u});
+  ns.writeNodes({x});
+  // shares x and U with the previous groups
+  ns.writeNodes({q, body});
+  ns.writeString("done");
+  std::string data = ss.str();
+
+  NodeDeserializer nd(d_nodeManager.get(), ss);
+  std::vector<TypeNode> types = nd.readTypes();
+  ASSERT_EQ(types.size(), 1);
+  ASSERT_TRUE(types[0].isSort());
+  ASSERT_EQ(types[0].getName(), "U");
+  ASSERT_NE(types[0], u);
+  std::vector<Node> vars = nd.readNodes();
+  ASSERT_EQ(vars.size(), 1);
+  ASSERT_EQ(vars[0].getKind(), BOUND_VARIABLE);
+  ASSERT_EQ(vars[0].getAttribute(VarNameAttr()), "x");
+  ASSERT_EQ(vars[0].getType(), types[0]);
+  std::vector<Node> nodes = nd.readNodes();
+  ASSERT_EQ(nodes.size(), 2);
+  ASSERT_EQ(nodes[0].getKind(), FORALL);
+  ASSERT_EQ(nodes[0][0][0], vars[0]);
+  ASSERT_EQ(nodes[0][1], nodes[1]);
+  ASSERT_EQ(nodes[1].toString(), body.toString());
+  ASSERT_EQ(nd.readString(), "done");
+
+  // a truncated stream is rejected
+  std::stringstream truncated(data.substr(0, data.size() - 6));
+  NodeDeserializer nd2(d_nodeManager.get(), truncated);
+  nd2.readTypes();
+  nd2.readNodes();
+  ASSERT_THROW(nd2.readNodes(), Exception);
+}
+
+TEST_F(TestNodeBlackNodeSerializer, unsupported)
+{
+  std::stringstream ss;
+  NodeSerializer ns(ss);
+  Node sk = d_skolemManager->mkDummySkolem("sk", *d_intTypeNode);
+  ASSERT_THROW(ns.writeNodes({sk}), Exception);
+
+  std::stringstream garbage("not a binary file");
+  ASSERT_THROW(NodeDeserializer(d_nodeManager.get(), garbage), Exception);
+}
+
+TEST_F(TestNodeBlackNodeSerializer, corrupt_length)
+{
+  std::stringstream ss;
+  NodeSerializer ns(ss);
+  // a string of length 2^62 - 1 with only three characters
+  ss << std::string(8, '\xff') << '\x3f' << "abc";
+  NodeDeserializer nd(d_nodeManager.get(), ss);
+  ASSERT_THROW(nd.readString(), Exception);
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::expr::NodeValueAllocator.
+ */
+
+#include <set>
+#include <vector>
+
+#include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace expr;
+
+namespace test {
+
+class TestNodeBlackNodeValueAllocator : public TestInternal
+{
+};
+
+TEST_F(TestNodeBlackNodeValueAllocator, size_classes)
+{
+  NodeValueAllocator alloc;
+  std::vector<std::pair<NodeValue*, uint32_t>> nvs;
+  std::set<NodeValue*> distinct;
+  for (uint32_t n = 0; n <= NodeValueAllocator::MAX_SLAB_CHILDREN + 2; ++n)
+  {
+    for (size_t i = 0; i < 100; ++i)
+    {
+      NodeValue* nv = alloc.allocate(n);
+      nvs.emplace_back(nv, n);
+      distinct.insert(nv);
+    }
+  }
+  ASSERT_EQ(distinct.size(), nvs.size());
+  const NodeValueAllocator::Statistics& stats = alloc.getStatistics();
+  ASSERT_EQ(stats.d_largeAllocations, 200u);
+  ASSERT_EQ(stats.d_slabAllocations, nvs.size() - 200);
+  ASSERT_EQ(stats.d_slabsAcquired, NodeValueAllocator::MAX_SLAB_CHILDREN + 1);
+
+  for (const auto& p : nvs)
+  {
+    alloc.deallocate(p.first, p.second);
+  }
+  // freed blocks are reused, in the same size class only
+  NodeValue* nv = alloc.allocate(3);
+  ASSERT_EQ(stats.d_recycled, 1u);
+  alloc.deallocate(nv, 3);
+}
+
+TEST_F(TestNodeBlackNodeValueAllocator, release)
+{
+  NodeValueAllocator alloc;
+  std::vector<NodeValue*> nvs;
+  const NodeValueAllocator::Statistics& stats = alloc.getStatistics();
+  while (stats.d_slabsAcquired < 40)
+  {
+    nvs.push_back(alloc.allocate(1));
+  }
+  // keep one node value alive in the first slab
+  for (size_t i = 1; i < nvs.size(); ++i)
+  {
+    alloc.deallocate(nvs[i], 1);
+  }
+  alloc.releaseEmptySlabs();
+  // the first slab is still used, the last one is used for allocation
+  ASSERT_EQ(stats.d_slabsReleased, 38u);
+  // the remaining free blocks can still be used
+  std::set<NodeValue*> reused;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    reused.insert(alloc.allocate(1));
+  }
+  ASSERT_EQ(reused.size(), 100u);
+  ASSERT_EQ(reused.count(nvs[0]), 0u);
+}
+
+}  // namespace test
+}  // namespace cvc5
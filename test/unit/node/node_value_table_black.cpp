@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::expr::NodeValueTable.
+ */
+
+#include <set>
+
+#include "expr/node_value_table.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace expr;
+
+namespace test {
+
+namespace {
+/**
+ * The tests only use the addresses of node values: we use fake pointers and
+ * a hash function with many collisions.
+ */
+NodeValue* fake(uintptr_t i) { return reinterpret_cast<NodeValue*>(i * 8); }
+struct CollidingHash
+{
+  size_t operator()(const NodeValue* nv) const
+  {
+    return reinterpret_cast<uintptr_t>(nv) / 8 % 97;
+  }
+};
+struct PointerEq
+{
+  bool operator()(const NodeValue* a, const NodeValue* b) const
+  {
+    return a == b;
+  }
+};
+using Table = NodeValueTable<CollidingHash, PointerEq>;
+}  // namespace
+
+class TestNodeBlackNodeValueTable : public TestInternal
+{
+};
+
+TEST_F(TestNodeBlackNodeValueTable, insert_find_erase)
+{
+  Table t;
+  ASSERT_TRUE(t.empty());
+  ASSERT_EQ(t.find(fake(1)), nullptr);
+  ASSERT_FALSE(t.erase(fake(1)));
+  for (uintptr_t i = 1; i <= 1000; ++i)
+  {
+    ASSERT_TRUE(t.insert(fake(i)));
+  }
+  ASSERT_FALSE(t.insert(fake(500)));
+  ASSERT_EQ(t.size(), 1000u);
+  for (uintptr_t i = 1; i <= 1000; ++i)
+  {
+    ASSERT_EQ(t.find(fake(i)), fake(i));
+  }
+  ASSERT_EQ(t.find(fake(1001)), nullptr);
+
+  // erase every other entry, the rest must remain reachable
+  for (uintptr_t i = 1; i <= 1000; i += 2)
+  {
+    ASSERT_TRUE(t.erase(fake(i)));
+  }
+  ASSERT_EQ(t.size(), 500u);
+  for (uintptr_t i = 1; i <= 1000; ++i)
+  {
+    ASSERT_EQ(t.find(fake(i)), i % 2 == 0 ? fake(i) : nullptr);
+  }
+}
+
+TEST_F(TestNodeBlackNodeValueTable, iterate_clear)
+{
+  Table t;
+  std::set<NodeValue*> expected;
+  for (uintptr_t i = 1; i <= 300; ++i)
+  {
+    t.insert(fake(i));
+    expected.insert(fake(i));
+  }
+  std::set<NodeValue*> found;
+  for (NodeValue* nv : t)
+  {
+    found.insert(nv);
+  }
+  ASSERT_EQ(found, expected);
+  t.clear();
+  ASSERT_TRUE(t.empty());
+  ASSERT_EQ(t.begin(), t.end());
+  ASSERT_EQ(t.find(fake(1)), nullptr);
+  ASSERT_TRUE(t.insert(fake(1)));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -90,7 +90,8 @@ class TestParserBlackParser : public TestInternal
                                        .withOptions(d_options)
                                        .withInputLanguage(d_lang)
                                        .build());
-    parser->setInput(Input::newStringInput(d_lang, goodInput, "test"));
+    parser->setInput(
+        Input::newStringInput(d_lang, goodInput, "test", d_fastParser));
     ASSERT_FALSE(parser->done());
     Command* cmd;
     while ((cmd = parser->nextCommand()) != NULL)
@@ -110,7 +111,8 @@ class TestParserBlackParser : public TestInternal
                                        .withInputLanguage(d_lang)
                                        .withStrictMode(strictMode)
                                        .build());
-    parser->setInput(Input::newStringInput(d_lang, badInput, "test"));
+    parser->setInput(
+        Input::newStringInput(d_lang, badInput, "test", d_fastParser));
     ASSERT_THROW(
         {
           Command* cmd;
@@ -131,7 +133,8 @@ class TestParserBlackParser : public TestInternal
                                        .withOptions(d_options)
                                        .withInputLanguage(d_lang)
                                        .build());
-    parser->setInput(Input::newStringInput(d_lang, goodExpr, "test"));
+    parser->setInput(
+        Input::newStringInput(d_lang, goodExpr, "test", d_fastParser));
     if (d_lang == LANG_SMTLIB_V2)
     {
       /* Use QF_LIA to make multiplication ("*") available */
@@ -166,7 +169,8 @@ class TestParserBlackParser : public TestInternal
                                        .withInputLanguage(d_lang)
                                        .withStrictMode(strictMode)
                                        .build());
-    parser->setInput(Input::newStringInput(d_lang, badExpr, "test"));
+    parser->setInput(
+        Input::newStringInput(d_lang, badExpr, "test", d_fastParser));
     setupContext(*parser);
     ASSERT_FALSE(parser->done());
     ASSERT_THROW(api::Term e = parser->nextExpression();
@@ -179,6 +183,8 @@ class TestParserBlackParser : public TestInternal
 
   Options d_options;
   InputLanguage d_lang;
+  /** Whether to use the fast SMT-LIB parser */
+  bool d_fastParser = false;
   std::unique_ptr<cvc5::api::Solver> d_solver;
   std::unique_ptr<SymbolManager> d_symman;
 };
@@ -384,5 +390,85 @@ TEST_F(TestParserBlackSmt2Parser, bad_exprs)
   tryBadExpr("(* 5 01)", true);  // '01' is not a valid integer constant
 #endif
 }
+
+/* -------------------------------------------------------------------------- */
+
+class TestParserBlackSmt2FastParser : public TestParserBlackParser
+{
+ protected:
+  TestParserBlackSmt2FastParser() : TestParserBlackParser(LANG_SMTLIB_V2)
+  {
+    d_fastParser = true;
+  }
+};
+
+TEST_F(TestParserBlackSmt2FastParser, good_inputs)
+{
+  tryGoodInput("");
+  tryGoodInput("(set-logic QF_UF)");
+  tryGoodInput("(set-info :notes |This is a note, take note!|)");
+  tryGoodInput("(set-info :notes |multi-line\n(note)|)");
+  tryGoodInput("(set-info :notes \"a \"\"quoted\"\" note\")");
+  tryGoodInput("(set-logic QF_UF) (assert false) (check-sat)");
+  tryGoodInput(
+      "(set-logic QF_UF) (declare-fun |a b| () Bool) "
+      "(declare-fun |(b)| () Bool) (assert (=> (and (=> |a b| |(b)|) |a b|) "
+      "|(b)|))");
+  tryGoodInput(
+      "(set-logic QF_BV) (declare-fun x () (_ BitVec 8)) "
+      "(assert (= x (bvadd #b00001111 #xf0)))");
+  tryGoodInput(
+      "(set-logic QF_S) (declare-fun s () String) "
+      "(assert (= s (str.++ \"a\"\"b\" \"\")))");
+  tryGoodInput(";; nothing but a comment");
+  tryGoodInput("; a comment\n(check-sat ; goodbye\n)");
+  tryGoodInput("(check-sat) ; a comment at the end of the input");
+}
+
+TEST_F(TestParserBlackSmt2FastParser, bad_inputs)
+{
+  // competition builds don't do any checking
+#ifndef CVC5_COMPETITION_MODE
+  tryBadInput("(assert)");
+  tryBadInput("(set-info :notes |Symbols can't contain the | character|)");
+  // unterminated quoted symbol
+  tryBadInput("(set-info :notes |an unterminated note)");
+  // unterminated string literal
+  tryBadInput("(set-info :notes \"an unterminated note)");
+  tryBadInput("(set-info :notes \"an unterminated \"\"note)");
+  // unterminated command
+  tryBadInput("(set-logic QF_UF) (assert true ; )");
+  tryBadInput("(declare-sort a 0) (declare-sort a 0)");
+  tryBadInput("(set-logic QF_UF) (declare-fun p Bool)");
+  tryBadInput("(assert true)", true);
+#endif
+}
+
+TEST_F(TestParserBlackSmt2FastParser, good_exprs)
+{
+  tryGoodExpr("(and a b)");
+  tryGoodExpr("(or (and |a| b) c)");
+  tryGoodExpr("(ite a (f x) y)");
+  tryGoodExpr("1.5");
+  tryGoodExpr("#xfab09c7");
+  tryGoodExpr("#b0001011");
+  tryGoodExpr("(* 5 1)");
+}
+
+TEST_F(TestParserBlackSmt2FastParser, bad_exprs)
+{
+// competition builds don't do any checking
+#ifndef CVC5_COMPETITION_MODE
+  tryBadExpr("(and a b");
+  tryBadExpr("(a b)");
+  tryBadExpr(".5");
+  tryBadExpr("#x");
+  tryBadExpr("#b");
+  tryBadExpr("#xg0f");
+  tryBadExpr("#b9");
+  tryBadExpr("|a");
+  tryBadExpr("\"a");
+#endif
+}
 }  // namespace test
 }  // namespace cvc5
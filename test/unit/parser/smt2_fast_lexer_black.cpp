@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::parser::Smt2FastLexer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/smt2/smt2_fast_lexer.h"
+#include "test.h"
+
+namespace cvc5 {
+
+using namespace parser;
+
+namespace test {
+
+class TestParserBlackSmt2FastLexer : public TestInternal
+{
+ protected:
+  using Tokens = std::vector<std::pair<Smt2Token, std::string>>;
+
+  /** Lex all tokens of the lexer, up to and excluding the end of input. */
+  static Tokens lexAll(Smt2FastLexer& lex)
+  {
+    Tokens tokens;
+    for (Smt2Token t = lex.peekToken(); t != Smt2Token::EOF_TOK;
+         t = lex.peekToken())
+    {
+      tokens.emplace_back(t, std::string(lex.tokenText()));
+      lex.consumeToken();
+      if (t == Smt2Token::UNTERMINATED || t == Smt2Token::INVALID)
+      {
+        break;
+      }
+    }
+    return tokens;
+  }
+
+  /** Lex all tokens of the given string. */
+  static Tokens lexString(const std::string& input,
+                          bool escapeDupDblQuote = true)
+  {
+    Smt2FastLexer lex;
+    lex.setEscapeDupDblQuote(escapeDupDblQuote);
+    lex.initString(input);
+    return lexAll(lex);
+  }
+};
+
+TEST_F(TestParserBlackSmt2FastLexer, simple_tokens)
+{
+  Tokens expected = {{Smt2Token::LPAREN_TOK, "("},
+                     {Smt2Token::SYMBOL, "assert"},
+                     {Smt2Token::LPAREN_TOK, "("},
+                     {Smt2Token::SYMBOL, "<="},
+                     {Smt2Token::NUMERAL, "12"},
+                     {Smt2Token::DECIMAL, "3.25"},
+                     {Smt2Token::SYMBOL, "x!1"},
+                     {Smt2Token::RPAREN_TOK, ")"},
+                     {Smt2Token::KEYWORD, ":named"},
+                     {Smt2Token::SYMBOL, "a"},
+                     {Smt2Token::RPAREN_TOK, ")"}};
+  ASSERT_EQ(lexString("(assert (<= 12 3.25 x!1) :named a)"), expected);
+  // a numeral followed by a dot is not a decimal
+  expected = {{Smt2Token::NUMERAL, "1"}, {Smt2Token::SYMBOL, "."}};
+  ASSERT_EQ(lexString("1."), expected);
+  ASSERT_EQ(lexString(":")[0].first, Smt2Token::INVALID);
+  ASSERT_EQ(lexString("[")[0].first, Smt2Token::INVALID);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, quoted_symbols)
+{
+  Tokens expected = {{Smt2Token::QUOTED_SYMBOL, "a b"},
+                     {Smt2Token::QUOTED_SYMBOL, ""},
+                     {Smt2Token::QUOTED_SYMBOL, "x\n(y);\"z\""},
+                     {Smt2Token::SYMBOL, "c"}};
+  ASSERT_EQ(lexString("|a b| || |x\n(y);\"z\"| c"), expected);
+  // a bar ends the quoted symbol
+  expected = {{Smt2Token::QUOTED_SYMBOL, "a"},
+              {Smt2Token::SYMBOL, "b"},
+              {Smt2Token::UNTERMINATED, "|"}};
+  ASSERT_EQ(lexString("|a|b|"), expected);
+  // backslashes are not allowed in quoted symbols
+  ASSERT_EQ(lexString("|a\\b|")[0].first, Smt2Token::UNTERMINATED);
+  ASSERT_EQ(lexString("(|abc")[1].first, Smt2Token::UNTERMINATED);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, strings)
+{
+  Tokens expected = {{Smt2Token::STRING, "a\"\"b"},
+                     {Smt2Token::STRING, ""},
+                     {Smt2Token::STRING, "\"\"\"\""},
+                     {Smt2Token::STRING, "a;b|c\\"}};
+  ASSERT_EQ(lexString("\"a\"\"b\" \"\" \"\"\"\"\"\" \"a;b|c\\\""), expected);
+  // with backslash escapes (SMT-LIB 2.0), "" are two string literals
+  expected = {{Smt2Token::STRING, "a\\\"b"},
+              {Smt2Token::STRING, ""},
+              {Smt2Token::STRING, ""}};
+  ASSERT_EQ(lexString("\"a\\\"b\" \"\"\"\"", false), expected);
+  ASSERT_EQ(lexString("\"abc")[0].first, Smt2Token::UNTERMINATED);
+  ASSERT_EQ(lexString("\"abc\"\"")[0].first, Smt2Token::UNTERMINATED);
+  ASSERT_EQ(lexString("\"abc\\", false)[0].first, Smt2Token::UNTERMINATED);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, bit_vector_literals)
+{
+  Tokens expected = {{Smt2Token::BINARY, "#b0101"},
+                     {Smt2Token::HEX, "#xfA09"},
+                     {Smt2Token::RPAREN_TOK, ")"}};
+  ASSERT_EQ(lexString("#b0101 #xfA09)"), expected);
+  // literals end at the first character that is not a digit
+  expected = {{Smt2Token::BINARY, "#b01"}, {Smt2Token::NUMERAL, "2"}};
+  ASSERT_EQ(lexString("#b012"), expected);
+  expected = {{Smt2Token::HEX, "#xf"}, {Smt2Token::SYMBOL, "g"}};
+  ASSERT_EQ(lexString("#xfg"), expected);
+  ASSERT_EQ(lexString("#b")[0].first, Smt2Token::INVALID);
+  ASSERT_EQ(lexString("#x")[0].first, Smt2Token::INVALID);
+  ASSERT_EQ(lexString("#b9")[0].first, Smt2Token::INVALID);
+  ASSERT_EQ(lexString("#o7")[0].first, Smt2Token::INVALID);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, comments)
+{
+  ASSERT_TRUE(lexString("").empty());
+  ASSERT_TRUE(lexString("; only a comment").empty());
+  ASSERT_TRUE(lexString(" \t\r\n;\n;").empty());
+  Tokens expected = {{Smt2Token::LPAREN_TOK, "("},
+                     {Smt2Token::SYMBOL, "check-sat"},
+                     {Smt2Token::RPAREN_TOK, ")"}};
+  ASSERT_EQ(lexString("; a comment\n(check-sat ; (bye\n) ; at the end"),
+            expected);
+  ASSERT_EQ(lexString("(check-sat);"), expected);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, positions)
+{
+  Smt2FastLexer lex;
+  lex.initString("(assert\n  |a\nb| c)");
+  ASSERT_EQ(lex.peekToken(), Smt2Token::LPAREN_TOK);
+  lex.consumeToken();
+  ASSERT_EQ(lex.peekToken(), Smt2Token::SYMBOL);
+  ASSERT_EQ(lex.getLine(), 1u);
+  ASSERT_EQ(lex.getColumn(), 1u);
+  lex.consumeToken();
+  ASSERT_EQ(lex.peekToken(), Smt2Token::QUOTED_SYMBOL);
+  ASSERT_EQ(lex.getLine(), 2u);
+  ASSERT_EQ(lex.getColumn(), 2u);
+  lex.consumeToken();
+  ASSERT_EQ(lex.peekToken(), Smt2Token::SYMBOL);
+  ASSERT_EQ(lex.getLine(), 3u);
+  ASSERT_EQ(lex.getColumn(), 3u);
+  ASSERT_EQ(lex.getLineText(), "b| c)");
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, stream_input)
+{
+  // tokens that span the chunks in which a stream is read
+  std::string big(200000, 'a');
+  std::stringstream input;
+  input << "(" << big << "\n\"" << big << "\"\"\" |" << big << "|\n\n)";
+  Smt2FastLexer lex;
+  lex.initStream(input);
+  Tokens expected = {{Smt2Token::LPAREN_TOK, "("},
+                     {Smt2Token::SYMBOL, big},
+                     {Smt2Token::STRING, big + "\"\""},
+                     {Smt2Token::QUOTED_SYMBOL, big},
+                     {Smt2Token::RPAREN_TOK, ")"}};
+  ASSERT_EQ(lexAll(lex), expected);
+
+  std::stringstream unterminated("(\"abc\n\n");
+  Smt2FastLexer lex2;
+  lex2.initStream(unterminated);
+  expected = {{Smt2Token::LPAREN_TOK, "("},
+              {Smt2Token::UNTERMINATED, "\"abc\n\n"}};
+  ASSERT_EQ(lexAll(lex2), expected);
+}
+
+TEST_F(TestParserBlackSmt2FastLexer, file_input)
+{
+  char filename[] = "/tmp/testinput.XXXXXX";
+  int32_t fd = mkstemp(filename);
+  ASSERT_NE(fd, -1);
+  close(fd);
+  {
+    std::ofstream out(filename);
+    out << "(set-info :source |a\nb|) ; a comment at the end of the file";
+  }
+  Tokens expected = {{Smt2Token::LPAREN_TOK, "("},
+                     {Smt2Token::SYMBOL, "set-info"},
+                     {Smt2Token::KEYWORD, ":source"},
+                     {Smt2Token::QUOTED_SYMBOL, "a\nb"},
+                     {Smt2Token::RPAREN_TOK, ")"}};
+  for (bool useMmap : {true, false})
+  {
+    Smt2FastLexer lex;
+    ASSERT_TRUE(lex.initFile(filename, useMmap));
+    ASSERT_EQ(lexAll(lex), expected);
+  }
+  remove(filename);
+  Smt2FastLexer lex;
+  ASSERT_FALSE(lex.initFile(filename, false));
+}
+
+}  // namespace test
+}  // namespace cvc5
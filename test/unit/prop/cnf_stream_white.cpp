@@ -40,7 +40,9 @@ namespace test {
 class FakeSatSolver : public SatSolver
 {
  public:
-  FakeSatSolver() : d_nextVar(0), d_addClauseCalled(false) {}
+  FakeSatSolver() : d_nextVar(0), d_addClauseCalled(false), d_numClauses(0)
+  {
+  }
 
   SatVariable newVar(bool theoryAtom, bool preRegister, bool canErase) override
   {
@@ -54,6 +56,7 @@ class FakeSatSolver : public SatSolver
   ClauseId addClause(SatClause& c, bool lemma) override
   {
     d_addClauseCalled = true;
+    ++d_numClauses;
     return ClauseIdUndef;
   }
 
@@ -69,6 +72,10 @@ class FakeSatSolver : public SatSolver
 
   unsigned int addClauseCalled() { return d_addClauseCalled; }
 
+  size_t numClauses() const { return d_numClauses; }
+
+  size_t numVars() const { return d_nextVar; }
+
   unsigned getAssertionLevel() const override { return 0; }
 
   bool isDecision(Node) const { return false; }
@@ -99,6 +106,7 @@ class FakeSatSolver : public SatSolver
  private:
   SatVariable d_nextVar;
   bool d_addClauseCalled;
+  size_t d_numClauses;
 };
 
 class TestPropWhiteCnfStream : public TestSmt
@@ -119,6 +127,19 @@ class TestPropWhiteCnfStream : public TestSmt
                                   d_smtEngine->getResourceManager()));
   }
 
+  /** Returns a CNF stream that uses the optimized encoding. */
+  std::unique_ptr<CnfStream> mkOptimizedCnfStream()
+  {
+    return std::make_unique<CnfStream>(d_satSolver.get(),
+                                       d_cnfRegistrar.get(),
+                                       d_cnfContext.get(),
+                                       &d_smtEngine->getOutputManager(),
+                                       d_smtEngine->getResourceManager(),
+                                       FormulaLitPolicy::INTERNAL,
+                                       "optimized",
+                                       true);
+  }
+
   void TearDown() override
   {
     d_cnfStream.reset(nullptr);
@@ -269,5 +290,114 @@ TEST_F(TestPropWhiteCnfStream, ensure_literal)
   ASSERT_TRUE(d_satSolver->addClauseCalled());
   ASSERT_TRUE(d_cnfStream->hasLiteral(a_and_b));
 }
+
+TEST_F(TestPropWhiteCnfStream, optimized_structural_hashing)
+{
+  NodeManagerScope nms(d_nodeManager.get());
+  std::unique_ptr<CnfStream> cnf = mkOptimizedCnfStream();
+  Node a = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node b = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node a_and_b = d_nodeManager->mkNode(kind::AND, a, b);
+  Node b_and_a = d_nodeManager->mkNode(kind::AND, b, a);
+  Node na_or_nb = d_nodeManager->mkNode(kind::OR, a.notNode(), b.notNode());
+  Node a_xor_b = d_nodeManager->mkNode(kind::XOR, a, b);
+  Node b_iff_na = d_nodeManager->mkNode(kind::EQUAL, b, a.notNode());
+  cnf->ensureLiteral(a_and_b);
+  size_t clauses = d_satSolver->numClauses();
+  cnf->ensureLiteral(b_and_a);
+  cnf->ensureLiteral(na_or_nb);
+  ASSERT_EQ(cnf->getLiteral(b_and_a), cnf->getLiteral(a_and_b));
+  ASSERT_EQ(cnf->getLiteral(na_or_nb), ~cnf->getLiteral(a_and_b));
+  cnf->ensureLiteral(a_xor_b);
+  cnf->ensureLiteral(b_iff_na);
+  ASSERT_EQ(cnf->getLiteral(b_iff_na), cnf->getLiteral(a_xor_b));
+  // only the XOR gate needed new clauses
+  ASSERT_EQ(d_satSolver->numClauses(), clauses + 4);
+}
+
+TEST_F(TestPropWhiteCnfStream, optimized_polarity)
+{
+  NodeManagerScope nms(d_nodeManager.get());
+  std::unique_ptr<CnfStream> cnf = mkOptimizedCnfStream();
+  Node a = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node b = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node c = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node d = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node a_and_b = d_nodeManager->mkNode(kind::AND, a, b);
+  // (g | c), (~g | a), (~g | b)
+  cnf->convertAndAssert(
+      d_nodeManager->mkNode(kind::OR, a_and_b, c), false, false);
+  ASSERT_EQ(d_satSolver->numClauses(), 3u);
+  // (~g | d), (g | ~a | ~b)
+  cnf->convertAndAssert(
+      d_nodeManager->mkNode(kind::OR, a_and_b.notNode(), d), false, false);
+  ASSERT_EQ(d_satSolver->numClauses(), 5u);
+  // both polarities are defined already
+  cnf->ensureLiteral(a_and_b);
+  ASSERT_EQ(d_satSolver->numClauses(), 5u);
+}
+
+TEST_F(TestPropWhiteCnfStream, optimized_flattening)
+{
+  NodeManagerScope nms(d_nodeManager.get());
+  std::unique_ptr<CnfStream> cnf = mkOptimizedCnfStream();
+  Node a = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node b = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node c = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node d = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node b_and_c = d_nodeManager->mkNode(kind::AND, b, c);
+  Node nested = d_nodeManager->mkNode(kind::AND, a, b_and_c);
+  // (g | d), (~g | a), (~g | b), (~g | c)
+  cnf->convertAndAssert(
+      d_nodeManager->mkNode(kind::OR, d, nested), false, false);
+  ASSERT_EQ(d_satSolver->numClauses(), 4u);
+  ASSERT_TRUE(cnf->hasLiteral(nested));
+  ASSERT_FALSE(cnf->hasLiteral(b_and_c));
+}
+
+TEST_F(TestPropWhiteCnfStream, parallel_matches_sequential)
+{
+  NodeManagerScope nms(d_nodeManager.get());
+  TypeNode boolType = d_nodeManager->booleanType();
+  // a bit-blasted fact (and (= b_i (xor a_i (and c_i d_i))) ...) with enough
+  // gates to use several threads, and some other top-level shapes
+  std::vector<Node> bits;
+  for (size_t i = 0; i < 2048; ++i)
+  {
+    Node a = d_nodeManager->mkVar(boolType);
+    Node b = d_nodeManager->mkVar(boolType);
+    Node c = d_nodeManager->mkVar(boolType);
+    Node d = d_nodeManager->mkVar(boolType);
+    bits.push_back(d_nodeManager->mkNode(
+        kind::EQUAL,
+        b,
+        d_nodeManager->mkNode(
+            kind::XOR, a, d_nodeManager->mkNode(kind::AND, c, d))));
+  }
+  Node p = d_nodeManager->mkVar(boolType);
+  Node q = d_nodeManager->mkVar(boolType);
+  Node r = d_nodeManager->mkVar(boolType);
+  std::vector<Node> assertions = {
+      d_nodeManager->mkNode(kind::AND, bits),
+      d_nodeManager->mkNode(kind::AND, p, q).notNode(),
+      d_nodeManager->mkNode(
+          kind::IMPLIES, p, d_nodeManager->mkNode(kind::OR, q, r)),
+      d_nodeManager->mkNode(kind::ITE, p, q, r)};
+  std::vector<Node> definitions = {d_nodeManager->mkNode(kind::OR, p, r)};
+
+  d_cnfStream->convertInParallel(assertions, definitions, 1);
+  FakeSatSolver parallelSat;
+  CnfStream parallel(&parallelSat,
+                     d_cnfRegistrar.get(),
+                     d_cnfContext.get(),
+                     &d_smtEngine->getOutputManager(),
+                     d_smtEngine->getResourceManager());
+  parallel.convertInParallel(assertions, definitions, 4);
+  ASSERT_EQ(parallelSat.numClauses(), d_satSolver->numClauses());
+  ASSERT_EQ(parallelSat.numVars(), d_satSolver->numVars());
+  // the conjuncts of the top-level fact get no literal of their own
+  ASSERT_FALSE(parallel.hasLiteral(bits[0]));
+  ASSERT_TRUE(parallel.hasLiteral(bits[0][1]));
+}
 }  // namespace test
 }  // namespace cvc5
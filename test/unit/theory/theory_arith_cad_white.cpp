@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 
+#include "smt/smt_engine_scope.h"
 #include "test_smt.h"
 #include "theory/arith/nl/cad/cdcac.h"
 #include "theory/arith/nl/cad/lazard_evaluation.h"
@@ -315,6 +316,71 @@ TEST_F(TestTheoryWhiteArithCAD, test_cdcac_4)
   std::cout << "SAT: " << cac.getModel() << std::endl;
 }
 
+TEST_F(TestTheoryWhiteArithCAD, test_cdcac_incremental)
+{
+  d_smtEngine->setOption("nl-cad-incremental", "true");
+  smt::SmtScope scope(d_smtEngine.get());
+  cad::CDCAC cac(nullptr, nullptr, {});
+  poly::Variable x = cac.getConstraints().varMapper()(make_real_variable("x"));
+  poly::Variable y = cac.getConstraints().varMapper()(make_real_variable("y"));
+
+  auto addUnsat = [&]() {
+    cac.getConstraints().addConstraint(
+        y - pow(-x - 3, 11) + pow(-x - 3, 10) + 1,
+        poly::SignCondition::GT,
+        dummy(1));
+    cac.getConstraints().addConstraint(
+        2 * y - x + 2, poly::SignCondition::LT, dummy(2));
+    cac.getConstraints().addConstraint(
+        2 * y - 1 + x * x, poly::SignCondition::GT, dummy(3));
+    cac.getConstraints().addConstraint(
+        3 * y + x + 2, poly::SignCondition::LT, dummy(4));
+    cac.getConstraints().addConstraint(
+        y * y * y - pow(x - 2, 11) + pow(x - 2, 10) + 1,
+        poly::SignCondition::GT,
+        dummy(5));
+  };
+  std::vector<Node> ref{dummy(1), dummy(2), dummy(3), dummy(4), dummy(5)};
+
+  addUnsat();
+  cac.computeVariableOrdering();
+  auto cover = cac.getUnsatCover();
+  EXPECT_FALSE(cover.empty());
+  EXPECT_EQ(cad::collectConstraints(cover), ref);
+
+  // the learned intervals only depend on their origins
+  cac.reset();
+  addUnsat();
+  cac.getConstraints().addConstraint(
+      y * y + 1, poly::SignCondition::GT, dummy(6));
+  cac.computeVariableOrdering();
+  cover = cac.getUnsatCover();
+  EXPECT_FALSE(cover.empty());
+  EXPECT_EQ(cad::collectConstraints(cover), ref);
+
+  // the last model is reused if it is still a model
+  cac.reset();
+  cac.getConstraints().addConstraint(
+      4 * y - x * x + 4, poly::SignCondition::LT, dummy(7));
+  cac.getConstraints().addConstraint(
+      4 * y - x - 2, poly::SignCondition::GT, dummy(8));
+  cac.computeVariableOrdering();
+  EXPECT_TRUE(cac.getUnsatCover().empty());
+  poly::Value xval = cac.getModel().get(x);
+  poly::Value yval = cac.getModel().get(y);
+  cac.reset();
+  cac.getConstraints().addConstraint(
+      4 * y - x * x + 4, poly::SignCondition::LT, dummy(7));
+  cac.getConstraints().addConstraint(
+      4 * y - x - 2, poly::SignCondition::GT, dummy(8));
+  cac.getConstraints().addConstraint(
+      y * y + 1, poly::SignCondition::GT, dummy(6));
+  cac.computeVariableOrdering();
+  EXPECT_TRUE(cac.getUnsatCover().empty());
+  EXPECT_EQ(cac.getModel().get(x), xval);
+  EXPECT_EQ(cac.getModel().get(y), yval);
+}
+
 void test_delta(const std::vector<Node>& a)
 {
   cad::CDCAC cac(nullptr, nullptr, {});
@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of cvc5::theory::arith::FloatingPointSimplex.
+ */
+
+#include <memory>
+
+#include "context/context.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/arith/approx_simplex.h"
+#include "theory/arith/callbacks.h"
+#include "theory/arith/cut_log.h"
+#include "theory/arith/fp_simplex.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/theory_arith.h"
+#include "theory/rewriter.h"
+#include "theory/theory_engine.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace theory::arith;
+using namespace kind;
+
+namespace test {
+
+class TestTheoryWhiteArithFpSimplex : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    TheoryArith* arith = static_cast<TheoryArith*>(
+        d_smtEngine->getTheoryEngine()->d_theoryTable[THEORY_ARITH]);
+    d_vars.reset(new ArithVariables(&d_context,
+                                    DeltaComputeCallback(*arith->d_internal)));
+    d_stats.reset(new ApproximateStatistics());
+  }
+
+  /** Allocates a fresh real variable. */
+  ArithVar mkVar()
+  {
+    Node x = d_nodeManager->mkVar(d_nodeManager->realType());
+    return d_vars->allocate(x);
+  }
+
+  /** Allocates the auxiliary variable for the sum of coeffs[i] * vars[i]. */
+  ArithVar mkRow(const std::vector<ArithVar>& vars,
+                 const std::vector<int64_t>& coeffs)
+  {
+    std::vector<Node> summands;
+    for (size_t i = 0, n = vars.size(); i < n; ++i)
+    {
+      summands.push_back(d_nodeManager->mkNode(
+          MULT,
+          d_nodeManager->mkConst(Rational(coeffs[i])),
+          d_vars->asNode(vars[i])));
+    }
+    Node sum = Rewriter::rewrite(d_nodeManager->mkNode(PLUS, summands));
+    return d_vars->allocate(sum, true);
+  }
+
+  std::unique_ptr<smt::SmtScope> d_scope;
+  context::Context d_context;
+  std::unique_ptr<ArithVariables> d_vars;
+  TreeLog d_log;
+  std::unique_ptr<ApproximateStatistics> d_stats;
+};
+
+TEST_F(TestTheoryWhiteArithFpSimplex, bound_flip)
+{
+  ArithVar x = mkVar();
+  ArithVar y = mkVar();
+  // s = x + y >= 3/2, with x in [0, 1] and y in [0, 10]
+  ArithVar s = mkRow({x, y}, {1, 1});
+  FloatingPointSimplex fps(*d_vars, d_log, *d_stats);
+  fps.d_lower[x] = 0;
+  fps.d_upper[x] = 1;
+  fps.d_lower[y] = 0;
+  fps.d_upper[y] = 10;
+  fps.d_lower[s] = 1.5;
+
+  // x enters first, but reaches its upper bound before s becomes feasible,
+  // hence its bound is flipped instead of pivoting
+  ASSERT_EQ(fps.solveRelaxation(), LinFeasible);
+  ApproximateSimplex::Solution sol = fps.extractRelaxation();
+  ASSERT_FALSE(sol.newBasis.isMember(x));
+  ASSERT_TRUE(sol.newBasis.isMember(y));
+  ASSERT_FALSE(sol.newBasis.isMember(s));
+  ASSERT_EQ(sol.newValues[x], DeltaRational(1, 0));
+  ASSERT_EQ(sol.newValues[y], DeltaRational(Rational(1, 2), 0));
+  ASSERT_EQ(sol.newValues[s], DeltaRational(Rational(3, 2), 0));
+}
+
+TEST_F(TestTheoryWhiteArithFpSimplex, harris_leaving)
+{
+  ArithVar x = mkVar();
+  ArithVar z = mkVar();
+  // t = x + z >= 5, a = x + 2z <= 2 and b = 2x + 3z <= 4 + 2e-9, with x in
+  // [0, 100] and z fixed to 0, which is infeasible
+  ArithVar t = mkRow({x, z}, {1, 1});
+  ArithVar a = mkRow({x, z}, {1, 2});
+  ArithVar b = mkRow({x, z}, {2, 3});
+  FloatingPointSimplex fps(*d_vars, d_log, *d_stats);
+  fps.d_lower[x] = 0;
+  fps.d_upper[x] = 100;
+  fps.d_lower[z] = 0;
+  fps.d_upper[z] = 0;
+  fps.d_lower[t] = 5;
+  fps.d_upper[a] = 2;
+  fps.d_upper[b] = 4.000000002;
+
+  // a blocks x first, but b blocks within the tolerance and has the larger
+  // coefficient, hence b leaves the basis
+  ASSERT_EQ(fps.solveRelaxation(), LinInfeasible);
+  ApproximateSimplex::Solution sol = fps.extractRelaxation();
+  ASSERT_TRUE(sol.newBasis.isMember(x));
+  ASSERT_TRUE(sol.newBasis.isMember(t));
+  ASSERT_TRUE(sol.newBasis.isMember(a));
+  ASSERT_FALSE(sol.newBasis.isMember(b));
+  ASSERT_FALSE(sol.newBasis.isMember(z));
+  ASSERT_EQ(sol.newValues[x], DeltaRational(2, 0));
+  ASSERT_GT(fps.sumInfeasibilities(false), 2.9);
+}
+
+}  // namespace test
+}  // namespace cvc5
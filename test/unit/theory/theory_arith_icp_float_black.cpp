@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::theory::arith::nl::icp::FloatPropagator.
+ */
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/nl/icp/float_propagator.h"
+
+namespace cvc5 {
+
+using namespace theory::arith::nl::icp;
+
+namespace test {
+
+class TestTheoryBlackArithIcpFloat : public TestInternal
+{
+ protected:
+  const double d_inf = std::numeric_limits<double>::infinity();
+};
+
+TEST_F(TestTheoryBlackArithIcpFloat, square)
+{
+  FloatPropagator fp;
+  size_t x = fp.addVariable(-1, 2);
+  size_t y = fp.addVariable(-d_inf, d_inf);
+  // y = x^2
+  fp.addCandidate(y, true, true, 1, 1);
+  fp.addMonomial(1, 1, {{x, 2}});
+  // x <= y + 3, which does not contract x
+  fp.addCandidate(x, false, true, 1, 1);
+  fp.addMonomial(1, 1, {{y, 1}});
+  fp.addMonomial(3, 3, {});
+
+  std::vector<size_t> contracted = fp.propagate(10);
+  ASSERT_EQ(contracted, std::vector<size_t>{0});
+  ASSERT_FALSE(fp.inConflict());
+  ASSERT_LE(fp.getLower(y), 0);
+  ASSERT_GT(fp.getLower(y), -1e-12);
+  ASSERT_GE(fp.getUpper(y), 4);
+  ASSERT_LT(fp.getUpper(y), 4 + 1e-12);
+  ASSERT_EQ(fp.getLower(x), -1);
+  ASSERT_EQ(fp.getUpper(x), 2);
+}
+
+TEST_F(TestTheoryBlackArithIcpFloat, conflict)
+{
+  FloatPropagator fp;
+  size_t x = fp.addVariable(0, 1);
+  size_t y = fp.addVariable(-d_inf, d_inf);
+  size_t z = fp.addVariable(-d_inf, d_inf);
+  // z >= y^2, no contraction
+  fp.addCandidate(z, true, false, 1, 1);
+  fp.addMonomial(1, 1, {{y, 2}});
+  // x >= 1/2 * (z + 3)
+  fp.addCandidate(x, true, false, 0.5, 0.5);
+  fp.addMonomial(1, 1, {{z, 1}});
+  fp.addMonomial(3, 3, {});
+
+  std::vector<size_t> contracted = fp.propagate(10);
+  ASSERT_TRUE(fp.inConflict());
+  // z is contracted first, which makes the second candidate contract x
+  ASSERT_EQ(contracted, (std::vector<size_t>{0, 1}));
+}
+
+TEST_F(TestTheoryBlackArithIcpFloat, enclosure)
+{
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> coord(-5, 5);
+  for (size_t round = 0; round < 200; ++round)
+  {
+    FloatPropagator fp;
+    std::vector<double> lower, upper;
+    for (size_t v = 0; v < 3; ++v)
+    {
+      double a = coord(rng);
+      double b = coord(rng);
+      lower.push_back(std::min(a, b));
+      upper.push_back(std::max(a, b));
+      fp.addVariable(lower.back(), upper.back());
+    }
+    size_t t = fp.addVariable(-d_inf, d_inf);
+    // t = mult * sum of random monomials over the first three variables
+    double mult = coord(rng);
+    fp.addCandidate(t, true, true, mult, mult);
+    std::vector<std::pair<double, std::vector<FloatPropagator::Factor>>> rhs;
+    for (size_t m = 0, n = 1 + rng() % 4; m < n; ++m)
+    {
+      double coeff = std::round(coord(rng) * 10);
+      std::vector<FloatPropagator::Factor> factors;
+      for (size_t v = 0; v < 3; ++v)
+      {
+        if (rng() % 2)
+        {
+          factors.emplace_back(v, 1 + rng() % 3);
+        }
+      }
+      fp.addMonomial(coeff, coeff, factors);
+      rhs.emplace_back(coeff, factors);
+    }
+    fp.propagate(1);
+
+    for (size_t sample = 0; sample < 50; ++sample)
+    {
+      std::vector<long double> point;
+      for (size_t v = 0; v < 3; ++v)
+      {
+        std::uniform_real_distribution<double> in(lower[v], upper[v]);
+        point.push_back(sample == 0 ? lower[v] : in(rng));
+      }
+      long double value = 0;
+      for (const auto& m : rhs)
+      {
+        long double term = m.first;
+        for (const auto& f : m.second)
+        {
+          term *= std::pow(point[f.first], f.second);
+        }
+        value += term;
+      }
+      value *= mult;
+      ASSERT_LE(fp.getLower(t), value);
+      ASSERT_GE(fp.getUpper(t), value);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::theory::arith::Tableau.
+ */
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/tableau.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory::arith;
+
+namespace test {
+
+class TestTheoryBlackArithTableau : public TestInternal
+{
+ protected:
+  /**
+   * Records a log of a random run in the format of Trace("arith::pivot-log"):
+   * numRows rows over numVars variables, followed by numPivots pivots on
+   * random entries of random rows.
+   */
+  std::string recordRandomRun(uint32_t seed,
+                              size_t numRows,
+                              size_t numVars,
+                              size_t numPivots)
+  {
+    std::mt19937 rng(seed);
+    std::stringstream log;
+    Tableau t;
+    t.increaseSizeTo(numRows + numVars);
+    NoEffectCCCB cb;
+    std::vector<ArithVar> basics;
+    for (size_t r = 0; r < numRows; ++r)
+    {
+      ArithVar basic = numVars + r;
+      std::vector<Rational> coeffs;
+      std::vector<ArithVar> vars;
+      for (ArithVar v = 0; v < numVars; ++v)
+      {
+        if (rng() % numVars < 4)
+        {
+          int c = static_cast<int>(rng() % 5) - 2;
+          vars.push_back(v);
+          coeffs.push_back(Rational(c == 0 ? 3 : c));
+        }
+      }
+      if (vars.empty())
+      {
+        vars.push_back(rng() % numVars);
+        coeffs.push_back(Rational(1));
+      }
+      log << "row " << basic << " " << vars.size();
+      for (size_t i = 0; i < vars.size(); ++i)
+      {
+        log << " " << vars[i] << " " << coeffs[i];
+      }
+      log << std::endl;
+      t.addRow(basic, coeffs, vars);
+      basics.push_back(basic);
+    }
+    for (size_t i = 0; i < numPivots; ++i)
+    {
+      size_t r = rng() % basics.size();
+      ArithVar basic = basics[r];
+      std::vector<ArithVar> candidates;
+      for (Tableau::RowIterator it = t.basicRowIterator(basic); !it.atEnd();
+           ++it)
+      {
+        if ((*it).getColVar() != basic)
+        {
+          candidates.push_back((*it).getColVar());
+        }
+      }
+      ArithVar entering = candidates[rng() % candidates.size()];
+      log << "pivot " << basic << " " << entering << std::endl;
+      t.pivot(basic, entering, cb);
+      basics[r] = entering;
+    }
+    return log.str();
+  }
+
+  /** Replays a pivot log on t, and returns the number of pivots. */
+  size_t replay(Tableau& t, std::istream& log, CoefficientChangeCallback& cb)
+  {
+    size_t pivots = 0;
+    std::string cmd;
+    while (log >> cmd)
+    {
+      if (cmd == "row")
+      {
+        ArithVar basic;
+        size_t n;
+        log >> basic >> n;
+        std::vector<ArithVar> vars(n);
+        std::vector<Rational> coeffs;
+        ArithVar maxVar = basic;
+        for (size_t i = 0; i < n; ++i)
+        {
+          std::string c;
+          log >> vars[i] >> c;
+          coeffs.push_back(Rational(c));
+          maxVar = std::max(maxVar, vars[i]);
+        }
+        t.increaseSizeTo(maxVar + 1);
+        t.addRow(basic, coeffs, vars);
+      }
+      else if (cmd == "pivot")
+      {
+        ArithVar oldBasic, newBasic;
+        log >> oldBasic >> newBasic;
+        t.pivot(oldBasic, newBasic, cb);
+        ++pivots;
+      }
+      else if (cmd == "remove")
+      {
+        ArithVar basic;
+        log >> basic;
+        t.removeBasicRow(basic);
+      }
+      else
+      {
+        ArithVar x, y;
+        std::string c;
+        log >> x >> y >> c;
+        t.increaseSizeTo(std::max(x, y) + 1);
+        if (cmd == "substitute")
+        {
+          t.substitutePlusTimesConstant(x, y, Rational(c), cb);
+        }
+        else
+        {
+          EXPECT_EQ(cmd, "add");
+          t.directlyAddToCoefficient(x, y, Rational(c), cb);
+        }
+      }
+    }
+    return pivots;
+  }
+
+  /** Returns the rows of t in iteration order. */
+  std::vector<std::string> rows(const Tableau& t)
+  {
+    std::vector<std::string> res;
+    for (Tableau::BasicIterator it = t.beginBasic(); it != t.endBasic(); ++it)
+    {
+      std::stringstream ss;
+      ss << *it << ":";
+      for (Tableau::RowIterator e = t.basicRowIterator(*it); !e.atEnd(); ++e)
+      {
+        ss << " " << (*e).getColVar() << "*" << (*e).getCoefficient();
+      }
+      res.push_back(ss.str());
+    }
+    return res;
+  }
+
+  /** Returns the columns of t in iteration order. */
+  std::vector<std::string> columns(const Tableau& t)
+  {
+    std::vector<std::string> res;
+    for (ArithVar v = 0; v < t.getNumColumns(); ++v)
+    {
+      std::stringstream ss;
+      for (Tableau::ColIterator e = t.colIterator(v); !e.atEnd(); ++e)
+      {
+        ss << " " << t.rowIndexToBasic((*e).getRowIndex());
+      }
+      res.push_back(ss.str());
+    }
+    return res;
+  }
+};
+
+TEST_F(TestTheoryBlackArithTableau, compact)
+{
+  std::string log = recordRandomRun(1, 60, 90, 200);
+  Tableau plain;
+  plain.setCompactionEnabled(false);
+  Tableau compacted;
+  std::stringstream in(log);
+  std::stringstream in2(log);
+  NoEffectCCCB cb;
+  replay(plain, in, cb);
+  replay(compacted, in2, cb);
+  compacted.compact();
+
+  // compaction changes the layout, but not the order of rows and columns
+  ASSERT_EQ(rows(plain), rows(compacted));
+  ASSERT_EQ(columns(plain), columns(compacted));
+  ASSERT_EQ(plain.size(), compacted.size());
+  ASSERT_EQ(compacted.getNumEntriesInTableau(), compacted.size());
+
+  // pivoting continues normally on the compacted tableau
+  ArithVar basic = *plain.beginBasic();
+  ArithVar entering = ARITHVAR_SENTINEL;
+  for (Tableau::RowIterator e = plain.basicRowIterator(basic);
+       entering == ARITHVAR_SENTINEL;
+       ++e)
+  {
+    if ((*e).getColVar() != basic)
+    {
+      entering = (*e).getColVar();
+    }
+  }
+  plain.pivot(basic, entering, cb);
+  compacted.pivot(basic, entering, cb);
+  ASSERT_EQ(rows(plain), rows(compacted));
+  ASSERT_EQ(columns(plain), columns(compacted));
+}
+
+}  // namespace test
+}  // namespace cvc5
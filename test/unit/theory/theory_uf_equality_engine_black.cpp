@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::theory::eq::EqualityEngine.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "smt/smt_engine_scope.h"
+#include "test_smt.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::eq;
+
+namespace test {
+
+class TestTheoryBlackUfEqualityEngine : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SmtScope(d_smtEngine.get()));
+    d_context.reset(new context::Context());
+    d_ee.reset(new EqualityEngine(d_context.get(), "ee_test::", false));
+    d_ee->addFunctionKind(APPLY_UF);
+    TypeNode u = d_nodeManager->mkSort("U");
+    d_f = d_skolemManager->mkDummySkolem("f",
+                                         d_nodeManager->mkFunctionType(u, u));
+    for (size_t i = 0; i < s_numTerms; ++i)
+    {
+      d_x.push_back(
+          d_skolemManager->mkDummySkolem("x" + std::to_string(i), u));
+    }
+  }
+
+  void TearDown() override
+  {
+    d_ee.reset();
+    d_context.reset();
+    d_scope.reset();
+    TestSmt::TearDown();
+  }
+
+  /** Returns f applied depth times to t */
+  Node apply(Node t, size_t depth)
+  {
+    for (size_t i = 0; i < depth; ++i)
+    {
+      t = d_nodeManager->mkNode(APPLY_UF, d_f, t);
+    }
+    return t;
+  }
+
+  /** The number of skolems */
+  static constexpr size_t s_numTerms = 200;
+  std::unique_ptr<smt::SmtScope> d_scope;
+  std::unique_ptr<context::Context> d_context;
+  std::unique_ptr<EqualityEngine> d_ee;
+  Node d_f;
+  std::vector<Node> d_x;
+};
+
+TEST_F(TestTheoryBlackUfEqualityEngine, congruence_and_backtrack)
+{
+  Node fa = apply(d_x[0], 1);
+  Node fb = apply(d_x[1], 1);
+  Node ffa = apply(d_x[0], 2);
+  Node ffb = apply(d_x[1], 2);
+  d_ee->addTerm(ffa);
+  d_ee->addTerm(ffb);
+  ASSERT_TRUE(d_ee->hasTerm(fa));
+  ASSERT_FALSE(d_ee->areEqual(ffa, ffb));
+
+  d_context->push();
+  Node eq = d_x[0].eqNode(d_x[1]);
+  d_ee->assertEquality(eq, true, eq);
+  ASSERT_TRUE(d_ee->areEqual(fa, fb));
+  ASSERT_TRUE(d_ee->areEqual(ffa, ffb));
+  std::vector<TNode> assumptions;
+  d_ee->explainEquality(ffa, ffb, true, assumptions);
+  ASSERT_EQ(assumptions.size(), 1);
+  ASSERT_EQ(assumptions[0], eq);
+
+  d_context->push();
+  Node fc = apply(d_x[2], 1);
+  d_ee->addTerm(fc);
+  ASSERT_TRUE(d_ee->hasTerm(fc));
+  d_context->pop();
+  ASSERT_FALSE(d_ee->hasTerm(fc));
+  ASSERT_FALSE(d_ee->hasTerm(d_x[2]));
+
+  d_context->pop();
+  ASSERT_FALSE(d_ee->areEqual(ffa, ffb));
+  ASSERT_TRUE(d_ee->hasTerm(ffa));
+}
+
+TEST_F(TestTheoryBlackUfEqualityEngine, merge_explain_congruence)
+{
+  constexpr size_t depth = 3;
+  std::vector<Node> terms;
+  for (const Node& x : d_x)
+  {
+    terms.push_back(apply(x, depth));
+    d_ee->addTerm(terms.back());
+  }
+  for (size_t round = 0; round < 2; ++round)
+  {
+    d_context->push();
+    // each merge of two skolems triggers depth congruence merges
+    for (size_t i = 0; i + 1 < s_numTerms; ++i)
+    {
+      Node eq = d_x[i].eqNode(d_x[i + 1]);
+      d_ee->assertEquality(eq, true, eq);
+    }
+    for (size_t i = 0; i < s_numTerms; i += 17)
+    {
+      std::vector<TNode> assumptions;
+      d_ee->explainEquality(terms[0], terms[i], true, assumptions);
+      ASSERT_EQ(assumptions.size(), i);
+    }
+    ASSERT_TRUE(d_ee->areEqual(terms.front(), terms.back()));
+    d_context->pop();
+    ASSERT_FALSE(d_ee->areEqual(terms.front(), terms.back()));
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -13,6 +13,7 @@
  * Black box testing of cvc5::Rational.
  */
 
+#include <climits>
 #include <sstream>
 
 #include "test.h"
@@ -42,5 +43,32 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, machineWordOverflow)
+{
+  Rational max(LONG_MAX);
+  Rational min(LONG_MIN);
+  Rational one(1);
+  Integer bigMax = Integer(LONG_MAX) + Integer(1);
+  ASSERT_EQ((max + one).getNumerator(), bigMax);
+  ASSERT_EQ(max + one - one, max);
+  ASSERT_EQ(-min, Rational(bigMax));
+  ASSERT_EQ(min - one + one, min);
+  ASSERT_EQ(-(-min), min);
+  ASSERT_EQ((max * max) / max, max);
+  ASSERT_EQ((min * min).getNumerator(), Integer(LONG_MIN) * Integer(LONG_MIN));
+  ASSERT_EQ(Rational(1L, LONG_MAX) + Rational(1L, LONG_MAX - 1),
+            Rational(Integer(LONG_MAX) + Integer(LONG_MAX - 1),
+                     Integer(LONG_MAX) * Integer(LONG_MAX - 1)));
+  ASSERT_EQ(Rational(1L, LONG_MAX).inverse(), max);
+  ASSERT_EQ(Rational(LONG_MAX, 2L).cmp(Rational(LONG_MAX - 1, 2L)), 1);
+  ASSERT_LT(Rational(LONG_MAX - 2, LONG_MAX - 1),
+            Rational(LONG_MAX - 1, LONG_MAX));
+  ASSERT_EQ((max + one).floor(), bigMax);
+  ASSERT_EQ(Rational(-7, 2).floor(), Integer(-4));
+  ASSERT_EQ(Rational(-7, 2).ceiling(), Integer(-3));
+  ASSERT_EQ((max + one - one).hash(), max.hash());
+  ASSERT_EQ(min.toString(), std::to_string(LONG_MIN));
+}
 }  // namespace test
 }  // namespace cvc5